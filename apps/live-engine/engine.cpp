@@ -2,24 +2,199 @@
 #include "ultra/core/time/rdtsc_clock.hpp"
 #include "ultra/core/thread_utils.hpp"
 #include "ultra/core/async_logger.hpp"
+#include "ultra/core/memory/memory_utils.hpp"
+#include "ultra/core/spin_wait.hpp"
+#include <chrono>
+#include <cstring>
 #include <iostream>
 #include <vector>
+#include <cstdlib>
+#include <time.h>
+#include <stdexcept>
+#include <string>
 
 namespace ultra {
 
+namespace {
+// Idle policy for one pipeline thread from the environment, e.g.
+// ULTRA_EXEC_WAIT=spin_futex (default: busy_spin, i.e. the hot-core behaviour).
+// Tunables: <prefix>_SPIN_ITERATIONS, <prefix>_MAX_BACKOFF_SHIFT,
+// <prefix>_PARK_TIMEOUT_NS (e.g. ULTRA_EXEC_PARK_TIMEOUT_NS)
+WaitStrategy::Config wait_config_from_env(const std::string& prefix) {
+    WaitStrategy::Config config;
+    const std::string var = prefix + "_WAIT";
+    if (const char* value = std::getenv(var.c_str())) {
+        if (!parse_wait_policy(value, config.policy)) {
+            std::cerr << "Unknown wait policy " << var << "=" << value << ", using busy_spin" << std::endl;
+        }
+    }
+    if (const char* v = std::getenv((prefix + "_SPIN_ITERATIONS").c_str())) {
+        config.spin_iterations = static_cast<uint32_t>(std::strtoul(v, nullptr, 10));
+    }
+    if (const char* v = std::getenv((prefix + "_MAX_BACKOFF_SHIFT").c_str())) {
+        const unsigned long shift = std::strtoul(v, nullptr, 10);
+        config.max_backoff_shift = static_cast<uint32_t>(shift < 63 ? shift : 63); // 1 << shift must fit
+    }
+    if (const char* v = std::getenv((prefix + "_PARK_TIMEOUT_NS").c_str())) {
+        config.park_timeout_ns = std::strtoull(v, nullptr, 10);
+    }
+    return config;
+}
+
+// Hot-memory policy ([hardware] in engine.toml) from the environment:
+//   ULTRA_NUMA_NODE    node to bind to (default: node of the MD core)
+//   ULTRA_HUGE_PAGE_MB 2 (default) or 1024
+//   ULTRA_LOCK_MEMORY  mlock queue memory (needs CAP_IPC_LOCK / RLIMIT_MEMLOCK)
+HugePageOptions memory_options_from_env(int md_core) {
+    HugePageOptions options;
+    options.populate = true; // No first-touch faults after market open
+    options.numa_node = HugePages::node_of_cpu(md_core);
+    if (const char* node = std::getenv("ULTRA_NUMA_NODE")) options.numa_node = std::atoi(node);
+    if (const char* mb = std::getenv("ULTRA_HUGE_PAGE_MB")) {
+        options.page_size = std::atoi(mb) >= 1024 ? PageSize::HUGE_1GB : PageSize::HUGE_2MB;
+    }
+    options.lock = std::getenv("ULTRA_LOCK_MEMORY") != nullptr;
+    return options;
+}
+
+// ULTRA_REQUIRE_HUGE_PAGES turns a page-size fallback into a refusal to start
+void check_mapping(const char* name, const HugePageMapping& m, const HugePageOptions& requested) {
+    if (m.page_size != requested.page_size && std::getenv("ULTRA_REQUIRE_HUGE_PAGES")) {
+        throw std::runtime_error(std::string(name) + ": got " + to_string(m.page_size) + " pages, " +
+                                 to_string(requested.page_size) + " required (ULTRA_REQUIRE_HUGE_PAGES)");
+    }
+}
+
+// Feed channels ([network] channels) from the environment:
+//   ULTRA_MD_CHANNELS  group:port[:priority],... (higher priority polled first)
+std::vector<network::MultiChannelReceiver::ChannelConfig> channels_from_env(const char* spec) {
+    std::vector<network::MultiChannelReceiver::ChannelConfig> channels;
+    std::string rest = spec;
+    while (!rest.empty()) {
+        const size_t comma = rest.find(',');
+        const std::string item = rest.substr(0, comma);
+        rest = comma == std::string::npos ? "" : rest.substr(comma + 1);
+        const size_t colon = item.find(':');
+        if (colon == std::string::npos) {
+            std::cerr << "Ignoring channel '" << item << "' (want group:port[:priority])" << std::endl;
+            continue;
+        }
+        network::MultiChannelReceiver::ChannelConfig channel;
+        channel.name = item;
+        channel.multicast_group = item.substr(0, colon);
+        channel.port = std::atoi(item.c_str() + colon + 1);
+        const size_t prio = item.find(':', colon + 1);
+        if (prio != std::string::npos) channel.priority = std::atoi(item.c_str() + prio + 1);
+        channels.push_back(channel);
+    }
+    return channels;
+}
+
+void print_latency(const char* name, const WakeLatencyHistogram& h) {
+    std::cout << "--- " << name << " ---" << std::endl;
+    std::cout << "Samples: " << h.count() << ", P50: <" << h.percentile_ns(0.50) << " ns, P99: <"
+              << h.percentile_ns(0.99) << " ns, P99.9: <" << h.percentile_ns(0.999) << " ns, Max: " << h.max_ns()
+              << " ns" << std::endl;
+}
+
+// Synthetic ITCH mix for warm-up, cycling through every message type the
+// book handles: add bid, add ask, replace the bid, delete the ask. Prices
+// walk over a few levels so level insert/remove paths are exercised too.
+class WarmupFeed {
+public:
+    explicit WarmupFeed(const char* stock) { std::memcpy(stock_, stock, sizeof(stock_)); }
+
+    // Writes the next message (a one-message packet) into buf; returns its length
+    size_t next(uint8_t* buf, uint64_t ts) noexcept {
+        using namespace md::itch;
+        const uint32_t level = static_cast<uint32_t>((step_ / 4) % 8) * 100;
+        size_t len = 0;
+        const uint64_t phase = step_++ % 4;
+        switch (phase) {
+        case 0:
+        case 1: {
+            const bool bid = phase == 0;
+            AddOrder m{};
+            m.header.type = static_cast<uint8_t>(MessageType::ADD_ORDER);
+            m.timestamp = __builtin_bswap64(ts);
+            m.order_ref_number = __builtin_bswap64(bid ? (bid_ref_ = next_ref_++) : (ask_ref_ = next_ref_++));
+            m.buy_sell_indicator = bid ? 'B' : 'S';
+            m.shares = __builtin_bswap32(100);
+            std::memcpy(m.stock, stock_, sizeof(m.stock));
+            m.price = __builtin_bswap32(bid ? 1499900 - level : 1500100 + level);
+            len = emit(buf, m);
+            break;
+        }
+        case 2: {
+            OrderReplace m{};
+            m.header.type = static_cast<uint8_t>(MessageType::ORDER_REPLACE);
+            m.timestamp = __builtin_bswap64(ts);
+            m.original_order_ref = __builtin_bswap64(bid_ref_);
+            m.new_order_ref = __builtin_bswap64(bid_ref_ = next_ref_++);
+            m.shares = __builtin_bswap32(200);
+            m.price = __builtin_bswap32(1499800 - level);
+            len = emit(buf, m);
+            break;
+        }
+        default: {
+            OrderDelete m{};
+            m.header.type = static_cast<uint8_t>(MessageType::ORDER_DELETE);
+            m.timestamp = __builtin_bswap64(ts);
+            m.order_ref_number = __builtin_bswap64(ask_ref_);
+            len = emit(buf, m);
+            break;
+        }
+        }
+        return len;
+    }
+
+private:
+    template<typename Msg>
+    static size_t emit(uint8_t* buf, Msg& m) noexcept {
+        m.header.length = __builtin_bswap16(sizeof(Msg));
+        std::memcpy(buf, &m, sizeof(Msg));
+        return sizeof(Msg);
+    }
+
+    char stock_[8]; ///< Registered symbol, space padded.
+    uint64_t step_{0}; ///< Messages generated.
+    uint64_t next_ref_{1ULL << 40}; ///< Order refs clear of the simulated feed's.
+    uint64_t bid_ref_{0}; ///< Latest resting bid.
+    uint64_t ask_ref_{0}; ///< Latest resting ask.
+};
+} // namespace
+
         /**
          * @brief Auto-generated description for Engine.
          */
 Engine::Engine() {
     ULTRA_TRACE("Engine::Engine", "Constructing HFT Engine", "None");
-    // --- 1. Allocate Queues ---
-    md_to_strategy_queue_ = std::make_unique<MDQueue>();
-    strategy_to_risk_queue_ = std::make_unique<OrderQueue>();
-    risk_to_gateway_queue_ = std::make_unique<OrderQueue>();
-    gateway_to_strategy_queue_ = std::make_unique<ExecQueue>();
+    // --- 1. Lay out hot data ---
+    // One huge-page region bound to the pipeline cores' node, faulted in
+    // (and optionally locked) now, so nothing first-touches after the open
+    const HugePageOptions memory = memory_options_from_env(MD_CORE);
+    const size_t arena_bytes =
+        HotArena::footprint(sizeof(MDQueue)) + HotArena::footprint(sizeof(RiskQueue)) +
+        HotArena::footprint(sizeof(OrderQueue)) + HotArena::footprint(sizeof(ExecQueue)) +
+        HotArena::footprint(sizeof(md::itch::ITCHDecoder)) + HotArena::footprint(sizeof(strategy::RLPolicyStrategy)) +
+        HotArena::footprint(sizeof(risk::PretradeChecker)) + HotArena::footprint(sizeof(exec::GatewaySim)) +
+        HotArena::footprint(sizeof(execution::SmartOrderRouter)) + HotArena::footprint(RX_BUFFER_SIZE) +
+        HotArena::footprint(md::OrderBookL2::OrderPool::chunk_bytes(), md::OrderBookL2::OrderPool::chunk_align());
+    arena_ = std::make_unique<HotArena>(arena_bytes, memory);
+    check_mapping("hot arena", arena_->mapping(), memory);
+
+    // Pipeline buffers first; components are placed as they are built below
+    rx_buffer_ = static_cast<uint8_t*>(arena_->allocate("md_rx_buffer", RX_BUFFER_SIZE));
+    md_to_strategy_queue_ = arena_->create<MDQueue>("md_to_strategy_queue");
+    strategy_to_risk_queue_ = arena_->create<RiskQueue>("strategy_to_risk_queue");
+    risk_to_gateway_queue_ = arena_->create<OrderQueue>("risk_to_gateway_queue");
+    gateway_to_strategy_queue_ = arena_->create<ExecQueue>("gateway_to_strategy_queue");
+
+    strategy_wait_.configure(wait_config_from_env("ULTRA_STRATEGY"));
+    exec_wait_.configure(wait_config_from_env("ULTRA_EXEC"));
     
     // --- 2. Initialize Components ---
-    decoder_ = std::make_unique<md::itch::ITCHDecoder>();
+    decoder_ = arena_->create<md::itch::ITCHDecoder>("itch_decoder");
     
     // Configure Symbol Universe (Hybrid Routing)
     const SymbolId AAPL_ID = 1;
@@ -33,12 +208,16 @@ Engine::Engine() {
 
     decoder_->register_symbol("AAPL    ", AAPL_ID);
     
-    strategy_ = std::make_unique<strategy::RLPolicyStrategy>(AAPL_ID);
+    // The book's first order-pool chunk comes from the arena; chunks the
+    // pool grows into later are mapped under the same options
+    void* order_storage = arena_->allocate("order_book_pool", md::OrderBookL2::OrderPool::chunk_bytes(),
+                                           md::OrderBookL2::OrderPool::chunk_align());
+    strategy_ = arena_->create<strategy::RLPolicyStrategy>("rl_strategy", AAPL_ID, memory, order_storage);
     
     risk::PretradeChecker::Config risk_config;
-    risk_checker_ = std::make_unique<risk::PretradeChecker>(risk_config);
+    risk_checker_ = arena_->create<risk::PretradeChecker>("pretrade_checker", risk_config);
     
-    gateway_ = std::make_unique<exec::GatewaySim>();
+    gateway_ = arena_->create<exec::GatewaySim>("gateway_sim");
 
     // --- 3. Initialize New Thesis Components ---
     fpga_driver_ = std::make_unique<fpga::FPGADriver>();
@@ -47,7 +226,7 @@ Engine::Engine() {
     }
     
     // Initialize Smart Order Router (Hybrid)
-    router_ = std::make_unique<execution::SmartOrderRouter>(fpga_driver_.get(), gateway_.get());
+    router_ = arena_->create<execution::SmartOrderRouter>("smart_order_router", fpga_driver_.get(), gateway_);
 
     // Config for Live Network (Example)
     // In production, load from toml
@@ -55,18 +234,116 @@ Engine::Engine() {
     net_config.multicast_group = "233.54.12.111"; // Example NASDAQ ITCH Group
     net_config.port = 5000;
     net_config.interface_ip = "127.0.0.1";
+    // SO_BUSY_POLL budget for the MD socket ([network] busy_poll_us)
+    if (const char* us = std::getenv("ULTRA_BUSY_POLL_US")) net_config.busy_poll_us = std::atoi(us);
+    // io_uring backend: same receive_batch() loop, no syscalls in steady state
+    const char* md_source = std::getenv("ULTRA_MD_SOURCE");
+    if (md_source && std::strcmp(md_source, "io_uring") == 0) {
+        net_config.backend = network::MulticastReceiver::Backend::IO_URING;
+        if (const char* cpu = std::getenv("ULTRA_SQPOLL_CPU")) net_config.uring_sqpoll_cpu = std::atoi(cpu);
+    }
     udp_receiver_ = std::make_unique<network::MulticastReceiver>(net_config);
-    
+    // Feed framing ([network] framing): bare ITCH messages per datagram, or
+    // MoldUDP64 packets as the venue (and md_replayer) publishes them
+    if (const char* framing = std::getenv("ULTRA_MD_FRAMING")) mold_framing_ = std::strcmp(framing, "moldudp64") == 0;
+
+    // Feed channels, shared by every MD source that can take several
+    std::vector<network::MultiChannelReceiver::ChannelConfig> md_channels;
+    if (const char* channels = std::getenv("ULTRA_MD_CHANNELS")) md_channels = channels_from_env(channels);
+
+    if (md_source && std::strcmp(md_source, "pcap") == 0) {
+        // Capture replay ([replay] in engine.toml): datagrams from a pcap or
+        // pcapng file, released on their capture stamps, which go on the
+        // events as received_ts. No network needed
+        const char* file = std::getenv("ULTRA_PCAP_FILE");
+        pcap_reader_ = std::make_unique<network::PcapReader>();
+        if (!file || !pcap_reader_->open(file)) {
+            std::cerr << "Failed to open capture (ULTRA_PCAP_FILE). Falling back to sim." << std::endl;
+            pcap_reader_.reset();
+        } else {
+            const char* speed = std::getenv("ULTRA_REPLAY_SPEED");
+            const char* max_gap_ms = std::getenv("ULTRA_REPLAY_MAX_GAP_MS");
+            replay_pacer_ = network::ReplayPacer(speed ? std::atof(speed) : 1.0,
+                                                 max_gap_ms ? std::strtoull(max_gap_ms, nullptr, 10) * 1'000'000ULL : 0);
+            uint16_t index = 0;
+            for (const auto& channel : md_channels) {
+                replay_flows_.add(channel.multicast_group.c_str(), static_cast<uint16_t>(channel.port), index++);
+            }
+            std::cout << "Replaying " << file << " at ";
+            if (replay_pacer_.speed() > 0) {
+                std::cout << replay_pacer_.speed() << "x";
+            } else {
+                std::cout << "full speed";
+            }
+            if (replay_flows_.size()) std::cout << ", " << replay_flows_.size() << " channel(s)";
+            std::cout << std::endl;
+        }
+    }
+
     // Default to Simulation for safety unless env var is set
-    if (std::getenv("ULTRA_LIVE_MODE")) {
+    if (!pcap_reader_ && std::getenv("ULTRA_LIVE_MODE")) {
         use_live_network_ = true;
-        if (!udp_receiver_->start()) {
+        if (md_source && std::strcmp(md_source, "packet_ring") == 0) {
+            // AF_PACKET ring on the feed interface ([network] md_source)
+            network::PacketRingReceiver::Config ring_config;
+            const char* iface = std::getenv("ULTRA_MD_INTERFACE");
+            ring_config.interface_name = iface ? iface : "lo";
+            ring_config.interface_ip = net_config.interface_ip;
+            ring_config.channels = {{net_config.multicast_group, static_cast<uint16_t>(net_config.port)}};
+            if (!md_channels.empty()) ring_config.channels.clear();
+            for (const auto& channel : md_channels) {
+                ring_config.channels.push_back({channel.multicast_group, static_cast<uint16_t>(channel.port)});
+            }
+            packet_ring_ = std::make_unique<network::PacketRingReceiver>(ring_config);
+            if (!packet_ring_->start()) {
+                std::cerr << "Failed to start packet ring. Falling back to UDP receiver." << std::endl;
+                packet_ring_.reset();
+            }
+        }
+        if (md_source && std::strcmp(md_source, "xdp") == 0) {
+            // AF_XDP socket on one rx queue of the feed interface. The UDP
+            // socket below (one per channel with ULTRA_MD_CHANNELS) still
+            // starts: it holds the group membership so the NIC accepts the
+            // feed's multicast MACs, but the XDP program takes the feed's
+            // packets before they reach it
+            network::XDPReceiver::Config xdp_config;
+            const char* iface = std::getenv("ULTRA_MD_INTERFACE");
+            xdp_config.interface_name = iface ? iface : "eth0";
+            if (const char* q = std::getenv("ULTRA_XDP_QUEUE")) xdp_config.queue_id = std::atoi(q);
+            xdp_config.ports = {static_cast<uint16_t>(net_config.port)};
+            if (!md_channels.empty()) xdp_config.ports.clear();
+            for (const auto& channel : md_channels) xdp_config.ports.push_back(static_cast<uint16_t>(channel.port));
+            xdp_config.memory = memory; // UMEM on the MD thread's node
+            xdp_receiver_ = std::make_unique<network::XDPReceiver>(xdp_config);
+            if (!xdp_receiver_->start()) {
+                std::cerr << "Failed to start XDP receiver. Falling back to UDP receiver." << std::endl;
+                xdp_receiver_.reset();
+            }
+        }
+        if (!md_channels.empty() && !packet_ring_) {
+            // Every channel of the venue on this MD thread, one socket each,
+            // same receive settings (backend, batch, timestamps) as above.
+            // Under XDP the sockets only hold the channels' group
+            // memberships (the XDP program takes the packets)
+            network::MultiChannelReceiver::Config multi_config;
+            multi_config.receiver = net_config;
+            if (mold_framing_) multi_config.sequencing = network::MultiChannelReceiver::Sequencing::MOLDUDP64;
+            multi_config.channels = md_channels;
+            multi_receiver_ = std::make_unique<network::MultiChannelReceiver>(multi_config);
+            if (multi_config.channels.empty() || !multi_receiver_->start()) {
+                std::cerr << "Failed to start multi-channel receiver. Falling back to UDP receiver." << std::endl;
+                multi_receiver_.reset();
+            }
+        }
+        if (!packet_ring_ && !multi_receiver_ && !udp_receiver_->start()) {
             std::cerr << "Failed to start UDP receiver. Falling back to sim." << std::endl;
             use_live_network_ = false;
         }
     }
     
-    std::cout << "Engine components initialized. Mode: " << (use_live_network_ ? "LIVE" : "SIMULATION") << std::endl;
+    arena_->print_layout(std::cout);
+    std::cout << "Engine components initialized. Mode: "
+              << (pcap_reader_ ? "REPLAY" : use_live_network_ ? "LIVE" : "SIMULATION") << std::endl;
 }
 
         /**
@@ -84,12 +361,7 @@ Engine::~Engine() {
               */
 void Engine::run() {
     ULTRA_TRACE_SIMPLE("Engine::run");
-    running_ = true;
-    
-    // Start threads (in reverse order of data flow)
-    exec_thread_ = std::thread(&Engine::exec_thread_loop, this);
-    strategy_thread_ = std::thread(&Engine::strategy_thread_loop, this);
-    md_thread_ = std::thread(&Engine::md_thread_loop, this);
+    start_threads();
 }
 
              /**
@@ -97,15 +369,127 @@ void Engine::run() {
               */
 void Engine::stop() {
     ULTRA_TRACE_SIMPLE("Engine::stop");
-    running_ = false;
-    
+    join_threads();
+    // After the join: stop() tears down the io_uring rings the MD thread reaps
     if (udp_receiver_) udp_receiver_->stop();
+    if (xdp_receiver_) {
+        const auto st = xdp_receiver_->stats();
+        std::cout << "XDP: " << xdp_receiver_->frames() << " frames, rx ring full " << st.rx_ring_full
+                  << ", fill ring empty " << st.fill_ring_empty << std::endl;
+        xdp_receiver_->stop();
+    }
+    if (multi_receiver_) {
+        std::cout << "MD channels (" << multi_receiver_->rounds() << " polling rounds):" << std::endl;
+        multi_receiver_->print_stats(std::cout);
+        multi_receiver_->stop();
+    }
+    if (packet_ring_) {
+        const auto st = packet_ring_->stats();
+        std::cout << "Packet ring: " << packet_ring_->frames() << " frames in " << packet_ring_->blocks()
+                  << " blocks, kernel drops " << st.drops << std::endl;
+        packet_ring_->stop();
+    }
+
+    if (pcap_reader_) {
+        std::cout << "Replay: " << pcap_reader_->packets() << " frames, " << pcap_reader_->not_udp() << " not UDP, "
+                  << pcap_reader_->filtered() << " other channels, " << pcap_reader_->skipped()
+                  << " unsupported link type; " << replay_pacer_.late() << " released late (mean "
+                  << replay_pacer_.mean_lag_ns() << " ns, max " << replay_pacer_.max_lag_ns() << " ns), "
+                  << replay_pacer_.gaps_cut() << " gaps cut" << std::endl;
+        if (wire_to_decision_.count() != 0) {
+            print_latency("Capture to decision (scheduled release -> strategy done)", wire_to_decision_);
+        }
+    }
+
+    if (warmup_target_ != 0 && live_first_seen_) {
+        std::cout << "First message MD->strategy latency: " << warmup_first_ns_ << " ns cold (warm-up), "
+                  << live_first_ns_ << " ns live after warm-up" << std::endl;
+    }
+    strategy_wait_.print_stats("Strategy Thread");
+    exec_wait_.print_stats("Exec Thread");
+    if (socket_queue_delay_.count() != 0) {
+        print_latency("Kernel queue delay (kernel rx -> user space)", socket_queue_delay_);
+        print_latency("Wire to decision (kernel rx -> strategy done)", wire_to_decision_);
+    }
     
+    ULTRA_LOG_FLOW(INFO, "Info", 0, "Engine stopped.");
+}
+
+void Engine::start_threads() {
+    running_ = true;
+
+    // Start threads (in reverse order of data flow)
+    exec_thread_ = std::thread(&Engine::exec_thread_loop, this);
+    strategy_thread_ = std::thread(&Engine::strategy_thread_loop, this);
+    md_thread_ = std::thread(&Engine::md_thread_loop, this);
+}
+
+void Engine::join_threads() {
+    running_ = false;
+    strategy_wait_.wake_all();
+    exec_wait_.wake_all();
+
     if (md_thread_.joinable()) md_thread_.join();
     if (strategy_thread_.joinable()) strategy_thread_.join();
     if (exec_thread_.joinable()) exec_thread_.join();
-    
-    ULTRA_LOG_FLOW(INFO, "Info", 0, "Engine stopped.");
+}
+
+void Engine::warm_up(size_t messages) {
+    ULTRA_TRACE_SIMPLE("Engine::warm_up");
+    if (messages == 0 || running_) return;
+
+    warmup_target_ = messages;
+    warmup_feed_done_ = false;
+    warmup_committed_ = 0;
+    warmup_processed_ = 0;
+    warmup_first_ns_ = warmup_last_ns_ = 0;
+    warmup_fpga_routes_ = 0;
+    warmup_latency_.reset();
+
+    // Same threads, cores and code paths as live; only the MD source and
+    // the final send differ
+    warming_up_ = true;
+    start_threads();
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (!warmup_feed_done_ || warmup_processed_.load(std::memory_order_acquire) <
+                                     warmup_committed_.load(std::memory_order_acquire)) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            std::cerr << "Warm-up: timed out after " << warmup_processed_.load() << "/" << messages
+                      << " messages" << std::endl;
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    join_threads();
+    warming_up_ = false;
+    reset_pipeline_state();
+    // Live stats start from zero; the warm-up has its own line below
+    live_first_seen_ = false;
+    strategy_wait_.reset_stats();
+    exec_wait_.reset_stats();
+    wire_to_decision_.reset();
+    socket_queue_delay_.reset();
+
+    std::cout << "Warm-up: " << warmup_processed_.load() << " messages, MD->strategy latency first "
+              << warmup_first_ns_ << " ns, last " << warmup_last_ns_ << " ns (P50 <"
+              << warmup_latency_.percentile_ns(0.50) << " ns, P99 <" << warmup_latency_.percentile_ns(0.99)
+              << " ns); " << warmup_fpga_routes_ << " FPGA route decisions suppressed" << std::endl;
+}
+
+void Engine::reset_pipeline_state() {
+    // Threads are joined: every queue can be drained from here
+    md::itch::ITCHDecoder::DecodedMessage md_msg;
+    while (md_to_strategy_queue_->pop(md_msg)) {}
+    strategy::StrategyOrder order;
+    while (strategy_to_risk_queue_->pop(order)) {}
+    while (risk_to_gateway_queue_->pop(order)) {}
+    exec::ExecutionReport report;
+    while (gateway_to_strategy_queue_->pop(report)) {}
+
+    strategy_->reset();
+    risk_checker_->reset();
 }
 
              /**
@@ -113,11 +497,16 @@ void Engine::stop() {
               */
 void Engine::md_thread_loop() {
     ULTRA_TRACE_SIMPLE("Engine::md_thread_loop");
-    ThreadUtils::pin_thread(1); // Pin MD to Core 1
+    ThreadUtils::pin_thread(MD_CORE); // Pin MD to Core 1
     ULTRA_LOG_FLOW(INFO, "Info", 0, "[MD Thread] running.");
+    MemoryUtils::warmup_stack(); // Fault the stack in before the first message
     
-    // Buffer for network packets
-    std::vector<uint8_t> rx_buffer(2048);
+    // Buffer for network packets: rx_buffer_ (arena, pre-faulted)
+    WarmupFeed warmup_feed("AAPL    ");
+    size_t warmup_sent = 0;
+    network::EthernetParser::ParsedPacket replay_packet{};
+    bool replay_pending = false;
+    bool replay_done = false;
 
     // Simulation State
     using namespace md::itch;
@@ -136,17 +525,119 @@ void Engine::md_thread_loop() {
         size_t packet_len = 0;
         Timestamp rdtsc_ts = RDTSCClock::rdtsc();
 
-        if (use_live_network_) {
-            // --- LIVE PATH ---
-            int n = udp_receiver_->receive(rx_buffer.data(), rx_buffer.size());
-            if (n > 0) {
-                packet_ptr = rx_buffer.data();
-                packet_len = static_cast<size_t>(n);
-            } else {
-                // No data, spin or yield
-                // std::this_thread::yield(); 
+        if (ULTRA_UNLIKELY(warming_up_.load(std::memory_order_relaxed))) {
+            // --- WARM-UP PATH ---
+            // One message in flight at a time, so each sample is pipeline
+            // latency rather than queueing delay
+            if (warmup_sent == warmup_target_ ||
+                warmup_processed_.load(std::memory_order_acquire) != warmup_committed_.load(std::memory_order_relaxed)) {
+                SpinWait::spin();
                 continue;
             }
+            packet_ptr = rx_buffer_;
+            packet_len = warmup_feed.next(rx_buffer_, RDTSCClock::now());
+            if (++warmup_sent == warmup_target_) warmup_feed_done_.store(true, std::memory_order_release);
+        } else if (pcap_reader_) {
+            // --- CAPTURE REPLAY PATH ---
+            // One datagram held until the pacer releases it, decoded in place
+            // in the mapped capture
+            if (!replay_pending) {
+                if (!pcap_reader_->next_udp(replay_packet, replay_flows_.size() ? &replay_flows_ : nullptr)) {
+                    if (!replay_done) {
+                        std::cout << "Capture replay finished: " << pcap_reader_->packets() << " frames" << std::endl;
+                        replay_done = true;
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    continue;
+                }
+                replay_pacer_.schedule(replay_packet.timestamp_ns);
+                replay_pending = true;
+            }
+            if (!replay_pacer_.due()) continue;
+            const Timestamp release_tsc = RDTSCClock::rdtsc();
+            const Timestamp release_ns = RDTSCClock::rdtsc_to_ns(release_tsc);
+            replay_pacer_.released(release_ns);
+            // Map the strategy thread's clock onto capture time, so that
+            // wire to decision reads scheduled release -> decision (paced;
+            // constant offset at 1x) or release -> decision (full speed)
+            const Timestamp basis = replay_pacer_.speed() > 0 ? replay_pacer_.due_ns() : release_ns;
+            wall_offset_ns_.store(static_cast<int64_t>(replay_packet.timestamp_ns) - static_cast<int64_t>(basis),
+                                  std::memory_order_relaxed);
+            decode_datagram(replay_packet.payload, replay_packet.payload_len, release_tsc, replay_packet.timestamp_ns);
+            replay_pending = false;
+            continue;
+        } else if (xdp_receiver_) {
+            // --- AF_XDP PATH ---
+            // DMARingBuffer-style consumer loop over frames in the UMEM; no
+            // kernel rx stamp (AF_XDP descriptors carry none)
+            if (!xdp_receiver_->has_data()) continue;
+            const Timestamp xdp_tsc = RDTSCClock::rdtsc();
+            do {
+                size_t frame_len = 0;
+                const uint8_t* frame = xdp_receiver_->peek(frame_len);
+                const auto p = network::EthernetParser::parse(frame, frame_len, 0);
+                if (ULTRA_LIKELY(p.valid)) decode_datagram(p.payload, p.payload_len, xdp_tsc, 0);
+                xdp_receiver_->advance();
+            } while (xdp_receiver_->has_data());
+            continue;
+        } else if (packet_ring_) {
+            // --- PACKET RING PATH ---
+            // One retired block per poll, frames parsed and decoded in
+            // place in the ring
+            const Timestamp ring_tsc = RDTSCClock::rdtsc();
+            timespec now;
+            bool stamped = false;
+            packet_ring_->poll_udp([&](const network::EthernetParser::ParsedPacket& p) {
+                if (!stamped) {
+                    clock_gettime(CLOCK_REALTIME, &now);
+                    const Timestamp user_ts = static_cast<Timestamp>(now.tv_sec) * 1'000'000'000ULL + now.tv_nsec;
+                    wall_offset_ns_.store(static_cast<int64_t>(user_ts - RDTSCClock::rdtsc_to_ns(ring_tsc)),
+                                          std::memory_order_relaxed);
+                    if (p.timestamp_ns <= user_ts) socket_queue_delay_.record(user_ts - p.timestamp_ns);
+                    stamped = true;
+                }
+                decode_datagram(p.payload, p.payload_len, ring_tsc, p.timestamp_ns);
+            });
+            continue;
+        } else if (multi_receiver_) {
+            // --- MULTI-CHANNEL PATH ---
+            // One round-robin pass over the venue's channels, highest
+            // priority first; no epoll, empty channels cost one poll each
+            bool stamped = false;
+            multi_receiver_->poll([&](uint32_t, const network::MulticastReceiver::Packet& packet, uint64_t) {
+                if (!stamped) {
+                    wall_offset_ns_.store(static_cast<int64_t>(packet.user_ts - RDTSCClock::rdtsc_to_ns(packet.rx_tsc)),
+                                          std::memory_order_relaxed);
+                    stamped = true;
+                }
+                if (packet.kernel_ts != 0 && packet.kernel_ts <= packet.user_ts) {
+                    socket_queue_delay_.record(packet.user_ts - packet.kernel_ts);
+                }
+                // MOLDUDP64 sequencing hands over the blocks past the header
+                if (mold_framing_) {
+                    decode_mold_blocks(packet.data, packet.len, packet.rx_tsc, packet.kernel_ts);
+                } else {
+                    decode_packet(packet.data, packet.len, packet.rx_tsc, packet.kernel_ts);
+                }
+            });
+            continue;
+        } else if (use_live_network_) {
+            // --- LIVE PATH ---
+            // One recvmmsg per poll; packets are decoded in place in the
+            // receiver's buffer ring, each stamped with its batch's TSC and
+            // its own kernel receive time
+            const auto packets = udp_receiver_->receive_batch();
+            if (packets.empty()) continue;
+            // Keep the TSC -> wall clock mapping fresh for the strategy thread
+            wall_offset_ns_.store(static_cast<int64_t>(packets[0].user_ts - RDTSCClock::rdtsc_to_ns(packets[0].rx_tsc)),
+                                  std::memory_order_relaxed);
+            for (const auto& packet : packets) {
+                if (packet.kernel_ts != 0 && packet.kernel_ts <= packet.user_ts) {
+                    socket_queue_delay_.record(packet.user_ts - packet.kernel_ts);
+                }
+                decode_datagram(packet.data, packet.len, packet.rx_tsc, packet.kernel_ts);
+            }
+            continue;
         } else {
             // --- SIMULATION PATH ---
             add_msg->timestamp = __builtin_bswap64(RDTSCClock::now());
@@ -163,34 +654,66 @@ void Engine::md_thread_loop() {
             packet_ptr = sim_add_order.data();
             packet_len = sim_add_order.size();
             std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            rdtsc_ts = RDTSCClock::rdtsc(); // "Received" now, not before the pause
         }
         
         // 2. Decode
-        // Note: Real ITCH feed has multiple messages per UDP packet. 
-        // A full implementation loops over the buffer parsing message lengths.
-        // For this Thesis implementation, we assume 1 msg/packet or handle first.
-        
-        // Simple loop for multiple messages in buffer (if live)
-        size_t offset = 0;
-        while (offset + 2 <= packet_len) { // Need at least 2 bytes for length
-             // ITCH 5.0 starts with Length (2 bytes)
-             uint16_t msg_len_be = *reinterpret_cast<const uint16_t*>(packet_ptr + offset);
-             uint16_t msg_len = __builtin_bswap16(msg_len_be);
-             
-             if (offset + 2 + msg_len > packet_len) break; // Incomplete
-             
-             // Decode payload (skip length bytes)
-             auto decoded = decoder_->decode(packet_ptr + offset + 2, msg_len, rdtsc_ts);
-             
-             if (decoded.valid) {
-                 if (ULTRA_UNLIKELY(!md_to_strategy_queue_->push(decoded))) {
-                     // Drop
-                 }
-             }
-             offset += 2 + msg_len;
-             
-             if (!use_live_network_) break; // Sim sends one struct, not ITCH framed packet
+        decode_packet(packet_ptr, packet_len, rdtsc_ts, 0); // No kernel stamp
+    }
+}
+
+// A packet carries back-to-back ITCH messages. Each starts with its
+// MessageHeader, whose (big-endian) length covers the whole message
+// including the header, which is what the decoder expects to see.
+ULTRA_HOT void Engine::decode_packet(const uint8_t* packet_ptr, size_t packet_len, Timestamp rdtsc_ts,
+                                     Timestamp received_ts) {
+    using md::itch::MessageHeader;
+    size_t offset = 0;
+    while (offset + sizeof(MessageHeader) <= packet_len) {
+        const auto* header = reinterpret_cast<const MessageHeader*>(packet_ptr + offset);
+        const size_t msg_len = __builtin_bswap16(header->length);
+        if (ULTRA_UNLIKELY(msg_len < sizeof(MessageHeader) || offset + msg_len > packet_len)) break; // Truncated
+
+        // Decode straight into the queue slot; invalid messages are
+        // simply never committed
+        auto* slot = md_to_strategy_queue_->try_reserve();
+        if (ULTRA_LIKELY(slot != nullptr)) {
+            if (decoder_->decode_into(packet_ptr + offset, msg_len, rdtsc_ts, *slot)) {
+                slot->received_ts = received_ts;
+                md_to_strategy_queue_->commit();
+                if (ULTRA_UNLIKELY(warming_up_.load(std::memory_order_relaxed))) {
+                    warmup_committed_.fetch_add(1, std::memory_order_release);
+                }
+                strategy_wait_.notify();
+            }
+        } else {
+            // Drop
         }
+        offset += msg_len;
+    }
+}
+
+ULTRA_HOT void Engine::decode_mold_blocks(const uint8_t* blocks, size_t len, Timestamp rdtsc_ts,
+                                          Timestamp received_ts) {
+    size_t offset = 0;
+    while (offset + 2 <= len) {
+        uint16_t block;
+        std::memcpy(&block, blocks + offset, sizeof(block));
+        const size_t msg_len = __builtin_bswap16(block);
+        offset += 2;
+        if (ULTRA_UNLIKELY(offset + msg_len > len)) break; // Truncated
+        decode_packet(blocks + offset, msg_len, rdtsc_ts, received_ts);
+        offset += msg_len;
+    }
+}
+
+ULTRA_HOT void Engine::decode_datagram(const uint8_t* data, size_t len, Timestamp rdtsc_ts, Timestamp received_ts) {
+    if (!mold_framing_) {
+        decode_packet(data, len, rdtsc_ts, received_ts);
+    } else if (ULTRA_LIKELY(len >= sizeof(network::MoldUDP64Header))) {
+        // No sequence check on this path (see MultiChannelReceiver)
+        decode_mold_blocks(data + sizeof(network::MoldUDP64Header), len - sizeof(network::MoldUDP64Header), rdtsc_ts,
+                           received_ts);
     }
 }
 
@@ -201,43 +724,73 @@ void Engine::strategy_thread_loop() {
     ULTRA_TRACE_SIMPLE("Engine::strategy_thread_loop");
     ThreadUtils::pin_thread(2);
     ULTRA_LOG_FLOW(INFO, "Info", 0, "[Strategy Thread] running.");
+    MemoryUtils::warmup_stack();
     
-    md::itch::ITCHDecoder::DecodedMessage md_msg;
-    exec::ExecutionReport exec_report;
-    strategy::StrategyOrder strategy_order;
-    
+    // Order the risk queue could not take yet (retried before pulling more)
+    strategy::StrategyOrder pending_order;
+    bool has_pending = false;
+
     // Throttle FPGA updates
     int msg_counter = 0;
 
     while (running_) {
         bool work_done = false;
         
-        if (md_to_strategy_queue_->pop(md_msg)) {
-            strategy_->on_market_data(md_msg);
+        // Consume in place: no copy out of the ring
+        if (const auto* md_msg = md_to_strategy_queue_->peek()) {
+            strategy_->on_market_data(*md_msg);
+            if (md_msg->received_ts != 0) {
+                // Wire (kernel/NIC stamp) to decision, on the wall clock via the TSC
+                const int64_t now = static_cast<int64_t>(RDTSCClock::now()) + wall_offset_ns_.load(std::memory_order_relaxed);
+                const int64_t ns = now - static_cast<int64_t>(md_msg->received_ts);
+                if (ns > 0) wire_to_decision_.record(static_cast<uint64_t>(ns));
+            }
+            if (ULTRA_UNLIKELY(warming_up_.load(std::memory_order_relaxed))) {
+                const uint64_t ns = RDTSCClock::rdtsc_to_ns(RDTSCClock::rdtsc() - md_msg->tsc);
+                if (warmup_processed_.load(std::memory_order_relaxed) == 0) warmup_first_ns_ = ns;
+                warmup_last_ns_ = ns;
+                warmup_latency_.record(ns);
+                warmup_processed_.fetch_add(1, std::memory_order_release);
+            } else if (ULTRA_UNLIKELY(!live_first_seen_)) {
+                // First message after warm-up, against warmup_first_ns_
+                live_first_ns_ = RDTSCClock::rdtsc_to_ns(RDTSCClock::rdtsc() - md_msg->tsc);
+                live_first_seen_ = true;
+            }
+            md_to_strategy_queue_->release();
             work_done = true;
             msg_counter++;
         }
         
-        if (gateway_to_strategy_queue_->pop(exec_report)) {
-            strategy_->on_execution(exec_report);
+        if (const auto* exec_report = gateway_to_strategy_queue_->peek()) {
+            strategy_->on_execution(*exec_report);
+            gateway_to_strategy_queue_->release();
             work_done = true;
         }
 
-        while (strategy_->get_order(strategy_order)) {
-            if (ULTRA_UNLIKELY(!strategy_to_risk_queue_->push(strategy_order))) {
-                // Drop
-            }
+        // Forward orders to the shared risk queue; if it is full, hold the
+        // order and retry on the next pass rather than dropping it
+        while (has_pending || strategy_->get_order(pending_order)) {
+            has_pending = true;
+            if (ULTRA_UNLIKELY(!strategy_to_risk_queue_->push(pending_order))) break;
+            has_pending = false;
             work_done = true;
+            exec_wait_.notify();
         }
         
-        // Update FPGA Parameters periodically
+        // Update FPGA Parameters periodically (not from the warm-up's
+        // synthetic flow, which warm_up() does not undo)
         if (msg_counter >= 100) {
-            fpga_driver_->update_strategy_params(0.1, 2.0, 1000); 
+            if (!warming_up_.load(std::memory_order_relaxed)) fpga_driver_->update_strategy_params(0.1, 2.0, 1000);
             msg_counter = 0;
         }
         
-        if (!work_done) {
-            // Spin
+        if (work_done) {
+            strategy_wait_.on_work();
+        } else {
+            strategy_->maintain(); // Pool growth here, not in allocate() on the next add
+            strategy_wait_.idle([this] {
+                return !md_to_strategy_queue_->empty() || !gateway_to_strategy_queue_->empty() || !running_;
+            });
         }
     }
 }
@@ -249,30 +802,39 @@ void Engine::exec_thread_loop() {
     ULTRA_TRACE_SIMPLE("Engine::exec_thread_loop");
     ThreadUtils::pin_thread(3);
     ULTRA_LOG_FLOW(INFO, "Info", 0, "[Exec Thread] running.");
+    MemoryUtils::warmup_stack();
 
-    strategy::StrategyOrder order_to_check;
-    exec::ExecutionReport exec_report;
-    
     while (running_) {
         bool work_done = false;
         
-        if (strategy_to_risk_queue_->pop(order_to_check)) {
-            if (ULTRA_LIKELY(risk_checker_->check_order(order_to_check))) {
-                // Route via Smart Order Router (FPGA vs CPU decision)
-                router_->route(order_to_check);
+        if (const auto* order_to_check = strategy_to_risk_queue_->peek()) {
+            if (ULTRA_LIKELY(risk_checker_->check_order(*order_to_check))) {
+                // Route via Smart Order Router (FPGA vs CPU decision);
+                // during warm-up only the decision runs, nothing is sent
+                if (ULTRA_UNLIKELY(warming_up_.load(std::memory_order_relaxed))) {
+                    warmup_fpga_routes_ += router_->prefers_fpga(*order_to_check);
+                } else {
+                    router_->route(*order_to_check);
+                }
             }
+            strategy_to_risk_queue_->release();
             work_done = true;
         }
         
-        if (gateway_->get_execution_report(exec_report)) {
-            if (ULTRA_UNLIKELY(!gateway_to_strategy_queue_->push(exec_report))) {
-                // Drop
+        if (auto* slot = gateway_to_strategy_queue_->try_reserve()) {
+            if (gateway_->get_execution_report(*slot)) {
+                gateway_to_strategy_queue_->commit();
+                strategy_wait_.notify();
+                work_done = true;
             }
-            work_done = true;
         }
         
-        if (!work_done) {
-            // Spin
+        if (work_done) {
+            exec_wait_.on_work();
+        } else {
+            exec_wait_.idle([this] {
+                return strategy_to_risk_queue_->size() != 0 || !running_;
+            });
         }
     }
 }
@@ -6,6 +6,14 @@
 #include <ultra/execution/gateway_sim.hpp>
 #include <ultra/execution/router/sor.hpp>
 #include <ultra/network/multicast_receiver.hpp>
+#include <ultra/network/multi_channel_receiver.hpp>
+#include <ultra/network/kernel-bypass/packet_ring.hpp>
+#include <ultra/network/kernel-bypass/xdp_receiver.hpp>
+#include <ultra/network/replay/pcap_reader.hpp>
+#include <ultra/network/replay/replay_pacer.hpp>
+#include <ultra/core/lockfree/mpsc_queue.hpp>
+#include <ultra/core/wait_strategy.hpp>
+#include <ultra/core/memory/hot_arena.hpp>
 #include <ultra/fpga/fpga_driver.hpp>
 #include <memory>
 #include <thread>
@@ -34,6 +42,17 @@ public:
           */
     void stop();
 
+    /**
+     * @brief Pre-open warm-up. Runs the pipeline threads on their cores
+     *        over a synthetic ITCH mix (decoder -> book -> strategy -> risk
+     *        -> router decision, nothing sent), then stops them, resets all
+     *        book/strategy/risk state and drains the queues. Prints the
+     *        first-message latency against the latency once warm.
+     * @param messages Synthetic messages to replay (0: skip).
+     * Call before run().
+     */
+    void warm_up(size_t messages);
+
 private:
          /**
           * @brief Auto-generated description for md_thread_loop.
@@ -48,42 +67,95 @@ private:
           */
     void strategy_thread_loop(); // Strategy Decision Loop
 
-    // --- Components ---
-    std::unique_ptr<md::itch::ITCHDecoder> decoder_; ///< int variable representing decoder_.
-    std::unique_ptr<strategy::RLPolicyStrategy> strategy_; ///< int variable representing strategy_.
-    std::unique_ptr<risk::PretradeChecker> risk_checker_; ///< int variable representing risk_checker_.
-    std::unique_ptr<exec::GatewaySim> gateway_; ///< int variable representing gateway_.
-    std::unique_ptr<execution::SmartOrderRouter> router_; ///< int variable representing router_.
+    // MD thread: split a packet into ITCH messages and decode them into the
+    // MD queue; received_ts (kernel rx stamp, 0 if none) goes on every event
+    void decode_packet(const uint8_t* packet, size_t len, Timestamp rdtsc_ts, Timestamp received_ts);
+    // MoldUDP64 message blocks ({length, message}...) through decode_packet
+    void decode_mold_blocks(const uint8_t* blocks, size_t len, Timestamp rdtsc_ts, Timestamp received_ts);
+    // One feed datagram: MoldUDP64 packet (mold_framing_) or bare ITCH messages
+    void decode_datagram(const uint8_t* data, size_t len, Timestamp rdtsc_ts, Timestamp received_ts);
+
+    void start_threads();
+    void join_threads();
+    void reset_pipeline_state(); // After warm-up: books, strategy, risk, queues
+
+    static constexpr int MD_CORE = 1; ///< MD thread core; queue memory is bound to its node.
+
+    static constexpr size_t RX_BUFFER_SIZE = 2048; ///< One MTU-sized datagram.
+
+    // --- Hot-data arena ---
+    // Declared first so it outlives everything placed in it. Queues, decoder
+    // tables, strategy/risk/gateway/router state and the MD receive buffer
+    // are all laid out here at construction (see the printed layout).
+    std::unique_ptr<HotArena> arena_; ///< Pre-faulted huge-page region.
+
+    // --- Components (arena-owned) ---
+    md::itch::ITCHDecoder* decoder_{nullptr}; ///< int variable representing decoder_.
+    strategy::RLPolicyStrategy* strategy_{nullptr}; ///< int variable representing strategy_.
+    risk::PretradeChecker* risk_checker_{nullptr}; ///< int variable representing risk_checker_.
+    exec::GatewaySim* gateway_{nullptr}; ///< int variable representing gateway_.
+    execution::SmartOrderRouter* router_{nullptr}; ///< int variable representing router_.
+    uint8_t* rx_buffer_{nullptr}; ///< MD thread receive buffer (RX_BUFFER_SIZE).
     
     // New Components (Thesis Integration)
     std::unique_ptr<network::MulticastReceiver> udp_receiver_; ///< int variable representing udp_receiver_.
+    std::unique_ptr<network::MultiChannelReceiver> multi_receiver_; ///< All feed channels (ULTRA_MD_CHANNELS), else null.
+    std::unique_ptr<network::PacketRingReceiver> packet_ring_; ///< AF_PACKET source (ULTRA_MD_SOURCE=packet_ring), else null.
+    std::unique_ptr<network::XDPReceiver> xdp_receiver_; ///< AF_XDP source (ULTRA_MD_SOURCE=xdp), else null.
+    std::unique_ptr<network::PcapReader> pcap_reader_; ///< Capture replay source (ULTRA_MD_SOURCE=pcap), else null.
+    network::ReplayPacer replay_pacer_; ///< Releases replayed datagrams on their capture stamps.
+    network::FlowTable replay_flows_; ///< Channels to replay (ULTRA_MD_CHANNELS); empty = all UDP.
     std::unique_ptr<fpga::FPGADriver> fpga_driver_; ///< int variable representing fpga_driver_.
     
     bool use_live_network_{false}; // Set to true to use UDP Receiver
+    bool mold_framing_{false}; ///< Feed datagrams are MoldUDP64 packets (ULTRA_MD_FRAMING=moldudp64).
     
     // --- Message Queues (The "Event Driven Pipeline" from Fig 3) ---
-    // (Using SPSC queues as this is a simple 1-to-1 pipeline)
+    // (Using SPSC queues as this is a simple 1-to-1 pipeline; arena-owned)
     
     // MD -> Strategy
     using MDQueue = SPSCQueue<md::itch::ITCHDecoder::DecodedMessage, 16384>;
-    std::unique_ptr<MDQueue> md_to_strategy_queue_; ///< int variable representing md_to_strategy_queue_.
+    MDQueue* md_to_strategy_queue_{nullptr}; ///< int variable representing md_to_strategy_queue_.
     
-    // Strategy -> Risk
-    using OrderQueue = SPSCQueue<strategy::StrategyOrder, 8192>;
-    std::unique_ptr<OrderQueue> strategy_to_risk_queue_; ///< int variable representing strategy_to_risk_queue_.
+    // Strategy -> Risk (MPSC: any number of strategy threads, one exec poll)
+    using RiskQueue = MPSCQueue<strategy::StrategyOrder, 8192>;
+    RiskQueue* strategy_to_risk_queue_{nullptr}; ///< Orders from all strategies.
 
     // Risk -> Gateway
-    std::unique_ptr<OrderQueue> risk_to_gateway_queue_; ///< int variable representing risk_to_gateway_queue_.
+    using OrderQueue = SPSCQueue<strategy::StrategyOrder, 8192>;
+    OrderQueue* risk_to_gateway_queue_{nullptr}; ///< int variable representing risk_to_gateway_queue_.
 
     // Gateway -> Strategy (Exec Reports)
     using ExecQueue = SPSCQueue<exec::ExecutionReport, 8192>;
-    std::unique_ptr<ExecQueue> gateway_to_strategy_queue_; ///< int variable representing gateway_to_strategy_queue_.
+    ExecQueue* gateway_to_strategy_queue_{nullptr}; ///< int variable representing gateway_to_strategy_queue_.
 
     // --- Threads ---
     std::thread md_thread_; ///< int variable representing md_thread_.
     std::thread exec_thread_; ///< int variable representing exec_thread_.
     std::thread strategy_thread_; ///< int variable representing strategy_thread_.
     std::atomic<bool> running_{false}; ///< int variable representing running_.
+
+    // --- Receive timestamps (live path) ---
+    std::atomic<int64_t> wall_offset_ns_{0}; ///< CLOCK_REALTIME - RDTSCClock::now() (MD thread, per batch).
+    WakeLatencyHistogram socket_queue_delay_; ///< Kernel rx stamp -> recvmmsg return (MD thread).
+    WakeLatencyHistogram wire_to_decision_; ///< Kernel rx stamp -> strategy done (strategy thread).
+
+    // --- Warm-up (see warm_up()) ---
+    std::atomic<bool> warming_up_{false}; ///< MD replays the synthetic mix; routing suppressed.
+    size_t warmup_target_{0}; ///< Synthetic messages to send.
+    std::atomic<bool> warmup_feed_done_{false}; ///< MD thread has sent them all.
+    std::atomic<uint64_t> warmup_committed_{0}; ///< Decoded into the MD queue (MD thread).
+    std::atomic<uint64_t> warmup_processed_{0}; ///< Handled by the strategy (strategy thread).
+    uint64_t warmup_first_ns_{0}; ///< MD receive -> strategy done, first message.
+    uint64_t warmup_last_ns_{0}; ///< Same, last message.
+    WakeLatencyHistogram warmup_latency_; ///< All warm-up samples (ns).
+    uint64_t warmup_fpga_routes_{0}; ///< Router decisions for the FPGA path (exec thread).
+    uint64_t live_first_ns_{0}; ///< MD receive -> strategy done, first message after warm-up.
+    bool live_first_seen_{false}; ///< live_first_ns_ is set (strategy thread).
+
+    // --- Idle policies (ULTRA_STRATEGY_WAIT / ULTRA_EXEC_WAIT, see [threading] in engine.toml) ---
+    WaitStrategy strategy_wait_; ///< Strategy thread; notified by MD and exec threads.
+    WaitStrategy exec_wait_; ///< Exec thread; notified by strategy thread.
 };
 
 } // namespace ultra
@@ -1,6 +1,7 @@
 #include "engine.hpp"
 #include "ultra/core/time/rdtsc_clock.hpp"
 #include "ultra/core/async_logger.hpp"
+#include <cstdlib>
 #include <iostream>
 
     /**
@@ -29,6 +30,14 @@ int main() {
     // --- 4. Create and Run Engine ---
     try {
         ultra::Engine engine;
+
+        // --- 5. Warm Up ---
+        // Prime caches, branch predictors and stacks on the pipeline cores
+        // before the first real message (ULTRA_WARMUP_MESSAGES, 0 to skip)
+        size_t warmup_messages = 20000;
+        if (const char* n = std::getenv("ULTRA_WARMUP_MESSAGES")) warmup_messages = std::strtoull(n, nullptr, 10);
+        engine.warm_up(warmup_messages);
+
         engine.run();
         std::cout << "Engine running. Press [Enter] to stop." << std::endl;
         std::cin.get();
@@ -0,0 +1,468 @@
+#include "ultra/core/time/rdtsc_clock.hpp"
+#include "ultra/market-data/itch/decoder.hpp"
+#include "ultra/network/multicast_sender.hpp"
+#include "ultra/network/parsers/moldudp64.hpp"
+#include "ultra/network/replay/pcap_reader.hpp"
+#include "ultra/network/replay/replay_pacer.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace ultra;
+using network::MoldUDP64Packer;
+using network::MulticastSender;
+using network::PcapReader;
+using network::ReplayPacer;
+
+/**
+ * Market data replayer: re-publishes an ITCH file (data_generator output)
+ * or a pcap/pcapng capture as MoldUDP64 multicast, so live_engine can be
+ * driven end to end through its socket path.
+ *
+ * - Pacing on the recorded timestamps (ITCH: message time; capture: frame
+ *   time) with a TSC pacer: --speed 1 is the historical rate, 10 / 100
+ *   replay faster, 0 is as fast as possible. --rate N ignores the
+ *   timestamps and sends N messages/s evenly
+ * - --burst N releases N messages per pacing step (microbursts)
+ * - Messages due together share MoldUDP64 packets (up to --max-payload
+ *   bytes); packets for all channels go out with one sendmmsg per batch
+ * - Several channels (--channels), each its own MoldUDP64 session and
+ *   sequence; messages are split by stock locate or round-robin. An
+ *   end-of-session packet closes every channel
+ *
+ * Engine side: ULTRA_LIVE_MODE=1 ULTRA_MD_FRAMING=moldudp64 and the same
+ * group(s) in ULTRA_MD_CHANNELS (or the default 233.54.12.111:5000).
+ */
+
+namespace {
+
+std::atomic<bool> g_stop{false};
+
+struct Options {
+    std::string input;
+    std::vector<std::pair<std::string, int>> channels;
+    std::string interface_ip = "127.0.0.1";
+    double speed = 1.0;
+    double rate = 0; ///< Messages/s; 0: recorded timestamps.
+    uint32_t burst = 1;
+    bool round_robin = false;
+    size_t max_payload = 1400;
+    uint32_t batch = 64;
+    uint32_t loops = 1;
+    uint64_t max_gap_ms = 0;
+    std::string session = "REPLAY";
+    bool pcap_mold = false; ///< Capture payloads are MoldUDP64 (else raw ITCH messages).
+    int ttl = 1;
+};
+
+void usage() {
+    std::cerr << "Usage: md_replayer <itch file | capture.pcap[ng]> [options]\n"
+                 "  --channels G:P[,G:P...]  Destination groups (default 233.54.12.111:5000)\n"
+                 "  --interface IP           Outgoing interface (default 127.0.0.1)\n"
+                 "  --speed X                Multiple of the recorded rate (default 1; 0 = as fast as possible)\n"
+                 "  --rate N                 N messages/s, ignoring timestamps\n"
+                 "  --burst N                Messages released per pacing step (default 1)\n"
+                 "  --split locate|round_robin  Message to channel mapping (default locate)\n"
+                 "  --max-payload N          MoldUDP64 packet size limit in bytes (default 1400)\n"
+                 "  --batch N                Datagrams per sendmmsg (default 64)\n"
+                 "  --loop N                 Passes over the input (default 1)\n"
+                 "  --max-gap-ms N           Cut recorded silences to N ms (default 0: keep)\n"
+                 "  --session NAME           MoldUDP64 session prefix (default REPLAY)\n"
+                 "  --pcap-framing itch|moldudp64  Capture payload format (default itch)\n"
+                 "  --ttl N                  Multicast TTL (default 1)"
+              << std::endl;
+}
+
+bool parse_options(int argc, char** argv, Options& opt) {
+    if (argc < 2) return false;
+    opt.input = argv[1];
+    for (int i = 2; i < argc; ++i) {
+        const std::string key = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << key << std::endl;
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (key == "--channels") {
+            size_t start = 0;
+            while (start < value.size()) {
+                const size_t comma = std::min(value.find(',', start), value.size());
+                const std::string item = value.substr(start, comma - start);
+                const size_t colon = item.find(':');
+                if (colon == std::string::npos) {
+                    std::cerr << "Bad channel '" << item << "' (want group:port)" << std::endl;
+                    return false;
+                }
+                opt.channels.emplace_back(item.substr(0, colon), std::atoi(item.c_str() + colon + 1));
+                start = comma + 1;
+            }
+        } else if (key == "--interface") {
+            opt.interface_ip = value;
+        } else if (key == "--speed") {
+            opt.speed = std::atof(value.c_str());
+        } else if (key == "--rate") {
+            opt.rate = std::atof(value.c_str());
+        } else if (key == "--burst") {
+            opt.burst = std::max(1, std::atoi(value.c_str()));
+        } else if (key == "--split") {
+            opt.round_robin = value == "round_robin";
+        } else if (key == "--max-payload") {
+            opt.max_payload = std::strtoul(value.c_str(), nullptr, 10);
+        } else if (key == "--batch") {
+            opt.batch = std::max(1, std::atoi(value.c_str()));
+        } else if (key == "--loop") {
+            opt.loops = std::max(1, std::atoi(value.c_str()));
+        } else if (key == "--max-gap-ms") {
+            opt.max_gap_ms = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (key == "--session") {
+            opt.session = value;
+        } else if (key == "--pcap-framing") {
+            opt.pcap_mold = value == "moldudp64";
+        } else if (key == "--ttl") {
+            opt.ttl = std::atoi(value.c_str());
+        } else {
+            std::cerr << "Unknown option " << key << std::endl;
+            return false;
+        }
+    }
+    if (opt.channels.empty()) opt.channels.emplace_back("233.54.12.111", 5000);
+    opt.max_payload = std::clamp<size_t>(opt.max_payload, sizeof(network::MoldUDP64Header) + 2 + 64, 2048);
+    return true;
+}
+
+// One ITCH message to publish
+struct Message {
+    const uint8_t* data;
+    uint16_t len;
+    Timestamp ts;
+};
+
+// ITCH file: back-to-back messages, each led by its MessageHeader (whose
+// length covers the whole message); timestamps are ns since midnight
+class ItchFileSource {
+public:
+    ~ItchFileSource() {
+        if (base_) munmap(const_cast<uint8_t*>(base_), size_);
+    }
+
+    bool open(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            perror(("open " + path).c_str());
+            return false;
+        }
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            std::cerr << path << " is empty" << std::endl;
+            ::close(fd);
+            return false;
+        }
+        void* map = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED) {
+            perror("mmap");
+            return false;
+        }
+        madvise(map, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+        base_ = static_cast<const uint8_t*>(map);
+        size_ = static_cast<size_t>(st.st_size);
+        return true;
+    }
+
+    void rewind() { pos_ = 0; }
+
+    ULTRA_ALWAYS_INLINE bool next(Message& m) {
+        using md::itch::MessageHeader;
+        if (pos_ + sizeof(MessageHeader) > size_) return false;
+        const uint16_t len = __builtin_bswap16(reinterpret_cast<const MessageHeader*>(base_ + pos_)->length);
+        if (len < sizeof(MessageHeader) || pos_ + len > size_) {
+            std::cerr << "Malformed ITCH message at offset " << pos_ << ", stopping" << std::endl;
+            pos_ = size_;
+            return false;
+        }
+        m.data = base_ + pos_;
+        m.len = len;
+        m.ts = len >= TIMESTAMP_OFFSET + 8 ? load_be64(base_ + pos_ + TIMESTAMP_OFFSET) : m.ts;
+        pos_ += len;
+        return true;
+    }
+
+private:
+    // Header, stock locate, tracking number, then the 8-byte timestamp
+    static constexpr size_t TIMESTAMP_OFFSET = sizeof(md::itch::MessageHeader) + 4;
+
+    static uint64_t load_be64(const uint8_t* p) {
+        uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return __builtin_bswap64(v);
+    }
+
+    const uint8_t* base_{nullptr};
+    size_t size_{0};
+    size_t pos_{0};
+};
+
+// Capture: each UDP datagram's ITCH messages (or MoldUDP64 blocks), all
+// stamped with the frame's capture time
+class PcapSource {
+public:
+    explicit PcapSource(bool mold) : mold_(mold), reader_(PcapReader::Config{true}) {}
+
+    bool open(const std::string& path) { return reader_.open(path); }
+
+    void rewind() {
+        reader_.rewind();
+        left_ = 0;
+    }
+
+    ULTRA_ALWAYS_INLINE bool next(Message& m) {
+        while (true) {
+            if (left_ >= (mold_ ? 2u : sizeof(md::itch::MessageHeader))) {
+                uint16_t len;
+                std::memcpy(&len, cur_, sizeof(len));
+                len = __builtin_bswap16(len);
+                const uint8_t* msg = cur_;
+                if (mold_) { // Block length excludes itself
+                    msg += 2;
+                    left_ -= 2;
+                }
+                if (len >= sizeof(md::itch::MessageHeader) && len <= left_) {
+                    m = {msg, len, ts_};
+                    cur_ = msg + len;
+                    left_ -= len;
+                    return true;
+                }
+                left_ = 0; // Truncated datagram: drop the rest
+            }
+            network::EthernetParser::ParsedPacket udp;
+            if (!reader_.next_udp(udp)) return false;
+            cur_ = udp.payload;
+            left_ = udp.payload_len;
+            ts_ = udp.timestamp_ns;
+            if (mold_) {
+                const size_t header = std::min<size_t>(left_, sizeof(network::MoldUDP64Header));
+                cur_ += header;
+                left_ -= header;
+            }
+        }
+    }
+
+private:
+    bool mold_;
+    PcapReader reader_;
+    const uint8_t* cur_{nullptr};
+    size_t left_{0};
+    Timestamp ts_{0};
+};
+
+// One MoldUDP64 stream: packet under construction, session and sequence
+struct Channel {
+    std::string group;
+    int port;
+    int destination;
+    char session[10];
+    uint64_t next_sequence = 1;
+    std::array<uint8_t, 2048> buffer;
+    MoldUDP64Packer packer;
+    bool open = false;
+    uint64_t messages = 0;
+    uint64_t packets = 0;
+};
+
+class Publisher {
+public:
+    Publisher(const Options& opt, MulticastSender& sender) : opt_(opt), sender_(sender) {
+        for (size_t i = 0; i < opt.channels.size(); ++i) {
+            Channel& ch = channels_.emplace_back();
+            ch.group = opt.channels[i].first;
+            ch.port = opt.channels[i].second;
+            ch.destination = sender.add_destination(ch.group, ch.port);
+            char name[16];
+            std::snprintf(name, sizeof(name), "%-6.6s%04zu", opt.session.c_str(), i + 1);
+            std::memcpy(ch.session, name, sizeof(ch.session));
+        }
+    }
+
+    bool valid() const {
+        return std::all_of(channels_.begin(), channels_.end(), [](const Channel& ch) { return ch.destination >= 0; });
+    }
+
+    ULTRA_ALWAYS_INLINE void add(const Message& m, uint64_t index) {
+        Channel& ch = channels_[pick(m, index)];
+        if (!ch.open) begin(ch);
+        if (ULTRA_UNLIKELY(!ch.packer.add(m.data, m.len))) {
+            close(ch);
+            begin(ch);
+            if (!ch.packer.add(m.data, m.len)) {
+                ++oversized_;
+                return;
+            }
+        }
+        ++ch.messages;
+    }
+
+    // Packets of every channel onto the wire
+    void flush() {
+        for (Channel& ch : channels_) close(ch);
+        sender_.flush();
+    }
+
+    void end_session() {
+        flush();
+        for (Channel& ch : channels_) {
+            sender_.commit(ch.destination, network::moldudp64::write_heartbeat(sender_.buffer(), ch.session,
+                                                                               ch.next_sequence,
+                                                                               network::moldudp64::END_OF_SESSION));
+        }
+        sender_.flush();
+    }
+
+    const std::vector<Channel>& channels() const { return channels_; }
+    uint64_t oversized() const { return oversized_; }
+
+private:
+    ULTRA_ALWAYS_INLINE size_t pick(const Message& m, uint64_t index) const {
+        if (channels_.size() == 1) return 0;
+        if (opt_.round_robin || m.len < 5) return index % channels_.size();
+        return static_cast<size_t>((m.data[3] << 8) | m.data[4]) % channels_.size(); // Stock locate
+    }
+
+    void begin(Channel& ch) {
+        ch.packer.begin(ch.buffer.data(), opt_.max_payload, ch.session, ch.next_sequence);
+        ch.open = true;
+    }
+
+    void close(Channel& ch) {
+        if (!ch.open) return;
+        ch.open = false;
+        if (ch.packer.count() == 0) return;
+        const size_t len = ch.packer.finish();
+        std::memcpy(sender_.buffer(), ch.buffer.data(), len);
+        sender_.commit(ch.destination, len);
+        ch.next_sequence += ch.packer.count();
+        ++ch.packets;
+    }
+
+    const Options& opt_;
+    MulticastSender& sender_;
+    std::vector<Channel> channels_;
+    uint64_t oversized_{0};
+};
+
+template <typename Source>
+int replay(Source& source, const Options& opt) {
+    MulticastSender::Config config;
+    config.interface_ip = opt.interface_ip;
+    config.ttl = opt.ttl;
+    config.batch_size = opt.batch;
+    MulticastSender sender(config);
+    if (!sender.start()) return 1;
+    Publisher publisher(opt, sender);
+    if (!publisher.valid()) {
+        std::cerr << "Bad channel group address" << std::endl;
+        return 1;
+    }
+
+    ReplayPacer pacer(opt.rate > 0 ? 1.0 : opt.speed, opt.max_gap_ms * 1'000'000ULL);
+    const double rate_step_ns = opt.rate > 0 ? 1e9 / opt.rate : 0;
+    uint64_t total = 0;
+    uint64_t report_at = RDTSCClock::now() + 1'000'000'000ULL;
+    uint64_t reported = 0;
+    const Timestamp start = RDTSCClock::now();
+
+    for (uint32_t pass = 0; pass < opt.loops && !g_stop; ++pass) {
+        source.rewind();
+        pacer.reset();
+        Message m{};
+        uint64_t index = 0;
+        while (!g_stop.load(std::memory_order_relaxed) && source.next(m)) {
+            if (index % opt.burst == 0) {
+                pacer.schedule(opt.rate > 0 ? static_cast<Timestamp>(index * rate_step_ns) : m.ts);
+                if (!pacer.due()) {
+                    publisher.flush(); // Everything due so far goes out before the wait
+                    pacer.wait();
+                }
+                pacer.released(RDTSCClock::now());
+            }
+            publisher.add(m, index);
+            ++index;
+            if ((++total & 1023) == 0 && RDTSCClock::now() >= report_at) {
+                std::cout << "  " << total - reported << " msgs/s" << std::endl;
+                reported = total;
+                report_at += 1'000'000'000ULL;
+            }
+        }
+    }
+    publisher.end_session();
+    const double secs = static_cast<double>(RDTSCClock::now() - start) / 1e9;
+
+    const auto& st = sender.stats();
+    std::cout << "Published " << total << " messages in " << st.datagrams << " datagrams (" << st.syscalls
+              << " sendmmsg calls, " << st.dropped << " dropped) over " << publisher.channels().size()
+              << " channel(s) in " << secs << " s: " << total / secs << " msgs/s, " << st.datagrams / secs
+              << " pkts/s, " << st.bytes / secs / 1e6 << " MB/s" << std::endl;
+    std::cout << "Pacing: " << pacer.late() << " late steps (mean " << pacer.mean_lag_ns() << " ns, max "
+              << pacer.max_lag_ns() << " ns), " << pacer.gaps_cut() << " gaps cut";
+    if (publisher.oversized() != 0) std::cout << ", " << publisher.oversized() << " messages too large, skipped";
+    std::cout << std::endl;
+    for (const Channel& ch : publisher.channels()) {
+        std::cout << "  " << ch.group << ":" << ch.port << " session " << std::string(ch.session, sizeof(ch.session))
+                  << ": " << ch.messages << " msgs in " << ch.packets << " packets, next seq " << ch.next_sequence
+                  << std::endl;
+    }
+    return 0;
+}
+
+bool is_capture(const std::string& path) {
+    FILE* f = std::fopen(path.c_str(), "rb");
+    uint32_t magic = 0;
+    if (!f) return false;
+    const bool read = std::fread(&magic, sizeof(magic), 1, f) == 1;
+    std::fclose(f);
+    for (uint32_t m : {0xA1B2C3D4u, 0xA1B23C4Du, 0x0A0D0D0Au}) {
+        if (read && (magic == m || magic == __builtin_bswap32(m))) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parse_options(argc, argv, opt)) {
+        usage();
+        return 1;
+    }
+    std::signal(SIGINT, [](int) { g_stop = true; });
+    RDTSCClock::calibrate();
+
+    std::cout << "Replaying " << opt.input << " to " << opt.channels.size() << " channel(s) at ";
+    if (opt.rate > 0) {
+        std::cout << opt.rate << " msgs/s";
+    } else if (opt.speed > 0) {
+        std::cout << opt.speed << "x";
+    } else {
+        std::cout << "full speed";
+    }
+    std::cout << ", bursts of " << opt.burst << std::endl;
+
+    if (is_capture(opt.input)) {
+        PcapSource source(opt.pcap_mold);
+        if (!source.open(opt.input)) return 1;
+        return replay(source, opt);
+    }
+    ItchFileSource source;
+    if (!source.open(opt.input)) return 1;
+    return replay(source, opt);
+}
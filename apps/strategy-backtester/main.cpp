@@ -2,10 +2,18 @@
 #include "ultra/market-data/book/order_book_l2.hpp"
 #include "ultra/strategy/signal_engine.hpp"
 #include "ultra/strategy/performance_metrics.hpp"
+#include "ultra/core/work_stealing_pool.hpp"
+#include "ultra/core/memory/scratch_arena.hpp"
 #include <iostream>
+#include <iomanip>
 #include <fstream>
 #include <vector>
 #include <chrono>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <memory_resource>
+#include <span>
 
 using namespace ultra;
 
@@ -15,61 +23,172 @@ struct TickData {
     std::vector<uint64_t> timestamps; ///< int variable representing timestamps.
 };
 
-// Load Binary Data into Columnar format (Vectorized Friendly)
-TickData load_data_vectorized(const std::string& filename, size_t max_limit = 0) {
-    TickData data;
-    std::ifstream in(filename, std::ios::binary);
-    if (!in) return data;
+// Messages per parse task in the loader
+static constexpr size_t CHUNK_MESSAGES = 1 << 16;
+
+// Extract the price column from one run of whole messages. Index i of the
+// run is message number first_index + i in the file.
+static void parse_chunk(const uint8_t* p, const uint8_t* end, uint64_t first_index, TickData& out) {
+    uint64_t count = first_index;
+    while (p + 2 <= end) {
+        uint16_t msg_len = __builtin_bswap16(*reinterpret_cast<const uint16_t*>(p));
 
-    std::vector<uint8_t> buffer(256); // Small buffer for single messages
-    size_t count = 0;
-    
-    // We only care about executions for price history in this simplified vector backtest
-    // Or BBO updates. Let's use Executions as "Last Price"
-    
-    while (in) {
-        uint16_t msg_len_be;
-        if (!in.read(reinterpret_cast<char*>(&msg_len_be), 2)) break;
-        in.seekg(-2, std::ios::cur);
-        uint16_t msg_len = __builtin_bswap16(msg_len_be);
-        
-        if (buffer.size() < msg_len) buffer.resize(msg_len);
-        in.read(reinterpret_cast<char*>(buffer.data()), msg_len);
-        
         // Manual decode minimal
-        uint8_t type = buffer[2]; // Offset 2 is Type
-        if (type == 'E' || type == 'C') { // Executed
-            // Extract Price
-            // Header(3) + Ref(8) + ... 
-            // See decoder.hpp for offsets. Or just use decoder
-            // Let's assume OrderExecuted struct layout:
-            // Hdr(3) + Loc(2) + Trk(2) + Time(6) + Ref(8) + Shares(4) + Match(8)
-            // Wait, executed message 'E' doesn't have price in ITCH 5.0 (it uses Ref order price)
-            // 'C' (Executed with Price) has price.
-            // Our generator produces 'E'. We need to track order books to know price.
-            // For this VECTOR example, let's assume we extract BBO mid-price from 'A' (Add Order) messages 
-            // just to build a price series.
-        } 
-        else if (type == 'A' || type == 'F') { // Add Order
+        uint8_t type = p[2]; // Offset 2 is Type
+        if (type == 'A' || type == 'F') { // Add Order
             // Use Add Order price as a proxy for market price updates
+            // ('E' executions carry no price in ITCH 5.0)
             // Struct AddOrder: Hdr(3) + Loc(2) + Trk(2) + Time(6) + Ref(8) + Side(1) + Shares(4) + Stock(8) + Price(4)
             // Offset of Price = 3+2+2+6+8+1+4+8 = 34
             if (msg_len >= 38) {
-                uint32_t price_be = *reinterpret_cast<uint32_t*>(&buffer[34]);
-                double price = static_cast<double>(__builtin_bswap32(price_be)) / 10000.0;
-                data.prices.push_back(price);
-                // Timestamp offset 7, 6 bytes. 
-                // Simplified:
-                data.timestamps.push_back(count); 
+                uint32_t price_be;
+                memcpy(&price_be, p + 34, sizeof(price_be));
+                out.prices.push_back(static_cast<double>(__builtin_bswap32(price_be)) / 10000.0);
+                out.timestamps.push_back(count); // Simplified: message index
             }
         }
+        p += msg_len;
+        count++;
+    }
+}
 
+// Load Binary Data into Columnar format (Vectorized Friendly)
+// The file is read in one go; a cheap sequential pass hops the 2-byte
+// length prefixes to cut it into CHUNK_MESSAGES-message runs, which are
+// parsed in parallel and concatenated in file order.
+TickData load_data_vectorized(WorkStealingPool& pool, const std::string& filename, size_t max_limit = 0) {
+    TickData data;
+    std::ifstream in(filename, std::ios::binary | std::ios::ate);
+    if (!in) return data;
+
+    std::vector<uint8_t> file(static_cast<size_t>(in.tellg()));
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(file.data()), file.size())) return data;
+
+    // 1. Chunk boundaries (whole messages only, honouring max_limit)
+    struct Chunk { size_t begin, end; uint64_t first_index; };
+    std::vector<Chunk> chunks;
+    size_t offset = 0;
+    uint64_t count = 0;
+    while (offset + 2 <= file.size()) {
+        if (count % CHUNK_MESSAGES == 0) chunks.push_back({offset, offset, count});
+        uint16_t msg_len = __builtin_bswap16(*reinterpret_cast<const uint16_t*>(&file[offset]));
+        if (msg_len < 3 || offset + msg_len > file.size()) break; // Corrupt or truncated
+        offset += msg_len;
+        chunks.back().end = offset;
         count++;
         if (max_limit > 0 && count >= max_limit) break;
     }
+
+    // 2. Parse chunks in parallel
+    std::vector<TickData> parts(chunks.size());
+    pool.parallel_for(0, chunks.size(), 1, [&](size_t lo, size_t hi) {
+        for (size_t c = lo; c < hi; ++c) {
+            parse_chunk(&file[chunks[c].begin], &file[0] + chunks[c].end, chunks[c].first_index, parts[c]);
+        }
+    });
+
+    // 3. Concatenate in order
+    std::vector<size_t> dest(parts.size() + 1, 0);
+    for (size_t c = 0; c < parts.size(); ++c) dest[c + 1] = dest[c] + parts[c].prices.size();
+    data.prices.resize(dest.back());
+    data.timestamps.resize(dest.back());
+    pool.parallel_for(0, parts.size(), 1, [&](size_t lo, size_t hi) {
+        for (size_t c = lo; c < hi; ++c) {
+            std::copy(parts[c].prices.begin(), parts[c].prices.end(), data.prices.begin() + dest[c]);
+            std::copy(parts[c].timestamps.begin(), parts[c].timestamps.end(), data.timestamps.begin() + dest[c]);
+        }
+    });
     return data;
 }
 
+// Apply RSI Filter (Don't buy if overbought > 70, Don't sell if oversold < 30)
+static void apply_rsi_filter(std::span<int> signals, std::span<const double> rsi) {
+    for (size_t i = 0; i < signals.size(); ++i) {
+        if (signals[i] == 1 && rsi[i] > 70) signals[i] = 0;
+        if (signals[i] == -1 && rsi[i] < 30) signals[i] = 0;
+    }
+}
+
+// Simple All-In model for vector test; returns the equity curve (in mr)
+static std::pmr::vector<double> simulate(std::span<const double> prices, std::span<const int> signals,
+                                         std::pmr::memory_resource* mr = std::pmr::get_default_resource()) {
+    std::pmr::vector<double> equity_curve(mr);
+    equity_curve.reserve(prices.size());
+    double cash = 100000.0;
+    double holdings = 0;
+
+    for (size_t i = 0; i < signals.size(); ++i) {
+        if (signals[i] == 1) { // Buy
+            if (cash > 0) {
+                holdings = cash / prices[i];
+                cash = 0;
+            }
+        } else if (signals[i] == -1) { // Sell
+            if (holdings > 0) {
+                cash = holdings * prices[i];
+                holdings = 0;
+            }
+        }
+        equity_curve.push_back(cash + (holdings * prices[i]));
+    }
+    return equity_curve;
+}
+
+// Grid search over MA windows: every moving average is computed once, then
+// each (fast, slow) pair is simulated and analysed as an independent task
+static void run_parameter_sweep(WorkStealingPool& pool, const TickData& data, const std::vector<double>& rsi) {
+    const std::vector<int> fast_windows = {10, 20, 50, 100};
+    const std::vector<int> slow_windows = {100, 200, 400, 800};
+
+    std::vector<int> windows(fast_windows);
+    windows.insert(windows.end(), slow_windows.begin(), slow_windows.end());
+    std::sort(windows.begin(), windows.end());
+    windows.erase(std::unique(windows.begin(), windows.end()), windows.end());
+
+    std::vector<std::vector<double>> mas(windows.size());
+    pool.parallel_for(0, windows.size(), 1, [&](size_t lo, size_t hi) {
+        for (size_t w = lo; w < hi; ++w) mas[w] = strategy::SignalEngine::sma(data.prices, windows[w]);
+    });
+    auto ma_for = [&](int window) -> const std::vector<double>& {
+        return mas[std::lower_bound(windows.begin(), windows.end(), window) - windows.begin()];
+    };
+
+    struct Run { int fast, slow; strategy::PerformanceReport report; };
+    std::vector<Run> runs;
+    for (int f : fast_windows)
+        for (int sl : slow_windows)
+            if (f < sl) runs.push_back({f, sl, {}});
+
+    // Each run's signal and equity series come from the worker's scratch
+    // arena and are released when the run ends: after the first run on a
+    // worker, steps reuse the same memory instead of hitting the heap
+    std::atomic<uint64_t> heap_fallbacks{0};
+    pool.parallel_for(0, runs.size(), 1, [&](size_t lo, size_t hi) {
+        for (size_t r = lo; r < hi; ++r) {
+            ScratchArena::Scope step;
+            const uint64_t fallbacks_before = step.arena().fallbacks();
+            auto signals = strategy::SignalEngine::ma_crossover_signal(ma_for(runs[r].fast), ma_for(runs[r].slow),
+                                                                       &step.arena());
+            apply_rsi_filter(signals, rsi);
+            runs[r].report = strategy::PerformanceAnalyst::analyze(simulate(data.prices, signals, &step.arena()));
+            heap_fallbacks += step.arena().fallbacks() - fallbacks_before;
+        }
+    });
+    // Steady-state steps should never grow an arena
+    std::cout << "Scratch arena heap fallbacks: " << heap_fallbacks.load() << std::endl;
+
+    std::sort(runs.begin(), runs.end(), [](const Run& a, const Run& b) {
+        return a.report.sharpe_ratio > b.report.sharpe_ratio;
+    });
+    std::cout << "fast\tslow\treturn%\tsharpe\tmax_dd%" << std::endl;
+    for (const auto& r : runs) {
+        std::cout << r.fast << "\t" << r.slow << "\t" << std::fixed << std::setprecision(2)
+                  << r.report.total_return * 100 << "\t" << std::setprecision(4) << r.report.sharpe_ratio
+                  << "\t" << std::setprecision(2) << r.report.max_drawdown * 100 << std::endl;
+    }
+}
+
     /**
      * @brief Auto-generated description for main.
      * @param argc Parameter description.
@@ -78,12 +197,20 @@ TickData load_data_vectorized(const std::string& filename, size_t max_limit = 0)
      */
 int main(int argc, char** argv) {
     std::string filename = "market_data_large.bin";
-    if (argc > 1) filename = argv[1];
+    bool sweep = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--sweep") sweep = true;
+        else filename = argv[i];
+    }
+
+    // Offline only: all cores are fair game
+    WorkStealingPool pool;
+    std::cout << "Worker threads: " << pool.num_threads() << std::endl;
 
     std::cout << "1. Loading Data (Vectorized)..." << std::endl;
     auto t1 = std::chrono::high_resolution_clock::now();
     
-    TickData data = load_data_vectorized(filename, 10000000); // Try to load all
+    TickData data = load_data_vectorized(pool, filename, 10000000); // Try to load all
     
     auto t2 = std::chrono::high_resolution_clock::now();
     std::cout << "   Loaded " << data.prices.size() << " price points in " 
@@ -98,14 +225,12 @@ int main(int argc, char** argv) {
     auto t3 = std::chrono::high_resolution_clock::now();
     
     // Strategy: Moving Average Crossover + RSI Filter
-    // 1. Compute Fast MA (50 period)
-    auto ma_fast = strategy::SignalEngine::sma(data.prices, 50);
-    
-    // 2. Compute Slow MA (200 period)
-    auto ma_slow = strategy::SignalEngine::sma(data.prices, 200);
-    
-    // 3. Compute RSI (14 period)
-    auto rsi = strategy::SignalEngine::rsi(data.prices, 14);
+    // Fast MA (50), Slow MA (200) and RSI (14) are independent: fork-join them
+    std::vector<double> ma_fast, ma_slow, rsi;
+    pool.parallel_invoke(
+        [&] { ma_fast = strategy::SignalEngine::sma(data.prices, 50); },
+        [&] { ma_slow = strategy::SignalEngine::sma(data.prices, 200); },
+        [&] { rsi = strategy::SignalEngine::rsi(data.prices, 14); });
 
     auto t4 = std::chrono::high_resolution_clock::now();
     std::cout << "   Signals Computed in " 
@@ -116,41 +241,21 @@ int main(int argc, char** argv) {
     // Generate Signals
     // 1 = Buy, -1 = Sell
     auto signals = strategy::SignalEngine::ma_crossover_signal(ma_fast, ma_slow);
-    
-    // Apply RSI Filter (Don't buy if overbought > 70, Don't sell if oversold < 30)
-    for (size_t i = 0; i < signals.size(); ++i) {
-        if (signals[i] == 1 && rsi[i] > 70) signals[i] = 0;
-        if (signals[i] == -1 && rsi[i] < 30) signals[i] = 0;
-    }
-
-    // Calculate Returns
-    std::vector<double> equity_curve;
-    equity_curve.reserve(data.prices.size());
-    double cash = 100000.0;
-    double holdings = 0;
-    double equity = cash;
-    
-    for (size_t i = 0; i < signals.size(); ++i) {
-        if (signals[i] == 1) { // Buy
-            // Simple All-In model for vector test
-            if (cash > 0) {
-                holdings = cash / data.prices[i];
-                cash = 0;
-            }
-        } else if (signals[i] == -1) { // Sell
-            if (holdings > 0) {
-                cash = holdings * data.prices[i];
-                holdings = 0;
-            }
-        }
-        
-        equity = cash + (holdings * data.prices[i]);
-        equity_curve.push_back(equity);
-    }
+    apply_rsi_filter(signals, rsi);
+    auto equity_curve = simulate(data.prices, signals);
     
     std::cout << "4. Analyzing Performance..." << std::endl;
     auto report = strategy::PerformanceAnalyst::analyze(equity_curve);
     report.print();
 
+    if (sweep) {
+        std::cout << "5. Parameter Sweep (MA windows)..." << std::endl;
+        auto t5 = std::chrono::high_resolution_clock::now();
+        run_parameter_sweep(pool, data, rsi);
+        auto t6 = std::chrono::high_resolution_clock::now();
+        std::cout << "   Sweep completed in "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(t6 - t5).count() << "ms" << std::endl;
+    }
+
     return 0;
-}
\ No newline at end of file
+}
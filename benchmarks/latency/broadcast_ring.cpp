@@ -0,0 +1,120 @@
+#include "ultra/core/lockfree/broadcast_ring.hpp"
+#include "ultra/core/lockfree/spsc_queue.hpp"
+#include "ultra/market-data/itch/decoder.hpp"
+#include "ultra/core/thread_utils.hpp"
+#include "ultra/core/spin_wait.hpp"
+#include "ultra/core/time/rdtsc_clock.hpp"
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+
+using namespace ultra;
+
+/**
+ * MD fan-out cost: one BroadcastRing vs one SPSCQueue per consumer.
+ * For 1..8 consumers, the producer (MD thread) publishes NUM_EVENTS decoded
+ * messages and we report producer cycles per event. Consumers spin on their
+ * own cores starting at first_consumer_core.
+ *
+ * Usage: broadcast_ring_bench [producer_core] [first_consumer_core]
+ */
+
+using Msg = md::itch::ITCHDecoder::DecodedMessage;
+static constexpr size_t RING_SIZE = 16384;
+static constexpr size_t MAX_CONSUMERS = 8;
+static constexpr uint64_t NUM_EVENTS = 5000000;
+
+using Ring = BroadcastRing<Msg, RING_SIZE, MAX_CONSUMERS>;
+using Queue = SPSCQueue<Msg, RING_SIZE>;
+
+static Msg make_msg(uint64_t i) {
+    Msg m{};
+    m.valid = true;
+    m.order_id = i;
+    m.event_type = MDEventType::ADD_ORDER;
+    return m;
+}
+
+static double run_broadcast(size_t consumers, int prod_core, int first_core) {
+    auto ring = std::make_unique<Ring>();
+    std::vector<size_t> ids;
+    for (size_t i = 0; i < consumers; ++i) ids.push_back(ring->add_consumer());
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < consumers; ++i) {
+        threads.emplace_back([&, i] {
+            ThreadUtils::pin_thread(first_core + static_cast<int>(i));
+            uint64_t seen = 0;
+            while (seen < NUM_EVENTS) {
+                const Msg* m = ring->peek(ids[i]);
+                if (!m) { SpinWait::spin(); continue; }
+                if (ULTRA_UNLIKELY(m->order_id != seen)) std::abort();
+                ring->advance(ids[i]);
+                ++seen;
+            }
+        });
+    }
+
+    ThreadUtils::pin_thread(prod_core);
+    uint64_t start = RDTSCClock::rdtsc();
+    for (uint64_t i = 0; i < NUM_EVENTS; ) {
+        Msg* slot = ring->try_claim();
+        if (!slot) { SpinWait::spin(); continue; }
+        *slot = make_msg(i++);
+        ring->publish();
+    }
+    uint64_t cycles = RDTSCClock::rdtsc() - start;
+    for (auto& t : threads) t.join();
+    return static_cast<double>(cycles) / NUM_EVENTS;
+}
+
+static double run_spsc_fanout(size_t consumers, int prod_core, int first_core) {
+    std::vector<std::unique_ptr<Queue>> queues;
+    for (size_t i = 0; i < consumers; ++i) queues.push_back(std::make_unique<Queue>());
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < consumers; ++i) {
+        threads.emplace_back([&, i] {
+            ThreadUtils::pin_thread(first_core + static_cast<int>(i));
+            uint64_t seen = 0;
+            while (seen < NUM_EVENTS) {
+                const Msg* m = queues[i]->peek();
+                if (!m) { SpinWait::spin(); continue; }
+                if (ULTRA_UNLIKELY(m->order_id != seen)) std::abort();
+                queues[i]->release();
+                ++seen;
+            }
+        });
+    }
+
+    ThreadUtils::pin_thread(prod_core);
+    uint64_t start = RDTSCClock::rdtsc();
+    for (uint64_t i = 0; i < NUM_EVENTS; ++i) {
+        const Msg m = make_msg(i);
+        for (auto& q : queues) {
+            while (!q->push(m)) SpinWait::spin();
+        }
+    }
+    uint64_t cycles = RDTSCClock::rdtsc() - start;
+    for (auto& t : threads) t.join();
+    return static_cast<double>(cycles) / NUM_EVENTS;
+}
+
+int main(int argc, char** argv) {
+    int prod_core = argc > 1 ? std::atoi(argv[1]) : 1;
+    int first_core = argc > 2 ? std::atoi(argv[2]) : 2;
+
+    RDTSCClock::calibrate();
+    std::cout << "Producer cycles/event (" << sizeof(Msg) << "-byte events, "
+              << NUM_EVENTS << " events)" << std::endl;
+    std::cout << "consumers\tbroadcast\tN x SPSC" << std::endl;
+
+    for (size_t n = 1; n <= MAX_CONSUMERS; n *= 2) {
+        double bcast = run_broadcast(n, prod_core, first_core);
+        double fanout = run_spsc_fanout(n, prod_core, first_core);
+        std::cout << n << "\t\t" << bcast << "\t\t" << fanout << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include "ultra/core/lockfree/byte_ring.hpp"
+#include "ultra/core/lockfree/spsc_queue.hpp"
+#include "ultra/core/time/rdtsc_clock.hpp"
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace ultra;
+
+/**
+ * Variable-length ByteRing vs fixed 2048-byte slots (the old DMARingBuffer
+ * layout) for the same 2MB of memory.
+ * 1. Burst capacity: packets accepted before the ring is full, and payload
+ *    bytes / ring bytes, for fixed ITCH-sized packets and a mixed size
+ *    distribution (mostly 20-50 byte ITCH messages, some MoldUDP64 bundles
+ *    up to 1400 bytes)
+ * 2. Cost: cycles per push+pop pair on one core (no cross-core traffic,
+ *    isolates the bookkeeping)
+ *
+ * Usage: byte_ring_bench
+ */
+
+static constexpr size_t RING_BYTES = 2 * 1024 * 1024;
+static constexpr size_t SLOT = 2048;
+static constexpr size_t SLOTS = RING_BYTES / SLOT;
+static constexpr size_t OPS = 2000000;
+
+struct Slot {
+    uint32_t len; ///< Bytes used in data.
+    uint8_t data[SLOT - sizeof(uint32_t)]; ///< Fixed-size packet buffer.
+};
+
+static std::vector<size_t> make_sizes(bool mixed, size_t n) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> small(20, 50), big(200, 1400);
+    std::uniform_int_distribution<int> pick(0, 99);
+    std::vector<size_t> sizes(n);
+    for (auto& s : sizes) s = !mixed ? 40 : (pick(rng) < 90 ? small(rng) : big(rng));
+    return sizes;
+}
+
+static void burst(const char* name, const std::vector<size_t>& sizes) {
+    static uint8_t pkt[SLOT] = {};
+
+    auto ring = std::make_unique<ByteRing<RING_BYTES>>();
+    size_t n_var = 0, bytes_var = 0;
+    while (ring->push(pkt, sizes[n_var % sizes.size()])) bytes_var += sizes[n_var++ % sizes.size()];
+
+    // Fixed slots hold exactly SLOTS packets whatever their size
+    size_t bytes_fixed = 0;
+    for (size_t i = 0; i < SLOTS; ++i) bytes_fixed += sizes[i % sizes.size()];
+
+    std::cout << name << "\tbyte_ring: " << n_var << " pkts, " << 100.0 * bytes_var / RING_BYTES << "% payload"
+              << "\tfixed_2048: " << SLOTS << " pkts, " << 100.0 * bytes_fixed / RING_BYTES << "% payload"
+              << std::endl;
+}
+
+static void cost(const char* name, const std::vector<size_t>& sizes) {
+    static uint8_t pkt[SLOT] = {};
+    uint64_t sink = 0;
+
+    auto ring = std::make_unique<ByteRing<RING_BYTES>>();
+    uint64_t t0 = RDTSCClock::rdtsc();
+    for (size_t i = 0; i < OPS; ++i) {
+        ring->push(pkt, sizes[i % sizes.size()]);
+        auto r = ring->peek();
+        sink += r.size();
+        ring->release();
+    }
+    const double var_cycles = static_cast<double>(RDTSCClock::rdtsc() - t0) / OPS;
+
+    auto slots = std::make_unique<SPSCQueue<Slot, SLOTS>>();
+    t0 = RDTSCClock::rdtsc();
+    for (size_t i = 0; i < OPS; ++i) {
+        Slot* s = slots->try_reserve();
+        s->len = static_cast<uint32_t>(sizes[i % sizes.size()]);
+        std::memcpy(s->data, pkt, s->len);
+        slots->commit();
+        const Slot* r = slots->peek();
+        sink += r->len;
+        slots->release();
+    }
+    const double fixed_cycles = static_cast<double>(RDTSCClock::rdtsc() - t0) / OPS;
+
+    std::cout << name << "\tbyte_ring: " << var_cycles << " cyc/pkt\tfixed_2048: " << fixed_cycles
+              << " cyc/pkt" << (sink == 1 ? " " : "") << std::endl;
+}
+
+int main() {
+    RDTSCClock::calibrate();
+    auto itch = make_sizes(false, 4096);
+    auto mixed = make_sizes(true, 4096);
+
+    std::cout << "--- Burst capacity (2MB) ---" << std::endl;
+    burst("itch40", itch);
+    burst("mixed", mixed);
+    std::cout << "--- push+pop cost ---" << std::endl;
+    cost("itch40", itch);
+    cost("mixed", mixed);
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include "ultra/core/lockfree/mpsc_queue.hpp"
+#include "ultra/core/lockfree/spsc_queue.hpp"
+#include "ultra/strategy/strategy.hpp"
+#include "ultra/core/thread_utils.hpp"
+#include "ultra/core/spin_wait.hpp"
+#include "ultra/core/time/rdtsc_clock.hpp"
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+using namespace ultra;
+
+/**
+ * Strategy -> Exec order flow with K strategy threads:
+ * (a) one MPSCQueue drained by a single poll
+ * (b) K SPSCQueues polled round-robin by the exec thread
+ * Reports consumer throughput and producer->consumer latency percentiles.
+ *
+ * Usage: mpsc_queue_bench [exec_core] [first_strategy_core]
+ */
+
+static constexpr size_t QUEUE_SIZE = 8192;
+static constexpr uint64_t ORDERS_PER_PRODUCER = 2000000;
+static constexpr size_t MAX_PRODUCERS = 4;
+
+using Order = strategy::StrategyOrder;
+
+struct Result {
+    double mops; ///< Consumed orders per second (millions).
+    uint64_t p50_ns; ///< Median enqueue->dequeue latency.
+    uint64_t p99_ns; ///< 99th percentile latency.
+};
+
+template<typename PushFn, typename PollFn>
+static Result run(size_t producers, int exec_core, int first_core, PushFn push, PollFn poll) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            ThreadUtils::pin_thread(first_core + static_cast<int>(p));
+            while (!go.load(std::memory_order_acquire)) SpinWait::spin();
+            Order o{};
+            o.symbol_id = static_cast<SymbolId>(p);
+            for (uint64_t i = 0; i < ORDERS_PER_PRODUCER; ) {
+                o.order_id = RDTSCClock::rdtsc(); // Enqueue timestamp
+                if (push(p, o)) ++i; else SpinWait::spin();
+            }
+        });
+    }
+
+    ThreadUtils::pin_thread(exec_core);
+    const uint64_t total = producers * ORDERS_PER_PRODUCER;
+    std::vector<uint64_t> samples;
+    samples.reserve(total / 16 + 1);
+    uint64_t consumed = 0;
+
+    go.store(true, std::memory_order_release);
+    uint64_t start = RDTSCClock::rdtsc();
+    while (consumed < total) {
+        consumed += poll([&](const Order& o) {
+            if ((consumed & 15) == 0) samples.push_back(RDTSCClock::rdtsc() - o.order_id);
+        });
+    }
+    uint64_t elapsed_ns = RDTSCClock::rdtsc_to_ns(RDTSCClock::rdtsc() - start);
+    for (auto& t : threads) t.join();
+
+    std::sort(samples.begin(), samples.end());
+    return {total / (elapsed_ns / 1e9) / 1e6,
+            RDTSCClock::rdtsc_to_ns(samples[samples.size() / 2]),
+            RDTSCClock::rdtsc_to_ns(samples[samples.size() * 99 / 100])};
+}
+
+int main(int argc, char** argv) {
+    int exec_core = argc > 1 ? std::atoi(argv[1]) : 3;
+    int first_core = argc > 2 ? std::atoi(argv[2]) : 4;
+
+    RDTSCClock::calibrate();
+    std::cout << "producers\tqueue\t\tM orders/s\tp50 ns\tp99 ns" << std::endl;
+
+    for (size_t k = 1; k <= MAX_PRODUCERS; k *= 2) {
+        // (a) Single MPSC queue
+        {
+            auto q = std::make_unique<MPSCQueue<Order, QUEUE_SIZE>>();
+            auto r = run(k, exec_core, first_core,
+                [&](size_t, const Order& o) { return q->push(o); },
+                [&](auto&& on_order) -> size_t {
+                    const Order* o = q->peek();
+                    if (!o) return 0;
+                    on_order(*o);
+                    q->release();
+                    return 1;
+                });
+            std::cout << k << "\t\tMPSC\t\t" << r.mops << "\t\t" << r.p50_ns << "\t" << r.p99_ns << std::endl;
+        }
+        // (b) K SPSC queues polled in turn
+        {
+            std::vector<std::unique_ptr<SPSCQueue<Order, QUEUE_SIZE>>> qs;
+            for (size_t p = 0; p < k; ++p) qs.push_back(std::make_unique<SPSCQueue<Order, QUEUE_SIZE>>());
+            auto r = run(k, exec_core, first_core,
+                [&](size_t p, const Order& o) { return qs[p]->push(o); },
+                [&](auto&& on_order) -> size_t {
+                    size_t n = 0;
+                    for (auto& q : qs) {
+                        if (const Order* o = q->peek()) {
+                            on_order(*o);
+                            q->release();
+                            ++n;
+                        }
+                    }
+                    return n;
+                });
+            std::cout << k << "\t\t" << k << "xSPSC\t\t" << r.mops << "\t\t" << r.p50_ns << "\t" << r.p99_ns << std::endl;
+        }
+    }
+    return 0;
+}
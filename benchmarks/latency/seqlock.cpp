@@ -0,0 +1,121 @@
+#include "ultra/core/lockfree/seqlock.hpp"
+#include "ultra/core/thread_utils.hpp"
+#include "ultra/core/time/rdtsc_clock.hpp"
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+using namespace ultra;
+
+/**
+ * Single writer publishing POD state to N readers: SeqLock vs std::mutex
+ * (the MetricsCollector approach). For 16, 64 and 256-byte payloads and
+ * 1..MAX_READERS readers, each configuration runs for RUN_MS with the
+ * writer storing flat out (worst case) and then once every WRITER_GAP
+ * cycles (typical parameter/BBO publish rate). Reports writer cycles per
+ * store (excluding the gap), aggregate reader Mreads/s and, for SeqLock,
+ * the fraction of read attempts that overlapped a write and retried.
+ *
+ * Usage: seqlock_bench [writer_core] [first_reader_core]
+ */
+
+static constexpr size_t MAX_READERS = 4;
+static constexpr int RUN_MS = 300;
+static constexpr uint64_t WRITER_GAP = 2000; // ~0.5-1us between stores
+
+template<size_t Bytes>
+struct Payload {
+    uint64_t words[Bytes / 8]; ///< Writer fills every word with the same value.
+};
+
+struct Result {
+    double writer_cycles; ///< Per store.
+    double reader_mops; ///< All readers combined.
+    double retry_pct; ///< Reads that overlapped a write (SeqLock only).
+};
+
+template<typename T>
+class MutexBox {
+public:
+    void store(const T& v) { std::lock_guard<std::mutex> l(m_); value_ = v; }
+    bool try_load(T& out) { std::lock_guard<std::mutex> l(m_); out = value_; return true; }
+private:
+    std::mutex m_;
+    T value_{};
+};
+
+template<typename Box, typename T>
+static Result run(size_t readers, uint64_t gap, int writer_core, int first_core) {
+    auto box = std::make_unique<Box>();
+    std::atomic<bool> go{false}, done{false};
+    std::vector<uint64_t> reads(readers, 0), retries(readers, 0);
+
+    std::vector<std::thread> threads;
+    for (size_t r = 0; r < readers; ++r) {
+        threads.emplace_back([&, r] {
+            ThreadUtils::pin_thread(first_core + static_cast<int>(r));
+            while (!go.load(std::memory_order_acquire)) {}
+            T v;
+            uint64_t n = 0, miss = 0, sink = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                if (box->try_load(v)) { ++n; sink += v.words[0]; } else { ++miss; }
+            }
+            reads[r] = n;
+            retries[r] = miss + (sink == 1); // Keep sink alive
+        });
+    }
+
+    ThreadUtils::pin_thread(writer_core);
+    go.store(true, std::memory_order_release);
+    T v{};
+    uint64_t stores = 0, cycles = 0;
+    const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(RUN_MS);
+    while ((stores & 1023) != 0 || std::chrono::steady_clock::now() < end) {
+        for (auto& w : v.words) w = stores;
+        const uint64_t t0 = RDTSCClock::rdtsc();
+        box->store(v);
+        const uint64_t t1 = RDTSCClock::rdtsc();
+        cycles += t1 - t0;
+        ++stores;
+        while (gap && RDTSCClock::rdtsc() - t1 < gap) {}
+    }
+    done.store(true, std::memory_order_relaxed);
+    for (auto& t : threads) t.join();
+
+    uint64_t total_reads = 0, total_retries = 0;
+    for (size_t r = 0; r < readers; ++r) { total_reads += reads[r]; total_retries += retries[r]; }
+    const double attempts = static_cast<double>(total_reads + total_retries);
+    return {static_cast<double>(cycles) / stores,
+            total_reads / (RUN_MS / 1e3) / 1e6,
+            attempts > 0 ? 100.0 * total_retries / attempts : 0.0};
+}
+
+template<size_t Bytes>
+static void run_size(int writer_core, int first_core) {
+    using T = Payload<Bytes>;
+    for (uint64_t gap : {uint64_t{0}, WRITER_GAP}) {
+        for (size_t n = 1; n <= MAX_READERS; n *= 2) {
+            auto s = run<SeqLock<T>, T>(n, gap, writer_core, first_core);
+            auto m = run<MutexBox<T>, T>(n, gap, writer_core, first_core);
+            std::cout << Bytes << "\t" << gap << "\t" << n << "\t"
+                      << s.writer_cycles << "\t" << s.reader_mops << "\t" << s.retry_pct << "\t\t"
+                      << m.writer_cycles << "\t" << m.reader_mops << std::endl;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    int writer_core = argc > 1 ? std::atoi(argv[1]) : 2;
+    int first_core = argc > 2 ? std::atoi(argv[2]) : 3;
+
+    RDTSCClock::calibrate();
+    std::cout << "bytes\tgap\treaders\tseqlock: wr cyc\tMreads/s\tretry%\tmutex: wr cyc\tMreads/s" << std::endl;
+    run_size<16>(writer_core, first_core);
+    run_size<64>(writer_core, first_core);
+    run_size<256>(writer_core, first_core);
+    return 0;
+}
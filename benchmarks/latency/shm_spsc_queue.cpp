@@ -0,0 +1,125 @@
+#include "ultra/core/lockfree/shm_spsc_queue.hpp"
+#include "ultra/core/lockfree/spsc_queue.hpp"
+#include "ultra/core/thread_utils.hpp"
+#include "ultra/core/spin_wait.hpp"
+#include "ultra/core/time/rdtsc_clock.hpp"
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <algorithm>
+#include <string>
+#include <sys/wait.h>
+
+using namespace ultra;
+
+/**
+ * One-way hop latency: in-process SPSCQueue (two threads) vs ShmSPSCQueue
+ * (two processes). Ping-pong over a pair of queues; half the round trip is
+ * reported so the figures are directly comparable to a single pipeline hop.
+ *
+ * Usage: shm_spsc_queue_bench [core_a] [core_b]
+ */
+
+static constexpr size_t QUEUE_SIZE = 4096;
+static constexpr uint64_t ROUND_TRIPS = 1000000;
+static constexpr uint64_t WARMUP = 10000;
+
+struct Msg {
+    uint64_t seq; ///< Round-trip number.
+    uint64_t payload[7]; ///< Pads to one cache line (typical small event).
+};
+
+static void report(const char* name, std::vector<uint64_t>& rtt) {
+    std::sort(rtt.begin(), rtt.end());
+    auto pct = [&](double p) { return RDTSCClock::rdtsc_to_ns(rtt[static_cast<size_t>(p * (rtt.size() - 1))]) / 2; };
+    std::cout << name << "\t" << pct(0.50) << "\t" << pct(0.99) << "\t" << pct(0.999) << std::endl;
+}
+
+// Echo side: pop from in, push the same message to out
+template<typename In, typename Out>
+static void echo(In& in, Out& out) {
+    Msg m;
+    for (uint64_t i = 0; i < WARMUP + ROUND_TRIPS; ++i) {
+        while (!in.pop(m)) SpinWait::spin();
+        while (!out.push(m)) SpinWait::spin();
+    }
+}
+
+// Timing side: push, wait for the echo, record the round trip
+template<typename Out, typename In>
+static std::vector<uint64_t> ping(Out& out, In& in) {
+    std::vector<uint64_t> rtt;
+    rtt.reserve(ROUND_TRIPS);
+    Msg m{};
+    for (uint64_t i = 0; i < WARMUP + ROUND_TRIPS; ++i) {
+        m.seq = i;
+        uint64_t start = RDTSCClock::rdtsc();
+        while (!out.push(m)) SpinWait::spin();
+        while (!in.pop(m)) SpinWait::spin();
+        uint64_t end = RDTSCClock::rdtsc();
+        if (i >= WARMUP) rtt.push_back(end - start);
+    }
+    return rtt;
+}
+
+static void run_in_process(int core_a, int core_b) {
+    using Queue = SPSCQueue<Msg, QUEUE_SIZE>;
+    auto a_to_b = std::make_unique<Queue>();
+    auto b_to_a = std::make_unique<Queue>();
+
+    std::thread peer([&] {
+        ThreadUtils::pin_thread(core_b);
+        echo(*a_to_b, *b_to_a);
+    });
+    ThreadUtils::pin_thread(core_a);
+    auto rtt = ping(*a_to_b, *b_to_a);
+    peer.join();
+    report("in-process", rtt);
+}
+
+static void run_cross_process(int core_a, int core_b) {
+    using Queue = ShmSPSCQueue<Msg, QUEUE_SIZE>;
+    const std::string ping_name = "ultra_bench_ping_" + std::to_string(getpid());
+    const std::string pong_name = "ultra_bench_pong_" + std::to_string(getpid());
+
+    Queue a_to_b;
+    if (!a_to_b.create(ping_name)) return;
+
+    pid_t child = fork();
+    if (child < 0) {
+        perror("fork");
+        return;
+    }
+    if (child == 0) {
+        ThreadUtils::pin_thread(core_b);
+        Queue in, out;
+        if (!out.create(pong_name) || !in.attach(ping_name)) _exit(1);
+        echo(in, out);
+        _exit(0);
+    }
+
+    ThreadUtils::pin_thread(core_a);
+    Queue b_to_a;
+    if (!b_to_a.attach(pong_name, 5'000'000'000ULL)) {
+        kill(child, SIGKILL);
+        waitpid(child, nullptr, 0);
+        return;
+    }
+    auto rtt = ping(a_to_b, b_to_a);
+    waitpid(child, nullptr, 0);
+    report("shared-mem", rtt);
+}
+
+int main(int argc, char** argv) {
+    int core_a = argc > 1 ? std::atoi(argv[1]) : 2;
+    int core_b = argc > 2 ? std::atoi(argv[2]) : 3;
+
+    RDTSCClock::calibrate();
+    std::cout << "One-way hop latency (ns), " << ROUND_TRIPS << " round trips, "
+              << sizeof(Msg) << "-byte messages" << std::endl;
+    std::cout << "queue\t\tp50\tp99\tp99.9" << std::endl;
+    run_in_process(core_a, core_b);
+    run_cross_process(core_a, core_b);
+    return 0;
+}
@@ -0,0 +1,204 @@
+#include "ultra/core/lockfree/spsc_queue.hpp"
+#include "ultra/core/thread_utils.hpp"
+#include "ultra/core/spin_wait.hpp"
+#include "ultra/core/time/rdtsc_clock.hpp"
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+using namespace ultra;
+
+/**
+ * Cross-core SPSCQueue benchmark
+ * 1. Throughput: producer core -> consumer core, single push/pop
+ * 2. Throughput: same, with push_n/pop_n batches
+ * 3. 136-byte payload (DecodedMessage sized): push/pop copies vs
+ *    try_reserve/commit + peek/release in place
+ * 4. Round-trip latency: ping-pong over two queues (RTT/2 = one hop)
+ *
+ * Usage: spsc_queue_bench [producer_core] [consumer_core]
+ */
+
+static constexpr size_t QUEUE_SIZE = 65536;
+static constexpr uint64_t NUM_MSGS = 50000000;
+static constexpr size_t BATCH = 32;
+
+using Queue = SPSCQueue<uint64_t, QUEUE_SIZE>;
+
+static void report_throughput(const char* name, std::chrono::nanoseconds elapsed) {
+    double sec = elapsed.count() / 1e9;
+    std::cout << "[" << name << "] " << NUM_MSGS / sec / 1e6 << " M msgs/sec ("
+              << static_cast<double>(elapsed.count()) / NUM_MSGS << " ns/msg)" << std::endl;
+}
+
+static void bench_single(int prod_core, int cons_core) {
+    auto q = std::make_unique<Queue>();
+    std::atomic<bool> ready{false};
+
+    std::thread consumer([&] {
+        ThreadUtils::pin_thread(cons_core);
+        ready = true;
+        uint64_t v = 0, expected = 0;
+        while (expected < NUM_MSGS) {
+            if (q->pop(v)) {
+                if (ULTRA_UNLIKELY(v != expected)) std::abort();
+                ++expected;
+            } else {
+                SpinWait::spin();
+            }
+        }
+    });
+
+    ThreadUtils::pin_thread(prod_core);
+    while (!ready) SpinWait::spin();
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < NUM_MSGS; ) {
+        if (q->push(i)) ++i; else SpinWait::spin();
+    }
+    consumer.join();
+    report_throughput("push/pop", std::chrono::steady_clock::now() - start);
+}
+
+static void bench_batched(int prod_core, int cons_core) {
+    auto q = std::make_unique<Queue>();
+    std::atomic<bool> ready{false};
+
+    std::thread consumer([&] {
+        ThreadUtils::pin_thread(cons_core);
+        ready = true;
+        uint64_t out[BATCH];
+        uint64_t expected = 0;
+        while (expected < NUM_MSGS) {
+            size_t n = q->pop_n(out, BATCH);
+            if (n == 0) { SpinWait::spin(); continue; }
+            for (size_t k = 0; k < n; ++k) {
+                if (ULTRA_UNLIKELY(out[k] != expected)) std::abort();
+                ++expected;
+            }
+        }
+    });
+
+    ThreadUtils::pin_thread(prod_core);
+    while (!ready) SpinWait::spin();
+    uint64_t in[BATCH];
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < NUM_MSGS; ) {
+        size_t n = std::min<uint64_t>(BATCH, NUM_MSGS - i);
+        for (size_t k = 0; k < n; ++k) in[k] = i + k;
+        size_t pushed = q->push_n(in, n);
+        if (pushed == 0) SpinWait::spin();
+        i += pushed;
+    }
+    consumer.join();
+    report_throughput("push_n/pop_n x32", std::chrono::steady_clock::now() - start);
+}
+
+static volatile uint64_t g_sink; // Keeps consumer reads from being optimised away
+
+struct Payload {
+    uint64_t seq; ///< Sequence number checked by the consumer.
+    char body[128]; ///< Filler up to a typical 136-byte record.
+};
+
+template<bool InPlace>
+static void bench_payload(int prod_core, int cons_core) {
+    using BigQueue = SPSCQueue<Payload, 4096>;
+    auto q = std::make_unique<BigQueue>();
+    std::atomic<bool> ready{false};
+
+    std::thread consumer([&] {
+        ThreadUtils::pin_thread(cons_core);
+        ready = true;
+        Payload item;
+        uint64_t expected = 0, sink = 0;
+        while (expected < NUM_MSGS) {
+            if constexpr (InPlace) {
+                const Payload* p = q->peek();
+                if (!p) { SpinWait::spin(); continue; }
+                if (ULTRA_UNLIKELY(p->seq != expected)) std::abort();
+                sink += static_cast<uint8_t>(p->body[p->seq & 127]);
+                q->release();
+            } else {
+                if (!q->pop(item)) { SpinWait::spin(); continue; }
+                if (ULTRA_UNLIKELY(item.seq != expected)) std::abort();
+                sink += static_cast<uint8_t>(item.body[item.seq & 127]);
+            }
+            ++expected;
+        }
+        g_sink = sink;
+    });
+
+    ThreadUtils::pin_thread(prod_core);
+    while (!ready) SpinWait::spin();
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < NUM_MSGS; ) {
+        if constexpr (InPlace) {
+            Payload* slot = q->try_reserve();
+            if (!slot) { SpinWait::spin(); continue; }
+            slot->seq = i;
+            std::memset(slot->body, static_cast<int>(i), sizeof(slot->body));
+            q->commit();
+        } else {
+            Payload item;
+            item.seq = i;
+            std::memset(item.body, static_cast<int>(i), sizeof(item.body));
+            if (!q->push(item)) { SpinWait::spin(); continue; }
+        }
+        ++i;
+    }
+    consumer.join();
+    report_throughput(InPlace ? "136B reserve/peek" : "136B push/pop", std::chrono::steady_clock::now() - start);
+}
+
+static void bench_round_trip(int prod_core, int cons_core) {
+    constexpr int ITERS = 1000000;
+    auto ping = std::make_unique<Queue>();
+    auto pong = std::make_unique<Queue>();
+
+    std::thread echo([&] {
+        ThreadUtils::pin_thread(cons_core);
+        uint64_t v;
+        for (int i = 0; i < ITERS; ++i) {
+            while (!ping->pop(v)) SpinWait::spin();
+            while (!pong->push(v)) SpinWait::spin();
+        }
+    });
+
+    ThreadUtils::pin_thread(prod_core);
+    std::vector<uint64_t> samples;
+    samples.reserve(ITERS);
+    uint64_t v;
+    for (int i = 0; i < ITERS; ++i) {
+        uint64_t start = RDTSCClock::rdtsc();
+        while (!ping->push(start)) SpinWait::spin();
+        while (!pong->pop(v)) SpinWait::spin();
+        samples.push_back(RDTSCClock::rdtsc() - start);
+    }
+    echo.join();
+
+    std::sort(samples.begin(), samples.end());
+    auto ns = [&](double q) { return RDTSCClock::rdtsc_to_ns(samples[samples.size() * q]) / 2; };
+    std::cout << "[one-hop latency (RTT/2)] P50: " << ns(0.50) << " ns  P99: " << ns(0.99)
+              << " ns  P99.9: " << ns(0.999) << " ns" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    int prod_core = argc > 1 ? std::atoi(argv[1]) : 2;
+    int cons_core = argc > 2 ? std::atoi(argv[2]) : 3;
+
+    RDTSCClock::calibrate();
+    std::cout << "SPSCQueue<uint64_t, " << QUEUE_SIZE << ">, producer core " << prod_core
+              << ", consumer core " << cons_core << std::endl;
+
+    bench_single(prod_core, cons_core);
+    bench_batched(prod_core, cons_core);
+    bench_payload<false>(prod_core, cons_core);
+    bench_payload<true>(prod_core, cons_core);
+    bench_round_trip(prod_core, cons_core);
+    return 0;
+}
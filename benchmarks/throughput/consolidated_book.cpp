@@ -0,0 +1,144 @@
+#include "ultra/market-data/book/consolidated_book.hpp"
+#include "ultra/core/time/rdtsc_clock.hpp"
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <map>
+
+using namespace ultra;
+using namespace ultra::md;
+
+/**
+ * Multi-feed replay: N venue feeds for one symbol are interleaved as they
+ * would arrive on separate multicast channels, applied to per-venue books and
+ * folded into the ConsolidatedBook. The same replay is then run against a
+ * naive "rebuild the ladder on every update" baseline for comparison.
+ */
+
+struct FeedEvent {
+    VenueId venue; ///< Venue that published the message.
+    itch::ITCHDecoder::DecodedMessage msg; ///< Decoded book event.
+};
+
+static std::vector<FeedEvent> make_replay(size_t venues, size_t num_events, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<FeedEvent> events;
+    events.reserve(num_events);
+    std::vector<std::vector<OrderId>> live(venues);
+    OrderId next_id = 1;
+    Price mid = 1500000;
+
+    for (size_t n = 0; n < num_events; ++n) {
+        VenueId v = static_cast<VenueId>(rng() % venues);
+        FeedEvent ev{v, {}};
+        ev.msg.valid = true;
+        ev.msg.symbol_id = 1;
+
+        // Keep each venue book around a steady size: ~55% adds, 45% deletes
+        if (live[v].size() < 64 || (rng() % 100) < 55) {
+            ev.msg.event_type = MDEventType::ADD_ORDER;
+            ev.msg.order_id = next_id;
+            ev.msg.side = (rng() & 1) ? Side::BUY : Side::SELL;
+            Price offset = static_cast<Price>(1 + rng() % 20) * 100;
+            ev.msg.price = ev.msg.side == Side::BUY ? mid - offset : mid + offset;
+            ev.msg.quantity = static_cast<Quantity>(100 * (1 + rng() % 10));
+            live[v].push_back(next_id++);
+        } else {
+            size_t k = rng() % live[v].size();
+            ev.msg.event_type = MDEventType::DELETE_ORDER;
+            ev.msg.order_id = live[v][k];
+            live[v][k] = live[v].back();
+            live[v].pop_back();
+        }
+        if (rng() % 1000 == 0) mid += (rng() & 1) ? 100 : -100;
+        events.push_back(ev);
+    }
+    return events;
+}
+
+static void print_stats(const std::string& name, std::vector<uint64_t>& samples, double total_ns) {
+    std::sort(samples.begin(), samples.end());
+    double avg = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    std::cout << "[" << name << "] Ticks (Cycles):" << std::endl;
+    std::cout << "  Avg: " << avg << std::endl;
+    std::cout << "  P50: " << samples[samples.size() * 0.50] << std::endl;
+    std::cout << "  P99: " << samples[samples.size() * 0.99] << std::endl;
+    std::cout << "  Max: " << samples.back() << std::endl;
+    std::cout << "  Throughput: " << (samples.size() / (total_ns / 1e9)) / 1e6 << " M updates/sec" << std::endl;
+}
+
+// Baseline: merge every venue's top-N from scratch
+static Price rebuild_ladder(const std::vector<std::unique_ptr<OrderBookL2>>& books) {
+    std::map<Price, Quantity, std::greater<Price>> bids;
+    std::map<Price, Quantity> asks;
+    for (const auto& b : books) {
+        for (size_t i = 0; i < ConsolidatedBook::DEPTH; ++i) {
+            if (b->bids()[i].price != 0) bids[b->bids()[i].price] += b->bids()[i].quantity;
+            if (b->asks()[i].price != INVALID_PRICE) asks[b->asks()[i].price] += b->asks()[i].quantity;
+        }
+    }
+    return bids.empty() ? 0 : bids.begin()->first;
+}
+
+int main(int argc, char** argv) {
+    size_t venues = 3; // NASDAQ, NYSE, ARCA
+    size_t num_events = 1000000;
+    if (argc > 1) venues = std::clamp<size_t>(std::stoul(argv[1]), 1, ConsolidatedBook::MAX_VENUES);
+    if (argc > 2) num_events = std::stoul(argv[2]);
+
+    RDTSCClock::calibrate();
+    std::cout << "Generating " << num_events << " events across " << venues << " venue feeds..." << std::endl;
+    auto replay = make_replay(venues, num_events, 42);
+
+    // 1. Incremental consolidated book
+    {
+        std::vector<std::unique_ptr<OrderBookL2>> books;
+        auto nbbo = std::make_unique<ConsolidatedBook>(1);
+        for (size_t v = 0; v < venues; ++v) {
+            books.push_back(std::make_unique<OrderBookL2>(1));
+            nbbo->add_venue(static_cast<VenueId>(v), "VENUE", books.back().get());
+        }
+
+        std::vector<uint64_t> samples;
+        samples.reserve(replay.size());
+        uint64_t total = 0;
+        for (const auto& ev : replay) {
+            books[ev.venue]->update(ev.msg);
+            uint64_t start = RDTSCClock::rdtsc();
+            nbbo->on_venue_update(ev.venue);
+            uint64_t end = RDTSCClock::rdtsc();
+            samples.push_back(end - start);
+            total += end - start;
+        }
+        print_stats("Consolidate (Incremental)", samples, RDTSCClock::rdtsc_to_ns(total));
+        std::cout << "  Level writes/update: "
+                  << static_cast<double>(nbbo->level_updates()) / replay.size() << std::endl;
+        std::cout << "  Final NBBO: " << nbbo->best_bid().price << " x " << nbbo->best_ask().price << std::endl;
+    }
+
+    // 2. Full rebuild baseline
+    {
+        std::vector<std::unique_ptr<OrderBookL2>> books;
+        for (size_t v = 0; v < venues; ++v) books.push_back(std::make_unique<OrderBookL2>(1));
+
+        std::vector<uint64_t> samples;
+        samples.reserve(replay.size());
+        uint64_t total = 0;
+        Price sink = 0;
+        for (const auto& ev : replay) {
+            books[ev.venue]->update(ev.msg);
+            uint64_t start = RDTSCClock::rdtsc();
+            sink ^= rebuild_ladder(books);
+            uint64_t end = RDTSCClock::rdtsc();
+            samples.push_back(end - start);
+            total += end - start;
+        }
+        print_stats("Consolidate (Full Rebuild)", samples, RDTSCClock::rdtsc_to_ns(total));
+        (void)sink;
+    }
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+// Cost of covering a venue's channels from one MD thread
+//
+// Usage: multi_channel_poll_bench [packets] [payload_bytes]
+//
+// For 1, 4 and 8 loopback channels (recvmmsg, then io_uring): the cost of
+// an empty polling round (what every idle pass of the MD loop pays), and
+// receive throughput with the packets spread round-robin over the channels.
+#include "ultra/network/multi_channel_receiver.hpp"
+#include "ultra/core/time/rdtsc_clock.hpp"
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace ultra;
+using network::MultiChannelReceiver;
+
+namespace {
+constexpr const char* GROUP = "239.255.42.95";
+constexpr const char* IFACE = "127.0.0.1";
+constexpr int BASE_PORT = 30200;
+constexpr int EMPTY_ROUNDS = 20000;
+
+MultiChannelReceiver::Config make_config(int channels, network::MulticastReceiver::Backend backend, int first_port) {
+    MultiChannelReceiver::Config config;
+    config.receiver.interface_ip = IFACE;
+    config.receiver.backend = backend;
+    config.receiver.uring_buffers = 256;
+    for (int i = 0; i < channels; ++i) {
+        MultiChannelReceiver::ChannelConfig channel;
+        channel.multicast_group = GROUP;
+        channel.port = first_port + i;
+        channel.max_batches = 0;
+        config.channels.push_back(channel);
+    }
+    return config;
+}
+
+void run(int channels, network::MulticastReceiver::Backend backend, const char* label, int first_port, int packets,
+         size_t payload) {
+    MultiChannelReceiver rx(make_config(channels, backend, first_port));
+    if (!rx.start()) return;
+    auto ignore = [](uint32_t, const network::MulticastReceiver::Packet&, uint64_t) {};
+
+    const uint64_t t0 = RDTSCClock::rdtsc();
+    for (int i = 0; i < EMPTY_ROUNDS; ++i) rx.poll(ignore);
+    const double empty_ns = RDTSCClock::rdtsc_to_ns(RDTSCClock::rdtsc() - t0) / static_cast<double>(EMPTY_ROUNDS);
+
+    std::thread sender([&] {
+        int fd = socket(AF_INET, SOCK_DGRAM, 0);
+        in_addr iface{};
+        iface.s_addr = inet_addr(IFACE);
+        setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &iface, sizeof(iface));
+        std::vector<sockaddr_in> dst(channels);
+        for (int c = 0; c < channels; ++c) {
+            dst[c].sin_family = AF_INET;
+            dst[c].sin_port = htons(static_cast<uint16_t>(first_port + c));
+            dst[c].sin_addr.s_addr = inet_addr(GROUP);
+        }
+        std::vector<uint8_t> buf(payload, 0x5A);
+        for (int i = 0; i < packets; ++i) {
+            sendto(fd, buf.data(), buf.size(), 0, reinterpret_cast<sockaddr*>(&dst[i % channels]), sizeof(sockaddr_in));
+            if ((i & 63) == 63) std::this_thread::yield(); // Let the receiver keep up on small hosts
+        }
+        close(fd);
+    });
+
+    size_t received = 0;
+    const auto start = std::chrono::steady_clock::now();
+    auto last = start;
+    while (received < static_cast<size_t>(packets)) {
+        const size_t n = rx.poll(ignore);
+        received += n;
+        const auto now = std::chrono::steady_clock::now();
+        if (n != 0) last = now;
+        else if (now - last > std::chrono::milliseconds(200)) break; // Rest was dropped
+    }
+    sender.join();
+    const double secs = std::chrono::duration<double>(last - start).count();
+    std::cout << label << "\t" << channels << "\t" << empty_ns << "\t" << empty_ns / channels << "\t" << received
+              << "/" << packets << "\t" << (secs > 0 ? received / secs : 0) << std::endl;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const int packets = argc > 1 ? std::atoi(argv[1]) : 200000;
+    const size_t payload = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 64;
+    RDTSCClock::calibrate();
+
+    std::cout << "backend\tchannels\tempty_round_ns\tns/channel\treceived\tpkts/s" << std::endl;
+    int port = BASE_PORT;
+    for (int channels : {1, 4, 8}) {
+        run(channels, network::MulticastReceiver::Backend::RECVMMSG, "recvmmsg", port, packets, payload);
+        port += channels;
+    }
+    for (int channels : {1, 4, 8}) {
+        run(channels, network::MulticastReceiver::Backend::IO_URING, "io_uring", port, packets, payload);
+        port += channels;
+    }
+    return 0;
+}
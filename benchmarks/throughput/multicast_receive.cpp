@@ -0,0 +1,172 @@
+#include "ultra/network/multicast_receiver.hpp"
+#include "ultra/network/uring_receive.hpp"
+#include "ultra/core/thread_utils.hpp"
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace ultra;
+
+/**
+ * Loopback multicast receive: one recv() per datagram vs receive_batch()
+ * with the recvmmsg backend vs the io_uring backend (multishot recvmsg,
+ * provided buffers, SQPOLL). A sender thread blasts fixed-size datagrams
+ * with sendmmsg; the receiver thread counts what it gets and reports
+ * packets/sec and receiver CPU time per packet (RUSAGE_THREAD). The last
+ * column is packets per non-empty poll; for io_uring the syscalls the MD
+ * thread actually made are printed separately. The SQ thread's CPU time is
+ * not in the receiver's figure: give it its own core (sqpoll_core).
+ *
+ * Usage: multicast_receive_bench [packets] [payload_bytes] [busy_poll_us] [rx_core] [tx_core] [sqpoll_core]
+ */
+
+static constexpr const char* GROUP = "239.255.42.99";
+static constexpr const char* IFACE = "127.0.0.1";
+
+struct Result {
+    uint64_t received; ///< Datagrams seen by the receiver.
+    uint64_t syscalls; ///< recv/recvmmsg calls that returned data.
+    double seconds; ///< First to last datagram.
+    double cpu_ns; ///< Receiver thread user+sys time.
+};
+
+static double thread_cpu_ns() {
+    rusage ru{};
+    getrusage(RUSAGE_THREAD, &ru);
+    return (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1e9 + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1e3;
+}
+
+// Sends `packets` datagrams of `payload` bytes, 32 per sendmmsg
+static void send_all(int port, uint64_t packets, size_t payload, int core) {
+    if (core >= 0) ThreadUtils::pin_thread(core);
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    in_addr iface{};
+    iface.s_addr = inet_addr(IFACE);
+    setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &iface, sizeof(iface));
+    unsigned char loop = 1;
+    setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+
+    sockaddr_in dst{};
+    dst.sin_family = AF_INET;
+    dst.sin_port = htons(static_cast<uint16_t>(port));
+    dst.sin_addr.s_addr = inet_addr(GROUP);
+
+    constexpr size_t BURST = 32;
+    std::vector<uint8_t> buf(payload, 0xAB);
+    iovec iov{buf.data(), payload};
+    mmsghdr msgs[BURST]{};
+    for (auto& m : msgs) {
+        m.msg_hdr.msg_name = &dst;
+        m.msg_hdr.msg_namelen = sizeof(dst);
+        m.msg_hdr.msg_iov = &iov;
+        m.msg_hdr.msg_iovlen = 1;
+    }
+    for (uint64_t sent = 0; sent < packets;) {
+        const unsigned burst = static_cast<unsigned>(std::min<uint64_t>(BURST, packets - sent));
+        const int n = sendmmsg(fd, msgs, burst, 0);
+        if (n > 0) sent += static_cast<uint64_t>(n);
+        else std::this_thread::yield(); // ENOBUFS: socket buffer full
+    }
+    close(fd);
+}
+
+template<typename Poll>
+static Result run(int port, uint64_t packets, size_t payload,
+                  int rx_core, int tx_core, Poll poll) {
+    if (rx_core >= 0) ThreadUtils::pin_thread(rx_core);
+    std::atomic<bool> done{false};
+    std::thread tx([&] {
+        send_all(port, packets, payload, tx_core);
+        done = true;
+    });
+
+    Result r{};
+    const double cpu0 = thread_cpu_ns();
+    auto first = std::chrono::steady_clock::now(), last = first;
+    auto idle_since = std::chrono::steady_clock::now();
+    while (r.received < packets) {
+        const uint64_t got = poll();
+        const auto now = std::chrono::steady_clock::now();
+        if (got) {
+            if (r.received == 0) first = now;
+            r.received += got;
+            ++r.syscalls;
+            last = idle_since = now;
+        } else if (done && now - idle_since > std::chrono::milliseconds(200)) {
+            break; // Sender finished; the rest was dropped
+        }
+    }
+    r.cpu_ns = thread_cpu_ns() - cpu0;
+    r.seconds = std::chrono::duration<double>(last - first).count();
+    tx.join();
+    return r;
+}
+
+static void report(const char* name, const Result& r, uint64_t sent) {
+    std::cout << name << "\t" << r.received << "/" << sent << "\t"
+              << static_cast<uint64_t>(r.seconds > 0 ? r.received / r.seconds : 0) << "\t"
+              << (r.received ? r.cpu_ns / r.received : 0) << "\t"
+              << (r.syscalls ? static_cast<double>(r.received) / r.syscalls : 0) << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const uint64_t packets = argc > 1 ? std::stoull(argv[1]) : 1000000;
+    const size_t payload = argc > 2 ? std::stoul(argv[2]) : 64;
+    const int busy_poll_us = argc > 3 ? std::stoi(argv[3]) : 0;
+    const int rx_core = argc > 4 ? std::stoi(argv[4]) : -1;
+    const int tx_core = argc > 5 ? std::stoi(argv[5]) : -1;
+    const int sqpoll_core = argc > 6 ? std::stoi(argv[6]) : -1;
+
+    network::MulticastReceiver::Config config;
+    config.interface_ip = IFACE;
+    config.multicast_group = GROUP;
+    config.busy_poll_us = busy_poll_us;
+
+    std::cout << "mode\treceived\tpkts/s\tcpu_ns/pkt\tpkts/poll" << std::endl;
+
+    config.port = 30001;
+    {
+        network::MulticastReceiver rx(config);
+        if (!rx.start()) return 1;
+        std::vector<uint8_t> buf(config.buffer_size);
+        Result r = run(config.port, packets, payload, rx_core, tx_core, [&]() -> uint64_t {
+            return rx.receive(buf.data(), buf.size()) > 0 ? 1 : 0;
+        });
+        report("recv", r, packets);
+    }
+
+    config.port = 30002;
+    {
+        network::MulticastReceiver rx(config);
+        if (!rx.start()) return 1;
+        Result r = run(config.port, packets, payload, rx_core, tx_core, [&]() -> uint64_t {
+            return rx.receive_batch().size();
+        });
+        report("recvmmsg", r, packets);
+    }
+
+    config.port = 30003;
+    config.backend = network::MulticastReceiver::Backend::IO_URING;
+    config.uring_sqpoll_cpu = sqpoll_core;
+    {
+        network::MulticastReceiver rx(config);
+        if (!rx.start()) return 1;
+        if (rx.backend_active() != network::MulticastReceiver::Backend::IO_URING) return 1;
+        Result r = run(config.port, packets, payload, rx_core, tx_core, [&]() -> uint64_t {
+            return rx.receive_batch().size();
+        });
+        report(rx.uring()->sqpoll_active() ? "io_uring+sqpoll" : "io_uring", r, packets);
+        std::cout << "  io_uring: " << rx.uring()->enters() << " syscalls, " << rx.uring()->rearms() << " re-arms, "
+                  << rx.uring()->no_buffer() << " out-of-buffer stops, "
+                  << (rx.uring()->buffer_ring_active() ? "buffer ring" : "PROVIDE_BUFFERS") << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "ultra/network/replay/pcap_reader.hpp"
+#include "ultra/network/replay/replay_pacer.hpp"
+#include "ultra/core/time/rdtsc_clock.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace ultra;
+using network::PcapReader;
+using network::ReplayPacer;
+
+/**
+ * Capture replay: how fast a capture can be read and parsed, and how close
+ * paced replay stays to the capture's timing.
+ * - read: PcapReader::next() over the mapped file
+ * - read+parse: next_udp() with a FlowTable of the feed's groups
+ * - paced: schedule() / wait() / released() per datagram at `speed`; lag is
+ *   release time minus due time (p50/p99/p99.9/max)
+ *
+ * Without a capture, a synthetic one is written to /tmp: `packets` 64-byte
+ * datagrams over 8 groups, in bursts of 64 sent 200 ns apart with 50 us
+ * between bursts (pcap, ns stamps).
+ *
+ * Usage: pcap_replay_bench [capture.pcap|capture.pcapng|-] [speed] [packets]
+ */
+
+static constexpr size_t PAYLOAD = 64;
+static constexpr uint32_t GROUPS = 8;
+static constexpr uint32_t BURST = 64;
+
+static uint32_t group_of(uint32_t g) { return 0xE9360000u + g; } // 233.54.x.y
+
+static std::string write_capture(uint64_t packets) {
+    const std::string path = "/tmp/pcap_replay_bench_" + std::to_string(getpid()) + ".pcap";
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        perror("fopen");
+        std::exit(1);
+    }
+    const uint32_t header[6] = {0xA1B23C4D, 2 | (4u << 16), 0, 0, 65535, 1};
+    std::fwrite(header, sizeof(header), 1, f);
+
+    uint8_t frame[14 + sizeof(network::IPv4Header) + sizeof(network::UDPHeader) + PAYLOAD] = {};
+    std::memset(frame, 0xAA, 12);
+    frame[12] = 0x08;
+    network::IPv4Header ip{};
+    ip.version_ihl = 0x45;
+    ip.total_length = htons(static_cast<uint16_t>(sizeof(ip) + sizeof(network::UDPHeader) + PAYLOAD));
+    ip.ttl = 1;
+    ip.protocol = IPPROTO_UDP;
+    network::UDPHeader udp{};
+    udp.length = htons(static_cast<uint16_t>(sizeof(udp) + PAYLOAD));
+
+    uint64_t ts = 1'700'000'000ull * 1'000'000'000ull;
+    for (uint64_t i = 0; i < packets; ++i) {
+        const uint32_t g = static_cast<uint32_t>(i % GROUPS);
+        ip.dst_ip = htonl(group_of(g));
+        udp.dst_port = htons(static_cast<uint16_t>(26400 + g));
+        std::memcpy(frame + 14, &ip, sizeof(ip));
+        std::memcpy(frame + 14 + sizeof(ip), &udp, sizeof(udp));
+        ts += i % BURST == 0 ? 50'000 : 200;
+        const uint32_t record[4] = {static_cast<uint32_t>(ts / 1'000'000'000ull),
+                                    static_cast<uint32_t>(ts % 1'000'000'000ull), sizeof(frame), sizeof(frame)};
+        std::fwrite(record, sizeof(record), 1, f);
+        std::fwrite(frame, sizeof(frame), 1, f);
+    }
+    std::fclose(f);
+    return path;
+}
+
+static void report(const char* mode, uint64_t frames, uint64_t ticks) {
+    const double ns = static_cast<double>(RDTSCClock::rdtsc_to_ns(ticks));
+    std::cout << mode << "\t" << frames / (ns / 1e3) << "\t" << ns / frames << "\t" << frames << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const double speed = argc > 2 ? std::atof(argv[2]) : 1.0;
+    const uint64_t packets = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 200000;
+    RDTSCClock::calibrate();
+
+    const bool synthetic = argc < 2 || std::strcmp(argv[1], "-") == 0;
+    const std::string path = synthetic ? write_capture(packets) : argv[1];
+    PcapReader::Config config;
+    config.populate = true; // Page faults out of the timed loops
+    PcapReader reader(config);
+    if (!reader.open(path)) return 1;
+
+    network::FlowTable flows;
+    for (uint32_t g = 0; g < GROUPS; ++g) flows.add(group_of(g), static_cast<uint16_t>(26400 + g), g);
+    const network::FlowTable* filter = synthetic ? &flows : nullptr;
+
+    std::cout << path << ": " << reader.size() / 1024 << " KB" << std::endl;
+    std::cout << "mode\tMframes/s\tns/frame\tframes" << std::endl;
+
+    PcapReader::Packet packet{};
+    uint64_t frames = 0;
+    uint64_t t0 = RDTSCClock::rdtsc();
+    while (reader.next(packet)) ++frames;
+    report("read", frames, RDTSCClock::rdtsc() - t0);
+
+    reader.rewind();
+    network::EthernetParser::ParsedPacket udp{};
+    uint64_t datagrams = 0;
+    uint64_t bytes = 0;
+    t0 = RDTSCClock::rdtsc();
+    while (reader.next_udp(udp, filter)) {
+        ++datagrams;
+        bytes += udp.payload[0] + udp.payload_len; // Touch the payload
+    }
+    report("read+parse", datagrams, RDTSCClock::rdtsc() - t0);
+    if (bytes == 0) std::cout << "  (no payload bytes)" << std::endl;
+
+    // Paced replay, as the engine's MD loop does it
+    reader.rewind();
+    ReplayPacer pacer(speed);
+    std::vector<uint64_t> lag;
+    lag.reserve(datagrams);
+    Timestamp first = 0, last = 0;
+    t0 = RDTSCClock::rdtsc();
+    while (reader.next_udp(udp, filter)) {
+        if (first == 0) first = udp.timestamp_ns;
+        last = udp.timestamp_ns;
+        pacer.schedule(udp.timestamp_ns);
+        pacer.wait();
+        const Timestamp now = RDTSCClock::now();
+        pacer.released(now);
+        lag.push_back(speed > 0 && now > pacer.due_ns() ? now - pacer.due_ns() : 0);
+    }
+    const uint64_t ticks = RDTSCClock::rdtsc() - t0;
+    report("paced", lag.size(), ticks);
+
+    if (!lag.empty()) {
+        std::sort(lag.begin(), lag.end());
+        auto pct = [&](double p) { return lag[std::min(lag.size() - 1, static_cast<size_t>(p * lag.size()))]; };
+        std::cout << "  speed " << speed << ": capture span " << (last - first) / 1000 << " us, replayed in "
+                  << RDTSCClock::rdtsc_to_ns(ticks) / 1000 << " us" << std::endl;
+        std::cout << "  lag behind schedule (ns): p50 " << pct(0.50) << ", p99 " << pct(0.99) << ", p99.9 "
+                  << pct(0.999) << ", max " << lag.back() << "; " << pacer.late() << " late" << std::endl;
+    }
+    if (synthetic) std::remove(path.c_str());
+    return 0;
+}
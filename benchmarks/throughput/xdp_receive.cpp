@@ -0,0 +1,191 @@
+#include "ultra/network/kernel-bypass/xdp_receiver.hpp"
+#include "ultra/network/kernel-bypass/packet_ring.hpp"
+#include "ultra/core/thread_utils.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <linux/if_packet.h>
+#include <net/if.h>
+#include <string>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace ultra;
+
+/**
+ * Raw-frame receive over a veth pair: AF_PACKET TPACKET_V3 ring vs AF_XDP
+ * (copy mode on veth; zero-copy on a capable NIC with real interfaces). A
+ * sender thread writes UDP frames into the peer with PACKET_QDISC_BYPASS
+ * sendmmsg; the receiver counts frames and reports frames/sec and receiver
+ * CPU time per frame (RUSAGE_THREAD). Creates and removes the veth pair
+ * unless interfaces are given.
+ *
+ * Usage: xdp_receive_bench [frames] [payload_bytes] [rx_if tx_if] [rx_core] [tx_core]
+ */
+
+static constexpr uint16_t PORT = 30401;
+
+struct Result {
+    uint64_t received; ///< Frames seen by the receiver.
+    double seconds; ///< First to last frame.
+    double cpu_ns; ///< Receiver thread user+sys time.
+};
+
+static double thread_cpu_ns() {
+    rusage ru{};
+    getrusage(RUSAGE_THREAD, &ru);
+    return (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1e9 + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1e3;
+}
+
+// Ethernet + IPv4 + UDP to 10.99.0.1:PORT
+static std::vector<uint8_t> udp_frame(size_t payload) {
+    std::vector<uint8_t> f(42 + payload, 0xAB);
+    std::fill_n(f.begin(), 6, 0xFF);
+    std::fill_n(f.begin() + 6, 6, 0x02);
+    f[12] = 0x08;
+    f[13] = 0x00;
+    f[14] = 0x45;
+    f[15] = 0;
+    const uint16_t ip_len = htons(static_cast<uint16_t>(28 + payload));
+    std::memcpy(&f[16], &ip_len, 2);
+    std::memset(&f[18], 0, 4);
+    f[22] = 64;
+    f[23] = 17;
+    f[24] = f[25] = 0;
+    const uint32_t src = inet_addr("10.99.0.2"), dst = inet_addr("10.99.0.1");
+    std::memcpy(&f[26], &src, 4);
+    std::memcpy(&f[30], &dst, 4);
+    const uint16_t sport = htons(40000), dport = htons(PORT), udp_len = htons(static_cast<uint16_t>(8 + payload));
+    std::memcpy(&f[34], &sport, 2);
+    std::memcpy(&f[36], &dport, 2);
+    std::memcpy(&f[38], &udp_len, 2);
+    f[40] = f[41] = 0;
+    return f;
+}
+
+// Writes `frames` frames on tx_if, 32 per sendmmsg
+static void send_all(const std::string& tx_if, uint64_t frames, size_t payload, int core) {
+    if (core >= 0) ThreadUtils::pin_thread(core);
+    int fd = socket(AF_PACKET, SOCK_RAW, 0);
+    int one = 1;
+    setsockopt(fd, SOL_PACKET, PACKET_QDISC_BYPASS, &one, sizeof(one));
+    sockaddr_ll addr{};
+    addr.sll_family = AF_PACKET;
+    addr.sll_ifindex = static_cast<int>(if_nametoindex(tx_if.c_str()));
+    bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+
+    constexpr size_t BURST = 32;
+    std::vector<uint8_t> frame = udp_frame(payload);
+    iovec iov{frame.data(), frame.size()};
+    mmsghdr msgs[BURST]{};
+    for (auto& m : msgs) {
+        m.msg_hdr.msg_iov = &iov;
+        m.msg_hdr.msg_iovlen = 1;
+    }
+    for (uint64_t sent = 0; sent < frames;) {
+        const unsigned burst = static_cast<unsigned>(std::min<uint64_t>(BURST, frames - sent));
+        const int n = sendmmsg(fd, msgs, burst, 0);
+        if (n > 0) sent += static_cast<uint64_t>(n);
+        else std::this_thread::yield();
+    }
+    close(fd);
+}
+
+template<typename Poll>
+static Result run(const std::string& tx_if, uint64_t frames, size_t payload, int rx_core, int tx_core, Poll poll) {
+    if (rx_core >= 0) ThreadUtils::pin_thread(rx_core);
+    std::atomic<bool> done{false};
+    std::thread tx([&] {
+        send_all(tx_if, frames, payload, tx_core);
+        done = true;
+    });
+
+    Result r{};
+    const double cpu0 = thread_cpu_ns();
+    auto first = std::chrono::steady_clock::now(), last = first;
+    auto idle_since = first;
+    while (r.received < frames) {
+        const uint64_t got = poll();
+        const auto now = std::chrono::steady_clock::now();
+        if (got) {
+            if (r.received == 0) first = now;
+            r.received += got;
+            last = idle_since = now;
+        } else if (done && now - idle_since > std::chrono::milliseconds(200)) {
+            break; // Sender finished; the rest was dropped
+        }
+    }
+    r.cpu_ns = thread_cpu_ns() - cpu0;
+    r.seconds = std::chrono::duration<double>(last - first).count();
+    tx.join();
+    return r;
+}
+
+static void report(const char* name, const Result& r, uint64_t sent) {
+    std::cout << name << "\t" << r.received << "/" << sent << "\t"
+              << static_cast<uint64_t>(r.seconds > 0 ? r.received / r.seconds : 0) << "\t"
+              << (r.received ? r.cpu_ns / r.received : 0) << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const uint64_t frames = argc > 1 ? std::stoull(argv[1]) : 1000000;
+    const size_t payload = argc > 2 ? std::stoul(argv[2]) : 64;
+    const bool own_veth = argc <= 4;
+    const std::string rx_if = own_veth ? "uxdpb0" : argv[3];
+    const std::string tx_if = own_veth ? "uxdpb1" : argv[4];
+    const int rx_core = argc > 5 ? std::stoi(argv[5]) : -1;
+    const int tx_core = argc > 6 ? std::stoi(argv[6]) : -1;
+
+    if (own_veth) {
+        std::system("ip link del uxdpb0 2>/dev/null");
+        if (std::system("ip link add uxdpb0 type veth peer name uxdpb1 && "
+                        "ip link set uxdpb0 up && ip link set uxdpb1 up") != 0) {
+            std::cerr << "Cannot create veth pair (needs CAP_NET_ADMIN)" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "mode\treceived\tframes/s\tcpu_ns/frame" << std::endl;
+    {
+        network::PacketRingReceiver::Config config;
+        config.interface_name = rx_if;
+        config.channels = {{"10.99.0.1", PORT}};
+        config.join_groups = false;
+        network::PacketRingReceiver rx(config);
+        if (rx.start()) {
+            Result r = run(tx_if, frames, payload, rx_core, tx_core, [&]() -> uint64_t {
+                return rx.poll([](const network::PacketRingReceiver::Frame&) {});
+            });
+            report("tpacket_v3", r, frames);
+        }
+    }
+    {
+        network::XDPReceiver::Config config;
+        config.interface_name = rx_if;
+        config.ports = {PORT};
+        network::XDPReceiver rx(config);
+        if (rx.start()) {
+            Result r = run(tx_if, frames, payload, rx_core, tx_core, [&]() -> uint64_t {
+                uint64_t n = 0;
+                while (rx.has_data()) {
+                    size_t len;
+                    rx.peek(len);
+                    rx.advance();
+                    ++n;
+                }
+                return n;
+            });
+            report(rx.zero_copy() ? "af_xdp_zc" : "af_xdp_copy", r, frames);
+        }
+    }
+
+    if (own_veth) std::system("ip link del uxdpb0 2>/dev/null");
+    return 0;
+}
@@ -1,12 +1,16 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 #include <fstream>
 #include <thread>
 #include <atomic>
 #include <mutex>
 #include <cstdarg>
-#include "lockfree/spsc_queue.hpp"
+#include <algorithm>
+#include <array>
+#include <memory>
+#include "lockfree/byte_ring.hpp"
 #include "compiler.hpp"
 #include "time/rdtsc_clock.hpp"
 
@@ -14,17 +18,24 @@ namespace ultra {
 
 /**
  * High-Performance Asynchronous Logger (Non-blocking)
- * Uses SPSC Queue to pass log messages to a dedicated thread.
+ * Passes formatted log lines to a dedicated thread through variable-length
+ * ByteRings: a line costs its own length (+8-byte header) instead of a fixed
+ * slot, so short lines are cheap and long ones are no longer truncated at 128.
+ *
+ * - One SPSC ring per logging thread, claimed on its first line and freed
+ *   when the thread exits (the ring is kept for the next thread), so
+ *   producers never share a cache line or a lock
+ * - The flush thread drains every ring in turn: lines of one thread stay in
+ *   order, lines of different threads interleave by batch (each carries
+ *   its TSC stamp)
+ * - Full ring, or more than MAX_PRODUCERS threads logging at once: the line
+ *   is dropped
  */
 class AsyncLogger {
 public:
-    static constexpr size_t QUEUE_SIZE = 65536; // 64K messages
-    static constexpr size_t MAX_MSG_LEN = 128; ///< const int variable representing MAX_MSG_LEN.
-
-    struct LogEntry {
-        uint64_t tsc; ///< int variable representing tsc.
-        char msg[MAX_MSG_LEN]; ///< int variable representing msg.
-    };
+    static constexpr size_t QUEUE_BYTES = 2 * 1024 * 1024; ///< Per thread, ~40K 40-byte lines.
+    static constexpr size_t MAX_PRODUCERS = 16; ///< Threads that can log at the same time.
+    static constexpr size_t MAX_MSG_LEN = 1024; ///< Longest line; longer lines are truncated.
 
     enum class LogLevel {
         DEBUG,
@@ -75,7 +86,7 @@ public:
                               * @param level Log level.
                               * @param fmt Format string.
                               */
-    ULTRA_ALWAYS_INLINE void log(LogLevel level, const char* fmt, ...) {
+    inline void log(LogLevel level, const char* fmt, ...) {
         va_list args;
         va_start(args, fmt);
         log_internal(level, 0, nullptr, 0, fmt, args);
@@ -85,7 +96,7 @@ public:
     /**
      * @brief Flow-aware logging function.
      */
-    ULTRA_ALWAYS_INLINE void log_flow(LogLevel level, const char* func, uint64_t duration_ns, const char* fmt, ...) {
+    inline void log_flow(LogLevel level, const char* func, uint64_t duration_ns, const char* fmt, ...) {
         va_list args;
         va_start(args, fmt);
         log_internal(level, flow_depth_, func, duration_ns, fmt, args);
@@ -135,51 +146,106 @@ private:
     }
 
     void log_internal(LogLevel level, uint32_t depth, const char* /*func*/, uint64_t duration_ns, const char* fmt, va_list args) {
-        LogEntry entry;
-        entry.tsc = RDTSCClock::now();
-        
-        char payload[MAX_MSG_LEN];
+        // Formatted outside the producer lock, then copied in at its real length
+        static thread_local char msg[MAX_MSG_LEN];
+        static thread_local char payload[MAX_MSG_LEN];
+        const uint64_t tsc = RDTSCClock::now();
+
         vsnprintf(payload, MAX_MSG_LEN, fmt, args);
 
+        int len;
         if (json_mode_) {
-            snprintf(entry.msg, MAX_MSG_LEN, 
+            len = snprintf(msg, MAX_MSG_LEN, 
                 "{\"ts\":%llu,\"lvl\":\"%s\",\"depth\":%u,\"stack\":\"%s\",\"dur_ns\":%llu,\"msg\":\"%s\"}",
-                (unsigned long long)entry.tsc, level_to_str(level), depth, get_stack_string().c_str(), 
+                (unsigned long long)tsc, level_to_str(level), depth, get_stack_string().c_str(), 
                 (unsigned long long)duration_ns, payload);
         } else {
             size_t offset = 0;
             for (uint32_t i = 0; i < depth && offset < MAX_MSG_LEN - 3; ++i) {
-                entry.msg[offset++] = ' ';
-                entry.msg[offset++] = ' ';
+                msg[offset++] = ' ';
+                msg[offset++] = ' ';
             }
             const char* dur_part = duration_ns > 0 ? " [dur=" : "";
             char dur_val[32] = "";
             if (duration_ns > 0) snprintf(dur_val, 32, "%llu ns]", (unsigned long long)duration_ns);
 
-            snprintf(entry.msg + offset, MAX_MSG_LEN - offset, "[%s] %s%s%s", 
+            len = static_cast<int>(offset) + snprintf(msg + offset, MAX_MSG_LEN - offset, "[%s] %s%s%s", 
                 level_to_str(level), payload, dur_part, dur_val);
         }
+        if (len < 0) return;
+        const size_t n = std::min(static_cast<size_t>(len), MAX_MSG_LEN - 1); // snprintf truncation
 
-        queue_.push(entry);
+        // This thread's own ring: no lock, no shared producer state. Full: drop.
+        if (Queue* queue = producer_queue()) queue->push(msg, n);
     }
 
-    void flush_loop() {
-        LogEntry entry;
-        while (running_ || !queue_.empty()) {
-            if (queue_.pop(entry)) {
-                file_ << entry.msg << "\n";
-            } else {
-                // No logs, relax the CPU
-                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    using Queue = ByteRing<QUEUE_BYTES>;
+
+    struct ULTRA_CACHE_ALIGNED Producer {
+        std::atomic<bool> claimed{false}; ///< A live thread owns the ring.
+        std::atomic<Queue*> queue{nullptr}; ///< Allocated by the first claimant, kept for the next.
+        std::unique_ptr<Queue> storage; ///< Owns queue.
+    };
+
+    // Releases the thread's slot when it exits; the flush thread still
+    // drains what it left in the ring
+    struct ProducerHandle {
+        Producer* producer{nullptr}; ///< Claimed slot (nullptr: none yet).
+        ~ProducerHandle() {
+            if (producer) producer->claimed.store(false, std::memory_order_release);
+        }
+    };
+
+    ULTRA_ALWAYS_INLINE Queue* producer_queue() {
+        static thread_local ProducerHandle handle;
+        if (ULTRA_LIKELY(handle.producer != nullptr)) return handle.producer->queue.load(std::memory_order_relaxed);
+        return claim_producer(handle);
+    }
+
+    // First line from this thread: take a free slot (cold path)
+    ULTRA_NEVER_INLINE ULTRA_COLD Queue* claim_producer(ProducerHandle& handle) {
+        for (auto& p : producers_) {
+            bool expected = false;
+            if (!p.claimed.compare_exchange_strong(expected, true, std::memory_order_acquire)) continue;
+            if (p.queue.load(std::memory_order_acquire) == nullptr) {
+                p.storage = std::make_unique<Queue>();
+                p.queue.store(p.storage.get(), std::memory_order_release);
+            }
+            handle.producer = &p;
+            return p.queue.load(std::memory_order_relaxed);
+        }
+        return nullptr; // Every slot taken: this thread's lines are dropped
+    }
+
+    // Writes what is queued in every ring; true if anything was written
+    bool drain() {
+        bool wrote = false;
+        for (auto& p : producers_) {
+            Queue* queue = p.queue.load(std::memory_order_acquire);
+            if (queue == nullptr) continue;
+            for (auto line = queue->peek(); !line.empty(); line = queue->peek()) {
+                file_.write(reinterpret_cast<const char*>(line.data()), static_cast<std::streamsize>(line.size()));
+                file_ << "\n";
+                queue->release();
+                wrote = true;
             }
         }
+        return wrote;
+    }
+
+    void flush_loop() {
+        while (running_) {
+            // No logs, relax the CPU
+            if (!drain()) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        drain(); // Lines logged before stop()
         file_.flush();
     }
 
     std::atomic<bool> running_{false}; ///< int variable representing running_.
     std::ofstream file_; ///< int variable representing file_.
     std::thread flush_thread_; ///< int variable representing flush_thread_.
-    SPSCQueue<LogEntry, QUEUE_SIZE> queue_; ///< int variable representing queue_.
+    std::array<Producer, MAX_PRODUCERS> producers_; ///< One ring per logging thread.
 };
 
 /**
@@ -187,10 +253,12 @@ private:
  */
 class FlowTracer {
 public:
-    FlowTracer(const char* func, const std::string& desc = "", const std::string& params = "") 
+    // string_view: params may be a std::string or a ScratchArena::format() result
+    FlowTracer(const char* func, std::string_view desc = "", std::string_view params = "") 
         : func_(func), start_tsc_(RDTSCClock::now()) {
         
-        AsyncLogger::instance().log_flow(AsyncLogger::LogLevel::INFO, func_, 0, "ENTER -> [%s] | Purpose: %s | Params: (%s)", func_, desc.c_str(), params.c_str());
+        AsyncLogger::instance().log_flow(AsyncLogger::LogLevel::INFO, func_, 0, "ENTER -> [%s] | Purpose: %.*s | Params: (%.*s)", func_,
+                                         static_cast<int>(desc.size()), desc.data(), static_cast<int>(params.size()), params.data());
         AsyncLogger::enter_flow(func_);
     }
     ~FlowTracer() {
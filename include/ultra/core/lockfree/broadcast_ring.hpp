@@ -0,0 +1,215 @@
+#pragma once
+#include "../compiler.hpp"
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace ultra {
+
+// What the producer does when the ring is full relative to the slowest consumer
+enum class BroadcastPolicy : uint8_t {
+    BLOCK_ON_SLOWEST, // try_claim() fails until every consumer has moved on
+    OVERWRITE         // Never blocks; lapped consumers detect and count the overrun
+};
+
+/**
+ * Single-Producer Multi-Consumer broadcast ring (Disruptor style)
+ * - Producer writes each event once; every consumer advances its own cursor
+ * - Sequences are monotonic 64-bit counters, slot = seq & (Capacity - 1)
+ * - BLOCK_ON_SLOWEST: producer caches the slowest cursor and rescans the
+ *   consumers only when the ring looks full, so publish cost does not grow
+ *   with the number of consumers
+ * - OVERWRITE: producer never reads consumer state; it announces each claim
+ *   before writing so a reader can tell when its copy may have been torn
+ */
+template<typename T, size_t Capacity, size_t MaxConsumers = 8,
+         BroadcastPolicy Policy = BroadcastPolicy::BLOCK_ON_SLOWEST>
+requires std::is_trivially_copyable_v<T>
+class BroadcastRing {
+public:
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be power of 2");
+    static constexpr size_t INVALID_CONSUMER = MaxConsumers; ///< Returned when no slot is free.
+
+    BroadcastRing() noexcept = default;
+
+    BroadcastRing(const BroadcastRing&) = delete;
+    BroadcastRing& operator=(const BroadcastRing&) = delete;
+
+    // --- Registration (one control thread; safe while the producer runs) ---
+
+    // New consumers start at the current producer cursor (they see only
+    // events published after registration).
+    size_t add_consumer() noexcept {
+        for (size_t id = 0; id < MaxConsumers; ++id) {
+            auto& c = consumers_[id];
+            if (c.active.load(std::memory_order_relaxed)) continue;
+
+            const uint64_t start = cursor_.load(std::memory_order_acquire);
+            c.cursor.store(start, std::memory_order_relaxed);
+            c.cached_published = start;
+            c.overruns.store(0, std::memory_order_relaxed);
+            c.active.store(true, std::memory_order_release);
+
+            size_t high = consumer_high_.load(std::memory_order_relaxed);
+            if (id + 1 > high) consumer_high_.store(id + 1, std::memory_order_release);
+            return id;
+        }
+        return INVALID_CONSUMER;
+    }
+
+    // Stop gating the producer on this consumer (e.g. a strategy shut down)
+    void remove_consumer(size_t id) noexcept {
+        if (id < MaxConsumers) consumers_[id].active.store(false, std::memory_order_release);
+    }
+
+    // --- Producer API ---
+
+    // Claim the next slot for in-place construction; nullptr if the slowest
+    // consumer is a full ring behind (BLOCK_ON_SLOWEST only).
+    ULTRA_ALWAYS_INLINE T* try_claim() noexcept {
+        const uint64_t seq = next_;
+        if constexpr (Policy == BroadcastPolicy::BLOCK_ON_SLOWEST) {
+            if (ULTRA_UNLIKELY(seq - cached_gate_ >= Capacity)) {
+                cached_gate_ = slowest_cursor(seq);
+                if (seq - cached_gate_ >= Capacity) return nullptr;
+            }
+        } else {
+            // Announce the overwrite before touching the slot (seqlock writer)
+            claim_.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+        return &buffer_[seq & MASK];
+    }
+
+    // Make the slot returned by try_claim() visible to all consumers
+    ULTRA_ALWAYS_INLINE void publish() noexcept {
+        cursor_.store(++next_, std::memory_order_release);
+    }
+
+    ULTRA_ALWAYS_INLINE bool publish(const T& item) noexcept {
+        T* slot = try_claim();
+        if (ULTRA_UNLIKELY(!slot)) return false;
+        *slot = item;
+        publish();
+        return true;
+    }
+
+    // --- Consumer API (each id owned by exactly one thread) ---
+
+    // Copy out the next event for this consumer. In OVERWRITE mode a lapped
+    // consumer skips ahead to the oldest intact event and overruns() grows.
+    ULTRA_ALWAYS_INLINE bool read(size_t id, T& out) noexcept {
+        auto& c = consumers_[id];
+        uint64_t seq = c.cursor.load(std::memory_order_relaxed);
+
+        if (ULTRA_UNLIKELY(seq == c.cached_published)) {
+            c.cached_published = cursor_.load(std::memory_order_acquire);
+            if (seq == c.cached_published) return false;
+        }
+
+        if constexpr (Policy == BroadcastPolicy::OVERWRITE) {
+            while (true) {
+                // Lapped before we even started: jump to the oldest live slot
+                if (ULTRA_UNLIKELY(c.cached_published - seq > Capacity)) {
+                    const uint64_t oldest = c.cached_published - Capacity;
+                    c.overruns.fetch_add(oldest - seq, std::memory_order_relaxed);
+                    seq = oldest;
+                }
+                out = buffer_[seq & MASK];
+                std::atomic_thread_fence(std::memory_order_acquire);
+                // The slot is reused by seq + Capacity; claim_ > seq + Capacity
+                // means the producer may have written it during our copy.
+                if (ULTRA_LIKELY(claim_.load(std::memory_order_relaxed) <= seq + Capacity)) break;
+                c.cached_published = cursor_.load(std::memory_order_acquire);
+                c.overruns.fetch_add(1, std::memory_order_relaxed);
+                ++seq;
+                if (seq >= c.cached_published) {
+                    c.cursor.store(seq, std::memory_order_release);
+                    return false;
+                }
+            }
+        } else {
+            out = buffer_[seq & MASK];
+        }
+
+        c.cursor.store(seq + 1, std::memory_order_release);
+        return true;
+    }
+
+    // In-place access; only safe when the producer cannot overwrite
+    ULTRA_ALWAYS_INLINE const T* peek(size_t id) noexcept
+        requires (Policy == BroadcastPolicy::BLOCK_ON_SLOWEST) {
+        auto& c = consumers_[id];
+        const uint64_t seq = c.cursor.load(std::memory_order_relaxed);
+
+        if (ULTRA_UNLIKELY(seq == c.cached_published)) {
+            c.cached_published = cursor_.load(std::memory_order_acquire);
+            if (seq == c.cached_published) return nullptr;
+        }
+        return &buffer_[seq & MASK];
+    }
+
+    ULTRA_ALWAYS_INLINE void advance(size_t id) noexcept
+        requires (Policy == BroadcastPolicy::BLOCK_ON_SLOWEST) {
+        auto& c = consumers_[id];
+        c.cursor.store(c.cursor.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // --- Metrics (any thread) ---
+
+    // Events published but not yet consumed by this consumer
+    uint64_t lag(size_t id) const noexcept {
+        const uint64_t head = cursor_.load(std::memory_order_acquire);
+        const uint64_t seq = consumers_[id].cursor.load(std::memory_order_acquire);
+        return head > seq ? head - seq : 0;
+    }
+
+    // Events this consumer lost to the producer lapping it (OVERWRITE only)
+    uint64_t overruns(size_t id) const noexcept {
+        return consumers_[id].overruns.load(std::memory_order_relaxed);
+    }
+
+    uint64_t published() const noexcept { return cursor_.load(std::memory_order_acquire); }
+    bool is_active(size_t id) const noexcept {
+        return id < MaxConsumers && consumers_[id].active.load(std::memory_order_acquire);
+    }
+    static constexpr size_t capacity() noexcept { return Capacity; }
+    static constexpr BroadcastPolicy policy() noexcept { return Policy; }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    struct ULTRA_CACHE_ALIGNED ConsumerState {
+        std::atomic<uint64_t> cursor{0}; ///< Next sequence to read (read by producer for gating).
+        std::atomic<uint64_t> overruns{0}; ///< Events lost to overwrite.
+        std::atomic<bool> active{false}; ///< Registered and gating the producer.
+        uint64_t cached_published{0}; ///< Consumer-private copy of cursor_.
+    };
+
+    // Slowest active cursor; seq itself if nobody is registered
+    ULTRA_NEVER_INLINE uint64_t slowest_cursor(uint64_t seq) const noexcept {
+        uint64_t min = seq;
+        const size_t high = consumer_high_.load(std::memory_order_acquire);
+        for (size_t id = 0; id < high; ++id) {
+            const auto& c = consumers_[id];
+            if (!c.active.load(std::memory_order_acquire)) continue;
+            const uint64_t cur = c.cursor.load(std::memory_order_acquire);
+            if (cur < min) min = cur;
+        }
+        return min;
+    }
+
+    std::array<T, Capacity> buffer_;
+
+    // Producer-owned
+    ULTRA_CACHE_ALIGNED std::atomic<uint64_t> cursor_{0}; ///< Published sequence count.
+    ULTRA_CACHE_ALIGNED std::atomic<uint64_t> claim_{0}; ///< Last claimed seq + 1 (OVERWRITE).
+    ULTRA_CACHE_ALIGNED uint64_t next_{0}; ///< Producer-private next sequence.
+    uint64_t cached_gate_{0}; ///< Producer-private slowest cursor.
+
+    ULTRA_CACHE_ALIGNED std::atomic<size_t> consumer_high_{0}; ///< Highest registered id + 1.
+    std::array<ConsumerState, MaxConsumers> consumers_{};
+};
+
+} // namespace ultra
@@ -0,0 +1,176 @@
+#pragma once
+#include "../compiler.hpp"
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace ultra {
+
+/**
+ * Single-Producer Single-Consumer ring of variable-length byte records
+ * For packets (DMA ring simulation) and log lines: a 40-byte ITCH packet
+ * costs 48 bytes of ring instead of a fixed 2048-byte slot.
+ *
+ * - Each record is an 8-byte header {length, kind} followed by the payload,
+ *   padded to 8 bytes, so headers stay aligned
+ * - Records are always contiguous: when the producer needs more bytes than
+ *   remain before the end of the buffer, it writes a padding record over
+ *   the tail end and places the record at offset 0; the consumer skips
+ *   padding transparently
+ * - Producer: try_reserve(n) -> write -> commit(used <= n). The padding (if
+ *   any) and the record are published by the same release store
+ * - Consumer: peek() -> span of the payload, release() when done
+ * - Positions are free-running 64-bit byte counters; each side caches the
+ *   other's position like SPSCQueue
+ */
+template<size_t CapacityBytes>
+class ByteRing {
+public:
+    static_assert((CapacityBytes & (CapacityBytes - 1)) == 0, "Capacity must be power of 2");
+    static_assert(CapacityBytes >= 64, "Capacity too small");
+
+    static constexpr size_t HEADER_SIZE = 8;
+    static constexpr size_t ALIGN = 8;
+
+    ByteRing() noexcept = default;
+    ByteRing(const ByteRing&) = delete;
+    ByteRing& operator=(const ByteRing&) = delete;
+
+    // Largest payload that is always eventually accepted (wrap padding
+    // can cost up to one record's worth of space)
+    static constexpr size_t max_record_size() noexcept { return CapacityBytes / 2 - HEADER_SIZE; }
+    static constexpr size_t capacity() noexcept { return CapacityBytes; }
+
+    // Ring bytes a payload of len bytes occupies (header + alignment)
+    static constexpr size_t footprint(size_t len) noexcept {
+        return (HEADER_SIZE + len + ALIGN - 1) & ~(ALIGN - 1);
+    }
+
+    // --- Producer ---
+
+    // Reserve len contiguous bytes; nullptr if the ring is too full or len
+    // exceeds max_record_size(). Calling again before commit() re-reserves.
+    ULTRA_ALWAYS_INLINE uint8_t* try_reserve(size_t len) noexcept {
+        if (ULTRA_UNLIKELY(len > max_record_size())) return nullptr;
+
+        uint64_t pos = head_.load(std::memory_order_relaxed);
+        const size_t total = footprint(len);
+        const size_t contiguous = CapacityBytes - (pos & MASK);
+        const size_t pad = total > contiguous ? contiguous : 0;
+
+        if (ULTRA_UNLIKELY(pos + pad + total - cached_tail_ > CapacityBytes)) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (pos + pad + total - cached_tail_ > CapacityBytes) {
+                return nullptr; // Ring full
+            }
+        }
+
+        if (pad) {
+            write_header(pos, static_cast<uint32_t>(pad - HEADER_SIZE), KIND_PADDING);
+            pos += pad;
+        }
+        reserved_pos_ = pos;
+        reserved_len_ = len;
+        return &buffer_[(pos & MASK) + HEADER_SIZE];
+    }
+
+    // Publish the last reservation; used may be smaller than reserved
+    // (e.g. reserve the MTU, commit the actual packet length)
+    ULTRA_ALWAYS_INLINE void commit(size_t used) noexcept {
+        if (ULTRA_UNLIKELY(used > reserved_len_)) used = reserved_len_;
+        write_header(reserved_pos_, static_cast<uint32_t>(used), KIND_DATA);
+        head_.store(reserved_pos_ + footprint(used), std::memory_order_release);
+    }
+
+    ULTRA_ALWAYS_INLINE void commit() noexcept { commit(reserved_len_); }
+
+    // Copy-in convenience (returns false if no room)
+    ULTRA_ALWAYS_INLINE bool push(const void* data, size_t len) noexcept {
+        uint8_t* dst = try_reserve(len);
+        if (ULTRA_UNLIKELY(!dst)) return false;
+        std::memcpy(dst, data, len);
+        commit(len);
+        return true;
+    }
+
+    // --- Consumer ---
+
+    // Next record's payload (empty span if none). Valid until release().
+    ULTRA_ALWAYS_INLINE std::span<const uint8_t> peek() noexcept {
+        uint64_t pos = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            if (ULTRA_UNLIKELY(pos == cached_head_)) {
+                cached_head_ = head_.load(std::memory_order_acquire);
+                if (pos == cached_head_) return {};
+            }
+            Header h;
+            std::memcpy(&h, &buffer_[pos & MASK], sizeof(h));
+            if (ULTRA_LIKELY(h.kind == KIND_DATA)) {
+                peek_len_ = h.length;
+                return {&buffer_[(pos & MASK) + HEADER_SIZE], h.length};
+            }
+            // Padding up to the end of the buffer: skip it and free the space
+            pos += HEADER_SIZE + h.length;
+            tail_.store(pos, std::memory_order_release);
+        }
+    }
+
+    // Free the record returned by the last non-empty peek()
+    ULTRA_ALWAYS_INLINE void release() noexcept {
+        const uint64_t pos = tail_.load(std::memory_order_relaxed);
+        tail_.store(pos + footprint(peek_len_), std::memory_order_release);
+    }
+
+    // Copy-out convenience; returns payload length, 0 if empty. Records
+    // longer than max_len are truncated to max_len (and still consumed).
+    ULTRA_ALWAYS_INLINE size_t pop(void* out, size_t max_len) noexcept {
+        auto rec = peek();
+        if (rec.empty()) return 0;
+        const size_t n = rec.size() < max_len ? rec.size() : max_len;
+        std::memcpy(out, rec.data(), n);
+        release();
+        return n;
+    }
+
+    ULTRA_ALWAYS_INLINE bool empty() const noexcept {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    // Ring bytes in use (headers, alignment and padding included)
+    ULTRA_ALWAYS_INLINE size_t used_bytes() const noexcept {
+        return static_cast<size_t>(head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire));
+    }
+
+private:
+    static constexpr uint64_t MASK = CapacityBytes - 1;
+    static constexpr uint32_t KIND_DATA = 0;
+    static constexpr uint32_t KIND_PADDING = 1;
+
+    struct Header {
+        uint32_t length; ///< Payload bytes (padding: bytes skipped after the header).
+        uint32_t kind; ///< KIND_DATA or KIND_PADDING.
+    };
+    static_assert(sizeof(Header) == HEADER_SIZE);
+
+    ULTRA_ALWAYS_INLINE void write_header(uint64_t pos, uint32_t length, uint32_t kind) noexcept {
+        const Header h{length, kind};
+        std::memcpy(&buffer_[pos & MASK], &h, sizeof(h));
+    }
+
+    alignas(64) std::array<uint8_t, CapacityBytes> buffer_; ///< Record storage.
+
+    // Producer-owned
+    ULTRA_CACHE_ALIGNED std::atomic<uint64_t> head_{0}; ///< Bytes published.
+    uint64_t cached_tail_{0}; ///< Producer's view of tail_.
+    uint64_t reserved_pos_{0}; ///< Header position of the open reservation.
+    size_t reserved_len_{0}; ///< Payload bytes reserved.
+
+    // Consumer-owned
+    ULTRA_CACHE_ALIGNED std::atomic<uint64_t> tail_{0}; ///< Bytes consumed.
+    uint64_t cached_head_{0}; ///< Consumer's view of head_.
+    size_t peek_len_{0}; ///< Payload length of the peeked record.
+};
+
+} // namespace ultra
@@ -0,0 +1,100 @@
+#pragma once
+#include "../compiler.hpp"
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace ultra {
+
+/**
+ * Chase-Lev work-stealing deque (fixed capacity)
+ * - Owner thread push()es and pop()s at the bottom (LIFO, cache-warm)
+ * - Any thread steal()s from the top (FIFO, oldest = usually largest task)
+ * - Memory orderings follow Le, Pop, Cohen, Zappa Nardelli, "Correct and
+ *   Efficient Work-Stealing for Weak Memory Models" (PPoPP'13)
+ *
+ * The ring does not grow: push() returns false when full and the caller
+ * runs the task inline instead, which bounds memory and keeps the
+ * buffer-swap/reclamation problem out of the picture.
+ */
+template<typename T, size_t Capacity>
+requires (std::is_trivially_copyable_v<T> && std::atomic<T>::is_always_lock_free)
+class ChaseLevDeque {
+public:
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be power of 2");
+
+    ChaseLevDeque() noexcept = default;
+    ChaseLevDeque(const ChaseLevDeque&) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+    // Owner only: push at the bottom (returns false if full)
+    ULTRA_ALWAYS_INLINE bool push(T item) noexcept {
+        const int64_t b = bottom_.load(std::memory_order_relaxed);
+        const int64_t t = top_.load(std::memory_order_acquire);
+        if (ULTRA_UNLIKELY(b - t >= static_cast<int64_t>(Capacity))) {
+            return false;
+        }
+        buffer_[b & MASK].store(item, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Owner only: pop the most recently pushed item (returns false if empty
+    // or the last item was stolen concurrently)
+    ULTRA_ALWAYS_INLINE bool pop(T& item) noexcept {
+        const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed); // Was empty
+            return false;
+        }
+
+        item = buffer_[b & MASK].load(std::memory_order_relaxed);
+        if (t == b) {
+            // Last item: race thieves for it
+            const bool won = top_.compare_exchange_strong(t, t + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Any thread: take the oldest item (returns false if empty or lost a race)
+    ULTRA_ALWAYS_INLINE bool steal(T& item) noexcept {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = bottom_.load(std::memory_order_acquire);
+
+        if (t >= b) return false;
+
+        item = buffer_[t & MASK].load(std::memory_order_relaxed);
+        return top_.compare_exchange_strong(t, t + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    // Approximate (exact only when called by the owner with no thieves)
+    size_t size() const noexcept {
+        const int64_t b = bottom_.load(std::memory_order_relaxed);
+        const int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    static constexpr size_t capacity() noexcept { return Capacity; }
+
+private:
+    static constexpr int64_t MASK = static_cast<int64_t>(Capacity) - 1;
+
+    ULTRA_CACHE_ALIGNED std::atomic<int64_t> top_{0}; ///< Next item to steal (thieves).
+    ULTRA_CACHE_ALIGNED std::atomic<int64_t> bottom_{0}; ///< Next free slot (owner).
+    ULTRA_CACHE_ALIGNED std::array<std::atomic<T>, Capacity> buffer_{}; ///< Ring storage.
+};
+
+} // namespace ultra
@@ -0,0 +1,112 @@
+#pragma once
+#include "../compiler.hpp"
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace ultra {
+
+/**
+ * Bounded Multi-Producer Single-Consumer lock-free queue
+ * - Per-slot sequence numbers (Vyukov bounded queue), no allocation
+ * - Producers claim a slot with one CAS on head_; no locks, no retries on
+ *   a shared "publish" word, so a stalled producer blocks only its own slot
+ * - Single consumer reads without any RMW
+ */
+template<typename T, size_t Capacity>
+requires std::is_trivially_copyable_v<T>
+class MPSCQueue {
+public:
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be power of 2");
+
+    MPSCQueue() noexcept {
+        for (size_t i = 0; i < Capacity; ++i) {
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    // Producer (any thread): push (returns false if full)
+    ULTRA_ALWAYS_INLINE bool push(const T& item) noexcept {
+        uint64_t pos = head_.load(std::memory_order_relaxed);
+        Slot* slot;
+
+        while (true) {
+            slot = &slots_[pos & MASK];
+            const uint64_t seq = slot->seq.load(std::memory_order_acquire);
+            const int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+
+            if (diff == 0) {
+                // Slot free for this lap: try to claim it
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false; // Queue full (consumer has not freed this slot yet)
+            } else {
+                pos = head_.load(std::memory_order_relaxed); // Another producer won
+            }
+        }
+
+        slot->data = item;
+        slot->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: pop (returns false if empty or the next slot is still being written)
+    ULTRA_ALWAYS_INLINE bool pop(T& item) noexcept {
+        Slot& slot = slots_[tail_ & MASK];
+        if (slot.seq.load(std::memory_order_acquire) != tail_ + 1) {
+            return false;
+        }
+
+        item = slot.data;
+        slot.seq.store(tail_ + Capacity, std::memory_order_release);
+        ++tail_;
+        return true;
+    }
+
+    // Consumer: view the next item in place (nullptr if none ready)
+    ULTRA_ALWAYS_INLINE const T* peek() noexcept {
+        Slot& slot = slots_[tail_ & MASK];
+        if (slot.seq.load(std::memory_order_acquire) != tail_ + 1) return nullptr;
+        return &slot.data;
+    }
+
+    // Consumer: free the slot returned by peek()
+    ULTRA_ALWAYS_INLINE void release() noexcept {
+        slots_[tail_ & MASK].seq.store(tail_ + Capacity, std::memory_order_release);
+        ++tail_;
+    }
+
+    // Consumer: drain up to max_items in one poll
+    ULTRA_ALWAYS_INLINE size_t pop_n(T* out, size_t max_items) noexcept {
+        size_t n = 0;
+        while (n < max_items && pop(out[n])) ++n;
+        return n;
+    }
+
+    // Approximate (racy by nature with several producers)
+    size_t size() const noexcept {
+        const uint64_t head = head_.load(std::memory_order_acquire);
+        return head > tail_ ? static_cast<size_t>(head - tail_) : 0;
+    }
+
+    static constexpr size_t capacity() noexcept { return Capacity; }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    struct Slot {
+        std::atomic<uint64_t> seq; ///< pos: free for lap; pos + 1: holds data.
+        T data; ///< Payload.
+    };
+
+    std::array<Slot, Capacity> slots_;
+
+    ULTRA_CACHE_ALIGNED std::atomic<uint64_t> head_{0}; ///< Next position to claim (producers).
+    ULTRA_CACHE_ALIGNED uint64_t tail_{0}; ///< Next position to read (consumer only).
+};
+
+} // namespace ultra
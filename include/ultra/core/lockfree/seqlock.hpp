@@ -0,0 +1,127 @@
+#pragma once
+#include "../compiler.hpp"
+#include "../spin_wait.hpp"
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace ultra {
+
+/**
+ * Sequence lock: one writer, any number of readers, latest value wins
+ * For POD state published across cores (FPGA/strategy parameters, risk
+ * limits, BBO snapshots, metrics).
+ *
+ * - Writer never waits: cost is two sequence stores plus one store per
+ *   8-byte word of T, independent of how many readers there are
+ * - Readers only load; they never write a shared cache line. A read that
+ *   overlaps a write is detected via the sequence number and retried
+ * - The payload is held as std::atomic<uint64_t> words (release stores,
+ *   acquire loads, no fences), so a concurrent read/write is not a data
+ *   race in the C++ memory model and TSAN can check it, while still
+ *   compiling to plain moves on x86-64
+ */
+template<typename T>
+requires (std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>)
+class ULTRA_CACHE_ALIGNED SeqLock {
+public:
+    SeqLock() noexcept : SeqLock(T{}) {}
+
+    explicit SeqLock(const T& initial) noexcept {
+        write_words(initial);
+    }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    // --- Writer (single thread) ---
+
+    ULTRA_ALWAYS_INLINE void store(const T& value) noexcept {
+        const uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed); // Odd: write in progress
+        write_words(value); // Release stores: cannot move above the odd seq store
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    // Read-modify-write from the writer thread (no retry needed: the
+    // writer is the only thread that changes the payload)
+    template<typename F>
+    ULTRA_ALWAYS_INLINE void update(F&& fn) noexcept(noexcept(fn(std::declval<T&>()))) {
+        T value = read_words();
+        fn(value);
+        store(value);
+    }
+
+    // --- Readers (any thread) ---
+
+    // Single attempt: false if a write was in progress or overlapped
+    ULTRA_ALWAYS_INLINE bool try_load(T& out) const noexcept {
+        const uint64_t seq = read_begin();
+        if (ULTRA_UNLIKELY(seq & 1)) return false;
+        out = read_words();
+        return !read_retry(seq);
+    }
+
+    // Retry until a consistent snapshot is read
+    ULTRA_ALWAYS_INLINE T load() const noexcept {
+        T out;
+        while (ULTRA_UNLIKELY(!try_load(out))) SpinWait::spin();
+        return out;
+    }
+
+    // Consistent snapshot plus the number of stores it reflects
+    ULTRA_ALWAYS_INLINE uint64_t load(T& out) const noexcept {
+        while (true) {
+            const uint64_t seq = read_begin();
+            if (ULTRA_LIKELY(!(seq & 1))) {
+                out = read_words();
+                if (ULTRA_LIKELY(!read_retry(seq))) return seq / 2;
+            }
+            SpinWait::spin();
+        }
+    }
+
+    // Explicit retry-loop API for readers that only need part of T:
+    //   uint64_t s; T v;
+    //   do { s = lock.read_begin(); v = lock.read_unchecked(); } while (lock.read_retry(s));
+    ULTRA_ALWAYS_INLINE uint64_t read_begin() const noexcept {
+        return seq_.load(std::memory_order_acquire);
+    }
+
+    // Possibly torn copy; only meaningful if read_retry() returns false
+    ULTRA_ALWAYS_INLINE T read_unchecked() const noexcept {
+        return read_words();
+    }
+
+    ULTRA_ALWAYS_INLINE bool read_retry(uint64_t seq) const noexcept {
+        // Payload loads were acquire, so this re-check cannot move above them
+        return (seq & 1) || seq_.load(std::memory_order_relaxed) != seq;
+    }
+
+    // Number of completed stores
+    uint64_t version() const noexcept { return seq_.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    ULTRA_ALWAYS_INLINE void write_words(const T& value) noexcept {
+        uint64_t tmp[WORDS] = {};
+        std::memcpy(tmp, &value, sizeof(T));
+        for (size_t i = 0; i < WORDS; ++i) data_[i].store(tmp[i], std::memory_order_release);
+    }
+
+    ULTRA_ALWAYS_INLINE T read_words() const noexcept {
+        uint64_t tmp[WORDS];
+        for (size_t i = 0; i < WORDS; ++i) tmp[i] = data_[i].load(std::memory_order_acquire);
+        T out;
+        std::memcpy(&out, tmp, sizeof(T));
+        return out;
+    }
+
+    std::atomic<uint64_t> seq_{0}; ///< Even: stable; odd: write in progress.
+    std::array<std::atomic<uint64_t>, WORDS> data_; ///< Payload (same line as seq_ for small T).
+};
+
+} // namespace ultra
@@ -0,0 +1,314 @@
+#pragma once
+#include "../compiler.hpp"
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cerrno>
+#include <string>
+#include <type_traits>
+#include <time.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace ultra {
+
+/**
+ * Single-Producer Single-Consumer ring in a named POSIX shared-memory segment
+ * Same wait-free push/pop (and zero-copy reserve/commit, peek/release) as
+ * SPSCQueue, but the producer and consumer may be different processes, e.g.
+ * feed handler -> strategy -> order gateway each pinned in its own process.
+ *
+ * - The producer create()s the segment ("/name" under /dev/shm), the consumer
+ *   attach()es to it. The control block is published last (magic word with
+ *   release), so an attaching peer never sees a half-initialised ring.
+ * - Only head/tail and the ring live in shared memory; each side's cached
+ *   copy of the opposite index is process-local, as in SPSCQueue.
+ * - Liveness: each side stores its pid and a CLOCK_MONOTONIC heartbeat word.
+ *   Call heartbeat() from the poll loop (it is one relaxed store) and
+ *   peer_alive() off the hot path to detect a crashed/hung peer.
+ */
+template<typename T, size_t Capacity>
+requires std::is_trivially_copyable_v<T>
+class ShmSPSCQueue {
+public:
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be power of 2");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Needs address-free 64-bit atomics");
+
+    enum class Role : uint8_t { NONE, PRODUCER, CONSUMER };
+
+    ShmSPSCQueue() = default;
+    ShmSPSCQueue(const ShmSPSCQueue&) = delete;
+    ShmSPSCQueue& operator=(const ShmSPSCQueue&) = delete;
+
+    ~ShmSPSCQueue() { close(); }
+
+    /**
+     * Create (or re-create) the segment and attach as producer.
+     * An existing segment with the same name is replaced.
+     */
+    bool create(const std::string& name) {
+        close();
+        name_ = shm_name(name);
+        shm_unlink(name_.c_str()); // Stale segment from a previous run
+
+        int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) {
+            perror("shm_open");
+            return false;
+        }
+        if (ftruncate(fd, sizeof(Shared)) < 0) {
+            perror("ftruncate");
+            ::close(fd);
+            shm_unlink(name_.c_str());
+            return false;
+        }
+        if (!map(fd)) {
+            shm_unlink(name_.c_str());
+            return false;
+        }
+
+        // Fresh pages are zero; set the non-zero fields, then publish magic
+        shared_->capacity = Capacity;
+        shared_->element_size = sizeof(T);
+        shared_->producer.pid.store(getpid(), std::memory_order_relaxed);
+        shared_->producer.heartbeat_ns.store(monotonic_ns(), std::memory_order_relaxed);
+        shared_->magic.store(MAGIC, std::memory_order_release);
+
+        role_ = Role::PRODUCER;
+        owner_ = true;
+        return true;
+    }
+
+    /**
+     * Attach to an existing segment as consumer. Waits up to timeout_ns for
+     * the producer to create and publish it. Fails if the segment was built
+     * for a different T or Capacity.
+     */
+    bool attach(const std::string& name, uint64_t timeout_ns = 1'000'000'000ULL) {
+        close();
+        name_ = shm_name(name);
+        const uint64_t deadline = monotonic_ns() + timeout_ns;
+
+        int fd;
+        while ((fd = shm_open(name_.c_str(), O_RDWR, 0600)) < 0) {
+            if (errno != ENOENT || monotonic_ns() > deadline) {
+                perror("shm_open");
+                return false;
+            }
+            usleep(1000);
+        }
+
+        // Segment may exist before the producer has sized it
+        struct stat st;
+        while (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) < sizeof(Shared)) {
+            if (monotonic_ns() > deadline) {
+                fprintf(stderr, "ShmSPSCQueue: %s was never sized by the producer\n", name_.c_str());
+                ::close(fd);
+                return false;
+            }
+            usleep(1000);
+        }
+        if (!map(fd)) return false;
+
+        while (shared_->magic.load(std::memory_order_acquire) != MAGIC) {
+            if (monotonic_ns() > deadline) {
+                fprintf(stderr, "ShmSPSCQueue: %s was never initialised\n", name_.c_str());
+                unmap();
+                return false;
+            }
+            usleep(1000);
+        }
+        if (shared_->capacity != Capacity || shared_->element_size != sizeof(T)) {
+            fprintf(stderr, "ShmSPSCQueue: %s layout mismatch (capacity %lu, element %lu bytes)\n",
+                    name_.c_str(), static_cast<unsigned long>(shared_->capacity),
+                    static_cast<unsigned long>(shared_->element_size));
+            unmap();
+            return false;
+        }
+
+        shared_->consumer.pid.store(getpid(), std::memory_order_relaxed);
+        shared_->consumer.heartbeat_ns.store(monotonic_ns(), std::memory_order_release);
+
+        cached_head_ = shared_->head.load(std::memory_order_acquire);
+        role_ = Role::CONSUMER;
+        return true;
+    }
+
+    // Unmap; the creator also removes the name (peers keep their mapping)
+    void close() noexcept {
+        if (!shared_) return;
+        if (role_ != Role::NONE) {
+            peer_of_self().pid.store(0, std::memory_order_release);
+        }
+        unmap();
+        if (owner_) shm_unlink(name_.c_str());
+        owner_ = false;
+        role_ = Role::NONE;
+        cached_tail_ = 0;
+        cached_head_ = 0;
+    }
+
+    bool is_open() const noexcept { return shared_ != nullptr; }
+    Role role() const noexcept { return role_; }
+    const std::string& name() const noexcept { return name_; }
+
+    // Producer: push (returns false if full)
+    ULTRA_ALWAYS_INLINE bool push(const T& item) noexcept {
+        T* slot = try_reserve();
+        if (ULTRA_UNLIKELY(!slot)) return false;
+        *slot = item;
+        commit();
+        return true;
+    }
+
+    // Consumer: pop (returns false if empty)
+    ULTRA_ALWAYS_INLINE bool pop(T& item) noexcept {
+        const T* slot = peek();
+        if (ULTRA_UNLIKELY(!slot)) return false;
+        item = *slot;
+        release();
+        return true;
+    }
+
+    // Producer: slot to build the next item in place (nullptr if full)
+    ULTRA_ALWAYS_INLINE T* try_reserve() noexcept {
+        const size_t head = shared_->head.load(std::memory_order_relaxed);
+        const size_t next = (head + 1) & MASK;
+
+        if (ULTRA_UNLIKELY(next == cached_tail_)) {
+            cached_tail_ = shared_->tail.load(std::memory_order_acquire);
+            if (next == cached_tail_) {
+                return nullptr; // Queue full
+            }
+        }
+        return &shared_->buffer[head];
+    }
+
+    // Producer: publish the slot returned by the last try_reserve()
+    ULTRA_ALWAYS_INLINE void commit() noexcept {
+        const size_t head = shared_->head.load(std::memory_order_relaxed);
+        shared_->head.store((head + 1) & MASK, std::memory_order_release);
+    }
+
+    // Consumer: view the oldest item in place (nullptr if empty)
+    ULTRA_ALWAYS_INLINE const T* peek() noexcept {
+        const size_t tail = shared_->tail.load(std::memory_order_relaxed);
+
+        if (ULTRA_UNLIKELY(tail == cached_head_)) {
+            cached_head_ = shared_->head.load(std::memory_order_acquire);
+            if (tail == cached_head_) {
+                return nullptr; // Queue empty
+            }
+        }
+        return &shared_->buffer[tail];
+    }
+
+    // Consumer: hand back the slot returned by the last peek()
+    ULTRA_ALWAYS_INLINE void release() noexcept {
+        const size_t tail = shared_->tail.load(std::memory_order_relaxed);
+        shared_->tail.store((tail + 1) & MASK, std::memory_order_release);
+    }
+
+    ULTRA_ALWAYS_INLINE size_t size() const noexcept {
+        return (shared_->head.load(std::memory_order_acquire) -
+                shared_->tail.load(std::memory_order_acquire)) & MASK;
+    }
+
+    static constexpr size_t capacity() noexcept { return Capacity - 1; }
+
+    // --- Liveness ---
+    // Stamp this side's heartbeat word (one clock read + relaxed store).
+    ULTRA_ALWAYS_INLINE void heartbeat() noexcept {
+        peer_of_self().heartbeat_ns.store(monotonic_ns(), std::memory_order_relaxed);
+    }
+
+    // True if the peer has attached, its process still exists and it has
+    // stamped its heartbeat within the last timeout_ns.
+    bool peer_alive(uint64_t timeout_ns) const noexcept {
+        const Peer& p = other_peer();
+        const pid_t pid = p.pid.load(std::memory_order_acquire);
+        if (pid == 0) return false; // Never attached, or closed cleanly
+        if (kill(pid, 0) < 0 && errno == ESRCH) return false; // Crashed
+        const uint64_t hb = p.heartbeat_ns.load(std::memory_order_relaxed); // Before the clock read
+        return heartbeat_fresh(hb, monotonic_ns(), timeout_ns);
+    }
+
+    // Heartbeat hb is within timeout_ns of now. A stamp at or after now
+    // (the peer beat after the clock was read) counts as fresh.
+    static constexpr bool heartbeat_fresh(uint64_t hb, uint64_t now, uint64_t timeout_ns) noexcept {
+        return hb >= now || now - hb <= timeout_ns;
+    }
+
+    // Peer's pid (0 if not attached)
+    pid_t peer_pid() const noexcept { return other_peer().pid.load(std::memory_order_acquire); }
+
+    static uint64_t monotonic_ns() noexcept {
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000ULL + static_cast<uint64_t>(ts.tv_nsec);
+    }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+    static constexpr uint64_t MAGIC = 0x5553504D53485131ULL; // "USPMSHQ1"
+
+    struct ULTRA_CACHE_ALIGNED Peer {
+        std::atomic<int32_t> pid; ///< Attached process (0 = none).
+        std::atomic<uint64_t> heartbeat_ns; ///< Last heartbeat (CLOCK_MONOTONIC).
+    };
+
+    // Everything in here is shared between processes
+    struct Shared {
+        std::atomic<uint64_t> magic; ///< MAGIC once the producer has initialised the block.
+        uint64_t capacity; ///< Ring size the producer was built with.
+        uint64_t element_size; ///< sizeof(T) the producer was built with.
+        Peer producer; ///< Producer liveness.
+        Peer consumer; ///< Consumer liveness.
+        ULTRA_CACHE_ALIGNED std::atomic<size_t> head; ///< Written by producer.
+        ULTRA_CACHE_ALIGNED std::atomic<size_t> tail; ///< Written by consumer.
+        ULTRA_CACHE_ALIGNED T buffer[Capacity]; ///< Ring storage.
+    };
+    static_assert(std::is_trivially_destructible_v<Shared>);
+
+    static std::string shm_name(const std::string& name) {
+        return name.empty() || name[0] != '/' ? "/" + name : name;
+    }
+
+    bool map(int fd) {
+        void* p = mmap(nullptr, sizeof(Shared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+        ::close(fd); // Mapping keeps the segment alive
+        if (p == MAP_FAILED) {
+            perror("mmap");
+            return false;
+        }
+        shared_ = static_cast<Shared*>(p);
+        return true;
+    }
+
+    void unmap() noexcept {
+        munmap(shared_, sizeof(Shared));
+        shared_ = nullptr;
+    }
+
+    Peer& peer_of_self() noexcept {
+        return role_ == Role::PRODUCER ? shared_->producer : shared_->consumer;
+    }
+    const Peer& other_peer() const noexcept {
+        return role_ == Role::PRODUCER ? shared_->consumer : shared_->producer;
+    }
+
+    Shared* shared_{nullptr}; ///< Mapped control block + ring.
+    std::string name_; ///< Segment name ("/...").
+    Role role_{Role::NONE}; ///< Side this process plays.
+    bool owner_{false}; ///< Creator unlinks the name on close().
+
+    // Process-local caches of the opposite index
+    ULTRA_CACHE_ALIGNED size_t cached_tail_{0}; ///< Producer's view of tail.
+    ULTRA_CACHE_ALIGNED size_t cached_head_{0}; ///< Consumer's view of head.
+};
+
+} // namespace ultra
@@ -2,6 +2,7 @@
 #include "../compiler.hpp"
 #include <atomic>
 #include <array>
+#include <algorithm>
 #include <type_traits>
 
 namespace ultra {
@@ -10,58 +11,163 @@ namespace ultra {
  * Single-Producer Single-Consumer lock-free ring buffer
  * Optimized for market data pipelines
  * False-sharing prevention with cache line padding
+ *
+ * Each side keeps a private copy of the other side's index and only reloads
+ * the shared atomic when the ring looks full (producer) or empty (consumer),
+ * so in steady state head_/tail_ lines are not bounced once per message.
  */
 template<typename T, size_t Capacity>
 requires std::is_trivially_copyable_v<T>
 class SPSCQueue {
 public:
     static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be power of 2");
-    
-    SPSCQueue() noexcept : head_(0), tail_(0) {}
-    
+
+    SPSCQueue() noexcept : head_(0), cached_tail_(0), tail_(0), cached_head_(0) {}
+
     // Producer: push (returns false if full)
     ULTRA_ALWAYS_INLINE bool push(const T& item) noexcept {
         const size_t head = head_.load(std::memory_order_relaxed);
         const size_t next = (head + 1) & MASK;
-        
-        if (ULTRA_UNLIKELY(next == tail_.load(std::memory_order_acquire))) {
-            return false; // Queue full
+
+        if (ULTRA_UNLIKELY(next == cached_tail_)) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (next == cached_tail_) {
+                return false; // Queue full
+            }
         }
-        
+
         buffer_[head] = item;
         head_.store(next, std::memory_order_release);
         return true;
     }
-    
+
     // Consumer: pop (returns false if empty)
     ULTRA_ALWAYS_INLINE bool pop(T& item) noexcept {
         const size_t tail = tail_.load(std::memory_order_relaxed);
-        
-        if (ULTRA_UNLIKELY(tail == head_.load(std::memory_order_acquire))) {
-            return false; // Queue empty
+
+        if (ULTRA_UNLIKELY(tail == cached_head_)) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail == cached_head_) {
+                return false; // Queue empty
+            }
         }
-        
+
         item = buffer_[tail];
         tail_.store((tail + 1) & MASK, std::memory_order_release);
         return true;
     }
-    
+
+    // Producer: push up to n items with a single release store.
+    // Returns the number pushed (0..n); never blocks.
+    ULTRA_ALWAYS_INLINE size_t push_n(const T* items, size_t n) noexcept {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        size_t free = (cached_tail_ - head - 1) & MASK;
+
+        if (ULTRA_UNLIKELY(free < n)) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            free = (cached_tail_ - head - 1) & MASK;
+        }
+
+        const size_t count = std::min(n, free);
+        if (ULTRA_UNLIKELY(count == 0)) return 0;
+
+        // Copy in at most two runs (before and after the wrap point)
+        const size_t first = std::min(count, Capacity - head);
+        std::copy_n(items, first, &buffer_[head]);
+        std::copy_n(items + first, count - first, &buffer_[0]);
+
+        head_.store((head + count) & MASK, std::memory_order_release);
+        return count;
+    }
+
+    // Consumer: pop up to max_items into out with a single release store.
+    // Returns the number popped (0..max_items).
+    ULTRA_ALWAYS_INLINE size_t pop_n(T* out, size_t max_items) noexcept {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t avail = (cached_head_ - tail) & MASK;
+
+        if (ULTRA_UNLIKELY(avail < max_items)) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            avail = (cached_head_ - tail) & MASK;
+        }
+
+        const size_t count = std::min(max_items, avail);
+        if (count == 0) return 0;
+
+        const size_t first = std::min(count, Capacity - tail);
+        std::copy_n(&buffer_[tail], first, out);
+        std::copy_n(&buffer_[0], count - first, out + first);
+
+        tail_.store((tail + count) & MASK, std::memory_order_release);
+        return count;
+    }
+
+    // --- Zero-copy API ---
+    // Producer: build the item directly in the ring slot, then commit().
+    // Returns nullptr if full. Calling try_reserve() again before commit()
+    // returns the same slot.
+    ULTRA_ALWAYS_INLINE T* try_reserve() noexcept {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        const size_t next = (head + 1) & MASK;
+
+        if (ULTRA_UNLIKELY(next == cached_tail_)) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (next == cached_tail_) {
+                return nullptr; // Queue full
+            }
+        }
+        return &buffer_[head];
+    }
+
+    // Producer: publish the slot returned by the last successful try_reserve()
+    ULTRA_ALWAYS_INLINE void commit() noexcept {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        head_.store((head + 1) & MASK, std::memory_order_release);
+    }
+
+    // Consumer: view the oldest item in place (nullptr if empty). The pointer
+    // stays valid until release().
+    ULTRA_ALWAYS_INLINE const T* peek() noexcept {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+
+        if (ULTRA_UNLIKELY(tail == cached_head_)) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail == cached_head_) {
+                return nullptr; // Queue empty
+            }
+        }
+        return &buffer_[tail];
+    }
+
+    // Consumer: hand the slot returned by the last successful peek() back
+    ULTRA_ALWAYS_INLINE void release() noexcept {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        tail_.store((tail + 1) & MASK, std::memory_order_release);
+    }
+
     ULTRA_ALWAYS_INLINE bool empty() const noexcept {
         return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
     }
-    
+
     ULTRA_ALWAYS_INLINE size_t size() const noexcept {
         return (head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire)) & MASK;
     }
-    
+
+    // Usable slots (one slot is kept empty to tell full from empty)
+    static constexpr size_t capacity() noexcept { return Capacity - 1; }
+
 private:
     static constexpr size_t MASK = Capacity - 1;
-    
+
     std::array<T, Capacity> buffer_;
-    
-    // Cache line padding to prevent false sharing
+
+    // Cache line padding to prevent false sharing.
+    // Producer-owned: head_ (shared) and its private view of tail_.
     ULTRA_CACHE_ALIGNED std::atomic<size_t> head_;
+    ULTRA_CACHE_ALIGNED size_t cached_tail_;
+    // Consumer-owned: tail_ (shared) and its private view of head_.
     ULTRA_CACHE_ALIGNED std::atomic<size_t> tail_;
+    ULTRA_CACHE_ALIGNED size_t cached_head_;
 };
 
 } // namespace ultra
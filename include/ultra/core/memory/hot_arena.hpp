@@ -0,0 +1,102 @@
+#pragma once
+#include "huge_page_allocator.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace ultra {
+
+/**
+ * Startup hot-data arena
+ * One huge-page mapping, bound/pre-faulted/locked per HugePageOptions, from
+ * which the engine bump-allocates every latency-critical structure (queues,
+ * decoder tables, strategy and risk state) before market open.
+ *
+ * - Contiguous: the whole hot set is covered by a handful of TLB entries
+ * - Every placement is at least cache-line aligned; page alignment on
+ *   request (e.g. for large rings, so one ring never shares a page edge)
+ * - Startup only: create()/allocate() are not thread-safe and never free;
+ *   objects are destroyed in reverse order when the arena is destroyed
+ * - print_layout() reports name, offset, size and page span per placement
+ */
+class HotArena {
+public:
+    static constexpr size_t CACHE_LINE = 64;
+
+    /**
+     * @brief Maps `capacity` bytes (rounded to the page size) under options.
+     * @throws std::bad_alloc if the region cannot be mapped.
+     */
+    HotArena(size_t capacity, const HugePageOptions& options);
+    ~HotArena();
+
+    HotArena(const HotArena&) = delete;
+    HotArena& operator=(const HotArena&) = delete;
+
+    /**
+     * @brief Raw placement. align is raised to at least CACHE_LINE.
+     * @throws std::bad_alloc if the arena is exhausted (size it at startup).
+     */
+    void* allocate(const char* name, size_t bytes, size_t align = CACHE_LINE);
+
+    // Constructs a T; destroyed when the arena is
+    template<typename T, typename... Args>
+    T* create(const char* name, Args&&... args) {
+        return construct<T>(allocate(name, sizeof(T), alignof(T)), std::forward<Args>(args)...);
+    }
+
+    // Same, starting on a page boundary of the mapping's page size
+    template<typename T, typename... Args>
+    T* create_page_aligned(const char* name, Args&&... args) {
+        return construct<T>(allocate(name, sizeof(T), page_bytes(mapping_.page_size)), std::forward<Args>(args)...);
+    }
+
+    // Bytes a set of placements needs, with worst-case alignment slop
+    static constexpr size_t footprint(size_t bytes, size_t align = CACHE_LINE) noexcept {
+        return bytes + (align > CACHE_LINE ? align : CACHE_LINE);
+    }
+
+    bool contains(const void* p) const noexcept {
+        const auto* b = static_cast<const uint8_t*>(p);
+        return b >= base() && b < base() + mapping_.bytes;
+    }
+
+    size_t used() const noexcept { return used_; }
+    size_t capacity() const noexcept { return mapping_.bytes; }
+    const HugePageMapping& mapping() const noexcept { return mapping_; }
+
+    void print_layout(std::ostream& os) const;
+
+private:
+    struct Placement {
+        const char* name; ///< Label for the layout report.
+        size_t offset; ///< From the start of the mapping.
+        size_t bytes; ///< Requested size.
+        size_t align; ///< Effective alignment.
+    };
+
+    struct Destructor {
+        void* object; ///< Constructed object.
+        void (*destroy)(void*); ///< Calls ~T().
+    };
+
+    template<typename T, typename... Args>
+    T* construct(void* p, Args&&... args) {
+        T* obj = new (p) T(std::forward<Args>(args)...);
+        destructors_.push_back({obj, [](void* o) { static_cast<T*>(o)->~T(); }});
+        return obj;
+    }
+
+    uint8_t* base() const noexcept { return static_cast<uint8_t*>(mapping_.addr); }
+
+    HugePageMapping mapping_; ///< Backing region.
+    HugePageOptions options_; ///< As requested (for the report).
+    size_t used_{0}; ///< Bump pointer offset.
+    std::vector<Placement> placements_; ///< In allocation order.
+    std::vector<Destructor> destructors_; ///< Run in reverse on destruction.
+};
+
+} // namespace ultra
@@ -1,13 +1,75 @@
 #pragma once
 #include "../compiler.hpp"
 #include <cstddef>
-#include <sys/mman.h>
-#include <iostream>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
 
 namespace ultra {
 
+enum class PageSize : uint8_t {
+    SMALL_4K,
+    HUGE_2MB,
+    HUGE_1GB
+};
+
+const char* to_string(PageSize size) noexcept;
+size_t page_bytes(PageSize size) noexcept;
+
+/**
+ * Placement and residency policy for a huge-page mapping.
+ * Mirrors [hardware] in engine.toml (numa_node, huge_page_size_mb).
+ */
+struct HugePageOptions {
+    PageSize page_size{PageSize::HUGE_2MB}; ///< Requested page size.
+    int numa_node{-1}; ///< mbind(MPOL_BIND) to this node; -1 = first-touch.
+    bool populate{false}; ///< Fault every page in at map time.
+    bool lock{false}; ///< mlock the range (implies populate).
+    bool allow_fallback{true}; ///< 1GB -> 2MB -> 4K if the pool is empty; else fail.
+};
+
 /**
- * Allocator using huge pages (2MB) for reduced TLB misses
+ * Result of HugePages::map: what was actually obtained.
+ */
+struct HugePageMapping {
+    void* addr{nullptr}; ///< Start of the mapping (nullptr on failure).
+    size_t bytes{0}; ///< Mapped length (multiple of the requested page size).
+    PageSize page_size{PageSize::SMALL_4K}; ///< Page size the kernel gave us.
+    bool numa_bound{false}; ///< mbind succeeded.
+    bool locked{false}; ///< mlock succeeded.
+};
+
+/**
+ * Huge-page mmap with optional NUMA binding, pre-faulting and mlock
+ * (Implementation in src/core/memory/huge_page_allocator.cpp)
+ */
+class HugePages {
+public:
+    /**
+     * @brief Maps at least `bytes` with the requested policy. Order: mmap
+     *        (MAP_HUGETLB + size flag, falling back to smaller pages if
+     *        allowed), mbind to the node before any page is touched,
+     *        then populate/mlock. Failures of mbind/mlock are reported on
+     *        stderr and in the returned flags, not fatal.
+     * @return Mapping; addr == nullptr if no page size could be mapped.
+     */
+    static HugePageMapping map(size_t bytes, const HugePageOptions& options) noexcept;
+
+    static void unmap(const HugePageMapping& mapping) noexcept;
+
+    // Mapping length map() uses for `bytes` under `options`
+    static size_t mapped_length(size_t bytes, const HugePageOptions& options) noexcept;
+
+    // NUMA node of a CPU from sysfs (0 if unknown / no NUMA)
+    static int node_of_cpu(int cpu) noexcept;
+
+    // Page size backing an address, from /proc/self/smaps (KernelPageSize)
+    static PageSize page_size_of(const void* addr) noexcept;
+};
+
+/**
+ * Allocator using huge pages (2MB or 1GB) for reduced TLB misses
  * Critical for order book and market data buffers
  * (Note: Implementation is in the header as it's a template)
  */
@@ -17,76 +79,89 @@ public:
     using value_type = T;
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
-    
+
     constexpr static size_type HUGE_PAGE_SIZE = 2 * 1024 * 1024; // 2MB
-    
-    /**
-     * @brief Auto-generated description for HugePageAllocator<T>.
-     */
+
     HugePageAllocator() noexcept = default;
-    
+
+    explicit HugePageAllocator(const HugePageOptions& options) noexcept : options_(options) {}
+
     template<typename U>
+    HugePageAllocator(const HugePageAllocator<U>& other) noexcept : options_(other.options()) {}
+
     /**
-     * @brief Auto-generated description for HugePageAllocator<T>.
+     * @brief Maps n objects' worth of memory under options().
+     * @throws std::bad_alloc if nothing could be mapped.
      */
-    HugePageAllocator(const HugePageAllocator<U>&) noexcept {}
-    
-       /**
-        * @brief Auto-generated description for allocate.
-        * @param n Parameter description.
-        * @return T * value.
-        */
     T* allocate(size_type n) {
         if (n > std::numeric_limits<size_type>::max() / sizeof(T)) {
             throw std::bad_alloc();
         }
-        
-        size_type num_bytes = n * sizeof(T);
-        // Align allocation to huge page size
-        size_type aligned_bytes = ((num_bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE) * HUGE_PAGE_SIZE;
-        
-        int flags = MAP_PRIVATE | MAP_ANONYMOUS;
-#if defined(__linux__)
-        flags |= MAP_HUGETLB | MAP_HUGE_2MB;
-#endif
-        
-        void* p = mmap(nullptr, 
-                       aligned_bytes, 
-                       PROT_READ | PROT_WRITE, 
-                       flags, 
-                       -1, 0);
-                       
-        if (p == MAP_FAILED) {
-            // Fallback to standard mmap without huge pages
-            p = mmap(nullptr, 
-                     aligned_bytes, 
-                     PROT_READ | PROT_WRITE, 
-                     MAP_PRIVATE | MAP_ANONYMOUS, 
-                     -1, 0);
-            if (p == MAP_FAILED) {
-                throw std::bad_alloc();
-            }
+
+        const HugePageMapping m = HugePages::map(n * sizeof(T), options_);
+        if (m.addr == nullptr) {
+            throw std::bad_alloc();
         }
-        return static_cast<T*>(p);
+        last_page_size_ = m.page_size;
+        return static_cast<T*>(m.addr);
     }
-    
-         /**
-          * @brief Auto-generated description for deallocate.
-          * @param p Parameter description.
-          * @param n Parameter description.
-          */
+
     void deallocate(T* p, size_type n) noexcept {
         if (p == nullptr) return;
-        
-        size_type num_bytes = n * sizeof(T);
-        size_type aligned_bytes = ((num_bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE) * HUGE_PAGE_SIZE;
-        munmap(p, aligned_bytes);
+        HugePages::unmap({p, HugePages::mapped_length(n * sizeof(T), options_), last_page_size_, false, false});
     }
-    
+
+    const HugePageOptions& options() const noexcept { return options_; }
+
+    // Page size the most recent allocate() obtained (check for fallback)
+    PageSize last_page_size() const noexcept { return last_page_size_; }
+
     template<typename U>
     struct rebind {
         using other = HugePageAllocator<U>;
     };
+
+private:
+    HugePageOptions options_{}; ///< Page size / NUMA / residency policy.
+    PageSize last_page_size_{PageSize::SMALL_4K}; ///< Set by allocate().
+};
+
+template<typename T, typename U>
+bool operator==(const HugePageAllocator<T>&, const HugePageAllocator<U>&) noexcept { return true; }
+
+/**
+ * Deleter for objects constructed in their own HugePages mapping
+ */
+template<typename T>
+struct HugePageDeleter {
+    HugePageMapping mapping; ///< Backing mapping.
+    void operator()(T* ptr) const noexcept {
+        if (!ptr) return;
+        ptr->~T();
+        HugePages::unmap(mapping);
+    }
 };
 
+template<typename T>
+using HugePagePtr = std::unique_ptr<T, HugePageDeleter<T>>;
+
+/**
+ * @brief Constructs a T in a dedicated mapping (e.g. a pipeline queue that
+ *        must be node-local to its cores). get_deleter().mapping reports
+ *        the page size obtained.
+ */
+template<typename T, typename... Args>
+HugePagePtr<T> make_huge_page(const HugePageOptions& options, Args&&... args) {
+    const HugePageMapping m = HugePages::map(sizeof(T), options);
+    if (m.addr == nullptr) throw std::bad_alloc();
+    T* obj;
+    try {
+        obj = new (m.addr) T(std::forward<Args>(args)...);
+    } catch (...) {
+        HugePages::unmap(m);
+        throw;
+    }
+    return HugePagePtr<T>(obj, HugePageDeleter<T>{m});
+}
+
 } // namespace ultra
@@ -1,91 +1,182 @@
 #pragma once
 #include "huge_page_allocator.hpp"
-#include <vector>
+#include <array>
 #include <cassert>
+#include <cstdint>
 #include <memory>
+#include <new>
 
 namespace ultra {
 
 /**
  * Fixed-size object pool for ultra-low latency allocations.
- * - Uses HugePageAllocator for backing memory.
+ * - Uses HugePageAllocator for backing memory, in chunks of PoolSize slots.
  * - O(1) allocate/deallocate.
  * - Cache-friendly (contiguous memory).
+ * - Intrusive free list: a free slot stores the pointer to the next free
+ *   slot in its own storage, so the pool object itself is a few cache lines
+ *   instead of carrying a PoolSize-entry index stack.
+ * - Optional growth: when occupancy crosses the watermark, maintain()
+ *   (called by the owner off the hot path) maps another chunk. If a burst
+ *   still exhausts the pool before that, allocate() grows inline rather than
+ *   failing (counted in emergency_grows()).
  */
 template<typename T, size_t PoolSize>
 class ObjectPool {
 public:
+    static constexpr size_t MAX_CHUNKS = 32; ///< Upper bound on chunks (incl. the first).
+
+    struct Config {
+        bool growable{false}; ///< Map extra chunks instead of returning nullptr.
+        uint32_t grow_watermark_pct{90}; ///< maintain() grows at this occupancy.
+        size_t max_chunks{MAX_CHUNKS}; ///< Growth limit (clamped to MAX_CHUNKS).
+        HugePageOptions memory{}; ///< Page size / NUMA node for every chunk.
+        void* first_chunk{nullptr}; ///< Caller-owned chunk_bytes() at chunk_align() for chunk 0 (nullptr: mapped).
+    };
+
+    // Storage one chunk needs, e.g. to carve the first one from a HotArena
+    static constexpr size_t chunk_bytes() noexcept { return PoolSize * sizeof(Slot); }
+    static constexpr size_t chunk_align() noexcept { return alignof(Slot); }
+
+    ObjectPool() : ObjectPool(Config{}) {}
+
     /**
-     * @brief Auto-generated description for ObjectPool<T, PoolSize>.
+     * @brief Maps the first chunk and threads the free list through it.
+     * @param config Growth policy.
      */
-    ObjectPool() {
-        // Allocate contiguous block
-        memory_block_ = allocator_.allocate(PoolSize);
-        
-        // Initialize free list
-        for (size_t i = 0; i < PoolSize; ++i) {
-            free_indices_[i] = i;
+    explicit ObjectPool(const Config& config) : config_(config), allocator_(config.memory) {
+        if (config_.max_chunks == 0 || config_.max_chunks > MAX_CHUNKS) config_.max_chunks = MAX_CHUNKS;
+        if (config_.first_chunk != nullptr) {
+            add_chunk(static_cast<Slot*>(config_.first_chunk)); // Growth chunks are still mapped
+        } else {
+            add_chunk(allocator_.allocate(PoolSize)); // Throws std::bad_alloc like before
         }
-        free_count_ = PoolSize;
     }
-    
-    /**
-     * @brief Auto-generated description for ~ObjectPool<T, PoolSize>.
-     */
+
     ~ObjectPool() {
-        if (memory_block_) {
-            allocator_.deallocate(memory_block_, PoolSize);
+        for (size_t c = config_.first_chunk != nullptr ? 1 : 0; c < num_chunks_; ++c) {
+            allocator_.deallocate(chunks_[c], PoolSize);
         }
     }
-    
+
     // Non-copyable/movable to keep it simple
     ObjectPool(const ObjectPool&) = delete;
     ObjectPool& operator=(const ObjectPool&) = delete;
-    
+
+    /**
+     * @brief Constructs a T in a free slot.
+     * @return nullptr only if the pool is exhausted and cannot grow.
+     */
     template<typename... Args>
-       /**
-        * @brief Auto-generated description for allocate.
-        * @return T * value.
-        */
     T* allocate(Args&&... args) noexcept {
-        if (ULTRA_UNLIKELY(free_count_ == 0)) {
-            return nullptr; // Pool exhausted
+        if (ULTRA_UNLIKELY(free_head_ == nullptr)) {
+            if (!config_.growable || !grow()) {
+                ++exhausted_;
+                return nullptr; // Pool exhausted
+            }
+            ++emergency_grows_;
         }
-        
-        uint32_t index = free_indices_[--free_count_];
-        T* ptr = &memory_block_[index];
-        new (ptr) T(std::forward<Args>(args)...); // Construct in-place
-        return ptr;
+
+        Slot* slot = free_head_;
+        free_head_ = slot->next;
+        if (++in_use_ > high_watermark_) high_watermark_ = in_use_;
+        return new (slot->storage) T(std::forward<Args>(args)...); // Construct in-place
     }
-    
-         /**
-          * @brief Auto-generated description for deallocate.
-          * @param ptr Parameter description.
-          */
+
+    /**
+     * @brief Destroys *ptr and pushes its slot onto the free list.
+     */
     void deallocate(T* ptr) noexcept {
-        // Calculate index from pointer
-        size_t index = ptr - memory_block_;
-        assert(index < PoolSize && "Pointer not from this pool");
-        
+        assert(owns(ptr) && "Pointer not from this pool");
         ptr->~T(); // Destruct
-        free_indices_[free_count_++] = static_cast<uint32_t>(index);
+        Slot* slot = reinterpret_cast<Slot*>(ptr);
+        slot->next = free_head_;
+        free_head_ = slot;
+        --in_use_;
     }
-    
-         /**
-          * @brief Auto-generated description for clear.
-          */
+
+    /**
+     * @brief Marks every slot free without running destructors (T is
+     *        expected to be trivial here). Rebuilds the free list: O(capacity).
+     */
     void clear() noexcept {
-        free_count_ = PoolSize;
-        // Optimization: Don't destruct everything if T is trivial
+        free_head_ = nullptr;
+        for (size_t c = num_chunks_; c-- > 0;) thread_chunk(chunks_[c]);
+        in_use_ = 0;
+    }
+
+    /**
+     * @brief Housekeeping for growable pools: maps one more chunk if
+     *        occupancy is at or above the watermark. Call from an idle point
+     *        of the owning thread, never mid-burst.
+     * @return true if a chunk was added.
+     */
+    bool maintain() noexcept {
+        if (!config_.growable || in_use_ < grow_threshold_) return false;
+        return grow();
+    }
+
+    // Maps one more chunk; false at max_chunks or if mmap fails
+    bool grow() noexcept {
+        if (num_chunks_ >= config_.max_chunks) return false;
+        Slot* chunk;
+        try {
+            chunk = allocator_.allocate(PoolSize);
+        } catch (const std::bad_alloc&) {
+            return false;
+        }
+        add_chunk(chunk);
+        return true;
+    }
+
+    // --- Stats ---
+    size_t in_use() const noexcept { return in_use_; }
+    size_t capacity() const noexcept { return num_chunks_ * PoolSize; }
+    size_t high_watermark() const noexcept { return high_watermark_; }
+    size_t chunks() const noexcept { return num_chunks_; }
+    PageSize page_size() const noexcept { return allocator_.last_page_size(); } ///< Of the latest chunk.
+    uint64_t emergency_grows() const noexcept { return emergency_grows_; } ///< Inline growth in allocate().
+    uint64_t exhausted() const noexcept { return exhausted_; } ///< allocate() calls that returned nullptr.
+
+    bool owns(const T* ptr) const noexcept {
+        const auto* p = reinterpret_cast<const Slot*>(ptr);
+        for (size_t c = 0; c < num_chunks_; ++c) {
+            if (p >= chunks_[c] && p < chunks_[c] + PoolSize) return true;
+        }
+        return false;
     }
 
 private:
-    HugePageAllocator<T> allocator_; ///< HugePageAllocator<T> variable representing allocator_.
-    T* memory_block_{nullptr}; ///< T * variable representing memory_block_.
-    
-    // Stack-based free list
-    std::array<uint32_t, PoolSize> free_indices_; ///< int variable representing free_indices_.
-    size_t free_count_{0}; ///< int variable representing free_count_.
+    union Slot {
+        Slot* next; ///< Next free slot (valid while free).
+        alignas(T) unsigned char storage[sizeof(T)]; ///< Object storage (valid while allocated).
+    };
+
+    void add_chunk(Slot* chunk) noexcept {
+        chunks_[num_chunks_++] = chunk;
+        thread_chunk(chunk);
+        grow_threshold_ = capacity() * config_.grow_watermark_pct / 100;
+    }
+
+    // Push a chunk's slots so that slot 0 is allocated first
+    void thread_chunk(Slot* chunk) noexcept {
+        for (size_t i = PoolSize; i-- > 0;) {
+            chunk[i].next = free_head_;
+            free_head_ = &chunk[i];
+        }
+    }
+
+    Slot* free_head_{nullptr}; ///< Top of the intrusive free list.
+    size_t in_use_{0}; ///< Live objects.
+    size_t high_watermark_{0}; ///< Peak in_use_.
+    size_t grow_threshold_{0}; ///< in_use_ at which maintain() grows.
+    uint64_t emergency_grows_{0}; ///< Growth forced by an empty free list.
+    uint64_t exhausted_{0}; ///< Failed allocations.
+
+    Config config_; ///< Growth policy.
+    HugePageAllocator<Slot> allocator_; ///< HugePageAllocator<Slot> variable representing allocator_.
+    size_t num_chunks_{0}; ///< Chunks mapped so far.
+    std::array<Slot*, MAX_CHUNKS> chunks_{}; ///< Chunk base addresses (each PoolSize slots).
 };
 
 } // namespace ultra
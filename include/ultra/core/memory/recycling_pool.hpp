@@ -0,0 +1,240 @@
+#pragma once
+#include "huge_page_allocator.hpp"
+#include "../compiler.hpp"
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+namespace ultra {
+
+/**
+ * Cross-thread recycling pool
+ * Objects are allocated on the owning thread (e.g. strategy) and may be
+ * retired on any other thread (e.g. exec). Large messages can then travel
+ * through the SPSC/MPSC queues as a T* handle instead of by value.
+ *
+ * - Owner side: same intrusive free list as ObjectPool, no atomics
+ * - Remote side: each retiring thread holds a Cache (its magazine for this
+ *   pool). release() destroys the object and chains the slot locally; a full
+ *   magazine is handed back with one CAS onto the pool's return stack
+ * - Return stack: lock-free LIFO of slot chains. The owner takes the whole
+ *   stack with a single exchange() when its free list runs dry, so there is
+ *   no per-node pop and no ABA
+ * - Same Config/growth semantics as ObjectPool; growth only ever happens on
+ *   the owner thread
+ *
+ * Lifetime: every Cache must be flushed or destroyed before the pool.
+ */
+template<typename T, size_t PoolSize>
+class RecyclingPool {
+    union Slot;
+
+public:
+    static constexpr size_t MAX_CHUNKS = 32; ///< Upper bound on chunks (incl. the first).
+    static constexpr uint32_t DEFAULT_MAGAZINE = 64; ///< Objects per returned batch.
+
+    struct Config {
+        bool growable{false}; ///< Map extra chunks instead of returning nullptr.
+        size_t max_chunks{MAX_CHUNKS}; ///< Growth limit (clamped to MAX_CHUNKS).
+        uint32_t magazine_size{DEFAULT_MAGAZINE}; ///< Remote frees per return batch.
+        HugePageOptions memory{}; ///< Page size / NUMA node (the owner's node).
+    };
+
+    RecyclingPool() : RecyclingPool(Config{}) {}
+
+    /**
+     * @brief Maps the first chunk and threads the free list through it.
+     * @throws std::bad_alloc if the first chunk cannot be mapped.
+     */
+    explicit RecyclingPool(const Config& config) : config_(config), allocator_(config.memory) {
+        if (config_.max_chunks == 0 || config_.max_chunks > MAX_CHUNKS) config_.max_chunks = MAX_CHUNKS;
+        if (config_.magazine_size == 0) config_.magazine_size = 1;
+        add_chunk(allocator_.allocate(PoolSize));
+    }
+
+    ~RecyclingPool() {
+        for (size_t c = 0; c < num_chunks_; ++c) {
+            allocator_.deallocate(chunks_[c], PoolSize);
+        }
+    }
+
+    RecyclingPool(const RecyclingPool&) = delete;
+    RecyclingPool& operator=(const RecyclingPool&) = delete;
+
+    /**
+     * Per-thread magazine for returning objects to one pool from a
+     * non-owning thread. Not shared between threads; flush() at idle points
+     * so a quiet thread does not sit on objects.
+     */
+    class Cache {
+    public:
+        explicit Cache(RecyclingPool& pool) noexcept : pool_(pool), magazine_size_(pool.config_.magazine_size) {}
+        ~Cache() { flush(); }
+
+        Cache(const Cache&) = delete;
+        Cache& operator=(const Cache&) = delete;
+
+        // Destroys *ptr; the slot goes back to the owner with the next batch
+        ULTRA_ALWAYS_INLINE void release(T* ptr) noexcept {
+            assert(pool_.owns(ptr) && "Pointer not from this pool");
+            ptr->~T();
+            Slot* slot = reinterpret_cast<Slot*>(ptr);
+            slot->next = head_;
+            head_ = slot;
+            if (tail_ == nullptr) tail_ = slot;
+            if (++count_ >= magazine_size_) flush();
+        }
+
+        // Hands the partial magazine back (no-op if empty)
+        void flush() noexcept {
+            if (count_ == 0) return;
+            pool_.push_returned(head_, tail_, count_);
+            head_ = tail_ = nullptr;
+            count_ = 0;
+        }
+
+        uint32_t pending() const noexcept { return count_; } ///< Objects not yet handed back.
+
+    private:
+        RecyclingPool& pool_; ///< Owning pool.
+        const uint32_t magazine_size_; ///< Copied: the pool's config_ shares a line with owner-written counters.
+        Slot* head_{nullptr}; ///< Magazine chain (most recent first).
+        Slot* tail_{nullptr}; ///< Oldest entry; linked to the return stack on flush.
+        uint32_t count_{0}; ///< Entries in the chain.
+    };
+
+    /**
+     * @brief Owner thread: constructs a T. Falls back to the returned
+     *        batches, then to growth, when the local free list is empty.
+     * @return nullptr only if the pool is exhausted and cannot grow.
+     */
+    template<typename... Args>
+    T* allocate(Args&&... args) noexcept {
+        if (ULTRA_UNLIKELY(free_head_ == nullptr) && !reclaim()) {
+            if (!config_.growable || !grow()) {
+                ++exhausted_;
+                return nullptr;
+            }
+            ++emergency_grows_;
+        }
+
+        Slot* slot = free_head_;
+        free_head_ = slot->next;
+        ++allocated_;
+        const size_t live = in_use();
+        if (live > high_watermark_) high_watermark_ = live;
+        return new (slot->storage) T(std::forward<Args>(args)...);
+    }
+
+    // Owner thread: retire an object that never left this thread
+    void deallocate(T* ptr) noexcept {
+        assert(owns(ptr) && "Pointer not from this pool");
+        ptr->~T();
+        Slot* slot = reinterpret_cast<Slot*>(ptr);
+        slot->next = free_head_;
+        free_head_ = slot;
+        ++freed_local_;
+    }
+
+    /**
+     * @brief Owner thread: takes every returned batch. Called by allocate()
+     *        when the free list is empty; may also be called at idle points.
+     * @return true if the free list is non-empty afterwards.
+     */
+    bool reclaim() noexcept {
+        Slot* chain = returned_.exchange(nullptr, std::memory_order_acquire);
+        if (chain != nullptr) {
+            ++reclaims_;
+            if (free_head_ == nullptr) {
+                free_head_ = chain; // O(1) in the common (empty) case
+            } else {
+                Slot* last = chain;
+                while (last->next) last = last->next;
+                last->next = free_head_;
+                free_head_ = chain;
+            }
+        }
+        return free_head_ != nullptr;
+    }
+
+    // Owner thread: maps one more chunk; false at max_chunks or if mmap fails
+    bool grow() noexcept {
+        if (num_chunks_ >= config_.max_chunks) return false;
+        Slot* chunk;
+        try {
+            chunk = allocator_.allocate(PoolSize);
+        } catch (const std::bad_alloc&) {
+            return false;
+        }
+        add_chunk(chunk);
+        return true;
+    }
+
+    // --- Stats (owner thread; remote counts lag by up to one magazine per Cache) ---
+    size_t in_use() const noexcept {
+        return static_cast<size_t>(allocated_ - freed_local_ - returned_objects_.load(std::memory_order_relaxed));
+    }
+    size_t capacity() const noexcept { return num_chunks_ * PoolSize; }
+    size_t high_watermark() const noexcept { return high_watermark_; }
+    size_t chunks() const noexcept { return num_chunks_; }
+    uint64_t returned() const noexcept { return returned_objects_.load(std::memory_order_relaxed); } ///< Objects handed back by Caches.
+    uint64_t return_batches() const noexcept { return return_batches_.load(std::memory_order_relaxed); } ///< CASes on the return stack.
+    uint64_t reclaims() const noexcept { return reclaims_; } ///< Non-empty reclaim() calls.
+    uint64_t emergency_grows() const noexcept { return emergency_grows_; } ///< Inline growth in allocate().
+    uint64_t exhausted() const noexcept { return exhausted_; } ///< allocate() calls that returned nullptr.
+
+    bool owns(const T* ptr) const noexcept {
+        const auto* p = reinterpret_cast<const Slot*>(ptr);
+        for (size_t c = 0; c < num_chunks_; ++c) {
+            if (p >= chunks_[c] && p < chunks_[c] + PoolSize) return true;
+        }
+        return false;
+    }
+
+private:
+    union Slot {
+        Slot* next; ///< Next free slot (free list, magazine or return chain).
+        alignas(T) unsigned char storage[sizeof(T)]; ///< Object storage (valid while allocated).
+    };
+
+    // Any thread: link [head..tail] in front of the return stack
+    void push_returned(Slot* head, Slot* tail, uint32_t count) noexcept {
+        Slot* top = returned_.load(std::memory_order_relaxed);
+        do {
+            tail->next = top;
+        } while (!returned_.compare_exchange_weak(top, head, std::memory_order_release, std::memory_order_relaxed));
+        returned_objects_.fetch_add(count, std::memory_order_relaxed);
+        return_batches_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void add_chunk(Slot* chunk) noexcept {
+        chunks_[num_chunks_++] = chunk;
+        for (size_t i = PoolSize; i-- > 0;) {
+            chunk[i].next = free_head_;
+            free_head_ = &chunk[i];
+        }
+    }
+
+    // --- Owner thread ---
+    Slot* free_head_{nullptr}; ///< Top of the local free list.
+    uint64_t allocated_{0}; ///< Successful allocate() calls.
+    uint64_t freed_local_{0}; ///< deallocate() calls on the owner.
+    size_t high_watermark_{0}; ///< Peak in_use().
+    uint64_t reclaims_{0}; ///< Return-stack takeovers.
+    uint64_t emergency_grows_{0}; ///< Growth forced by an empty free list.
+    uint64_t exhausted_{0}; ///< Failed allocations.
+
+    Config config_; ///< Growth and magazine policy.
+    HugePageAllocator<Slot> allocator_; ///< Chunk memory.
+    size_t num_chunks_{0}; ///< Chunks mapped so far.
+    std::array<Slot*, MAX_CHUNKS> chunks_{}; ///< Chunk base addresses (each PoolSize slots).
+
+    // --- Shared with remote threads (own cache lines) ---
+    ULTRA_CACHE_ALIGNED std::atomic<Slot*> returned_{nullptr}; ///< Return stack (chains of slots).
+    std::atomic<uint64_t> returned_objects_{0}; ///< Objects pushed to the return stack.
+    std::atomic<uint64_t> return_batches_{0}; ///< Batches pushed.
+};
+
+} // namespace ultra
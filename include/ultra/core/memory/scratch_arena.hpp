@@ -0,0 +1,112 @@
+#pragma once
+#include "../compiler.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace ultra {
+
+/**
+ * Per-thread monotonic scratch arena (std::pmr::memory_resource)
+ * For temporaries that live for one event, batch or backtest step: trace
+ * parameter strings, indicator work vectors, per-run signal/equity series.
+ *
+ * - allocate() is a pointer bump; deallocate() is a no-op
+ * - reset() / Scope rewind the arena in O(1). Blocks are kept, so after
+ *   the first event/step has sized the arena, steady state never touches
+ *   the global heap
+ * - When the current blocks are exhausted a new block is taken from the
+ *   upstream (global) heap and counted. Taking one after the first
+ *   reset is a steady-state fallback: counted in fallbacks() and, in debug
+ *   builds, reported on stderr once per arena
+ * - Not thread-safe: use local() (one arena per thread)
+ *
+ * Usage:
+ *   ScratchArena::Scope scratch;                    // rewinds on exit
+ *   std::pmr::vector<double> tmp(n, &scratch.arena());
+ */
+class ScratchArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 256 * 1024;
+
+    explicit ScratchArena(size_t initial_block = DEFAULT_BLOCK_SIZE,
+                          std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~ScratchArena() override;
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    // The calling thread's arena
+    static ScratchArena& local();
+
+    struct Mark {
+        size_t block; ///< Block index.
+        size_t offset; ///< Bytes used in that block.
+    };
+
+    ULTRA_ALWAYS_INLINE Mark mark() const noexcept { return {block_, offset_}; }
+    ULTRA_ALWAYS_INLINE void rewind(const Mark& m) noexcept { block_ = m.block; offset_ = m.offset; }
+    ULTRA_ALWAYS_INLINE void reset() noexcept { rewind({0, 0}); ++resets_; }
+
+    /**
+     * RAII rewind: everything allocated from the arena while the Scope is
+     * alive is released when it ends. Scopes nest.
+     */
+    class Scope {
+    public:
+        explicit Scope(ScratchArena& arena = ScratchArena::local()) noexcept
+            : arena_(arena), mark_(arena.mark()) {}
+        ~Scope() {
+            arena_.rewind(mark_);
+            if (mark_.block == 0 && mark_.offset == 0) ++arena_.resets_;
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        ScratchArena& arena() noexcept { return arena_; }
+
+    private:
+        ScratchArena& arena_; ///< Arena to rewind.
+        Mark mark_; ///< Position at construction.
+    };
+
+    /**
+     * @brief printf into the arena (e.g. trace parameters) instead of
+     *        building a std::string via std::to_string.
+     * @return NUL-terminated string valid until the enclosing Scope ends.
+     */
+    const char* format(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+    // --- Stats ---
+    size_t bytes_reserved() const noexcept; ///< Sum of block sizes.
+    size_t high_watermark() const noexcept { return high_watermark_; } ///< Peak bytes in use.
+    uint64_t upstream_allocations() const noexcept { return upstream_allocations_; } ///< Blocks taken from the heap.
+    uint64_t fallbacks() const noexcept { return fallbacks_; } ///< Of those, after the first reset.
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {} // Monotonic: freed by rewind
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    struct Block {
+        uint8_t* data; ///< Block storage.
+        size_t size; ///< Bytes.
+        size_t start; ///< Sum of the sizes of earlier blocks.
+    };
+
+    void* allocate_slow(size_t bytes, size_t alignment);
+    void add_block(size_t min_bytes);
+
+    std::pmr::memory_resource* upstream_; ///< Global heap by default.
+    std::vector<Block> blocks_; ///< Retained across resets.
+    size_t block_{0}; ///< Current block.
+    size_t offset_{0}; ///< Used bytes in the current block.
+    size_t high_watermark_{0}; ///< Peak of used bytes across blocks.
+    uint64_t resets_{0}; ///< Full rewinds (reset() or outermost Scope).
+    uint64_t upstream_allocations_{0}; ///< Blocks from upstream.
+    uint64_t fallbacks_{0}; ///< Blocks from upstream after the first reset.
+};
+
+} // namespace ultra
@@ -2,6 +2,7 @@
 #include "compiler.hpp"
 #include <cstdint>
 #include <vector>
+#include <span>
 #include <cmath>
 
 #if defined(__x86_64__) || defined(_M_X64)
@@ -59,7 +60,7 @@ public:
     }
     
     // Calculate Standard Deviation
-    static double calculate_std_dev(const std::vector<double>& returns) {
+    static double calculate_std_dev(std::span<const double> returns) {
         size_t n = returns.size();
         if (n < 2) return 0.0;
 
@@ -35,6 +35,7 @@ using SymbolId = uint32_t;
 using OrderId = uint64_t;
 using Timestamp = uint64_t;  // nanoseconds since epoch
 using SequenceNum = uint64_t;
+using VenueId = uint8_t;    // Index into [execution] venue_preference
 
 // Side enum
 enum class Side : uint8_t {
@@ -91,7 +92,7 @@ constexpr Quantity INVALID_QUANTITY = -1; ///< const int variable representing I
 struct Event {
     Timestamp tsc;       // RDTSC timestamp
     Timestamp exchange_ts; // Exchange timestamp
-    Timestamp received_ts; // Our ingress timestamp
+    Timestamp received_ts; // Our ingress timestamp: kernel/NIC rx stamp, CLOCK_REALTIME ns (0 if none)
 };
 
 } // namespace ultra
\ No newline at end of file
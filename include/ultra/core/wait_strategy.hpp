@@ -0,0 +1,223 @@
+#pragma once
+#include "compiler.hpp"
+#include "spin_wait.hpp"
+#include "time/rdtsc_clock.hpp"
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace ultra {
+
+/**
+ * How a pipeline thread behaves when a poll finds no work.
+ * - BUSY_SPIN:  return immediately (latency-critical cores, 100% CPU)
+ * - BACKOFF:    pause 1, 2, 4 ... 2^max_backoff_shift times per empty poll
+ * - SPIN_YIELD: pause for spin_iterations empty polls, then sched_yield()
+ * - SPIN_FUTEX: pause for spin_iterations empty polls, then sleep on a futex
+ *               until a producer notify()s or park_timeout_ns elapses
+ */
+enum class WaitPolicy : uint8_t {
+    BUSY_SPIN,
+    BACKOFF,
+    SPIN_YIELD,
+    SPIN_FUTEX
+};
+
+const char* to_string(WaitPolicy policy) noexcept;
+
+// Accepts "busy_spin", "backoff", "spin_yield", "spin_futex" (as in engine.toml)
+bool parse_wait_policy(const std::string& name, WaitPolicy& out) noexcept;
+
+/**
+ * Log2-bucketed latency histogram (bucket i holds [2^i, 2^(i+1)) ns).
+ * Single writer (the waiting thread), readable from any thread.
+ */
+class WakeLatencyHistogram {
+public:
+    static constexpr size_t NUM_BUCKETS = 40; // Up to ~18 minutes
+
+    ULTRA_ALWAYS_INLINE void record(uint64_t latency_ns) noexcept {
+        const size_t idx = latency_ns == 0 ? 0 : 63 - __builtin_clzll(latency_ns);
+        auto& b = buckets_[idx < NUM_BUCKETS ? idx : NUM_BUCKETS - 1];
+        b.store(b.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        count_.store(count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (latency_ns > max_ns_.load(std::memory_order_relaxed)) {
+            max_ns_.store(latency_ns, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t count() const noexcept { return count_.load(std::memory_order_relaxed); }
+    uint64_t max_ns() const noexcept { return max_ns_.load(std::memory_order_relaxed); }
+    uint64_t bucket(size_t i) const noexcept { return buckets_[i].load(std::memory_order_relaxed); }
+
+    // Upper bound of the bucket holding the p-th quantile (0 if empty)
+    uint64_t percentile_ns(double p) const noexcept;
+
+    // Prints "--- <title>: <name> ---" and the percentiles
+    void print_stats(const char* name, const char* title = "Wake Latency") const;
+    void reset() noexcept;
+
+private:
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> buckets_{};
+    std::atomic<uint64_t> count_{0}; ///< Samples recorded.
+    std::atomic<uint64_t> max_ns_{0}; ///< Largest sample.
+};
+
+/**
+ * Per-thread idle policy for a poll loop:
+ *
+ *     while (running) {
+ *         bool work_done = poll_queues();
+ *         if (work_done) wait.on_work(); else wait.idle(has_work);
+ *     }
+ *
+ * Producers feeding this thread call notify() after publishing; it is a
+ * single predictable branch unless the policy is SPIN_FUTEX, and issues a
+ * FUTEX_WAKE only when the consumer is actually parked. The optional
+ * has_work predicate is re-checked after the thread announces it is about
+ * to park, which closes the publish-before-park race; without it, such work
+ * is still picked up within park_timeout_ns.
+ *
+ * Every idle -> busy transition records two things, for every policy:
+ * - Wake latency: the first notify() of the idle stretch (stamped by the
+ *   producer) to the productive poll. Comparable across policies; work
+ *   published without a notify() gives no sample
+ * - Idle gap: the whole stretch, first empty poll to productive poll
+ */
+class WaitStrategy {
+public:
+    struct Config {
+        WaitPolicy policy = WaitPolicy::BUSY_SPIN; ///< Idle behaviour.
+        uint32_t spin_iterations = 10000; ///< SPIN_YIELD/SPIN_FUTEX: empty polls before yielding/parking.
+        uint32_t max_backoff_shift = 10; ///< BACKOFF: cap of 2^shift pauses per empty poll.
+        uint64_t park_timeout_ns = 50'000; ///< SPIN_FUTEX: longest futex sleep (bounds wake latency).
+    };
+
+    WaitStrategy() = default;
+    explicit WaitStrategy(const Config& config) noexcept : config_(config) {}
+
+    WaitStrategy(const WaitStrategy&) = delete;
+    WaitStrategy& operator=(const WaitStrategy&) = delete;
+
+    // Only before the owning thread starts
+    void configure(const Config& config) noexcept { config_ = config; }
+    const Config& config() const noexcept { return config_; }
+
+    // Owning thread: the last poll found work
+    ULTRA_ALWAYS_INLINE void on_work() noexcept {
+        if (ULTRA_LIKELY(idle_polls_ == 0)) return;
+        record_wake();
+    }
+
+    // Owning thread: the last poll found nothing
+    ULTRA_ALWAYS_INLINE void idle() noexcept {
+        idle([] { return false; });
+    }
+
+    template<typename HasWork>
+    ULTRA_ALWAYS_INLINE void idle(HasWork&& has_work) noexcept {
+        const uint64_t polls = idle_polls_++;
+        if (polls == 0) begin_idle();
+        if (config_.policy == WaitPolicy::BUSY_SPIN) return;
+
+        switch (config_.policy) {
+        case WaitPolicy::BACKOFF: {
+            const uint64_t shift = polls < config_.max_backoff_shift ? polls : config_.max_backoff_shift;
+            for (uint64_t i = 0, n = uint64_t{1} << shift; i < n; ++i) SpinWait::spin();
+            break;
+        }
+        case WaitPolicy::SPIN_YIELD:
+            if (polls < config_.spin_iterations) SpinWait::spin();
+            else yield();
+            break;
+        case WaitPolicy::SPIN_FUTEX:
+            if (polls < config_.spin_iterations) {
+                SpinWait::spin();
+                break;
+            }
+            waiters_.store(1, std::memory_order_relaxed);
+            // Pairs with the fence in notify(): either the producer sees
+            // waiters_ == 1, or has_work() sees its publish
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            {
+                // Read the word before re-checking so a wake that lands in
+                // between makes the futex wait return at once
+                const uint32_t seq = futex_word_.load(std::memory_order_acquire);
+                if (!has_work()) park(seq);
+            }
+            waiters_.store(0, std::memory_order_relaxed);
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Producer (any thread): new work was published for the owning thread.
+    // The first notify() after the owner went idle stamps the TSC (one load
+    // otherwise, of a line the owner writes only on idle transitions)
+    ULTRA_ALWAYS_INLINE void notify() noexcept {
+        if (notify_tsc_.load(std::memory_order_relaxed) == 0) {
+            notify_tsc_.store(RDTSCClock::rdtsc(), std::memory_order_relaxed);
+        }
+        if (config_.policy != WaitPolicy::SPIN_FUTEX) return;
+        // Pairs with the fence in idle(): either we see the waiter, or its
+        // has_work() re-check sees our publish
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (ULTRA_UNLIKELY(waiters_.load(std::memory_order_relaxed) != 0)) {
+            wake();
+        }
+    }
+
+    // Wake a parked owner unconditionally (e.g. on shutdown)
+    void wake_all() noexcept { wake(); }
+
+    const WakeLatencyHistogram& wake_latency() const noexcept { return histogram_; }
+    const WakeLatencyHistogram& idle_gap() const noexcept { return idle_gap_; }
+    uint64_t parks() const noexcept { return parks_.load(std::memory_order_relaxed); }
+    uint64_t yields() const noexcept { return yields_.load(std::memory_order_relaxed); }
+
+    void print_stats(const char* thread_name) const;
+
+    // Clears the wake-latency and park/yield counts (owning thread stopped),
+    // e.g. so a warm-up run does not show up in the live numbers
+    void reset_stats() noexcept {
+        histogram_.reset();
+        idle_gap_.reset();
+        notify_tsc_.store(0, std::memory_order_relaxed);
+        parks_.store(0, std::memory_order_relaxed);
+        yields_.store(0, std::memory_order_relaxed);
+        idle_polls_ = 0;
+    }
+
+private:
+    void yield() noexcept;
+    void park(uint32_t seq) noexcept;
+    void wake() noexcept;
+    void record_wake() noexcept;
+
+    // First empty poll of a stretch: notifies before it were for work
+    // already consumed
+    ULTRA_ALWAYS_INLINE void begin_idle() noexcept {
+        idle_start_tsc_ = RDTSCClock::rdtsc();
+        if (notify_tsc_.load(std::memory_order_relaxed) != 0) notify_tsc_.store(0, std::memory_order_relaxed);
+    }
+
+    Config config_; ///< Policy and tuning.
+
+    // Owner-thread state
+    uint64_t idle_polls_{0}; ///< Consecutive empty polls.
+    uint64_t idle_start_tsc_{0}; ///< TSC of the stretch's first empty poll.
+
+    WakeLatencyHistogram histogram_; ///< notify() -> productive poll (ns).
+    WakeLatencyHistogram idle_gap_; ///< First empty poll -> productive poll (ns).
+    std::atomic<uint64_t> parks_{0}; ///< Futex sleeps entered.
+    std::atomic<uint64_t> yields_{0}; ///< sched_yield() calls.
+
+    // Shared with producers
+    ULTRA_CACHE_ALIGNED std::atomic<uint32_t> futex_word_{0}; ///< Bumped by each wake.
+    std::atomic<uint32_t> waiters_{0}; ///< 1 while the owner is parked (or about to park).
+    std::atomic<uint64_t> notify_tsc_{0}; ///< TSC of the first notify() this idle stretch (0: none).
+};
+
+} // namespace ultra
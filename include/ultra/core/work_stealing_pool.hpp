@@ -0,0 +1,169 @@
+#pragma once
+#include "compiler.hpp"
+#include "lockfree/chase_lev_deque.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(ULTRA_LIVE_ENGINE)
+#error "WorkStealingPool is for offline tools (backtests, loaders, sweeps); keep it out of the live engine"
+#endif
+
+namespace ultra {
+
+class WorkStealingPool;
+
+/**
+ * Fork-join scope: run() spawns tasks onto the pool, wait() blocks until all
+ * of them (and anything they spawned into this group) have finished. The
+ * waiting thread executes queued tasks itself instead of sleeping, so
+ * nested parallelism from inside a task does not deadlock.
+ * The first exception thrown by a task is rethrown from wait().
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(WorkStealingPool& pool) noexcept : pool_(pool) {}
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    template<typename F>
+    void run(F&& fn);
+
+    void wait();
+
+private:
+    friend class WorkStealingPool;
+
+    void record_error(std::exception_ptr e) noexcept;
+
+    WorkStealingPool& pool_; ///< Pool the tasks run on.
+    std::atomic<size_t> pending_{0}; ///< Spawned but not finished.
+    std::mutex error_mutex_; ///< Guards error_.
+    std::exception_ptr error_; ///< First task exception.
+};
+
+/**
+ * Work-stealing thread pool for offline paths (backtester, file loading,
+ * parameter sweeps). Never use it on the live pipeline threads; including
+ * this header with ULTRA_LIVE_ENGINE defined is a compile error.
+ *
+ * - One Chase-Lev deque per worker: a worker pushes/pops its own tasks LIFO
+ *   and steals FIFO from a random victim when it runs dry
+ * - Tasks spawned from outside the pool go to a mutex-guarded injection
+ *   queue (cold path: one lock per external spawn)
+ * - Workers optionally pinned via ThreadUtils::pin_thread (Config::cores)
+ * - Idle workers sleep on a condition variable with a short timeout
+ */
+class WorkStealingPool {
+public:
+    struct Config {
+        size_t num_threads = 0; ///< Workers; 0 = hardware_concurrency() - 1 (the caller helps in wait()).
+        std::vector<int> cores; ///< Worker i is pinned to cores[i % cores.size()]; empty = no pinning.
+    };
+
+    WorkStealingPool() : WorkStealingPool(Config{}) {}
+    explicit WorkStealingPool(const Config& config);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    size_t num_threads() const noexcept { return workers_.size(); }
+
+    /**
+     * Calls body(lo, hi) over disjoint sub-ranges covering [begin, end),
+     * each at most grain long. The range is split recursively so idle
+     * workers steal large halves first.
+     */
+    template<typename F>
+    void parallel_for(size_t begin, size_t end, size_t grain, F&& body) {
+        if (end <= begin) return;
+        TaskGroup group(*this);
+        split(group, begin, end, std::max<size_t>(grain, 1), body);
+        group.wait();
+    }
+
+    // Grain chosen for ~8 chunks per thread
+    template<typename F>
+    void parallel_for(size_t begin, size_t end, F&& body) {
+        const size_t chunks = (num_threads() + 1) * 8;
+        parallel_for(begin, end, (end - begin + chunks - 1) / chunks, std::forward<F>(body));
+    }
+
+    // Run all callables concurrently; returns when every one has finished
+    template<typename F, typename... Rest>
+    void parallel_invoke(F&& first, Rest&&... rest) {
+        TaskGroup group(*this);
+        (group.run(std::forward<Rest>(rest)), ...);
+        first();
+        group.wait();
+    }
+
+private:
+    friend class TaskGroup;
+
+    struct Task {
+        explicit Task(TaskGroup* g) noexcept : group(g) {}
+        virtual ~Task() = default;
+        virtual void run() = 0;
+        TaskGroup* group; ///< Group to signal on completion.
+    };
+
+    template<typename F>
+    struct TaskImpl final : Task {
+        TaskImpl(TaskGroup* g, F&& f) : Task(g), fn(std::move(f)) {}
+        void run() override { fn(); }
+        F fn; ///< User callable.
+    };
+
+    static constexpr size_t DEQUE_CAPACITY = 4096;
+    using Deque = ChaseLevDeque<Task*, DEQUE_CAPACITY>;
+
+    template<typename F>
+    void split(TaskGroup& group, size_t lo, size_t hi, size_t grain, F& body) {
+        while (hi - lo > grain) {
+            const size_t mid = lo + (hi - lo) / 2;
+            group.run([this, &group, &body, mid, hi, grain] { split(group, mid, hi, grain, body); });
+            hi = mid;
+        }
+        body(lo, hi);
+    }
+
+    void submit(Task* task);
+    bool try_run_one();
+    void execute(Task* task) noexcept;
+    void worker_loop(size_t index);
+
+    // Index of the calling worker in this pool, or -1 for outside threads
+    long current_worker() const noexcept;
+
+    Config config_; ///< Construction parameters.
+    std::vector<std::unique_ptr<Deque>> deques_; ///< One per worker.
+    std::vector<std::thread> workers_; ///< Worker threads.
+
+    std::mutex mutex_; ///< Guards injection_ and sleeping.
+    std::condition_variable cv_; ///< Idle workers wait here.
+    std::deque<Task*> injection_; ///< Tasks spawned by non-worker threads.
+    std::atomic<size_t> injected_{0}; ///< injection_.size(), readable without the lock.
+    std::atomic<size_t> sleeping_{0}; ///< Workers blocked on cv_.
+    std::atomic<bool> stop_{false}; ///< Shutdown flag.
+};
+
+template<typename F>
+void TaskGroup::run(F&& fn) {
+    using Fn = std::decay_t<F>;
+    auto* task = new WorkStealingPool::TaskImpl<Fn>(this, Fn(std::forward<F>(fn)));
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    pool_.submit(task);
+}
+
+} // namespace ultra
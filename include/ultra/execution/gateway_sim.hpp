@@ -2,12 +2,10 @@
 #include "../core/types.hpp"
 #include "../core/lockfree/spsc_queue.hpp"
 #include "../market-data/itch/decoder.hpp"
+#include "../strategy/strategy.hpp"
 #include "execution_report.hpp"
-#include <vector>
-
-namespace ultra::strategy {
-    struct StrategyOrder; // <-- ADDED FORWARD DECLARATION
-}
+#include <array>
+#include <cstddef>
 
 namespace ultra::exec {
 
@@ -15,9 +13,14 @@ namespace ultra::exec {
  * A simple, single-threaded, simulated exchange gateway
  * It pretends to be an exchange, processing orders and sending
  * execution reports back.
+ * Resting orders are kept in fixed arrays inside the object, so the whole
+ * gateway sits wherever it is placed (the engine's hot arena) with no heap
+ * behind it; an order that cannot rest on a full side is cancelled.
  */
 class GatewaySim {
 public:
+    static constexpr size_t MAX_RESTING = 4096; ///< Resting orders per side.
+
     GatewaySim() = default;
 
     // Engine -> Gateway
@@ -32,9 +35,11 @@ public:
 private:
     // A *very* simple matching engine
     // Bids (descending)
-    std::vector<strategy::StrategyOrder> active_bids_;  ///< int variable representing active_bids_.
+    std::array<strategy::StrategyOrder, MAX_RESTING> active_bids_;  ///< int variable representing active_bids_.
+    size_t num_bids_{0}; ///< Resting bids.
     // Asks (ascending)
-    std::vector<strategy::StrategyOrder> active_asks_;  ///< int variable representing active_asks_.
+    std::array<strategy::StrategyOrder, MAX_RESTING> active_asks_;  ///< int variable representing active_asks_.
+    size_t num_asks_{0}; ///< Resting asks.
 
     SPSCQueue<ExecutionReport, 8192> exec_reports_queue_; ///< int variable representing exec_reports_queue_.
     OrderId next_order_id_{1}; ///< int variable representing next_order_id_.
@@ -56,6 +61,11 @@ private:
           * @param order Parameter description.
           */
     void send_accept(const strategy::StrategyOrder& order);
+
+    // Inserts in price order (better_than(a, b): a ranks ahead of b);
+    // cancels the order if the side is full
+    template<typename BetterThan>
+    void rest(strategy::StrategyOrder* side, size_t& count, const strategy::StrategyOrder& order, BetterThan better_than);
 };
 
 } // namespace ultra::exec
\ No newline at end of file
@@ -23,13 +23,7 @@ public:
           * @param order Parameter description.
           */
     void route(const strategy::StrategyOrder& order) {
-        auto& universe = SymbolUniverse::instance();
-        const SymbolInfo* info = universe.get_symbol(order.symbol_id);
-        
-        bool use_fpga = false;
-        if (info && info->use_fpga_execution) {
-            use_fpga = true;
-        }
+        const bool use_fpga = prefers_fpga(order);
 
         uint64_t start = RDTSCClock::rdtsc();
 
@@ -50,6 +44,12 @@ public:
         }
     }
 
+    // Venue decision only, nothing is sent (route() and warm-up replays)
+    bool prefers_fpga(const strategy::StrategyOrder& order) const noexcept {
+        const SymbolInfo* info = SymbolUniverse::instance().get_symbol(order.symbol_id);
+        return info && info->use_fpga_execution;
+    }
+
 private:
     fpga::FPGADriver* fpga_; ///< fpga::FPGADriver * variable representing fpga_.
     exec::GatewaySim* gateway_; ///< exec::GatewaySim * variable representing gateway_.
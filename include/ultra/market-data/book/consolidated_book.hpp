@@ -0,0 +1,115 @@
+#pragma once
+#include "../../core/compiler.hpp"
+#include "../../core/types.hpp"
+#include "order_book_l2.hpp"
+#include <array>
+#include <cstdint>
+
+namespace ultra::md {
+
+/**
+ * Consolidated (NBBO) L2 Book across several venues
+ * - Merges the top DEPTH levels of each registered OrderBookL2 into one ladder
+ * - Incremental: each venue update diffs that venue's top-N against its last
+ *   snapshot and only touches the consolidated levels whose quantity changed
+ * - Keeps per-venue quantity at every consolidated level for the router
+ */
+class ConsolidatedBook {
+public:
+    static constexpr size_t MAX_VENUES = 8;  // Fits venue_mask in a byte
+    static constexpr size_t DEPTH = 10;      // Per-venue levels merged ([order_book] levels)
+    static constexpr size_t MAX_LEVELS = MAX_VENUES * DEPTH; // Worst case: no shared prices
+
+    struct Level {
+        Price price{INVALID_PRICE}; ///< Consolidated price.
+        Quantity quantity{0}; ///< Sum of venue_qty.
+        uint8_t venue_mask{0}; ///< Bit v set if venue v quotes this price.
+        std::array<Quantity, MAX_VENUES> venue_qty{}; ///< Per-venue attribution.
+    };
+
+    using PriceLevelSide = std::array<Level, MAX_LEVELS>;
+
+    /**
+     * @brief Construct an empty consolidated book for one symbol.
+     * @param symbol_id Symbol shared by every registered venue book.
+     */
+    explicit ConsolidatedBook(SymbolId symbol_id);
+
+    /**
+     * @brief Register a venue's book. Venue ids index the [execution]
+     *        venue_preference list, so a lower id wins ties in best_venue().
+     * @param venue Venue id, must be < MAX_VENUES.
+     * @param name Short venue name (not copied, must outlive this object).
+     * @param book Venue book; must outlive this object.
+     * @return false if the id is out of range or already registered.
+     */
+    bool add_venue(VenueId venue, const char* name, const OrderBookL2* book) noexcept;
+
+    /**
+     * @brief Fold the latest state of one venue's book into the ladder.
+     *        Call after every OrderBookL2::update() on that venue.
+     * @param venue Registered venue id.
+     */
+    ULTRA_HOT void on_venue_update(VenueId venue) noexcept;
+
+    // Get current NBBO
+    ULTRA_ALWAYS_INLINE const Level& best_bid() const noexcept { return bids_[0]; }
+    ULTRA_ALWAYS_INLINE const Level& best_ask() const noexcept { return asks_[0]; }
+
+    // Get all levels (bids descending, asks ascending; empty levels hold the
+    // same sentinels as OrderBookL2: 0 for bids, INVALID_PRICE for asks)
+    const PriceLevelSide& bids() const noexcept { return bids_; }
+    const PriceLevelSide& asks() const noexcept { return asks_; }
+    size_t bid_depth() const noexcept { return bid_count_; }
+    size_t ask_depth() const noexcept { return ask_count_; }
+
+    /**
+     * @brief Venue with the most size at a consolidated level; ties go to the
+     *        lower (more preferred) venue id.
+     * @return Venue id, or MAX_VENUES if the level is empty.
+     */
+    VenueId best_venue(Side side, size_t level = 0) const noexcept;
+
+    const char* venue_name(VenueId venue) const noexcept {
+        return venue < MAX_VENUES ? venues_[venue].name : nullptr;
+    }
+    size_t venue_count() const noexcept { return venue_count_; }
+    SymbolId symbol_id() const noexcept { return symbol_id_; }
+
+    // Number of consolidated level writes so far (for benchmarks/diagnostics)
+    uint64_t level_updates() const noexcept { return level_updates_; }
+
+private:
+    using VenueSide = std::array<OrderBookL2::Level, DEPTH>;
+
+    struct VenueState {
+        const OrderBookL2* book{nullptr}; ///< Source book (not owned).
+        const char* name{nullptr}; ///< Display name.
+        VenueSide bids{}; ///< Last merged top-N bids.
+        VenueSide asks{}; ///< Last merged top-N asks.
+    };
+
+    SymbolId symbol_id_; ///< Symbol of all venue books.
+    std::array<VenueState, MAX_VENUES> venues_{}; ///< Indexed by VenueId.
+    size_t venue_count_{0}; ///< Registered venues.
+
+    ULTRA_CACHE_ALIGNED PriceLevelSide bids_{}; ///< Consolidated bids.
+    ULTRA_CACHE_ALIGNED PriceLevelSide asks_{}; ///< Consolidated asks.
+    size_t bid_count_{0}; ///< Occupied bid levels.
+    size_t ask_count_{0}; ///< Occupied ask levels.
+    uint64_t level_updates_{0}; ///< Consolidated level writes.
+
+    // Merge-diff one side of a venue's top-N against its previous snapshot
+    void diff_side(VenueId venue, Side side, VenueSide& prev,
+                   const OrderBookL2::PriceLevelSide& curr) noexcept;
+
+    // Apply a per-venue quantity delta at one price; inserts or removes the
+    // consolidated level as needed (same memmove scheme as OrderBookL2)
+    void apply_delta(VenueId venue, Side side, Price price, Quantity delta) noexcept;
+
+    ULTRA_ALWAYS_INLINE static Price empty_price(Side side) noexcept {
+        return side == Side::BUY ? 0 : INVALID_PRICE;
+    }
+};
+
+} // namespace ultra::md
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <vector>
 #include <cstring>
+#include <functional>
 
 namespace ultra::md {
 
@@ -14,12 +15,13 @@ namespace ultra::md {
  * Optimized L2 Order Book
  * - Flat arrays for Price Levels (No std::map tree traversal)
  * - Open Addressing Hash Map for Orders (No std::unordered_map allocations)
- * - Object Pool for Order storage
+ * - Object Pool for Order storage (grows in MAX_ORDERS chunks instead of
+ *   dropping orders when a symbol's resting order count spikes)
  */
 class OrderBookL2 {
 public:
     static constexpr size_t MAX_LEVELS = 100; ///< const int variable representing MAX_LEVELS.
-    static constexpr size_t MAX_ORDERS = 100000; // Power of 2 recommended for faster mod, but we use strict capacity
+    static constexpr size_t MAX_ORDERS = 100000; // Orders per pool chunk (pool grows past this)
     static constexpr size_t HASH_SIZE = 131072; // Power of 2 > MAX_ORDERS for load factor < 0.8
     
     struct Level {
@@ -49,12 +51,18 @@ public:
     };
 
     using BBOListener = std::function<void(const BBOUpdate&)>;
+    using OrderPool = ObjectPool<OrderEntry, MAX_ORDERS>;
 
     /**
      * @brief Auto-generated description for OrderBookL2.
      * @param symbol_id Parameter description.
+     * @param memory Page size / NUMA node for the order pool (bind to the
+     *        node of the core that updates this book).
+     * @param order_storage Caller-owned first pool chunk
+     *        (OrderPool::chunk_bytes()), e.g. from the engine's arena;
+     *        nullptr maps it.
      */
-    OrderBookL2(SymbolId symbol_id);
+    explicit OrderBookL2(SymbolId symbol_id, const HugePageOptions& memory = {}, void* order_storage = nullptr);
 
          /**
           * @brief Auto-generated description for set_bbo_listener.
@@ -73,12 +81,31 @@ public:
     const PriceLevelSide& bids() const noexcept { return bids_; }
     const PriceLevelSide& asks() const noexcept { return asks_; }
 
+    /**
+     * @brief Off-hot-path housekeeping: grows the order pool once it crosses
+     *        its occupancy watermark. Call when the MD thread is idle.
+     */
+    void maintain() noexcept { order_pool_.maintain(); }
+
+    /**
+     * @brief Empties the book (orders back to the pool, levels cleared)
+     *        without unmapping anything, e.g. after a warm-up replay.
+     */
+    void reset() noexcept;
+
+    // Order pool occupancy (in_use, high_watermark, capacity, emergency_grows)
+    const OrderPool& order_pool() const noexcept { return order_pool_; }
+
+    // Adds rejected because the pool could not grow (max chunks reached or mmap failed)
+    uint64_t dropped_orders() const noexcept { return dropped_orders_; }
+
 private:
     SymbolId symbol_id_; ///< int variable representing symbol_id_.
     
     // --- 1. Order Storage (Object Pool) ---
     // Instead of allocating `L3Order` on heap, we use a pool.
     ObjectPool<OrderEntry, MAX_ORDERS> order_pool_; ///< int variable representing order_pool_.
+    uint64_t dropped_orders_{0}; ///< Adds lost to pool exhaustion.
 
     // --- 2. Order Lookup (Custom Hash Map) ---
     // Simple bucket array with chaining for this iteration. 
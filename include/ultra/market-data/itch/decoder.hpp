@@ -100,6 +100,10 @@ public:
     
     // Fast path: decode single message
     DecodedMessage decode(const uint8_t* data, size_t len, Timestamp rdtsc_ts) noexcept;
+
+    // Same, but decodes into caller storage (e.g. an SPSCQueue slot).
+    // Returns out.valid.
+    bool decode_into(const uint8_t* data, size_t len, Timestamp rdtsc_ts, DecodedMessage& out) noexcept;
     
     // Symbol lookup (pre-registered)
     void register_symbol(const char* symbol, SymbolId id);
@@ -1,6 +1,7 @@
 #pragma once
 #include "ouch_messages.hpp"
 #include <cstring>
+#include <string>
 #include <vector>
 #include <algorithm>
 
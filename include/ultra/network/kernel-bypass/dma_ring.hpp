@@ -1,11 +1,14 @@
 #pragma once
 #include <atomic>
 #include <cstdint>
+#include <cstring>
+#include <new>
 #include <vector>
 #include <sys/mman.h>
 #include <unistd.h>
 #include <iostream>
 #include "../../core/compiler.hpp"
+#include "../../core/lockfree/byte_ring.hpp"
 
 namespace ultra::network {
 
@@ -13,81 +16,89 @@ namespace ultra::network {
  * Simulated DMA Ring Buffer (Fig 1)
  * Mimics the shared memory structure used by VFIO-PCI cards (e.g., Solarflare, Mellanox).
  * In production, this memory is mapped from the NIC's BAR or pinned RAM.
+ *
+ * Packets are variable-length records in a ByteRing (8-byte header,
+ * 8-byte alignment) rather than fixed 2048-byte slots: the same 2MB holds
+ * ~43K 40-byte ITCH packets instead of 1024.
  */
 class DMARingBuffer {
 public:
-    static constexpr size_t SLOT_SIZE = 2048; // Standard MTU + padding
-    static constexpr size_t RING_SIZE = 1024; // Power of 2
-    static constexpr size_t BUFFER_SIZE = SLOT_SIZE * RING_SIZE; ///< const int variable representing BUFFER_SIZE.
+    static constexpr size_t BUFFER_SIZE = 2 * 1024 * 1024; // Same footprint as 1024 x 2048B slots
+    static constexpr size_t MAX_PACKET_SIZE = 2048; // Standard MTU + padding
 
-    struct ControlBlock {
-        alignas(64) std::atomic<uint32_t> head{0}; // Written by NIC (Producer)
-        alignas(64) std::atomic<uint32_t> tail{0}; // Written by SW (Consumer)
-    };
+    using Ring = ByteRing<BUFFER_SIZE>;
+    static_assert(MAX_PACKET_SIZE <= Ring::max_record_size());
 
     /**
-     * @brief Auto-generated description for DMARingBuffer.
+     * Maps the simulated DMA region (ring + control words) and constructs
+     * the ring in place.
      */
     DMARingBuffer() {
         // Allocate simulated DMA memory
         // In real code: mmap /dev/vfio/...
-        void* ptr = mmap(nullptr, BUFFER_SIZE + sizeof(ControlBlock), 
-                         PROT_READ | PROT_WRITE, 
+        void* ptr = mmap(nullptr, sizeof(Ring),
+                         PROT_READ | PROT_WRITE,
                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
         if (ptr == MAP_FAILED) {
             std::cerr << "Failed to allocate DMA buffer\n";
             abort();
         }
-        
-        control_ = new (ptr) ControlBlock();
-        buffer_base_ = reinterpret_cast<uint8_t*>(ptr) + sizeof(ControlBlock);
+
+        ring_ = new (ptr) Ring();
     }
 
-    /**
-     * @brief Auto-generated description for ~DMARingBuffer.
-     */
     ~DMARingBuffer() {
-        // munmap ...
+        ring_->~Ring();
+        munmap(ring_, sizeof(Ring));
     }
 
+    DMARingBuffer(const DMARingBuffer&) = delete;
+    DMARingBuffer& operator=(const DMARingBuffer&) = delete;
+
     // --- Consumer API (Poller Thread) ---
-    
+
     // Check if new data is available
     ULTRA_HOT inline bool has_data() const {
-        return control_->tail.load(std::memory_order_acquire) != 
-               control_->head.load(std::memory_order_acquire);
+        return !ring_->empty();
     }
 
-    // Get pointer to current packet
-    ULTRA_HOT inline const uint8_t* peek() const {
-        uint32_t idx = control_->tail.load(std::memory_order_relaxed) & (RING_SIZE - 1);
-        return buffer_base_ + (idx * SLOT_SIZE);
+    // Get pointer to current packet and its length (nullptr if none)
+    ULTRA_HOT inline const uint8_t* peek(size_t& len) {
+        auto pkt = ring_->peek();
+        len = pkt.size();
+        return pkt.empty() ? nullptr : pkt.data();
     }
 
     // Mark current packet as processed
     ULTRA_HOT inline void advance() {
-        // Increment tail
-        control_->tail.fetch_add(1, std::memory_order_release);
+        ring_->release();
     }
 
     // --- Producer API (Simulating FPGA DMA) ---
     // Only used for testing/simulation
-    void write_packet(const uint8_t* data, size_t len) {
-        uint32_t head = control_->head.load(std::memory_order_relaxed);
-        uint32_t idx = head & (RING_SIZE - 1);
-        uint8_t* dest = buffer_base_ + (idx * SLOT_SIZE);
-        
+
+    // Zero-copy: reserve room for up to max_len bytes, fill, then commit the
+    // actual length (what a NIC does when it DMAs into a posted buffer)
+    uint8_t* reserve(size_t max_len = MAX_PACKET_SIZE) {
+        return ring_->try_reserve(max_len);
+    }
+
+    void commit(size_t len) {
+        ring_->commit(len);
+    }
+
+    // Copying write; returns false (packet dropped) if the ring is full
+    bool write_packet(const uint8_t* data, size_t len) {
         // Simple memcpy simulating DMA write
-        size_t copy_len = (len > SLOT_SIZE) ? SLOT_SIZE : len;
-        std::memcpy(dest, data, copy_len);
-        
-        // Update head (commit)
-        control_->head.fetch_add(1, std::memory_order_release);
+        const size_t copy_len = (len > MAX_PACKET_SIZE) ? MAX_PACKET_SIZE : len;
+        return ring_->push(data, copy_len);
     }
 
+    // Ring bytes in use (occupancy under burst)
+    size_t used_bytes() const { return ring_->used_bytes(); }
+
 private:
-    ControlBlock* control_; ///< ControlBlock * variable representing control_.
-    uint8_t* buffer_base_; ///< int * variable representing buffer_base_.
+    Ring* ring_; ///< Ring placed in the simulated DMA region.
 };
 
 } // namespace ultra::network
@@ -0,0 +1,167 @@
+#pragma once
+#include "../../core/compiler.hpp"
+#include "../../core/types.hpp"
+#include "../parsers/ethernet_parser.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <linux/if_packet.h>
+
+namespace ultra::network {
+
+/**
+ * AF_PACKET TPACKET_V3 ring receiver ("kernel-bypass lite")
+ * The kernel writes whole Ethernet frames into an mmap'd ring of blocks and
+ * hands a block over once it is full or its timeout expires; the user side
+ * walks the block in place and returns it. Works on any Linux interface
+ * (eth, veth, lo) without DPDK or a special NIC.
+ *
+ * - No copy: frames are read where the kernel put them
+ * - No per-packet syscall: poll() only reads the block status word
+ * - Classic BPF filter attached in the kernel: IPv4/UDP, unfragmented,
+ *   destination in the configured groups (and ports), so only feed traffic
+ *   reaches the ring
+ * - Group membership is joined on a helper UDP socket so the NIC accepts
+ *   the multicast MACs (AF_PACKET itself does not join)
+ * - Latency floor: a partially filled block is retired after
+ *   block_timeout_ms, so on a quiet feed a frame can wait up to that long.
+ *   Size blocks for the burst rate, not the average
+ *
+ * Needs CAP_NET_RAW.
+ */
+class PacketRingReceiver {
+public:
+    struct Channel {
+        std::string group; ///< Multicast group, e.g. "233.54.12.111".
+        uint16_t port{0}; ///< UDP destination port (0: any).
+    };
+
+    struct Config {
+        std::string interface_name; ///< "eth0", "veth0", "lo", ...
+        std::string interface_ip; ///< For IP_ADD_MEMBERSHIP (empty: INADDR_ANY).
+        std::vector<Channel> channels; ///< Filter; empty = all IPv4/UDP.
+        uint32_t block_size = 1u << 20; ///< Bytes per block (multiple of the page size).
+        uint32_t block_count = 64; ///< Blocks in the ring.
+        uint32_t frame_size = 2048; ///< Frame slot hint (TPACKET_V3 packs frames tightly).
+        uint32_t block_timeout_ms = 1; ///< Retire a partly filled block after this long.
+        bool join_groups = true; ///< IP_ADD_MEMBERSHIP on a helper socket.
+    };
+
+    struct Frame {
+        const uint8_t* data; ///< Ethernet frame (starts at the MAC header).
+        uint32_t len; ///< Captured bytes.
+        Timestamp kernel_ts; ///< Kernel rx stamp, CLOCK_REALTIME ns.
+    };
+
+    struct Stats {
+        uint64_t packets; ///< Frames that passed the filter, drops included.
+        uint64_t drops; ///< Frames lost because the ring was full.
+        uint64_t freeze_count; ///< Times the queue froze on a full ring.
+    };
+
+    /** Default on_block_end for poll(). */
+    struct NoBlockEnd {
+        void operator()() const noexcept {}
+    };
+
+    explicit PacketRingReceiver(const Config& config);
+    ~PacketRingReceiver();
+
+    PacketRingReceiver(const PacketRingReceiver&) = delete;
+    PacketRingReceiver& operator=(const PacketRingReceiver&) = delete;
+
+    /**
+     * @brief Opens the socket, attaches the filter, maps the ring and binds
+     *        to the interface. Errors are reported with perror.
+     */
+    bool start();
+    void stop();
+
+    /**
+     * @brief Processes the next retired block, if any: calls on_frame(const
+     *        Frame&) for each frame in it, then returns the block to the
+     *        kernel. Frames are only valid inside the callback and in
+     *        on_block_end(), called once before the block goes back.
+     * @return Frames delivered (0 if the next block is still the kernel's).
+     */
+    template<typename OnFrame, typename OnBlockEnd = NoBlockEnd>
+    ULTRA_ALWAYS_INLINE size_t poll(OnFrame&& on_frame, OnBlockEnd&& on_block_end = {}) {
+        auto* block = reinterpret_cast<tpacket_block_desc*>(ring_ + static_cast<size_t>(current_) * config_.block_size);
+        std::atomic_ref<uint32_t> status(block->hdr.bh1.block_status);
+        if ((status.load(std::memory_order_acquire) & TP_STATUS_USER) == 0) return 0;
+
+        const uint32_t count = block->hdr.bh1.num_pkts;
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(block) + block->hdr.bh1.offset_to_first_pkt;
+        size_t delivered = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            const auto* hdr = reinterpret_cast<const tpacket3_hdr*>(p);
+            const auto* ll = reinterpret_cast<const sockaddr_ll*>(p + TPACKET_ALIGN(sizeof(tpacket3_hdr)));
+            if (ULTRA_LIKELY(ll->sll_pkttype != PACKET_OUTGOING)) { // Own sends on lo
+                on_frame(Frame{p + hdr->tp_mac, hdr->tp_snaplen,
+                               static_cast<Timestamp>(hdr->tp_sec) * 1'000'000'000ULL + hdr->tp_nsec});
+                ++delivered;
+            }
+            p += hdr->tp_next_offset;
+        }
+
+        on_block_end(); // Frames still valid here
+        status.store(TP_STATUS_KERNEL, std::memory_order_release);
+        current_ = current_ + 1 == config_.block_count ? 0 : current_ + 1;
+        ++blocks_;
+        frames_ += delivered;
+        return delivered;
+    }
+
+    /**
+     * @brief poll(), with the frames run through EthernetParser::parse_burst
+     *        BURST at a time; on_packet(const EthernetParser::ParsedPacket&)
+     *        sees valid UDP datagrams only (payload points into the ring),
+     *        with channel set to the index of the matching Config::channels
+     *        entry (NO_CHANNEL when no channels are configured).
+     */
+    template<typename OnPacket>
+    ULTRA_ALWAYS_INLINE size_t poll_udp(OnPacket&& on_packet) {
+        EthernetParser::Frame burst[BURST];
+        EthernetParser::ParsedPacket parsed[BURST];
+        size_t pending = 0;
+        auto flush = [&] {
+            const size_t kept = EthernetParser::parse_burst(burst, pending, parsed, flows_.empty() ? nullptr : &flows_,
+                                                            &parse_drops_);
+            for (size_t i = 0; i < kept; ++i) on_packet(parsed[i]);
+            pending = 0;
+        };
+        return poll(
+            [&](const Frame& f) {
+                burst[pending++] = {f.data, f.len, f.kernel_ts};
+                if (pending == BURST) flush();
+            },
+            [&] {
+                if (pending != 0) flush();
+            });
+    }
+
+    Stats stats() const; ///< Kernel counters since the previous call (PACKET_STATISTICS resets them).
+    uint64_t blocks() const noexcept { return blocks_; } ///< Blocks consumed.
+    uint64_t frames() const noexcept { return frames_; } ///< Frames delivered.
+    const EthernetParser::DropCounters& parse_drops() const noexcept { return parse_drops_; } ///< poll_udp() frames by outcome.
+    bool running() const noexcept { return ring_ != nullptr; }
+
+private:
+    static constexpr size_t BURST = 32; ///< Frames per parse_burst() in poll_udp().
+    bool attach_filter();
+    bool join_groups();
+
+    Config config_; ///< As given.
+    int fd_{-1}; ///< AF_PACKET socket.
+    int join_fd_{-1}; ///< UDP socket holding the group memberships.
+    uint8_t* ring_{nullptr}; ///< block_count * block_size mapping.
+    size_t ring_bytes_{0}; ///< Mapped length.
+    uint32_t current_{0}; ///< Next block to read.
+    uint64_t blocks_{0}; ///< See blocks().
+    uint64_t frames_{0}; ///< See frames().
+    FlowTable flows_; ///< Config::channels -> channel index.
+    EthernetParser::DropCounters parse_drops_{}; ///< See parse_drops().
+};
+
+} // namespace ultra::network
@@ -0,0 +1,152 @@
+#pragma once
+#include "../../core/compiler.hpp"
+#include "../../core/types.hpp"
+#include "../../core/memory/huge_page_allocator.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <linux/if_xdp.h>
+
+namespace ultra::network {
+
+/**
+ * AF_XDP (XSK) receiver with the DMARingBuffer consumer API
+ * The NIC driver (or the generic XDP hook) writes frames into a UMEM of
+ * fixed-size chunks that we own; the kernel passes chunk descriptors on the
+ * RX ring and takes chunks back on the FILL ring. has_data()/peek()/advance()
+ * read the frame where the NIC put it, so a poll loop written against the
+ * simulated DMARingBuffer runs unchanged on real traffic.
+ *
+ * - Zero-copy when the driver supports it; otherwise (veth, most virtual
+ *   NICs, the generic hook) the kernel copies into the UMEM and the API is
+ *   the same. Mode::AUTO tries zero-copy first
+ * - The XDP program is generated and loaded here (no libbpf): IPv4/UDP to
+ *   one of the configured ports is redirected to this socket, everything
+ *   else (ARP, other traffic) goes on to the kernel stack. It is attached
+ *   through a bpf link, so it goes away with the receiver
+ * - Ring indices are published once per drained batch, not per frame
+ * - No rx timestamps: AF_XDP descriptors carry none
+ *
+ * Needs CAP_NET_ADMIN + CAP_BPF (root) and kernel >= 5.9.
+ */
+class XDPReceiver {
+public:
+    enum class Mode {
+        AUTO, ///< Zero-copy if the driver allows it, else copy.
+        ZERO_COPY, ///< Fail if the driver cannot do zero-copy.
+        COPY ///< Always copy (works on every driver).
+    };
+
+    struct Config {
+        std::string interface_name; ///< "eth0", "veth0", ...
+        uint32_t queue_id = 0; ///< NIC rx queue to bind (steer the feed there with ethtool -N).
+        std::vector<uint16_t> ports; ///< UDP destination ports to redirect; empty = all UDP.
+        uint32_t frame_size = 2048; ///< UMEM chunk size (2048 or 4096).
+        uint32_t frame_count = 4096; ///< UMEM chunks (power of two).
+        uint32_t rx_ring_size = 2048; ///< RX descriptors (power of two).
+        Mode mode = Mode::AUTO; ///< Zero-copy policy.
+        bool generic_xdp = false; ///< Attach in SKB (generic) mode instead of driver mode.
+        HugePageOptions memory{}; ///< UMEM placement (populate is forced).
+    };
+
+    struct Stats {
+        uint64_t rx_dropped; ///< Dropped for other reasons (e.g. frame too large).
+        uint64_t rx_ring_full; ///< Dropped because the RX ring was full.
+        uint64_t fill_ring_empty; ///< Times the kernel found no free chunk.
+        uint64_t invalid_descs; ///< Bad descriptors on the FILL ring.
+    };
+
+    explicit XDPReceiver(const Config& config);
+    ~XDPReceiver();
+
+    XDPReceiver(const XDPReceiver&) = delete;
+    XDPReceiver& operator=(const XDPReceiver&) = delete;
+
+    /**
+     * @brief Maps the UMEM and rings, binds the socket to the queue, loads
+     *        and attaches the redirect program. Errors are reported with
+     *        perror.
+     */
+    bool start();
+    void stop();
+
+    // --- Consumer API (same as DMARingBuffer) ---
+
+    // Check if new data is available; when the current batch is used up
+    // this hands it back to the kernel and looks for the next one
+    ULTRA_HOT inline bool has_data() {
+        if (ULTRA_LIKELY(rx_cons_ != rx_cached_prod_)) return true;
+        return refill();
+    }
+
+    // Get pointer to the current frame (Ethernet header) and its length
+    // (nullptr if none)
+    ULTRA_HOT inline const uint8_t* peek(size_t& len) {
+        if (!has_data()) {
+            len = 0;
+            return nullptr;
+        }
+        const xdp_desc& desc = rx_.descs[rx_cons_ & rx_.mask];
+        len = desc.len;
+        return umem_base_ + desc.addr;
+    }
+
+    // Mark current frame as processed; its chunk goes back on the FILL ring
+    // (published with the next refill)
+    ULTRA_HOT inline void advance() {
+        const uint64_t addr = rx_.descs[rx_cons_ & rx_.mask].addr;
+        fill_.addrs[fill_prod_ & fill_.mask] = addr & ~static_cast<uint64_t>(config_.frame_size - 1);
+        ++fill_prod_;
+        ++rx_cons_;
+        ++frames_;
+    }
+
+    Stats stats() const; ///< Kernel counters (XDP_STATISTICS).
+    bool zero_copy() const noexcept { return zero_copy_; } ///< Bound with XDP_ZEROCOPY.
+    bool generic_mode() const noexcept { return generic_; } ///< Program runs at the generic (SKB) hook.
+    uint64_t frames() const noexcept { return frames_; } ///< Frames consumed.
+    uint64_t wakeups() const noexcept { return wakeups_; } ///< recvfrom() kicks for need_wakeup.
+    bool running() const noexcept { return xsk_fd_ >= 0; }
+
+private:
+    // One mmap'd producer/consumer ring shared with the kernel
+    struct Ring {
+        std::atomic<uint32_t>* producer{nullptr};
+        std::atomic<uint32_t>* consumer{nullptr};
+        uint32_t* flags{nullptr};
+        uint32_t mask{0};
+        void* map{nullptr};
+        size_t map_len{0};
+    };
+    struct RxRing : Ring { xdp_desc* descs{nullptr}; };
+    struct FillRing : Ring { uint64_t* addrs{nullptr}; };
+
+    bool refill();
+    bool setup_umem();
+    bool map_rings();
+    bool bind_socket();
+    bool load_program();
+
+    Config config_; ///< As given (sizes validated in start()).
+    int xsk_fd_{-1}; ///< AF_XDP socket.
+    int map_fd_{-1}; ///< XSKMAP: queue id -> socket.
+    int prog_fd_{-1}; ///< Redirect program.
+    int link_fd_{-1}; ///< bpf link attaching the program to the interface.
+    unsigned ifindex_{0}; ///< Interface index.
+    HugePageMapping umem_{}; ///< Frame memory.
+    uint8_t* umem_base_{nullptr}; ///< umem_.addr.
+    RxRing rx_{}; ///< Kernel -> us: filled frames.
+    FillRing fill_{}; ///< Us -> kernel: free chunks.
+    Ring completion_{}; ///< Required by bind; unused on rx.
+    uint32_t rx_cons_{0}; ///< Next descriptor to read.
+    uint32_t rx_cached_prod_{0}; ///< Kernel producer as of the last refill.
+    uint32_t fill_prod_{0}; ///< FILL entries written (published in refill).
+    bool zero_copy_{false}; ///< See zero_copy().
+    bool generic_{false}; ///< See generic_mode().
+    bool need_wakeup_{false}; ///< Bound with XDP_USE_NEED_WAKEUP.
+    uint64_t frames_{0}; ///< See frames().
+    uint64_t wakeups_{0}; ///< See wakeups().
+};
+
+} // namespace ultra::network
@@ -0,0 +1,218 @@
+#pragma once
+#include "../core/compiler.hpp"
+#include "../core/types.hpp"
+#include "multicast_receiver.hpp"
+#include "parsers/moldudp64.hpp"
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ultra::network {
+
+/**
+ * One venue's multicast channels, busy-polled from a single (pinned) thread
+ * Venues split a feed over several groups (by symbol range, A/B lines...);
+ * this owns one MulticastReceiver per channel and visits them round-robin
+ * on every poll(), without epoll: each visit is one receive_batch() on a
+ * non-blocking socket (or, with the IO_URING backend, a read of the
+ * completion ring, so idle channels cost no syscall).
+ *
+ * - Priority: channels with a higher priority are visited first on every
+ *   round; channels of equal priority rotate which one goes first, so none
+ *   is always last. strict_priority ends the round as soon as a tier
+ *   delivered something (lower tiers then wait until the higher ones are
+ *   quiet)
+ * - max_batches per channel bounds how long one busy channel is drained
+ *   before the next is looked at (0: until empty)
+ * - With the IO_URING backend all channels share one SQ thread
+ * - Per-channel sequence state: with Sequencing::MOLDUDP64 each packet's
+ *   header is checked against the next expected sequence; gaps (and the
+ *   messages missed), duplicates and heartbeats are counted, duplicates
+ *   are dropped and overlapping packets are trimmed to their new messages
+ *   before delivery. Session changes restart the sequence
+ */
+class MultiChannelReceiver {
+public:
+    enum class Sequencing {
+        NONE, ///< Payload delivered as received; no sequence tracking.
+        MOLDUDP64 ///< MoldUDP64 header checked and stripped.
+    };
+
+    struct ChannelConfig {
+        std::string name; ///< For reporting ("itch-a", "A-F"...).
+        std::string multicast_group; ///< Group address.
+        int port = 0; ///< UDP port.
+        int priority = 0; ///< Higher is visited first.
+        uint32_t max_batches = 1; ///< Batches drained per visit (0: until empty).
+    };
+
+    struct Config {
+        std::vector<ChannelConfig> channels; ///< One socket each.
+        MulticastReceiver::Config receiver{}; ///< Template for every channel (group/port overridden).
+        Sequencing sequencing = Sequencing::NONE; ///< Transport framing of every channel.
+        bool strict_priority = false; ///< End a round at the first tier that delivered.
+    };
+
+    struct ChannelStats {
+        uint64_t polls; ///< receive_batch() calls.
+        uint64_t empty_polls; ///< ...that returned nothing.
+        uint64_t packets; ///< Packets delivered.
+        uint64_t bytes; ///< Payload bytes delivered.
+        uint64_t truncated; ///< Oversized datagrams dropped by the receiver.
+        uint64_t gaps; ///< Sequence jumps forward.
+        uint64_t missed; ///< Messages skipped over by those jumps.
+        uint64_t duplicates; ///< Packets with only already-seen messages (dropped).
+        uint64_t heartbeats; ///< Packets with no messages.
+        uint64_t malformed; ///< Too short for the header or blocks (dropped).
+        uint64_t session_changes; ///< Sequence restarts on a new session id.
+        uint64_t next_sequence; ///< Next expected message sequence (0: not synced).
+        Timestamp last_rx_tsc; ///< TSC of the last delivered packet.
+    };
+
+    explicit MultiChannelReceiver(const Config& config);
+    ~MultiChannelReceiver();
+
+    MultiChannelReceiver(const MultiChannelReceiver&) = delete;
+    MultiChannelReceiver& operator=(const MultiChannelReceiver&) = delete;
+
+    /**
+     * @brief Opens and joins every channel. Fails (and closes the others)
+     *        if any channel fails; errors are reported by MulticastReceiver.
+     */
+    bool start();
+    void stop();
+
+    /**
+     * @brief One round over all channels in priority order; calls
+     *        on_packet(uint32_t channel, const MulticastReceiver::Packet&,
+     *        uint64_t first_sequence) for every packet delivered. With
+     *        MOLDUDP64 the packet starts at the first new message block
+     *        (first_sequence is its sequence); otherwise first_sequence is 0.
+     *        Packets stay valid as for MulticastReceiver::receive_batch().
+     * @return Packets delivered.
+     */
+    template<typename OnPacket>
+    ULTRA_HOT size_t poll(OnPacket&& on_packet) {
+        size_t delivered = 0;
+        for (Tier& tier : tiers_) {
+            const uint32_t size = tier.end - tier.begin;
+            uint32_t slot = tier.cursor;
+            for (uint32_t k = 0; k < size; ++k) {
+                delivered += drain(channels_[order_[tier.begin + slot]], on_packet);
+                slot = slot + 1 == size ? 0 : slot + 1;
+            }
+            tier.cursor = tier.cursor + 1 == size ? 0 : tier.cursor + 1;
+            if (config_.strict_priority && delivered != 0) break;
+        }
+        ++rounds_;
+        return delivered;
+    }
+
+    size_t channel_count() const noexcept { return channels_.size(); }
+    const ChannelConfig& channel_config(size_t channel) const { return config_.channels[channel]; }
+    ChannelStats stats(size_t channel) const; ///< Snapshot (truncated read from the receiver).
+    const MulticastReceiver& receiver(size_t channel) const { return *channels_[channel].receiver; } ///< After start().
+    uint64_t rounds() const noexcept { return rounds_; } ///< poll() calls.
+    void print_stats(std::ostream& os) const; ///< One line per channel.
+
+private:
+    struct Channel {
+        std::unique_ptr<MulticastReceiver> receiver; ///< Created by start().
+        uint32_t index{0}; ///< Position in config_.channels.
+        uint32_t max_batches{1};
+        ChannelStats stats{};
+        char session[10]{}; ///< Current MoldUDP64 session.
+    };
+
+    // Channels [begin, end) of order_ sharing one priority
+    struct Tier {
+        uint32_t begin;
+        uint32_t end;
+        uint32_t cursor; ///< Slot visited first next round.
+    };
+
+    template<typename OnPacket>
+    ULTRA_ALWAYS_INLINE size_t drain(Channel& ch, OnPacket& on_packet) {
+        size_t delivered = 0;
+        uint32_t batches = 0;
+        do {
+            ++ch.stats.polls;
+            const auto packets = ch.receiver->receive_batch();
+            if (packets.empty()) {
+                ++ch.stats.empty_polls;
+                break;
+            }
+            for (const auto& packet : packets) {
+                MulticastReceiver::Packet out = packet;
+                uint64_t first_sequence = 0;
+                if (config_.sequencing == Sequencing::MOLDUDP64 && !sequence(ch, out, first_sequence)) continue;
+                ++ch.stats.packets;
+                ch.stats.bytes += out.len;
+                ch.stats.last_rx_tsc = out.rx_tsc;
+                on_packet(ch.index, out, first_sequence);
+                ++delivered;
+            }
+        } while (++batches != ch.max_batches);
+        return delivered;
+    }
+
+    // Updates the channel's sequence state; trims `packet` to its unseen
+    // message blocks. False if there is nothing to deliver.
+    ULTRA_ALWAYS_INLINE bool sequence(Channel& ch, MulticastReceiver::Packet& packet, uint64_t& first_sequence) {
+        ChannelStats& st = ch.stats;
+        if (ULTRA_UNLIKELY(packet.len < sizeof(MoldUDP64Header))) {
+            ++st.malformed;
+            return false;
+        }
+        const auto* header = reinterpret_cast<const MoldUDP64Header*>(packet.data);
+        const uint64_t seq = moldudp64::sequence(*header);
+        const uint16_t raw_count = moldudp64::count(*header);
+        const uint64_t count = raw_count == moldudp64::END_OF_SESSION ? 0 : raw_count;
+        if (ULTRA_UNLIKELY(st.next_sequence == 0 || std::memcmp(ch.session, header->session, sizeof(ch.session)) != 0)) {
+            if (st.next_sequence != 0) ++st.session_changes;
+            std::memcpy(ch.session, header->session, sizeof(ch.session));
+            st.next_sequence = seq; // Join wherever the feed is
+        }
+        if (count == 0) {
+            ++st.heartbeats; // Carries the next sequence: a gap shows here too
+            if (seq > st.next_sequence) {
+                ++st.gaps;
+                st.missed += seq - st.next_sequence;
+                st.next_sequence = seq;
+            }
+            return false;
+        }
+        if (seq + count <= st.next_sequence) {
+            ++st.duplicates;
+            return false;
+        }
+        size_t skip = sizeof(MoldUDP64Header);
+        first_sequence = seq;
+        if (ULTRA_UNLIKELY(seq > st.next_sequence)) {
+            ++st.gaps;
+            st.missed += seq - st.next_sequence;
+        } else if (ULTRA_UNLIKELY(seq < st.next_sequence)) {
+            // Overlap: drop the blocks already delivered
+            const size_t seen = moldudp64::skip_blocks(packet.data + skip, packet.len - skip, st.next_sequence - seq);
+            if (seen > packet.len - skip) {
+                ++st.malformed;
+                return false;
+            }
+            skip += seen;
+            first_sequence = st.next_sequence;
+        }
+        st.next_sequence = seq + count;
+        packet.data += skip;
+        packet.len -= static_cast<uint32_t>(skip);
+        return true;
+    }
+
+    Config config_; ///< As given.
+    std::vector<Channel> channels_; ///< In config order.
+    std::vector<uint32_t> order_; ///< Channel indices by descending priority.
+    std::vector<Tier> tiers_; ///< Runs of equal priority in order_.
+    uint64_t rounds_{0}; ///< See rounds().
+};
+
+} // namespace ultra::network
@@ -1,10 +1,14 @@
 #pragma once
 #include "../core/compiler.hpp"
 #include "../core/types.hpp"
+#include "../core/memory/huge_page_allocator.hpp"
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 #include <atomic>
 #include <netinet/in.h>
+#include <sys/socket.h>
 
 namespace ultra::network {
 
@@ -15,15 +19,55 @@ namespace ultra::network {
  * - SO_REUSEPORT/SO_REUSEADDR
  * - Non-blocking IO
  * - Kernel Bypass simulation (via optimized socket options)
+ * - Batched receive: receive_batch() drains up to batch_size datagrams with
+ *   one recvmmsg() into a pre-faulted ring of MTU buffers, optionally with
+ *   SO_BUSY_POLL so the syscall spins on the NIC queue instead of sleeping
+ * - Kernel receive timestamps (SO_TIMESTAMPING): software rx stamps, plus
+ *   NIC hardware stamps when enabled on the interface, read from the cmsg
+ *   of each datagram so socket-queue delay is measurable
+ * - Backend::IO_URING: receive_batch() reaps completions of one multishot
+ *   recvmsg into registered provided buffers, with an SQPOLL thread, so
+ *   steady-state receive makes no syscalls (see UringReceive)
  */
+class UringReceive;
+
 class MulticastReceiver {
 public:
+    enum class Backend {
+        RECVMMSG, ///< recvmmsg() per receive_batch().
+        IO_URING ///< Multishot recvmsg + provided buffer ring + SQPOLL.
+    };
+
     struct Config {
         std::string interface_ip; ///< int variable representing interface_ip.
         std::string multicast_group; ///< int variable representing multicast_group.
         int port; ///< int variable representing port.
         bool non_blocking = true; ///< bool variable representing non_blocking.
         int receive_buffer_size = 16 * 1024 * 1024; // 16MB kernel buffer
+        uint32_t batch_size = 64; ///< Datagrams per receive_batch() (recvmmsg vlen).
+        uint32_t ring_batches = 2; ///< Batches kept alive in the buffer ring (>= 1).
+        uint32_t buffer_size = 2048; ///< Bytes per datagram buffer (>= MTU).
+        int busy_poll_us = 0; ///< SO_BUSY_POLL budget in us (0: off; >sysctl needs CAP_NET_ADMIN).
+        bool timestamping = true; ///< SO_TIMESTAMPING software rx stamps.
+        bool hardware_timestamps = false; ///< Also enable NIC rx stamping (SIOCSHWTSTAMP, needs root).
+        std::string interface_name; ///< NIC for hardware_timestamps (e.g. "eth0").
+        Backend backend = Backend::RECVMMSG; ///< How receive_batch() gets datagrams.
+        uint32_t uring_buffers = 1024; ///< IO_URING provided buffers (power of two, > batch_size * ring_batches).
+        bool uring_sqpoll = true; ///< IO_URING: SQ thread (falls back to io_uring_enter when idle).
+        int uring_sqpoll_cpu = -1; ///< IO_URING: core for the SQ thread (-1: unpinned).
+        int uring_attach_fd = -1; ///< IO_URING: share this ring's SQ thread (see UringReceive::ring_fd()).
+    };
+
+    /**
+     * One received datagram, pointing into the receiver's buffer ring.
+     * Valid until the ring wraps: for ring_batches - 1 further calls.
+     */
+    struct Packet {
+        const uint8_t* data; ///< Payload (UDP data).
+        uint32_t len; ///< Bytes received.
+        Timestamp rx_tsc; ///< RDTSC right after the syscall returned.
+        Timestamp kernel_ts; ///< Kernel/NIC rx stamp, CLOCK_REALTIME ns (0: none).
+        Timestamp user_ts; ///< CLOCK_REALTIME ns when the syscall returned (per batch).
     };
 
              /**
@@ -50,11 +94,46 @@ public:
     // Returns bytes received, or -1 if empty/error
     int receive(uint8_t* buffer, size_t max_len);
 
+    /**
+     * @brief Receive up to batch_size datagrams with a single recvmmsg()
+     *        (or, with the IO_URING backend, from the completion queue).
+     * @return Packets received (empty if none ready or on error). Truncated
+     *         datagrams (larger than buffer_size) are dropped and counted.
+     */
+    ULTRA_HOT std::span<const Packet> receive_batch();
+
+    // --- Stats ---
+    uint64_t batches() const noexcept { return batches_; } ///< Non-empty receive_batch() calls.
+    uint64_t packets() const noexcept { return packets_; } ///< Datagrams returned by receive_batch().
+    uint64_t truncated() const noexcept { return truncated_; } ///< Datagrams dropped as oversized.
+    bool hardware_timestamps_active() const noexcept { return hw_timestamps_; } ///< NIC stamping enabled.
+    Backend backend_active() const noexcept { return uring_ ? Backend::IO_URING : Backend::RECVMMSG; } ///< After start().
+    const UringReceive* uring() const noexcept { return uring_.get(); } ///< IO_URING state (nullptr otherwise).
+
 private:
+    void setup_ring();
+    void enable_timestamping();
+    bool start_uring();
+    std::span<const Packet> receive_batch_uring();
+
+
     Config config_; ///< Config variable representing config_.
     int sock_fd_{-1}; ///< int variable representing sock_fd_.
     std::atomic<bool> running_{false}; ///< int variable representing running_.
     struct sockaddr_in addr_; ///< struct sockaddr_in variable representing addr_.
+
+    // --- Batched receive ---
+    HugePageMapping ring_; ///< batch_size * ring_batches buffers.
+    uint32_t ring_batch_{0}; ///< Batch the next receive_batch() fills.
+    std::vector<mmsghdr> msgs_; ///< recvmmsg vector (one per ring buffer).
+    std::vector<iovec> iovecs_; ///< One per ring buffer.
+    std::vector<uint64_t> control_; ///< cmsg space per ring buffer (8-byte aligned).
+    std::vector<Packet> packets_out_; ///< Result storage (one per ring buffer).
+    uint64_t batches_{0}; ///< See batches().
+    uint64_t packets_{0}; ///< See packets().
+    uint64_t truncated_{0}; ///< See truncated().
+    bool hw_timestamps_{false}; ///< See hardware_timestamps_active().
+    std::unique_ptr<UringReceive> uring_; ///< IO_URING backend (null: recvmmsg).
 };
 
 } // namespace ultra::network
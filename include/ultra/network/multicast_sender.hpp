@@ -0,0 +1,85 @@
+#pragma once
+#include "../core/compiler.hpp"
+#include "../core/types.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+namespace ultra::network {
+
+/**
+ * Batched UDP multicast publisher (feed simulators, the md_replayer tool)
+ * Datagrams are built in place in the sender's buffers and go out with one
+ * sendmmsg() per batch, each to its own destination, so one socket and one
+ * syscall serve all of a venue's channels.
+ *
+ * - buffer() / commit(): write the next datagram, queue it
+ * - flush(): sends what is queued (also done when a batch fills up)
+ * - Loopback delivery on by default, so receivers on the same host (the
+ *   engine's socket path) see the traffic
+ */
+class MulticastSender {
+public:
+    struct Config {
+        std::string interface_ip; ///< IP_MULTICAST_IF (empty: routing table's choice).
+        int ttl = 1; ///< IP_MULTICAST_TTL.
+        bool loopback = true; ///< IP_MULTICAST_LOOP: deliver to receivers on this host.
+        uint32_t batch_size = 64; ///< Datagrams per sendmmsg().
+        uint32_t buffer_size = 2048; ///< Bytes per datagram buffer.
+        int send_buffer_size = 16 * 1024 * 1024; ///< SO_SNDBUF.
+    };
+
+    struct Stats {
+        uint64_t datagrams; ///< Sent.
+        uint64_t bytes; ///< Payload bytes sent.
+        uint64_t syscalls; ///< sendmmsg() calls.
+        uint64_t dropped; ///< Datagrams given up on after a send error.
+    };
+
+    explicit MulticastSender(const Config& config);
+    ~MulticastSender();
+
+    MulticastSender(const MulticastSender&) = delete;
+    MulticastSender& operator=(const MulticastSender&) = delete;
+
+    /**
+     * @brief Opens and configures the socket. Errors are reported with
+     *        perror.
+     */
+    bool start();
+    void stop();
+
+    /** @return Destination index for commit(), or -1 if `group` is not an IPv4 address. */
+    int add_destination(const std::string& group, int port);
+
+    /** Buffer (buffer_size bytes) for the next datagram. */
+    ULTRA_ALWAYS_INLINE uint8_t* buffer() noexcept { return buffers_.data() + static_cast<size_t>(pending_) * config_.buffer_size; }
+
+    /** @brief Queues the datagram written to buffer(); flushes a full batch. */
+    ULTRA_ALWAYS_INLINE bool commit(int destination, size_t len) noexcept {
+        mmsghdr& msg = msgs_[pending_];
+        msg.msg_hdr.msg_name = &destinations_[static_cast<size_t>(destination)];
+        msg.msg_hdr.msg_iov->iov_len = len;
+        return ++pending_ < config_.batch_size || flush();
+    }
+
+    /** @brief Sends every queued datagram. @return false if some were dropped. */
+    bool flush();
+
+    uint32_t pending() const noexcept { return pending_; }
+    const Stats& stats() const noexcept { return stats_; }
+
+private:
+    Config config_;
+    int sock_fd_{-1};
+    std::vector<sockaddr_in> destinations_;
+    std::vector<uint8_t> buffers_; ///< batch_size * buffer_size, touched at construction.
+    std::vector<iovec> iovecs_;
+    std::vector<mmsghdr> msgs_;
+    uint32_t pending_{0};
+    Stats stats_{};
+};
+
+} // namespace ultra::network
@@ -1,7 +1,11 @@
 #pragma once
 #include "../../core/compiler.hpp"
 #include "../../core/types.hpp"
+#include <array>
+#include <cstddef>
 #include <cstring>
+#include <vector>
+#include <arpa/inet.h>
 
 #if defined(__APPLE__)
     #include <net/ethernet.h>
@@ -36,6 +40,11 @@ struct IPv4Header {
     uint32_t dst_ip; ///< int variable representing dst_ip.
 };
 
+struct VLANTag {
+    uint16_t tci; ///< PCP (3 bits), DEI (1), VLAN id (12).
+    uint16_t ethertype; ///< Of what follows the tag.
+};
+
 struct UDPHeader {
     uint16_t src_port; ///< int variable representing src_port.
     uint16_t dst_port; ///< int variable representing dst_port.
@@ -45,12 +54,132 @@ struct UDPHeader {
 
 #pragma pack(pop)
 
+/**
+ * (dst ip, dst port) -> channel id, for telling a venue's feeds apart on
+ * raw frames. add() recompiles the flows into a collision-free table: the
+ * hash multiplier (and, if needed, the table size) is searched until every
+ * flow has a slot of its own, so lookup() is a multiply, a shift, one load
+ * and one compare, without a probe loop or a data-dependent branch. Keys
+ * are kept in network byte order; no allocation after setup.
+ * Port 0 matches any port of that group (tried after the exact key).
+ */
+class FlowTable {
+public:
+    static constexpr uint16_t NO_CHANNEL = 0xFFFF; ///< lookup() miss.
+
+    /** @brief dst_ip/dst_port in host byte order; replaces an existing flow. */
+    void add(uint32_t dst_ip, uint16_t dst_port, uint16_t channel) {
+        const uint64_t k = key(htonl(dst_ip), htons(dst_port));
+        auto it = flows_.begin();
+        while (it != flows_.end() && it->key != k) ++it;
+        if (it != flows_.end()) it->channel = channel;
+        else flows_.push_back({k, channel});
+        any_port_ |= dst_port == 0;
+        compile();
+    }
+
+    /** @brief Dotted-quad group; false if it does not parse. */
+    bool add(const char* group, uint16_t dst_port, uint16_t channel) {
+        in_addr addr{};
+        if (inet_pton(AF_INET, group, &addr) != 1) return false;
+        add(ntohl(addr.s_addr), dst_port, channel);
+        return true;
+    }
+
+    /** @brief dst_ip/dst_port in network byte order (as in ParsedPacket). */
+    ULTRA_ALWAYS_INLINE uint16_t lookup(uint32_t dst_ip, uint16_t dst_port) const noexcept {
+        const uint16_t channel = find(key(dst_ip, dst_port));
+        if (channel != NO_CHANNEL || !any_port_) return channel;
+        return find(key(dst_ip, 0));
+    }
+
+    size_t size() const noexcept { return flows_.size(); }
+    bool empty() const noexcept { return flows_.empty(); }
+    size_t slots() const noexcept { return slots_.size(); } ///< Compiled table size.
+
+private:
+    struct Slot {
+        uint64_t key; ///< EMPTY or ip << 16 | port (network order).
+        uint16_t channel;
+    };
+    static constexpr uint64_t EMPTY = ~0ULL; // Never a key: those fit in 48 bits
+
+    ULTRA_ALWAYS_INLINE static uint64_t key(uint32_t ip, uint16_t port) noexcept {
+        return static_cast<uint64_t>(ip) << 16 | port;
+    }
+    ULTRA_ALWAYS_INLINE uint16_t find(uint64_t k) const noexcept {
+        const Slot& s = slots_[static_cast<size_t>((k * multiplier_) >> shift_)];
+        return s.key == k ? s.channel : NO_CHANNEL;
+    }
+
+    // Tries odd multipliers (splitmix64 sequence) at 2x, 4x... the flow
+    // count until one maps every flow to its own slot. A few dozen flows
+    // settle at 4x-8x within a handful of tries.
+    void compile() {
+        unsigned bits = 1;
+        while ((size_t{1} << bits) < flows_.size() * 2) ++bits;
+        uint64_t seed = 0x9E3779B97F4A7C15ULL;
+        for (;; ++bits) {
+            const size_t size = size_t{1} << bits;
+            for (int attempt = 0; attempt < 64; ++attempt) {
+                uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                const uint64_t multiplier = (z ^ (z >> 31)) | 1;
+                slots_.assign(size, Slot{EMPTY, NO_CHANNEL});
+                bool collision = false;
+                for (const auto& f : flows_) {
+                    Slot& s = slots_[static_cast<size_t>((f.key * multiplier) >> (64 - bits))];
+                    if (s.key != EMPTY) {
+                        collision = true;
+                        break;
+                    }
+                    s = f;
+                }
+                if (!collision) {
+                    multiplier_ = multiplier;
+                    shift_ = 64 - bits;
+                    return;
+                }
+            }
+        }
+    }
+
+    std::vector<Slot> flows_; ///< As added.
+    std::vector<Slot> slots_{Slot{EMPTY, NO_CHANNEL}}; ///< Compiled table (power of two; one empty slot before add()).
+    uint64_t multiplier_{0}; ///< Found by compile().
+    unsigned shift_{63}; ///< 64 - log2(slots_.size()); any key >> 63 of 0 hits slot 0.
+    bool any_port_{false}; ///< Some flow has port 0.
+};
+
 /**
  * Zero-copy Ethernet/IP/UDP parser
  * Parses in-place, no allocations
+ * - Up to two VLAN tags: 802.1Q, and QinQ with an 802.1ad (0x88A8) or
+ *   legacy 0x9100 outer tag
+ * - Every header is checked to fit before it is read; the IP datagram must
+ *   fit in the frame (Ethernet padding past it is ignored) and the UDP
+ *   length in the IP datagram. Fragments are rejected (a first fragment
+ *   carries only part of the UDP payload)
+ * - parse_burst(): a vector of frames, prefetching a few frames ahead, with
+ *   an optional FlowTable tagging each datagram with its channel
  */
 class EthernetParser {
 public:
+    /** Why a frame was rejected (ParsedPacket::drop). */
+    enum class Drop : uint8_t {
+        NONE, ///< Valid.
+        TRUNCATED, ///< A header or the IP datagram runs past the frame.
+        NOT_IPV4, ///< Other ethertype (ARP, IPv6, a third VLAN tag...).
+        BAD_IP_HEADER, ///< Version != 4 or IHL < 5.
+        NOT_UDP, ///< Other IP protocol.
+        FRAGMENT, ///< MF set or non-zero fragment offset.
+        BAD_UDP_LENGTH, ///< UDP length < 8 or past the IP datagram.
+        NO_FLOW, ///< parse_burst(): not in the FlowTable.
+        COUNT
+    };
+    using DropCounters = std::array<uint64_t, static_cast<size_t>(Drop::COUNT)>;
+
     struct ParsedPacket {
         const uint8_t* payload; ///< const int * variable representing payload.
         uint16_t payload_len; ///< int variable representing payload_len.
@@ -60,21 +189,42 @@ public:
         uint16_t dst_port; ///< int variable representing dst_port.
         Timestamp timestamp_ns; ///< int variable representing timestamp_ns.
         bool valid; ///< bool variable representing valid.
+        Drop drop; ///< Reason when !valid.
+        uint16_t vlan_id; ///< Innermost VLAN id (0: untagged or priority-tagged).
+        uint16_t outer_vlan_id; ///< QinQ service VLAN id (0: single or no tag).
+        uint16_t channel; ///< FlowTable channel (parse_burst with a table; else NO_CHANNEL).
     };
-    
-                                            /**
-                                             * @brief Auto-generated description for parse.
-                                             * @param packet Parameter description.
-                                             * @param packet_len Parameter description.
-                                             * @param timestamp_ns Parameter description.
-                                             * @return ParsedPacket value.
-                                             */
+
+    /** One frame for parse_burst(). */
+    struct Frame {
+        const uint8_t* data; ///< Starts at the MAC header.
+        uint32_t len; ///< Bytes captured.
+        Timestamp timestamp_ns; ///< Copied to the ParsedPacket.
+    };
+
+    static constexpr size_t PREFETCH_AHEAD = 4; ///< Frames parse_burst() prefetches ahead.
+
+    /**
+     * @brief Parses one frame in place; payload points into it.
+     * @return valid UDP datagram, or valid = false with the reason in drop.
+     */
     ULTRA_ALWAYS_INLINE static ParsedPacket parse(
         const uint8_t* packet, 
         size_t packet_len,
         Timestamp timestamp_ns
     ) noexcept;
-    
+
+    /**
+     * @brief Parses frames[0, count) into out (room for count entries),
+     *        keeping only valid datagrams (and, with flows, only those with
+     *        a channel), in order.
+     * @param drops Per-reason frame counts, added to (optional; Drop::NONE
+     *        counts the frames kept).
+     * @return Datagrams written to out.
+     */
+    ULTRA_HOT static size_t parse_burst(const Frame* frames, size_t count, ParsedPacket* out,
+                                        const FlowTable* flows = nullptr, DropCounters* drops = nullptr) noexcept;
+
                                         /**
                                          * @brief Auto-generated description for ntohs_fast.
                                          * @param n Parameter description.
@@ -92,6 +242,109 @@ public:
     ULTRA_ALWAYS_INLINE static uint32_t ntohl_fast(uint32_t n) noexcept {
         return __builtin_bswap32(n);
     }
+
+private:
+    ULTRA_ALWAYS_INLINE static bool is_vlan(uint16_t ethertype_be) noexcept {
+        return ethertype_be == ntohs_fast(ETHERTYPE_VLAN) || ethertype_be == ntohs_fast(0x88A8) ||
+               ethertype_be == ntohs_fast(0x9100);
+    }
 };
 
+// Defined here so callers in other translation units can inline it
+ULTRA_ALWAYS_INLINE EthernetParser::ParsedPacket EthernetParser::parse(
+    const uint8_t* packet, 
+    size_t packet_len,
+    Timestamp timestamp_ns
+) noexcept {
+    ParsedPacket result = {nullptr, 0, 0, 0, 0, 0, timestamp_ns, false, Drop::TRUNCATED, 0, 0, FlowTable::NO_CHANNEL};
+
+    if (ULTRA_UNLIKELY(packet_len < sizeof(EthernetHeader))) return result;
+    uint16_t ethertype = reinterpret_cast<const EthernetHeader*>(packet)->ethertype;
+    size_t offset = sizeof(EthernetHeader);
+
+    // VLAN tags (usually stripped by the NIC; present on trunk ports and
+    // some capture setups)
+    if (ULTRA_UNLIKELY(is_vlan(ethertype))) {
+        if (ULTRA_UNLIKELY(packet_len < offset + sizeof(VLANTag))) return result;
+        const auto* tag = reinterpret_cast<const VLANTag*>(packet + offset);
+        result.vlan_id = ntohs_fast(tag->tci) & 0x0FFF;
+        ethertype = tag->ethertype;
+        offset += sizeof(VLANTag);
+        if (is_vlan(ethertype)) { // QinQ: that was the service tag
+            if (ULTRA_UNLIKELY(packet_len < offset + sizeof(VLANTag))) return result;
+            tag = reinterpret_cast<const VLANTag*>(packet + offset);
+            result.outer_vlan_id = result.vlan_id;
+            result.vlan_id = ntohs_fast(tag->tci) & 0x0FFF;
+            ethertype = tag->ethertype;
+            offset += sizeof(VLANTag);
+        }
+    }
+
+    if (ULTRA_UNLIKELY(ethertype != ntohs_fast(ETHERTYPE_IP))) {
+        result.drop = Drop::NOT_IPV4;
+        return result;
+    }
+    if (ULTRA_UNLIKELY(packet_len < offset + sizeof(IPv4Header))) return result;
+    const auto* ip_hdr = reinterpret_cast<const IPv4Header*>(packet + offset);
+    const size_t ip_header_len = (ip_hdr->version_ihl & 0x0F) * 4u;
+    if (ULTRA_UNLIKELY((ip_hdr->version_ihl & 0xF0) != 0x40 || ip_header_len < sizeof(IPv4Header))) {
+        result.drop = Drop::BAD_IP_HEADER;
+        return result;
+    }
+    if (ULTRA_UNLIKELY(ip_hdr->protocol != IPPROTO_UDP)) {
+        result.drop = Drop::NOT_UDP;
+        return result;
+    }
+    // The datagram, not the frame, bounds what follows: short frames are
+    // padded to 60 bytes
+    const size_t ip_len = ntohs_fast(ip_hdr->total_length);
+    if (ULTRA_UNLIKELY(ip_len < ip_header_len || offset + ip_len > packet_len)) return result;
+    if (ULTRA_UNLIKELY(ip_hdr->flags_offset & ntohs_fast(0x3FFF))) {
+        result.drop = Drop::FRAGMENT;
+        return result;
+    }
+    if (ULTRA_UNLIKELY(ip_len < ip_header_len + sizeof(UDPHeader))) {
+        result.drop = Drop::BAD_UDP_LENGTH;
+        return result;
+    }
+    const auto* udp_hdr = reinterpret_cast<const UDPHeader*>(packet + offset + ip_header_len);
+    const size_t udp_len = ntohs_fast(udp_hdr->length);
+    if (ULTRA_UNLIKELY(udp_len < sizeof(UDPHeader) || udp_len > ip_len - ip_header_len)) {
+        result.drop = Drop::BAD_UDP_LENGTH;
+        return result;
+    }
+
+    result.payload = packet + offset + ip_header_len + sizeof(UDPHeader);
+    result.payload_len = static_cast<uint16_t>(udp_len - sizeof(UDPHeader));
+    result.src_ip = ip_hdr->src_ip; // Already network byte order
+    result.dst_ip = ip_hdr->dst_ip; // Already network byte order
+    result.src_port = udp_hdr->src_port; // Already network byte order
+    result.dst_port = udp_hdr->dst_port; // Already network byte order
+    result.valid = true;
+    result.drop = Drop::NONE;
+    return result;
+}
+
+// Every result is stored and the output index only advances for kept
+// ones, so there is no branch on validity in the loop
+ULTRA_HOT inline size_t EthernetParser::parse_burst(const Frame* frames, size_t count, ParsedPacket* out,
+                                                    const FlowTable* flows, DropCounters* drops) noexcept {
+    size_t kept = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (i + PREFETCH_AHEAD < count) __builtin_prefetch(frames[i + PREFETCH_AHEAD].data);
+        ParsedPacket p = parse(frames[i].data, frames[i].len, frames[i].timestamp_ns);
+        if (flows && ULTRA_LIKELY(p.valid)) {
+            p.channel = flows->lookup(p.dst_ip, p.dst_port);
+            if (ULTRA_UNLIKELY(p.channel == FlowTable::NO_CHANNEL)) {
+                p.valid = false;
+                p.drop = Drop::NO_FLOW;
+            }
+        }
+        out[kept] = p;
+        kept += p.valid;
+        if (drops) ++(*drops)[static_cast<size_t>(p.drop)];
+    }
+    return kept;
+}
+
 } // namespace ultra::network
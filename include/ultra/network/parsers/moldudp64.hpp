@@ -0,0 +1,108 @@
+#pragma once
+#include "../../core/compiler.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ultra::network {
+
+#pragma pack(push, 1)
+
+/**
+ * MoldUDP64 downstream packet header (NASDAQ). Followed by message_count
+ * blocks of {uint16_t length (big-endian, excludes itself), message}.
+ * All fields big-endian.
+ */
+struct MoldUDP64Header {
+    char session[10]; ///< Session id, space padded.
+    uint64_t sequence_number; ///< Sequence of the first message in the packet.
+    uint16_t message_count; ///< Messages in the packet (0: heartbeat).
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(MoldUDP64Header) == 20);
+
+namespace moldudp64 {
+
+constexpr uint16_t END_OF_SESSION = 0xFFFF; ///< message_count of the session's last packet.
+
+ULTRA_ALWAYS_INLINE uint64_t sequence(const MoldUDP64Header& h) noexcept { return __builtin_bswap64(h.sequence_number); }
+ULTRA_ALWAYS_INLINE uint16_t count(const MoldUDP64Header& h) noexcept { return __builtin_bswap16(h.message_count); }
+
+/**
+ * @brief Skips `n` message blocks starting at `data`.
+ * @return Bytes skipped, or len + 1 if the blocks run past len.
+ */
+ULTRA_ALWAYS_INLINE size_t skip_blocks(const uint8_t* data, size_t len, uint64_t n) noexcept {
+    size_t offset = 0;
+    for (uint64_t i = 0; i < n; ++i) {
+        if (offset + 2 > len) return len + 1;
+        uint16_t block;
+        std::memcpy(&block, data + offset, sizeof(block));
+        offset += 2 + __builtin_bswap16(block);
+    }
+    return offset <= len ? offset : len + 1;
+}
+
+/**
+ * @brief Writes a message-less packet: a heartbeat carrying the next
+ *        sequence, or with END_OF_SESSION the session's last packet.
+ * @return sizeof(MoldUDP64Header).
+ */
+ULTRA_ALWAYS_INLINE size_t write_heartbeat(uint8_t* buffer, const char* session, uint64_t next_sequence,
+                                           uint16_t count = 0) noexcept {
+    MoldUDP64Header h;
+    std::memcpy(h.session, session, sizeof(h.session));
+    h.sequence_number = __builtin_bswap64(next_sequence);
+    h.message_count = __builtin_bswap16(count);
+    std::memcpy(buffer, &h, sizeof(h));
+    return sizeof(h);
+}
+
+} // namespace moldudp64
+
+/**
+ * Builds one MoldUDP64 packet in place in a send buffer: begin() writes the
+ * header, add() appends message blocks while they fit in max_size bytes,
+ * finish() fills in the message count.
+ */
+class MoldUDP64Packer {
+public:
+    /** @param session 10 bytes, space padded. */
+    ULTRA_ALWAYS_INLINE void begin(uint8_t* buffer, size_t max_size, const char* session, uint64_t sequence) noexcept {
+        buffer_ = buffer;
+        max_size_ = max_size;
+        size_ = moldudp64::write_heartbeat(buffer, session, sequence);
+        count_ = 0;
+    }
+
+    /** @return false (nothing written) if the block does not fit. */
+    ULTRA_ALWAYS_INLINE bool add(const uint8_t* message, uint16_t len) noexcept {
+        if (size_ + 2 + len > max_size_ || count_ == moldudp64::END_OF_SESSION - 1) return false;
+        const uint16_t block = __builtin_bswap16(len);
+        std::memcpy(buffer_ + size_, &block, sizeof(block));
+        std::memcpy(buffer_ + size_ + 2, message, len);
+        size_ += 2 + len;
+        ++count_;
+        return true;
+    }
+
+    /** @return Packet bytes. */
+    ULTRA_ALWAYS_INLINE size_t finish() noexcept {
+        const uint16_t count = __builtin_bswap16(count_);
+        std::memcpy(buffer_ + offsetof(MoldUDP64Header, message_count), &count, sizeof(count));
+        return size_;
+    }
+
+    uint16_t count() const noexcept { return count_; } ///< Messages added since begin().
+    size_t size() const noexcept { return size_; }
+
+private:
+    uint8_t* buffer_{nullptr};
+    size_t max_size_{0};
+    size_t size_{0};
+    uint16_t count_{0};
+};
+
+} // namespace ultra::network
@@ -0,0 +1,139 @@
+#pragma once
+#include "../../core/compiler.hpp"
+#include "../../core/types.hpp"
+#include "../parsers/ethernet_parser.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ultra::network {
+
+/**
+ * pcap / pcapng capture reader for market data replay
+ * The file is mmap'd read-only and walked in place: frames are handed out as
+ * pointers into the mapping, so replay costs no copy and no read() per
+ * packet. Feed them to EthernetParser, or use next_udp() which does.
+ *
+ * - pcap: microsecond and nanosecond magics, either byte order
+ * - pcapng: SHB (either byte order, several sections), IDB with
+ *   if_tsresol / if_tsoffset, EPB, SPB and the obsolete OPB; other blocks
+ *   are skipped
+ * - Link types: Ethernet and Linux cooked (SLL, "any" captures); frames on
+ *   other link types are skipped and counted
+ * - Timestamps are converted to ns since the epoch, the scale of the
+ *   receivers' kernel stamps, so replayed packets carry their capture time
+ *   as received_ts
+ * - A capture cut off mid-record (tcpdump killed) ends at the last whole
+ *   record; truncated() tells
+ */
+class PcapReader {
+public:
+    enum class Format : uint8_t { NONE, PCAP, PCAPNG };
+
+    struct Config {
+        bool populate = false; ///< Pre-fault the whole mapping (MAP_POPULATE) before replay starts.
+    };
+
+    struct Packet {
+        const uint8_t* data; ///< Frame from the Ethernet header (Linux cooked: see next()).
+        uint32_t caplen; ///< Bytes captured.
+        uint32_t wire_len; ///< Original frame length (>= caplen with a snaplen).
+        Timestamp timestamp_ns; ///< Capture time, ns since the epoch.
+        uint32_t interface; ///< pcapng interface id (0 for pcap).
+    };
+
+    PcapReader();
+    explicit PcapReader(const Config& config);
+    ~PcapReader();
+
+    PcapReader(const PcapReader&) = delete;
+    PcapReader& operator=(const PcapReader&) = delete;
+
+    /**
+     * @brief Maps the file and reads the file header. Errors are reported
+     *        on stderr (perror for system calls).
+     */
+    bool open(const std::string& path);
+    void close();
+
+    /** Back to the first packet. */
+    void rewind();
+
+    /**
+     * @brief Next frame on a supported link type. Linux cooked frames are
+     *        returned 2 bytes in, so the protocol field lines up with the
+     *        Ethernet ethertype and EthernetParser reads them unchanged.
+     * @return false at the end of the capture.
+     */
+    ULTRA_HOT bool next(Packet& packet);
+
+    /**
+     * @brief Next UDP datagram: next() through EthernetParser::parse, with
+     *        flows only those with a channel (set in out.channel).
+     *        timestamp_ns is the capture time.
+     */
+    ULTRA_ALWAYS_INLINE bool next_udp(EthernetParser::ParsedPacket& out, const FlowTable* flows = nullptr) {
+        Packet packet;
+        while (next(packet)) {
+            out = EthernetParser::parse(packet.data, packet.caplen, packet.timestamp_ns);
+            if (ULTRA_UNLIKELY(!out.valid)) {
+                ++not_udp_;
+                continue;
+            }
+            if (flows) {
+                out.channel = flows->lookup(out.dst_ip, out.dst_port);
+                if (out.channel == FlowTable::NO_CHANNEL) {
+                    ++filtered_;
+                    continue;
+                }
+            }
+            return true;
+        }
+        return false;
+    }
+
+    Format format() const noexcept { return format_; }
+    size_t size() const noexcept { return size_; } ///< Mapped bytes.
+    size_t position() const noexcept { return pos_; } ///< Read offset.
+    uint64_t packets() const noexcept { return packets_; } ///< Frames returned by next().
+    uint64_t skipped() const noexcept { return skipped_; } ///< Frames on unsupported link types.
+    uint64_t not_udp() const noexcept { return not_udp_; } ///< next_udp(): frames that were not UDP.
+    uint64_t filtered() const noexcept { return filtered_; } ///< next_udp(): datagrams not in the flows.
+    bool truncated() const noexcept { return truncated_; } ///< Stopped at a cut-off or malformed record.
+
+private:
+    struct Interface {
+        uint16_t link_type;
+        bool binary_resolution; ///< Ticks are 2^-exponent s (else 10^-exponent s).
+        uint8_t exponent;
+        int64_t offset_s; ///< if_tsoffset.
+    };
+
+    bool next_pcap(Packet& packet);
+    bool next_pcapng(Packet& packet);
+    bool add_interface(const uint8_t* body, size_t len);
+    bool deliver(Packet& packet, uint32_t interface, uint64_t ticks, const uint8_t* data, uint32_t caplen,
+                 uint32_t wire_len);
+    uint16_t load16(const uint8_t* p) const noexcept;
+    uint32_t load32(const uint8_t* p) const noexcept;
+    static Timestamp to_ns(const Interface& itf, uint64_t ticks) noexcept;
+    void stop(const char* why);
+
+    Config config_;
+    const uint8_t* base_{nullptr};
+    size_t size_{0};
+    size_t pos_{0};
+    size_t first_record_{0};
+    Format format_{Format::NONE};
+    bool swapped_{false}; ///< File (section) byte order differs from ours.
+    bool truncated_{false};
+    std::vector<Interface> interfaces_;
+    Timestamp last_ts_{0}; ///< SPBs carry no timestamp: they get the previous one.
+    uint64_t packets_{0};
+    uint64_t skipped_{0};
+    uint64_t not_udp_{0};
+    uint64_t filtered_{0};
+};
+
+} // namespace ultra::network
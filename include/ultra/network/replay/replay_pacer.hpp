@@ -0,0 +1,101 @@
+#pragma once
+#include "../../core/compiler.hpp"
+#include "../../core/spin_wait.hpp"
+#include "../../core/time/rdtsc_clock.hpp"
+#include "../../core/types.hpp"
+#include <algorithm>
+#include <cstdint>
+
+namespace ultra::network {
+
+/**
+ * Releases replayed packets on their capture timestamps
+ * The first packet is released at once and anchors capture time to
+ * RDTSCClock::now(); each later one is due when the capture time elapsed
+ * since the anchor, divided by speed, has passed.
+ *
+ * - speed 1: original inter-arrival times, bursts included; N: N times
+ *   faster; 0: as fast as possible (always due)
+ * - max_gap_ns: capture silences longer than this (overnight, halts,
+ *   stitched captures) are cut to it. 0: no limit
+ * - Timestamps going backwards (merged interfaces) release at once
+ * - due() is one rdtsc and a compare, so a poll loop can interleave it with
+ *   other work; wait() spins on it
+ */
+class ReplayPacer {
+public:
+    explicit ReplayPacer(double speed = 1.0, Timestamp max_gap_ns = 0) noexcept
+        : speed_(speed), max_gap_ns_(max_gap_ns) {}
+
+    /** Forget the anchor: the next packet is released at once. */
+    void reset() noexcept {
+        started_ = false;
+        lag_ns_ = 0;
+        max_lag_ns_ = 0;
+        late_ = 0;
+        gaps_cut_ = 0;
+    }
+
+    /** @brief Sets the release time of the next packet; once per packet, in capture order. */
+    ULTRA_ALWAYS_INLINE void schedule(Timestamp capture_ts) noexcept {
+        if (speed_ <= 0.0) return;
+        if (ULTRA_UNLIKELY(!started_)) {
+            started_ = true;
+            anchor_ns_ = RDTSCClock::now();
+            due_ns_ = anchor_ns_;
+            last_capture_ts_ = capture_ts;
+            elapsed_ns_ = 0;
+            return;
+        }
+        Timestamp gap = capture_ts > last_capture_ts_ ? capture_ts - last_capture_ts_ : 0;
+        if (max_gap_ns_ != 0 && gap > max_gap_ns_) {
+            gap = max_gap_ns_;
+            ++gaps_cut_;
+        }
+        last_capture_ts_ = std::max(last_capture_ts_, capture_ts);
+        elapsed_ns_ += gap;
+        due_ns_ = anchor_ns_ + static_cast<Timestamp>(static_cast<double>(elapsed_ns_) / speed_);
+    }
+
+    ULTRA_ALWAYS_INLINE bool due() const noexcept { return speed_ <= 0.0 || RDTSCClock::now() >= due_ns_; }
+
+    void wait() const noexcept {
+        while (!due()) SpinWait::spin();
+    }
+
+    static constexpr Timestamp LATE_NS = 1000; ///< Released this far past due counts as late.
+
+    /**
+     * @brief Records that the scheduled packet went out at `now`, for the
+     *        lateness figures (a sender busy with a burst falls behind).
+     */
+    ULTRA_ALWAYS_INLINE void released(Timestamp now) noexcept {
+        if (speed_ <= 0.0 || now <= due_ns_ + LATE_NS) return;
+        const Timestamp lag = now - due_ns_;
+        lag_ns_ += lag;
+        max_lag_ns_ = std::max(max_lag_ns_, lag);
+        ++late_;
+    }
+
+    double speed() const noexcept { return speed_; }
+    Timestamp due_ns() const noexcept { return due_ns_; } ///< Release time of the scheduled packet (RDTSCClock::now() scale).
+    uint64_t late() const noexcept { return late_; } ///< Packets released more than LATE_NS after due.
+    Timestamp max_lag_ns() const noexcept { return max_lag_ns_; }
+    Timestamp mean_lag_ns() const noexcept { return late_ ? lag_ns_ / late_ : 0; } ///< Over late packets.
+    uint64_t gaps_cut() const noexcept { return gaps_cut_; } ///< Silences shortened to max_gap_ns.
+
+private:
+    double speed_;
+    Timestamp max_gap_ns_;
+    bool started_{false};
+    Timestamp anchor_ns_{0};
+    Timestamp due_ns_{0};
+    Timestamp last_capture_ts_{0};
+    Timestamp elapsed_ns_{0}; ///< Capture time since the anchor, after gap cuts.
+    Timestamp lag_ns_{0};
+    Timestamp max_lag_ns_{0};
+    uint64_t late_{0};
+    uint64_t gaps_cut_{0};
+};
+
+} // namespace ultra::network
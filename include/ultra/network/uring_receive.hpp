@@ -0,0 +1,178 @@
+#pragma once
+#include "../core/compiler.hpp"
+#include "../core/memory/huge_page_allocator.hpp"
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <vector>
+#include <linux/io_uring.h>
+#include <sys/socket.h>
+
+namespace ultra::network {
+
+/**
+ * io_uring receive engine for one datagram socket (MulticastReceiver's
+ * IO_URING backend)
+ * - One multishot IORING_OP_RECVMSG stays armed: every datagram posts a
+ *   completion without a new submission
+ * - Provided buffer ring: the kernel picks a free buffer per datagram and
+ *   writes {io_uring_recvmsg_out, cmsg, payload} into it; buffers go back
+ *   by bumping the ring tail, no syscall. start() probes the ring once;
+ *   kernels that register it but never select from it get classic
+ *   provided buffers instead (returned with PROVIDE_BUFFERS SQEs, which
+ *   the SQ thread picks up, so still no syscall with SQPOLL)
+ * - SQPOLL: the request is owned by the kernel's SQ thread, so completions
+ *   are posted without the MD thread entering the kernel; reap() only reads
+ *   the CQ ring. Without SQPOLL (unprivileged on old kernels) an empty poll
+ *   costs one io_uring_enter to run the pending completions
+ * - Multishot ends when no buffer is free (or on error); reap() re-arms it
+ */
+class UringReceive {
+public:
+    struct Config {
+        uint32_t buffer_count = 1024; ///< Provided buffers (power of two, <= 32768).
+        uint32_t payload_size = 2048; ///< Max datagram bytes per buffer.
+        uint32_t control_len = 0; ///< cmsg space per buffer (0: no ancillary data).
+        uint32_t batch_size = 64; ///< Completions per reap().
+        uint32_t ring_batches = 2; ///< Batches whose buffers stay valid (>= 1).
+        bool sqpoll = true; ///< IORING_SETUP_SQPOLL (falls back to plain if refused).
+        int sqpoll_cpu = -1; ///< Pin the SQ thread (-1: unpinned).
+        uint32_t sqpoll_idle_ms = 1000; ///< SQ thread spins this long before sleeping.
+        int attach_ring_fd = -1; ///< ring_fd() of another instance whose SQ thread to share (-1: own).
+        HugePageOptions memory{}; ///< Buffer placement (populate is forced).
+    };
+
+    /** One received datagram inside a provided buffer. */
+    struct Message {
+        const uint8_t* payload; ///< UDP data.
+        uint32_t len; ///< Bytes in the buffer (<= payload_size).
+        bool truncated; ///< Datagram was larger than payload_size.
+        msghdr* control; ///< Ancillary data (msg_control/msg_controllen), for CMSG_FIRSTHDR.
+    };
+
+    explicit UringReceive(const Config& config);
+    ~UringReceive();
+
+    UringReceive(const UringReceive&) = delete;
+    UringReceive& operator=(const UringReceive&) = delete;
+
+    /**
+     * @brief Creates the ring, registers the buffers and arms the multishot
+     *        receive on sock_fd. Errors are reported with perror.
+     */
+    bool start(int sock_fd);
+    void stop();
+
+    /**
+     * @brief Hands back the buffers of the batch from ring_batches calls
+     *        ago, then calls on_msg(const Message&) for up to batch_size
+     *        completions. Messages stay valid for ring_batches - 1 further
+     *        non-empty calls.
+     * @return Datagrams delivered, truncated ones included (error
+     *         completions are consumed but not counted).
+     */
+    template<typename OnMessage>
+    ULTRA_HOT size_t reap(OnMessage&& on_message) {
+        recycle(batch_);
+        uint32_t head = *cq_head_; // Only we move it
+        const uint32_t tail = cq_tail_->load(std::memory_order_acquire);
+        if (head == tail) {
+            idle();
+            return 0;
+        }
+        auto& held = held_[batch_];
+        size_t count = 0;
+        while (head != tail && count < config_.batch_size) {
+            const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+            ++head;
+            // Anything else is a failed PROVIDE_BUFFERS (successes are skipped)
+            if (ULTRA_UNLIKELY(cqe.user_data != RECV_USER_DATA)) continue;
+            if (ULTRA_UNLIKELY(!(cqe.flags & IORING_CQE_F_MORE))) armed_ = false;
+            if (ULTRA_UNLIKELY(cqe.res < 0 || !(cqe.flags & IORING_CQE_F_BUFFER))) {
+                if (cqe.res == -ENOBUFS) ++no_buffer_;
+                continue;
+            }
+            const uint16_t bid = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+            held.push_back(bid);
+            uint8_t* buf = buffers_ + static_cast<size_t>(bid) * buffer_stride_;
+            const auto* out = reinterpret_cast<const io_uring_recvmsg_out*>(buf);
+            control_view_.msg_control = buf + sizeof(io_uring_recvmsg_out); // No name requested
+            control_view_.msg_controllen = out->controllen;
+            const uint32_t len = out->payloadlen < config_.payload_size ? out->payloadlen : config_.payload_size;
+            on_message(Message{buf + sizeof(io_uring_recvmsg_out) + config_.control_len, len,
+                               (out->flags & MSG_TRUNC) != 0 || out->payloadlen > config_.payload_size,
+                               &control_view_});
+            ++count;
+        }
+        cq_head_store(head);
+        if (count != 0) batch_ = batch_ + 1 == config_.ring_batches ? 0 : batch_ + 1;
+        if (ULTRA_UNLIKELY(!armed_)) arm(); // Buffers are back before the next datagram needs one
+        return count;
+    }
+
+    bool sqpoll_active() const noexcept { return sqpoll_; } ///< Ring runs with an SQ thread.
+    int ring_fd() const noexcept { return ring_fd_; } ///< For Config::attach_ring_fd of further instances.
+    bool buffer_ring_active() const noexcept { return !legacy_buffers_; } ///< Registered buffer ring (else PROVIDE_BUFFERS).
+    uint64_t no_buffer() const noexcept { return no_buffer_; } ///< Times the kernel ran out of buffers.
+    uint64_t rearms() const noexcept { return rearms_; } ///< Multishot re-submissions after start.
+    uint64_t enters() const noexcept { return enters_; } ///< io_uring_enter calls after start.
+
+private:
+    static constexpr uint64_t RECV_USER_DATA = 1; ///< user_data of the multishot recvmsg.
+
+    bool setup_ring();
+    bool setup_buffers();
+    bool probe_buffer_ring();
+    io_uring_sqe* next_sqe();
+    void submit(uint32_t count);
+    bool submit_and_wait(int32_t& res);
+    void provide_pending();
+    void arm();
+    void idle();
+    void recycle(uint32_t batch);
+    void cq_head_store(uint32_t head) {
+        std::atomic_ref<uint32_t>(*cq_head_).store(head, std::memory_order_release);
+    }
+
+    Config config_; ///< As given.
+    int ring_fd_{-1}; ///< io_uring instance.
+    int sock_fd_{-1}; ///< Socket being received from (not owned).
+    bool sqpoll_{false}; ///< See sqpoll_active().
+    bool armed_{false}; ///< Multishot recvmsg outstanding.
+
+    // Rings (one mapping for SQ+CQ with IORING_FEAT_SINGLE_MMAP)
+    void* ring_map_{nullptr}; ///< SQ/CQ ring mapping.
+    size_t ring_map_len_{0}; ///< Its length.
+    io_uring_sqe* sqes_{nullptr}; ///< SQE array mapping.
+    size_t sqes_len_{0}; ///< Its length.
+    std::atomic<uint32_t>* sq_head_{nullptr}; ///< SQ head (kernel consumes).
+    std::atomic<uint32_t>* sq_tail_{nullptr}; ///< SQ tail (we produce).
+    std::atomic<uint32_t>* sq_flags_{nullptr}; ///< IORING_SQ_NEED_WAKEUP.
+    uint32_t* sq_array_{nullptr}; ///< SQ index array.
+    uint32_t sq_mask_{0}; ///< SQ entries - 1.
+    uint32_t sq_pending_tail_{0}; ///< SQ tail including SQEs not yet published.
+    uint32_t* cq_head_{nullptr}; ///< CQ head (we consume).
+    std::atomic<uint32_t>* cq_tail_{nullptr}; ///< CQ tail (kernel produces).
+    io_uring_cqe* cqes_{nullptr}; ///< CQE array.
+    uint32_t cq_mask_{0}; ///< CQ entries - 1.
+
+    // Provided buffers
+    io_uring_buf_ring* buf_ring_{nullptr}; ///< Shared ring of free buffers.
+    size_t buf_ring_len_{0}; ///< Its mapping length.
+    HugePageMapping buffer_map_{}; ///< buffer_count * buffer_stride_ bytes.
+    uint8_t* buffers_{nullptr}; ///< buffer_map_.addr.
+    uint32_t buffer_stride_{0}; ///< recvmsg_out + control_len + payload_size.
+    uint16_t buf_tail_{0}; ///< Free-buffer ring tail (we produce).
+    bool legacy_buffers_{false}; ///< Buffers returned with PROVIDE_BUFFERS.
+    std::vector<uint16_t> to_provide_; ///< Legacy: buffer ids waiting for SQ space.
+    std::vector<std::vector<uint16_t>> held_; ///< Buffer ids handed out, per batch.
+    uint32_t batch_{0}; ///< Batch the next reap() fills.
+    msghdr msg_{}; ///< Template for the multishot recvmsg (name/control sizes).
+    msghdr control_view_{}; ///< Per-message cmsg view handed to on_message.
+
+    uint64_t no_buffer_{0}; ///< See no_buffer().
+    uint64_t rearms_{0}; ///< See rearms().
+    uint64_t enters_{0}; ///< See enters().
+};
+
+} // namespace ultra::network
@@ -26,6 +26,9 @@ public:
 
     void on_execution(const exec::ExecutionReport& report) noexcept;
 
+    // Back to a flat, start-of-session state (limits unchanged)
+    void reset() noexcept;
+
 private:
     Config config_;
     
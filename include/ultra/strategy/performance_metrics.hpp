@@ -1,5 +1,8 @@
 #pragma once
 #include "../core/simd_utils.hpp"
+#include "../core/memory/scratch_arena.hpp"
+#include <memory_resource>
+#include <span>
 #include <vector>
 #include <cmath>
 #include <algorithm>
@@ -41,7 +44,8 @@ public:
                               * @param risk_free_rate Parameter description.
                               * @return PerformanceReport value.
                               */
-    static PerformanceReport analyze(const std::vector<double>& equity_curve, double risk_free_rate = 0.0) {
+    static PerformanceReport analyze(std::span<const double> equity_curve, double risk_free_rate = 0.0) {
+        ScratchArena::Scope scratch; // Return series live for this call only
         PerformanceReport report{};
         size_t n = equity_curve.size();
         if (n < 2) return report;
@@ -58,7 +62,7 @@ public:
         report.cagr = report.total_return; // Placeholder if time unknown
 
         // 2. Returns Series
-        std::vector<double> returns;
+        std::pmr::vector<double> returns(&scratch.arena());
         returns.reserve(n-1);
         for (size_t i = 1; i < n; ++i) {
             returns.push_back((equity_curve[i] - equity_curve[i-1]) / equity_curve[i-1]);
@@ -78,7 +82,8 @@ public:
         }
 
         // 4. Sortino Ratio (Downside Deviation)
-        std::vector<double> neg_returns;
+        std::pmr::vector<double> neg_returns(&scratch.arena());
+        neg_returns.reserve(n-1);
         for (double r : returns) {
             if (r < 0) neg_returns.push_back(r);
         }
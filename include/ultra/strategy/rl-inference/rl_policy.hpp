@@ -14,7 +14,13 @@ namespace ultra::strategy {
  */
 class RLPolicyStrategy : public IStrategy {
 public:
-    explicit RLPolicyStrategy(SymbolId symbol_id);
+    /**
+     * @param memory Order-book pool placement (pass populate=true to have
+     *        the pool faulted in at construction rather than on first add).
+     * @param order_storage First book pool chunk, caller-owned (see
+     *        OrderBookL2); nullptr maps it under `memory`.
+     */
+    explicit RLPolicyStrategy(SymbolId symbol_id, const HugePageOptions& memory = {}, void* order_storage = nullptr);
     /**
      * @brief Auto-generated description for ~RLPolicyStrategy.
      */
@@ -37,6 +43,15 @@ public:
           */
     bool get_order(StrategyOrder& order) override;
 
+    // Drops book, inventory and queued orders (after a warm-up replay)
+    void reset() noexcept;
+
+    // Off-hot-path housekeeping (book pool growth); call when the strategy
+    // thread is idle
+    void maintain() noexcept { order_book_.maintain(); }
+
+    const md::OrderBookL2& order_book() const noexcept { return order_book_; }
+
 private:
     // This is the "Decision Engine" from your thesis, Fig 5 [cite: 175]
     void run_inference() noexcept;
@@ -1,6 +1,9 @@
 #pragma once
 #include "../core/simd_utils.hpp"
+#include "../core/memory/scratch_arena.hpp"
 #include <vector>
+#include <memory_resource>
+#include <span>
 #include <algorithm>
 
 namespace ultra::strategy {
@@ -8,6 +11,10 @@ namespace ultra::strategy {
 /**
  * Vectorized Signal Engine
  * Computes indicators on batches of data using AVX2.
+ *
+ * The std::pmr overloads place results in the given memory resource (e.g.
+ * a ScratchArena scoped to one backtest step); intermediate work vectors
+ * always come from the calling thread's ScratchArena.
  */
 class SignalEngine {
 public:
@@ -18,14 +25,54 @@ public:
         return result;
     }
 
+    static std::pmr::vector<double> sma(std::span<const double> prices, int window, std::pmr::memory_resource* mr) {
+        std::pmr::vector<double> result(prices.size(), mr);
+        SIMDUtils::compute_rolling_mean(prices.data(), prices.size(), window, result.data());
+        return result;
+    }
+
     // Relative Strength Index (Vectorized)
     static std::vector<double> rsi(const std::vector<double>& prices, int period = 14) {
         size_t n = prices.size();
         if (n <= static_cast<size_t>(period)) return std::vector<double>(n, 50.0);
 
         std::vector<double> rsi_vec(n);
-        std::vector<double> gains(n, 0.0);
-        std::vector<double> losses(n, 0.0);
+        rsi_into(prices, period, rsi_vec.data());
+        return rsi_vec;
+    }
+
+    static std::pmr::vector<double> rsi(std::span<const double> prices, int period, std::pmr::memory_resource* mr) {
+        size_t n = prices.size();
+        if (n <= static_cast<size_t>(period)) return std::pmr::vector<double>(n, 50.0, mr);
+
+        std::pmr::vector<double> rsi_vec(n, mr); // Allocated before rsi_into's scratch scope opens
+        rsi_into(prices, period, rsi_vec.data());
+        return rsi_vec;
+    }
+    
+    // Generate signals based on MA Crossover (Vectorized)
+    // Returns 1 (Buy), -1 (Sell), 0 (Hold)
+    static std::vector<int> ma_crossover_signal(const std::vector<double>& fast_ma, const std::vector<double>& slow_ma) {
+        std::vector<int> signals(std::min(fast_ma.size(), slow_ma.size()), 0);
+        crossover_into(fast_ma, slow_ma, signals);
+        return signals;
+    }
+
+    static std::pmr::vector<int> ma_crossover_signal(std::span<const double> fast_ma, std::span<const double> slow_ma,
+                                                     std::pmr::memory_resource* mr) {
+        std::pmr::vector<int> signals(std::min(fast_ma.size(), slow_ma.size()), 0, mr);
+        crossover_into(fast_ma, slow_ma, signals);
+        return signals;
+    }
+
+private:
+    // out[0..n) must be zero-initialised; entries below `period` stay 0
+    static void rsi_into(std::span<const double> prices, int period, double* out) {
+        const size_t n = prices.size();
+        ScratchArena::Scope scratch;
+        std::pmr::memory_resource* mr = &scratch.arena();
+        std::pmr::vector<double> gains(n, 0.0, mr);
+        std::pmr::vector<double> losses(n, 0.0, mr);
 
         // 1. Calculate Deltas
         for (size_t i = 1; i < n; ++i) {
@@ -37,35 +84,27 @@ public:
         // 2. Rolling Average of Gains/Losses (Smoothed is standard RSI, here simple for speed/example)
         // Using SMA for simplicity in this vector example, though Wilders is standard.
         // To use SIMDUtils::compute_rolling_mean, we treat it as SMA-RSI
-        std::vector<double> avg_gain(n), avg_loss(n);
+        std::pmr::vector<double> avg_gain(n, mr), avg_loss(n, mr);
         SIMDUtils::compute_rolling_mean(gains.data(), n, period, avg_gain.data());
         SIMDUtils::compute_rolling_mean(losses.data(), n, period, avg_loss.data());
 
         // 3. Compute RS and RSI
         for (size_t i = period; i < n; ++i) {
             double rs = (avg_loss[i] == 0) ? 100.0 : (avg_gain[i] / avg_loss[i]);
-            rsi_vec[i] = 100.0 - (100.0 / (1.0 + rs));
+            out[i] = 100.0 - (100.0 / (1.0 + rs));
         }
-
-        return rsi_vec;
     }
-    
-    // Generate signals based on MA Crossover (Vectorized)
-    // Returns 1 (Buy), -1 (Sell), 0 (Hold)
-    static std::vector<int> ma_crossover_signal(const std::vector<double>& fast_ma, const std::vector<double>& slow_ma) {
-        size_t n = std::min(fast_ma.size(), slow_ma.size());
-        std::vector<int> signals(n, 0);
-        
+
+    static void crossover_into(std::span<const double> fast_ma, std::span<const double> slow_ma, std::span<int> signals) {
         // This loop can be auto-vectorized by modern compilers (-O3 -mavx2)
         // Explicit intrinsics for int comparison/blending is verbose, trusting compiler here.
-        for (size_t i = 1; i < n; ++i) {
+        for (size_t i = 1; i < signals.size(); ++i) {
             if (fast_ma[i] > slow_ma[i] && fast_ma[i-1] <= slow_ma[i-1]) {
                 signals[i] = 1; // Golden Cross
             } else if (fast_ma[i] < slow_ma[i] && fast_ma[i-1] >= slow_ma[i-1]) {
                 signals[i] = -1; // Death Cross
             }
         }
-        return signals;
     }
 };
 
@@ -0,0 +1,56 @@
+#include "ultra/core/memory/hot_arena.hpp"
+#include <iomanip>
+#include <iostream>
+
+namespace ultra {
+
+HotArena::HotArena(size_t capacity, const HugePageOptions& options)
+    : mapping_(HugePages::map(capacity, options)), options_(options) {
+    if (mapping_.addr == nullptr) throw std::bad_alloc();
+    placements_.reserve(32);
+    destructors_.reserve(32);
+}
+
+HotArena::~HotArena() {
+    for (auto it = destructors_.rbegin(); it != destructors_.rend(); ++it) {
+        it->destroy(it->object);
+    }
+    HugePages::unmap(mapping_);
+}
+
+void* HotArena::allocate(const char* name, size_t bytes, size_t align) {
+    if (align < CACHE_LINE) align = CACHE_LINE;
+    const size_t offset = (used_ + align - 1) & ~(align - 1);
+    if (offset + bytes > mapping_.bytes) {
+        std::cerr << "HotArena: '" << name << "' (" << bytes << " bytes) does not fit: "
+                  << used_ << "/" << mapping_.bytes << " used\n";
+        throw std::bad_alloc();
+    }
+    // Round the end up to a cache line so the next placement never shares one
+    used_ = (offset + bytes + CACHE_LINE - 1) & ~(CACHE_LINE - 1);
+    placements_.push_back({name, offset, bytes, align});
+    return base() + offset;
+}
+
+void HotArena::print_layout(std::ostream& os) const {
+    const size_t page = page_bytes(mapping_.page_size);
+    os << "Hot arena @ " << mapping_.addr << ": " << used_ / 1024 << " KB used of "
+       << mapping_.bytes / 1024 << " KB, " << to_string(mapping_.page_size) << " pages ("
+       << (used_ + page - 1) / page << " touched)";
+    if (mapping_.page_size != options_.page_size) os << " [requested " << to_string(options_.page_size) << "]";
+    os << (mapping_.numa_bound ? ", node " + std::to_string(options_.numa_node) : std::string(", unbound"))
+       << (mapping_.locked ? ", locked" : ", not locked") << "\n";
+
+    os << "  " << std::left << std::setw(24) << "name" << std::right << std::setw(12) << "offset"
+       << std::setw(12) << "bytes" << std::setw(8) << "align" << "  pages\n";
+    for (const auto& p : placements_) {
+        const size_t first = p.offset / page;
+        const size_t last = (p.offset + (p.bytes ? p.bytes - 1 : 0)) / page;
+        os << "  " << std::left << std::setw(24) << p.name << std::right << std::setw(12) << p.offset
+           << std::setw(12) << p.bytes << std::setw(8) << p.align << "  " << first;
+        if (last != first) os << "-" << last;
+        os << "\n";
+    }
+}
+
+} // namespace ultra
@@ -0,0 +1,176 @@
+#include "ultra/core/memory/huge_page_allocator.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <sys/mman.h>
+#if defined(__linux__)
+#include <dirent.h>
+#include <linux/mempolicy.h>
+#include <linux/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ultra {
+
+const char* to_string(PageSize size) noexcept {
+    switch (size) {
+        case PageSize::SMALL_4K: return "4K";
+        case PageSize::HUGE_2MB: return "2MB";
+        case PageSize::HUGE_1GB: return "1GB";
+    }
+    return "unknown";
+}
+
+size_t page_bytes(PageSize size) noexcept {
+    switch (size) {
+        case PageSize::SMALL_4K: return 4096;
+        case PageSize::HUGE_2MB: return size_t{2} << 20;
+        case PageSize::HUGE_1GB: return size_t{1} << 30;
+    }
+    return 4096;
+}
+
+namespace {
+
+int mmap_flags(PageSize size) {
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#if defined(__linux__)
+    if (size == PageSize::HUGE_2MB) flags |= MAP_HUGETLB | MAP_HUGE_2MB;
+    if (size == PageSize::HUGE_1GB) flags |= MAP_HUGETLB | MAP_HUGE_1GB;
+#endif
+    return flags;
+}
+
+// Bind before first touch: pages are allocated on the node at fault time
+bool bind_to_node(void* addr, size_t len, int node) {
+#if defined(__linux__)
+    constexpr size_t BITS = 8 * sizeof(unsigned long);
+    unsigned long mask[16] = {};
+    if (node < 0 || static_cast<size_t>(node) >= BITS * 16) return false;
+    mask[node / BITS] = 1UL << (node % BITS);
+    // Raw syscall: avoids a libnuma dependency for one call
+    if (syscall(SYS_mbind, addr, len, MPOL_BIND, mask, BITS * 16 + 1, MPOL_MF_STRICT) != 0) {
+        perror("mbind");
+        return false;
+    }
+    return true;
+#else
+    (void)addr; (void)len; (void)node;
+    return false;
+#endif
+}
+
+void touch_pages(void* addr, size_t len, size_t stride) {
+    volatile uint8_t* p = static_cast<uint8_t*>(addr);
+    for (size_t off = 0; off < len; off += stride) p[off] = 0;
+}
+
+} // namespace
+
+size_t HugePages::mapped_length(size_t bytes, const HugePageOptions& options) noexcept {
+    // Rounded to the requested page size even if we fall back, so the length
+    // is valid for whichever size was obtained and deallocate() can recompute it
+    const size_t page = page_bytes(options.page_size);
+    if (bytes == 0) bytes = 1;
+    return ((bytes + page - 1) / page) * page;
+}
+
+HugePageMapping HugePages::map(size_t bytes, const HugePageOptions& options) noexcept {
+    HugePageMapping m;
+    m.bytes = mapped_length(bytes, options);
+
+    // Try the requested size, then each smaller one if allowed
+    int size = static_cast<int>(options.page_size);
+    for (; size >= 0; --size) {
+        void* p = mmap(nullptr, m.bytes, PROT_READ | PROT_WRITE, mmap_flags(static_cast<PageSize>(size)), -1, 0);
+        if (p != MAP_FAILED) {
+            m.addr = p;
+            m.page_size = static_cast<PageSize>(size);
+            break;
+        }
+        if (!options.allow_fallback) break;
+    }
+    if (m.addr == nullptr) {
+        std::cerr << "HugePages: failed to map " << m.bytes << " bytes of " << to_string(options.page_size)
+                  << " pages" << (options.allow_fallback ? " (or any fallback)" : "") << "\n";
+        return m;
+    }
+    // Warn once per process; callers get the page size in the result
+    static std::atomic<bool> fallback_reported{false};
+    if (m.page_size != options.page_size && !fallback_reported.exchange(true)) {
+        std::cerr << "HugePages: " << to_string(options.page_size) << " pages unavailable, got "
+                  << to_string(m.page_size) << " for " << m.bytes << " bytes (reported once)\n";
+    }
+
+    if (options.numa_node >= 0) {
+        m.numa_bound = bind_to_node(m.addr, m.bytes, options.numa_node);
+    }
+
+    // Only the requested bytes are faulted/locked (fallback may over-map)
+    const size_t resident = bytes < m.bytes ? bytes : m.bytes;
+    if (options.populate || options.lock) {
+        touch_pages(m.addr, resident, page_bytes(m.page_size));
+    }
+    if (options.lock) {
+        if (mlock(m.addr, resident) == 0) {
+            m.locked = true;
+        } else {
+            perror("mlock (need CAP_IPC_LOCK or higher RLIMIT_MEMLOCK?)");
+        }
+    }
+    return m;
+}
+
+void HugePages::unmap(const HugePageMapping& mapping) noexcept {
+    if (mapping.addr == nullptr) return;
+    munmap(mapping.addr, mapping.bytes);
+}
+
+int HugePages::node_of_cpu(int cpu) noexcept {
+#if defined(__linux__)
+    // /sys/devices/system/cpu/cpuN/ holds a "nodeX" link on NUMA kernels
+    const std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    DIR* dir = opendir(path.c_str());
+    if (!dir) return 0;
+    int node = 0;
+    while (dirent* e = readdir(dir)) {
+        if (std::strncmp(e->d_name, "node", 4) == 0 && e->d_name[4] >= '0' && e->d_name[4] <= '9') {
+            node = std::atoi(e->d_name + 4);
+            break;
+        }
+    }
+    closedir(dir);
+    return node;
+#else
+    (void)cpu;
+    return 0;
+#endif
+}
+
+PageSize HugePages::page_size_of(const void* addr) noexcept {
+    std::ifstream smaps("/proc/self/smaps");
+    const auto a = reinterpret_cast<uintptr_t>(addr);
+    std::string line;
+    bool in_range = false;
+    while (std::getline(smaps, line)) {
+        unsigned long lo, hi;
+        if (std::sscanf(line.c_str(), "%lx-%lx ", &lo, &hi) == 2) {
+            in_range = a >= lo && a < hi;
+            continue;
+        }
+        unsigned long kb;
+        if (in_range && std::sscanf(line.c_str(), "KernelPageSize: %lu kB", &kb) == 1) {
+            if (kb >= (1UL << 20)) return PageSize::HUGE_1GB;
+            if (kb >= 2048) return PageSize::HUGE_2MB;
+            return PageSize::SMALL_4K;
+        }
+    }
+    return PageSize::SMALL_4K;
+}
+
+} // namespace ultra
@@ -0,0 +1,94 @@
+#include "ultra/core/memory/scratch_arena.hpp"
+#include <cstdarg>
+#include <cstdio>
+#include <iostream>
+
+namespace ultra {
+
+ScratchArena::ScratchArena(size_t initial_block, std::pmr::memory_resource* upstream)
+    : upstream_(upstream) {
+    blocks_.reserve(16);
+    add_block(initial_block);
+    upstream_allocations_ = 0; // The initial block is not a fallback
+}
+
+ScratchArena::~ScratchArena() {
+    for (const auto& b : blocks_) upstream_->deallocate(b.data, b.size, alignof(std::max_align_t));
+}
+
+ScratchArena& ScratchArena::local() {
+    static thread_local ScratchArena arena;
+    return arena;
+}
+
+void* ScratchArena::do_allocate(size_t bytes, size_t alignment) {
+    Block& b = blocks_[block_];
+    // Align the address, not the offset: blocks are only max_align_t aligned
+    const uintptr_t base = reinterpret_cast<uintptr_t>(b.data);
+    const size_t offset = ((base + offset_ + alignment - 1) & ~(alignment - 1)) - base;
+    if (ULTRA_LIKELY(offset + bytes <= b.size)) {
+        offset_ = offset + bytes;
+        if (b.start + offset_ > high_watermark_) high_watermark_ = b.start + offset_;
+        return b.data + offset;
+    }
+    return allocate_slow(bytes, alignment);
+}
+
+void* ScratchArena::allocate_slow(size_t bytes, size_t alignment) {
+    // Next retained block that fits, else a new one from upstream
+    while (block_ + 1 < blocks_.size()) {
+        ++block_;
+        offset_ = 0;
+        if (bytes + alignment <= blocks_[block_].size) return do_allocate(bytes, alignment);
+    }
+    add_block(bytes + alignment);
+    block_ = blocks_.size() - 1;
+    offset_ = 0;
+    return do_allocate(bytes, alignment);
+}
+
+void ScratchArena::add_block(size_t min_bytes) {
+    // Geometric growth so a large step settles in a few blocks
+    size_t size = blocks_.empty() ? DEFAULT_BLOCK_SIZE : blocks_.back().size * 2;
+    if (blocks_.empty() && min_bytes) size = min_bytes;
+    while (size < min_bytes) size *= 2;
+
+    auto* data = static_cast<uint8_t*>(upstream_->allocate(size, alignof(std::max_align_t)));
+    const size_t start = blocks_.empty() ? 0 : blocks_.back().start + blocks_.back().size;
+    blocks_.push_back({data, size, start});
+    ++upstream_allocations_;
+
+    if (resets_ > 0) {
+        ++fallbacks_;
+#ifndef NDEBUG
+        if (fallbacks_ == 1) {
+            std::cerr << "ScratchArena: steady-state heap fallback (" << size << " byte block, "
+                      << bytes_reserved() << " reserved); size the arena for the largest step\n";
+        }
+#endif
+    }
+}
+
+size_t ScratchArena::bytes_reserved() const noexcept {
+    return blocks_.empty() ? 0 : blocks_.back().start + blocks_.back().size;
+}
+
+const char* ScratchArena::format(const char* fmt, ...) {
+    constexpr size_t GUESS = 64;
+    char* buf = static_cast<char*>(allocate(GUESS, 1));
+    va_list args;
+    va_start(args, fmt);
+    const int n = vsnprintf(buf, GUESS, fmt, args);
+    va_end(args);
+    if (n < 0) {
+        buf[0] = '\0';
+    } else if (static_cast<size_t>(n) >= GUESS) {
+        buf = static_cast<char*>(allocate(static_cast<size_t>(n) + 1, 1));
+        va_start(args, fmt);
+        vsnprintf(buf, static_cast<size_t>(n) + 1, fmt, args);
+        va_end(args);
+    }
+    return buf;
+}
+
+} // namespace ultra
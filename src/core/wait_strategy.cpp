@@ -0,0 +1,111 @@
+#include "ultra/core/wait_strategy.hpp"
+#include <iostream>
+#include <sched.h>
+#include <time.h>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ultra {
+
+const char* to_string(WaitPolicy policy) noexcept {
+    switch (policy) {
+    case WaitPolicy::BUSY_SPIN: return "busy_spin";
+    case WaitPolicy::BACKOFF: return "backoff";
+    case WaitPolicy::SPIN_YIELD: return "spin_yield";
+    case WaitPolicy::SPIN_FUTEX: return "spin_futex";
+    }
+    return "unknown";
+}
+
+bool parse_wait_policy(const std::string& name, WaitPolicy& out) noexcept {
+    for (WaitPolicy p : {WaitPolicy::BUSY_SPIN, WaitPolicy::BACKOFF,
+                         WaitPolicy::SPIN_YIELD, WaitPolicy::SPIN_FUTEX}) {
+        if (name == to_string(p)) {
+            out = p;
+            return true;
+        }
+    }
+    return false;
+}
+
+// --- WakeLatencyHistogram ---
+
+uint64_t WakeLatencyHistogram::percentile_ns(double p) const noexcept {
+    const uint64_t total = count();
+    if (total == 0) return 0;
+
+    const uint64_t rank = static_cast<uint64_t>(p * static_cast<double>(total - 1)) + 1;
+    uint64_t accum = 0;
+    for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+        accum += bucket(i);
+        if (accum >= rank) return (uint64_t{2} << i) - 1;
+    }
+    return max_ns();
+}
+
+void WakeLatencyHistogram::print_stats(const char* name, const char* title) const {
+    const uint64_t total = count();
+    std::cout << "--- " << title << ": " << name << " ---" << std::endl;
+    std::cout << "Samples: " << total << std::endl;
+    if (total == 0) return;
+    std::cout << "P50: <" << percentile_ns(0.50) << " ns, P99: <" << percentile_ns(0.99)
+              << " ns, P99.9: <" << percentile_ns(0.999) << " ns, Max: " << max_ns() << " ns" << std::endl;
+}
+
+void WakeLatencyHistogram::reset() noexcept {
+    for (auto& b : buckets_) b.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    max_ns_.store(0, std::memory_order_relaxed);
+}
+
+// --- WaitStrategy ---
+
+void WaitStrategy::yield() noexcept {
+    yields_.store(yields_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    sched_yield();
+}
+
+void WaitStrategy::park(uint32_t seq) noexcept {
+    parks_.store(parks_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+#if defined(__linux__)
+    timespec timeout;
+    timeout.tv_sec = static_cast<time_t>(config_.park_timeout_ns / 1'000'000'000ULL);
+    timeout.tv_nsec = static_cast<long>(config_.park_timeout_ns % 1'000'000'000ULL);
+    // Returns on wake, timeout, signal, or at once if the word already moved
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&futex_word_), FUTEX_WAIT_PRIVATE,
+            seq, &timeout, nullptr, 0);
+#else
+    (void)seq;
+    sched_yield();
+#endif
+}
+
+void WaitStrategy::wake() noexcept {
+    futex_word_.fetch_add(1, std::memory_order_release);
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&futex_word_), FUTEX_WAKE_PRIVATE,
+            1, nullptr, nullptr, 0);
+#endif
+}
+
+void WaitStrategy::record_wake() noexcept {
+    const uint64_t now = RDTSCClock::rdtsc();
+    idle_gap_.record(now > idle_start_tsc_ ? RDTSCClock::rdtsc_to_ns(now - idle_start_tsc_) : 0);
+    // Unstamped if the work came without a notify(), or its stamp is not
+    // visible yet (producers notify after publishing)
+    const uint64_t notified = notify_tsc_.exchange(0, std::memory_order_relaxed);
+    if (notified != 0) histogram_.record(now > notified ? RDTSCClock::rdtsc_to_ns(now - notified) : 0);
+    idle_polls_ = 0;
+}
+
+void WaitStrategy::print_stats(const char* thread_name) const {
+    std::cout << "[" << thread_name << "] wait policy " << to_string(config_.policy)
+              << ", parks: " << parks() << ", yields: " << yields() << std::endl;
+    histogram_.print_stats(thread_name);
+    idle_gap_.print_stats(thread_name, "Idle Gap");
+}
+
+} // namespace ultra
@@ -0,0 +1,175 @@
+#include "ultra/core/work_stealing_pool.hpp"
+#include "ultra/core/thread_utils.hpp"
+#include <chrono>
+
+namespace ultra {
+
+namespace {
+thread_local const WorkStealingPool* tls_pool = nullptr;
+thread_local size_t tls_index = 0;
+thread_local uint64_t tls_rng = 0x9E3779B97F4A7C15ULL;
+
+inline uint64_t next_random() noexcept {
+    // xorshift64: victim selection only
+    tls_rng ^= tls_rng << 13;
+    tls_rng ^= tls_rng >> 7;
+    tls_rng ^= tls_rng << 17;
+    return tls_rng;
+}
+} // namespace
+
+// --- TaskGroup ---
+
+TaskGroup::~TaskGroup() {
+    // Tasks reference this group: never let it go out of scope early
+    while (pending_.load(std::memory_order_acquire) != 0) {
+        if (!pool_.try_run_one()) std::this_thread::yield();
+    }
+}
+
+void TaskGroup::wait() {
+    while (pending_.load(std::memory_order_acquire) != 0) {
+        if (!pool_.try_run_one()) std::this_thread::yield();
+    }
+    std::exception_ptr e;
+    {
+        std::lock_guard<std::mutex> lock(error_mutex_);
+        std::swap(e, error_);
+    }
+    if (e) std::rethrow_exception(e);
+}
+
+void TaskGroup::record_error(std::exception_ptr e) noexcept {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    if (!error_) error_ = std::move(e);
+}
+
+// --- WorkStealingPool ---
+
+WorkStealingPool::WorkStealingPool(const Config& config) : config_(config) {
+    size_t n = config_.num_threads;
+    if (n == 0) {
+        const size_t hw = std::thread::hardware_concurrency();
+        n = hw > 1 ? hw - 1 : 1;
+    }
+
+    deques_.reserve(n);
+    for (size_t i = 0; i < n; ++i) deques_.push_back(std::make_unique<Deque>());
+
+    workers_.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        workers_.emplace_back(&WorkStealingPool::worker_loop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_.store(true, std::memory_order_release);
+    }
+    cv_.notify_all();
+    for (auto& t : workers_) {
+        if (t.joinable()) t.join();
+    }
+}
+
+long WorkStealingPool::current_worker() const noexcept {
+    return tls_pool == this ? static_cast<long>(tls_index) : -1;
+}
+
+void WorkStealingPool::submit(Task* task) {
+    const long self = current_worker();
+    if (self >= 0) {
+        if (ULTRA_UNLIKELY(!deques_[self]->push(task))) {
+            execute(task); // Deque full: run inline rather than grow
+            return;
+        }
+    } else {
+        std::lock_guard<std::mutex> lock(mutex_);
+        injection_.push_back(task);
+        injected_.fetch_add(1, std::memory_order_release);
+    }
+    // A wake can slip past a worker that is just going to sleep; the
+    // bounded wait in worker_loop covers that case
+    if (sleeping_.load(std::memory_order_acquire) != 0) cv_.notify_one();
+}
+
+bool WorkStealingPool::try_run_one() {
+    const long self = current_worker();
+    Task* task = nullptr;
+
+    // 1. Own deque, newest first
+    if (self >= 0 && deques_[self]->pop(task)) {
+        execute(task);
+        return true;
+    }
+
+    // 2. Externally spawned work
+    if (injected_.load(std::memory_order_acquire) != 0) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!injection_.empty()) {
+            task = injection_.front();
+            injection_.pop_front();
+            injected_.fetch_sub(1, std::memory_order_release);
+            lock.unlock();
+            execute(task);
+            return true;
+        }
+    }
+
+    // 3. Steal, oldest first, starting at a random victim
+    const size_t n = deques_.size();
+    const size_t start = static_cast<size_t>(next_random() % n);
+    for (size_t k = 0; k < n; ++k) {
+        const size_t victim = (start + k) % n;
+        if (static_cast<long>(victim) == self) continue;
+        if (deques_[victim]->steal(task)) {
+            execute(task);
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::execute(Task* task) noexcept {
+    TaskGroup* group = task->group;
+    try {
+        task->run();
+    } catch (...) {
+        group->record_error(std::current_exception());
+    }
+    delete task;
+    group->pending_.fetch_sub(1, std::memory_order_release);
+}
+
+void WorkStealingPool::worker_loop(size_t index) {
+    tls_pool = this;
+    tls_index = index;
+    tls_rng ^= (index + 1) * 0xBF58476D1CE4E5B9ULL;
+    if (!config_.cores.empty()) {
+        ThreadUtils::pin_thread(config_.cores[index % config_.cores.size()]);
+    }
+
+    static constexpr int SPINS_BEFORE_SLEEP = 64;
+    int misses = 0;
+    while (!stop_.load(std::memory_order_acquire)) {
+        if (try_run_one()) {
+            misses = 0;
+            continue;
+        }
+        if (++misses < SPINS_BEFORE_SLEEP) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        sleeping_.fetch_add(1, std::memory_order_acq_rel);
+        if (!stop_.load(std::memory_order_acquire) && injection_.empty()) {
+            cv_.wait_for(lock, std::chrono::milliseconds(1));
+        }
+        sleeping_.fetch_sub(1, std::memory_order_acq_rel);
+        misses = 0;
+    }
+}
+
+} // namespace ultra
@@ -1,5 +1,4 @@
 #include "ultra/execution/gateway_sim.hpp"
-#include "ultra/strategy/strategy.hpp" // <-- ADDED FULL INCLUDE
 #include <iostream>
 #include <algorithm>
 
@@ -47,7 +46,7 @@ void GatewaySim::try_match(strategy::StrategyOrder& order) {
     // This is a *very* simple FIFO matching stub
     if (order.side == Side::BUY) {
         // Try to match against asks
-        if (!active_asks_.empty() && order.price >= active_asks_[0].price) {
+        if (num_asks_ != 0 && order.price >= active_asks_[0].price) {
             // Match!
             Price fill_price = active_asks_[0].price;
             Quantity fill_qty = std::min(order.quantity, active_asks_[0].quantity);
@@ -57,14 +56,13 @@ void GatewaySim::try_match(strategy::StrategyOrder& order) {
             // ... (and update/remove the resting order)
         } else {
             // Add to book
-            active_bids_.push_back(order);
-            std::sort(active_bids_.begin(), active_bids_.end(), [](const auto& a, const auto& b){
+            rest(active_bids_.data(), num_bids_, order, [](const auto& a, const auto& b) {
                 return a.price > b.price; // Bids descending
             });
         }
     } else {
         // Try to match against bids
-        if (!active_bids_.empty() && order.price <= active_bids_[0].price) {
+        if (num_bids_ != 0 && order.price <= active_bids_[0].price) {
             // Match!
             Price fill_price = active_bids_[0].price;
             Quantity fill_qty = std::min(order.quantity, active_bids_[0].quantity);
@@ -72,14 +70,36 @@ void GatewaySim::try_match(strategy::StrategyOrder& order) {
             send_fill(order, fill_price, fill_qty);
         } else {
             // Add to book
-            active_asks_.push_back(order);
-            std::sort(active_asks_.begin(), active_asks_.end(), [](const auto& a, const auto& b){
+            rest(active_asks_.data(), num_asks_, order, [](const auto& a, const auto& b) {
                 return a.price < b.price; // Asks ascending
             });
         }
     }
 }
 
+template<typename BetterThan>
+void GatewaySim::rest(strategy::StrategyOrder* side, size_t& count, const strategy::StrategyOrder& order,
+                      BetterThan better_than) {
+    if (count == MAX_RESTING) {
+        exec_reports_queue_.push(ExecutionReport{
+            .tsc = 0,
+            .order_id = order.order_id,
+            .symbol_id = order.symbol_id,
+            .status = OrderStatus::CANCELLED, // Book side full
+            .remaining_quantity = 0
+        });
+        return;
+    }
+    // Price priority, FIFO among equal prices
+    size_t i = count;
+    while (i > 0 && better_than(order, side[i - 1])) {
+        side[i] = side[i - 1];
+        --i;
+    }
+    side[i] = order;
+    ++count;
+}
+
                  /**
                   * @brief Auto-generated description for send_accept.
                   * @param order Parameter description.
@@ -0,0 +1,136 @@
+#include "ultra/market-data/book/consolidated_book.hpp"
+#include <cstring> // for memmove
+
+namespace ultra::md {
+
+ConsolidatedBook::ConsolidatedBook(SymbolId symbol_id) : symbol_id_(symbol_id) {
+    for (auto& level : bids_) level.price = 0;
+    for (auto& level : asks_) level.price = INVALID_PRICE;
+}
+
+bool ConsolidatedBook::add_venue(VenueId venue, const char* name, const OrderBookL2* book) noexcept {
+    if (venue >= MAX_VENUES || !book || venues_[venue].book) return false;
+
+    auto& state = venues_[venue];
+    state.book = book;
+    state.name = name;
+    for (auto& level : state.bids) level = OrderBookL2::Level{0, 0, 0};
+    for (auto& level : state.asks) level = OrderBookL2::Level{INVALID_PRICE, 0, 0};
+    ++venue_count_;
+
+    // Pick up whatever the venue book already holds
+    on_venue_update(venue);
+    return true;
+}
+
+ULTRA_HOT void ConsolidatedBook::on_venue_update(VenueId venue) noexcept {
+    if (ULTRA_UNLIKELY(venue >= MAX_VENUES)) return;
+    auto& state = venues_[venue];
+    if (ULTRA_UNLIKELY(!state.book)) return;
+
+    diff_side(venue, Side::BUY, state.bids, state.book->bids());
+    diff_side(venue, Side::SELL, state.asks, state.book->asks());
+}
+
+// Both arrays are sorted best-first with the empty sentinel sorting last, so a
+// single merge pass finds every price whose quantity changed in O(DEPTH).
+void ConsolidatedBook::diff_side(VenueId venue, Side side, VenueSide& prev,
+                                 const OrderBookL2::PriceLevelSide& curr) noexcept {
+    const Price empty = empty_price(side);
+    size_t i = 0, j = 0;
+
+    while (i < DEPTH || j < DEPTH) {
+        const Price old_px = (i < DEPTH) ? prev[i].price : empty;
+        const Price new_px = (j < DEPTH) ? curr[j].price : empty;
+        if (old_px == empty && new_px == empty) break;
+
+        if (old_px == new_px) {
+            const Quantity delta = curr[j].quantity - prev[i].quantity;
+            if (delta != 0) apply_delta(venue, side, new_px, delta);
+            ++i; ++j;
+        } else if ((side == Side::BUY) ? (old_px > new_px) : (old_px < new_px)) {
+            // Level left this venue's top-N
+            apply_delta(venue, side, old_px, -prev[i].quantity);
+            ++i;
+        } else {
+            // Level entered this venue's top-N
+            apply_delta(venue, side, new_px, curr[j].quantity);
+            ++j;
+        }
+    }
+
+    std::memcpy(prev.data(), curr.data(), DEPTH * sizeof(OrderBookL2::Level));
+}
+
+void ConsolidatedBook::apply_delta(VenueId venue, Side side, Price price, Quantity delta) noexcept {
+    auto& levels = (side == Side::BUY) ? bids_ : asks_;
+    size_t& count = (side == Side::BUY) ? bid_count_ : ask_count_;
+    const uint8_t bit = static_cast<uint8_t>(1u << venue);
+    ++level_updates_;
+
+    for (size_t i = 0; i < MAX_LEVELS; ++i) {
+        // Case A: Found existing level
+        if (levels[i].price == price) {
+            Level& level = levels[i];
+            level.venue_qty[venue] += delta;
+            level.quantity += delta;
+            if (level.venue_qty[venue] > 0) {
+                level.venue_mask |= bit;
+            } else {
+                level.venue_qty[venue] = 0;
+                level.venue_mask &= static_cast<uint8_t>(~bit);
+            }
+
+            // Last venue left this price: remove level
+            if (level.venue_mask == 0 || level.quantity <= 0) {
+                if (i < MAX_LEVELS - 1) {
+                    std::memmove(&levels[i], &levels[i+1], (MAX_LEVELS - 1 - i) * sizeof(Level));
+                }
+                levels[MAX_LEVELS-1] = Level{};
+                levels[MAX_LEVELS-1].price = empty_price(side);
+                --count;
+            }
+            return;
+        }
+
+        // Case B: Found insertion point (Empty slot OR correct sort order)
+        const bool empty_slot = levels[i].price == empty_price(side);
+        const bool correct_order = (side == Side::BUY && levels[i].price < price) ||
+                                   (side == Side::SELL && levels[i].price > price);
+
+        if (empty_slot || correct_order) {
+            if (delta <= 0) return; // Unknown price, nothing to remove
+
+            if (i < MAX_LEVELS - 1) {
+                std::memmove(&levels[i+1], &levels[i], (MAX_LEVELS - 1 - i) * sizeof(Level));
+            }
+            levels[i] = Level{};
+            levels[i].price = price;
+            levels[i].quantity = delta;
+            levels[i].venue_mask = bit;
+            levels[i].venue_qty[venue] = delta;
+            if (count < MAX_LEVELS) ++count;
+            return;
+        }
+    }
+}
+
+VenueId ConsolidatedBook::best_venue(Side side, size_t level) const noexcept {
+    const auto& levels = (side == Side::BUY) ? bids_ : asks_;
+    if (level >= MAX_LEVELS || levels[level].venue_mask == 0) {
+        return static_cast<VenueId>(MAX_VENUES);
+    }
+
+    const Level& l = levels[level];
+    VenueId best = static_cast<VenueId>(MAX_VENUES);
+    Quantity best_qty = 0;
+    for (size_t v = 0; v < MAX_VENUES; ++v) {
+        if (l.venue_qty[v] > best_qty) {
+            best_qty = l.venue_qty[v];
+            best = static_cast<VenueId>(v);
+        }
+    }
+    return best;
+}
+
+} // namespace ultra::md
@@ -9,7 +9,10 @@ namespace ultra::md {
               * @brief Auto-generated description for OrderBookL2.
               * @param symbol_id Parameter description.
               */
-OrderBookL2::OrderBookL2(SymbolId symbol_id) : symbol_id_(symbol_id) {
+OrderBookL2::OrderBookL2(SymbolId symbol_id, const HugePageOptions& memory, void* order_storage)
+    : symbol_id_(symbol_id),
+      order_pool_({.growable = true, .grow_watermark_pct = 90, .max_chunks = 32, .memory = memory,
+                   .first_chunk = order_storage}) {
     // Clear hash map
     std::fill(order_map_.begin(), order_map_.end(), nullptr);
     
@@ -18,6 +21,18 @@ OrderBookL2::OrderBookL2(SymbolId symbol_id) : symbol_id_(symbol_id) {
     for (auto& level : asks_) { level.price = INVALID_PRICE; level.quantity = 0; level.order_count = 0; }
 }
 
+void OrderBookL2::reset() noexcept {
+    for (auto& head : order_map_) {
+        while (head) {
+            OrderEntry* next = head->next;
+            order_pool_.deallocate(head);
+            head = next;
+        }
+    }
+    for (auto& level : bids_) { level.price = 0; level.quantity = 0; level.order_count = 0; }
+    for (auto& level : asks_) { level.price = INVALID_PRICE; level.quantity = 0; level.order_count = 0; }
+}
+
                             /**
                              * @brief Auto-generated description for update.
                              * @param msg Parameter description.
@@ -100,8 +115,11 @@ void OrderBookL2::add_order(OrderId id, Side side, Price price, Quantity qty) no
     // 1. Allocate from pool
     OrderEntry* new_order = order_pool_.allocate();
     if (ULTRA_UNLIKELY(!new_order)) {
-        // Pool full - in prod we might log or crash. 
-        // For now, silently drop to avoid segfault.
+        // Only reachable once the pool is at max_chunks or mmap fails
+        if (dropped_orders_++ == 0) {
+            std::cerr << "[OrderBookL2] symbol " << symbol_id_ << ": order pool exhausted at "
+                      << order_pool_.capacity() << " orders, dropping adds\n";
+        }
         return;
     }
     new_order->id = id;
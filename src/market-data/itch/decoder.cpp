@@ -1,5 +1,6 @@
 #include "ultra/market-data/itch/decoder.hpp"
 #include "ultra/core/async_logger.hpp"
+#include "ultra/core/memory/scratch_arena.hpp"
 #include <iostream>
 
 namespace ultra::md::itch {
@@ -61,13 +62,20 @@ SymbolId ITCHDecoder::lookup_symbol(const char* symbol) const noexcept {
                                           * @return ITCHDecoder::DecodedMessage value.
                                           */
 ITCHDecoder::DecodedMessage ITCHDecoder::decode(const uint8_t* data, size_t len, Timestamp rdtsc_ts) noexcept {
-    ULTRA_TRACE("ITCHDecoder::decode", "Binary ITCH 5.0 parsing", "len=" + std::to_string(len));
-    DecodedMessage msg{};
+    DecodedMessage msg;
+    decode_into(data, len, rdtsc_ts, msg);
+    return msg;
+}
+
+bool ITCHDecoder::decode_into(const uint8_t* data, size_t len, Timestamp rdtsc_ts, DecodedMessage& msg) noexcept {
+    ScratchArena::Scope scratch; // Per-message temporaries (trace parameters)
+    ULTRA_TRACE("ITCHDecoder::decode", "Binary ITCH 5.0 parsing", scratch.arena().format("len=%zu", len));
+    msg = DecodedMessage{};
     msg.tsc = rdtsc_ts;
     msg.valid = false;
     msg.event_type = MDEventType::UNKNOWN;
     
-    if (ULTRA_UNLIKELY(len < sizeof(MessageHeader))) return msg;
+    if (ULTRA_UNLIKELY(len < sizeof(MessageHeader))) return false;
     
     const auto* header = reinterpret_cast<const MessageHeader*>(data);
     const auto msg_type = static_cast<MessageType>(header->type);
@@ -75,7 +83,7 @@ ITCHDecoder::DecodedMessage ITCHDecoder::decode(const uint8_t* data, size_t len,
     // This switch is the critical path
     switch(msg_type) {
         case MessageType::ADD_ORDER: {
-            if (ULTRA_UNLIKELY(len < sizeof(AddOrder))) return msg;
+            if (ULTRA_UNLIKELY(len < sizeof(AddOrder))) return false;
             const auto* add = reinterpret_cast<const AddOrder*>(data);
             
             msg.event_type = MDEventType::ADD_ORDER;
@@ -86,22 +94,22 @@ ITCHDecoder::DecodedMessage ITCHDecoder::decode(const uint8_t* data, size_t len,
             msg.price = decode_price(add->price);
             msg.symbol_id = lookup_symbol(add->stock);
             msg.valid = true;
-            return msg;
+            return true;
         }
         
         case MessageType::ORDER_DELETE: {
-            if (ULTRA_UNLIKELY(len < sizeof(OrderDelete))) return msg;
+            if (ULTRA_UNLIKELY(len < sizeof(OrderDelete))) return false;
             const auto* del = reinterpret_cast<const OrderDelete*>(data);
             
             msg.event_type = MDEventType::DELETE_ORDER;
             msg.exchange_ts = bswap_64(del->timestamp);
             msg.order_id = bswap_64(del->order_ref_number);
             msg.valid = true;
-            return msg;
+            return true;
         }
 
         case MessageType::ORDER_REPLACE: {
-            if (ULTRA_UNLIKELY(len < sizeof(OrderReplace))) return msg;
+            if (ULTRA_UNLIKELY(len < sizeof(OrderReplace))) return false;
             const auto* rep = reinterpret_cast<const OrderReplace*>(data);
             
             msg.event_type = MDEventType::MODIFY_ORDER;
@@ -111,14 +119,14 @@ ITCHDecoder::DecodedMessage ITCHDecoder::decode(const uint8_t* data, size_t len,
             msg.quantity = bswap_32(rep->shares);
             msg.price = decode_price(rep->price);
             msg.valid = true;
-            return msg;
+            return true;
         }
         
         // ... Add other cases: ORDER_EXECUTED, TRADE, etc.
         
         default:
             // Not a message type we care about for book building
-            return msg;
+            return false;
     }
 }
 
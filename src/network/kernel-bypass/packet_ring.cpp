@@ -0,0 +1,246 @@
+#include "ultra/network/kernel-bypass/packet_ring.hpp"
+#include <iostream>
+#include <cstring>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <linux/filter.h>
+#include <linux/if_ether.h>
+
+namespace ultra::network {
+
+namespace {
+// Classic BPF over the Ethernet frame. Jump targets are labels patched once
+// the program is laid out (cBPF jumps are forward, 8-bit relative).
+class FilterBuilder {
+public:
+    static constexpr int ACCEPT = -1;
+    static constexpr int REJECT = -2;
+    static constexpr int NEXT = -3; ///< The following instruction.
+
+    void stmt(uint16_t code, uint32_t k) { prog_.push_back(BPF_STMT(code, k)); }
+
+    void jump(uint16_t code, uint32_t k, int jt, int jf) {
+        fixups_.push_back({prog_.size(), jt, jf});
+        prog_.push_back(BPF_JUMP(code, k, 0, 0));
+    }
+
+    int new_label() { labels_.push_back(0); return static_cast<int>(labels_.size()) - 1; }
+    void place(int label) { labels_[label] = prog_.size(); }
+
+    // Appends the accept/reject returns and resolves every jump
+    bool finish(std::vector<sock_filter>& out) {
+        const size_t reject_at = prog_.size();
+        stmt(BPF_RET | BPF_K, 0);
+        const size_t accept_at = prog_.size();
+        stmt(BPF_RET | BPF_K, 0x40000); // Whole frame (capped by snaplen)
+        for (const auto& f : fixups_) {
+            int jt = offset(f.at, f.jt, accept_at, reject_at);
+            int jf = offset(f.at, f.jf, accept_at, reject_at);
+            if (jt < 0 || jt > 255 || jf < 0 || jf > 255) return false;
+            prog_[f.at].jt = static_cast<uint8_t>(jt);
+            prog_[f.at].jf = static_cast<uint8_t>(jf);
+        }
+        out = std::move(prog_);
+        return true;
+    }
+
+private:
+    struct Fixup { size_t at; int jt; int jf; };
+
+    int offset(size_t at, int label, size_t accept_at, size_t reject_at) const {
+        size_t target = at + 1;
+        if (label == ACCEPT) target = accept_at;
+        else if (label == REJECT) target = reject_at;
+        else if (label >= 0) target = labels_[label];
+        return static_cast<int>(target) - static_cast<int>(at + 1);
+    }
+
+    std::vector<sock_filter> prog_;
+    std::vector<Fixup> fixups_;
+    std::vector<size_t> labels_;
+};
+} // namespace
+
+PacketRingReceiver::PacketRingReceiver(const Config& config) : config_(config) {
+    for (size_t i = 0; i < config_.channels.size(); ++i) {
+        // Bad addresses are reported by attach_filter()
+        flows_.add(config_.channels[i].group.c_str(), config_.channels[i].port, static_cast<uint16_t>(i));
+    }
+}
+
+PacketRingReceiver::~PacketRingReceiver() {
+    stop();
+}
+
+bool PacketRingReceiver::start() {
+    if (config_.block_count == 0 || config_.frame_size == 0 || config_.block_size % getpagesize() != 0 ||
+        config_.block_size % config_.frame_size != 0) {
+        std::cerr << "PacketRingReceiver: block_size must be a multiple of the page and frame size" << std::endl;
+        return false;
+    }
+    const unsigned ifindex = if_nametoindex(config_.interface_name.c_str());
+    if (ifindex == 0) {
+        perror("if_nametoindex");
+        return false;
+    }
+
+    // Protocol 0: nothing is queued until bind(), so no unfiltered frames
+    // land in the ring before the filter is attached
+    fd_ = socket(AF_PACKET, SOCK_RAW, 0);
+    if (fd_ < 0) {
+        perror("socket(AF_PACKET)");
+        return false;
+    }
+
+    if (!attach_filter()) {
+        stop();
+        return false;
+    }
+
+    int version = TPACKET_V3;
+    if (setsockopt(fd_, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0) {
+        perror("setsockopt(PACKET_VERSION)");
+        stop();
+        return false;
+    }
+
+#ifdef PACKET_IGNORE_OUTGOING
+    // Our own sends would otherwise show up on the ring as well
+    int ignore = 1;
+    if (setsockopt(fd_, SOL_PACKET, PACKET_IGNORE_OUTGOING, &ignore, sizeof(ignore)) < 0) {
+        perror("setsockopt(PACKET_IGNORE_OUTGOING)");
+    }
+#endif
+
+    tpacket_req3 req{};
+    req.tp_block_size = config_.block_size;
+    req.tp_block_nr = config_.block_count;
+    req.tp_frame_size = config_.frame_size;
+    req.tp_frame_nr = config_.block_size / config_.frame_size * config_.block_count;
+    req.tp_retire_blk_tov = config_.block_timeout_ms;
+    if (setsockopt(fd_, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) < 0) {
+        perror("setsockopt(PACKET_RX_RING)");
+        stop();
+        return false;
+    }
+
+    ring_bytes_ = static_cast<size_t>(config_.block_size) * config_.block_count;
+    void* ring = mmap(nullptr, ring_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, 0);
+    if (ring == MAP_FAILED) {
+        perror("mmap(PACKET_RX_RING)");
+        stop();
+        return false;
+    }
+    ring_ = static_cast<uint8_t*>(ring);
+    current_ = 0;
+
+    sockaddr_ll addr{};
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons(ETH_P_ALL);
+    addr.sll_ifindex = static_cast<int>(ifindex);
+    if (bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        perror("bind(AF_PACKET)");
+        stop();
+        return false;
+    }
+
+    if (config_.join_groups && !join_groups()) {
+        stop();
+        return false;
+    }
+
+    std::cout << "Packet ring started on " << config_.interface_name << ": " << config_.block_count << " x "
+              << (config_.block_size >> 10) << " KB blocks, " << config_.channels.size() << " channel(s)" << std::endl;
+    return true;
+}
+
+void PacketRingReceiver::stop() {
+    if (ring_) {
+        munmap(ring_, ring_bytes_);
+        ring_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+    if (join_fd_ >= 0) {
+        close(join_fd_); // Drops the memberships
+        join_fd_ = -1;
+    }
+}
+
+// IPv4, UDP, not a fragment (only the first fragment carries the UDP
+// header), then (dst ip, dst port) in the channel list
+bool PacketRingReceiver::attach_filter() {
+    FilterBuilder b;
+    b.stmt(BPF_LD | BPF_H | BPF_ABS, 12); // Ethertype
+    b.jump(BPF_JMP | BPF_JEQ | BPF_K, ETH_P_IP, FilterBuilder::NEXT, FilterBuilder::REJECT);
+    b.stmt(BPF_LD | BPF_B | BPF_ABS, 23); // IP protocol
+    b.jump(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_UDP, FilterBuilder::NEXT, FilterBuilder::REJECT);
+    b.stmt(BPF_LD | BPF_H | BPF_ABS, 20); // Flags / fragment offset
+    b.jump(BPF_JMP | BPF_JSET | BPF_K, 0x3FFF, FilterBuilder::REJECT, FilterBuilder::NEXT); // MF or offset
+    b.stmt(BPF_LDX | BPF_B | BPF_MSH, 14); // X = IP header length
+
+    if (config_.channels.empty()) b.stmt(BPF_RET | BPF_K, 0x40000);
+    for (const auto& channel : config_.channels) {
+        in_addr group{};
+        if (inet_pton(AF_INET, channel.group.c_str(), &group) != 1) {
+            std::cerr << "PacketRingReceiver: bad group address " << channel.group << std::endl;
+            return false;
+        }
+        const int next = b.new_label();
+        b.stmt(BPF_LD | BPF_W | BPF_ABS, 30); // Destination IP
+        if (channel.port == 0) {
+            b.jump(BPF_JMP | BPF_JEQ | BPF_K, ntohl(group.s_addr), FilterBuilder::ACCEPT, next);
+        } else {
+            b.jump(BPF_JMP | BPF_JEQ | BPF_K, ntohl(group.s_addr), FilterBuilder::NEXT, next);
+            b.stmt(BPF_LD | BPF_H | BPF_IND, 16); // UDP dst port at 14 + ihl + 2
+            b.jump(BPF_JMP | BPF_JEQ | BPF_K, channel.port, FilterBuilder::ACCEPT, next);
+        }
+        b.place(next);
+    }
+
+    std::vector<sock_filter> prog;
+    if (!b.finish(prog)) {
+        std::cerr << "PacketRingReceiver: too many channels for one filter" << std::endl;
+        return false;
+    }
+    sock_fprog fprog{static_cast<unsigned short>(prog.size()), prog.data()};
+    if (setsockopt(fd_, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog)) < 0) {
+        perror("setsockopt(SO_ATTACH_FILTER)");
+        return false;
+    }
+    return true;
+}
+
+bool PacketRingReceiver::join_groups() {
+    if (config_.channels.empty()) return true;
+    join_fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+    if (join_fd_ < 0) {
+        perror("socket(join)");
+        return false;
+    }
+    for (const auto& channel : config_.channels) {
+        ip_mreq group{};
+        inet_pton(AF_INET, channel.group.c_str(), &group.imr_multiaddr);
+        group.imr_interface.s_addr =
+            config_.interface_ip.empty() ? htonl(INADDR_ANY) : inet_addr(config_.interface_ip.c_str());
+        if (setsockopt(join_fd_, IPPROTO_IP, IP_ADD_MEMBERSHIP, &group, sizeof(group)) < 0 && errno != EADDRINUSE) {
+            perror("setsockopt(IP_ADD_MEMBERSHIP)");
+            return false;
+        }
+    }
+    return true;
+}
+
+PacketRingReceiver::Stats PacketRingReceiver::stats() const {
+    tpacket_stats_v3 st{};
+    socklen_t len = sizeof(st);
+    if (fd_ < 0 || getsockopt(fd_, SOL_PACKET, PACKET_STATISTICS, &st, &len) < 0) return {};
+    return {st.tp_packets, st.tp_drops, st.tp_freeze_q_cnt};
+}
+
+} // namespace ultra::network
@@ -0,0 +1,333 @@
+#include "ultra/network/kernel-bypass/xdp_receiver.hpp"
+#include <iostream>
+#include <cstring>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <net/if.h>
+#include <linux/bpf.h>
+#include <linux/if_link.h>
+
+namespace ultra::network {
+
+namespace {
+int sys_bpf(int cmd, bpf_attr& attr) {
+    return static_cast<int>(syscall(__NR_bpf, cmd, &attr, sizeof(attr)));
+}
+
+bpf_insn insn(uint8_t code, uint8_t dst, uint8_t src, int16_t off, int32_t imm) {
+    bpf_insn i{};
+    i.code = code;
+    i.dst_reg = dst & 0xF;
+    i.src_reg = src & 0xF;
+    i.off = off;
+    i.imm = imm;
+    return i;
+}
+
+bool is_pow2(uint32_t v) { return v != 0 && (v & (v - 1)) == 0; }
+
+// Frame offsets the program reads (Ethernet + 20-byte IPv4 header)
+constexpr int16_t ETH_TYPE = 12;
+constexpr int16_t IP_VERSION_IHL = 14;
+constexpr int16_t IP_FLAGS_FRAG = 20;
+constexpr int16_t IP_PROTO = 23;
+constexpr int16_t UDP_DPORT = 36;
+constexpr int32_t UDP_HEADERS_END = 42;
+} // namespace
+
+XDPReceiver::XDPReceiver(const Config& config) : config_(config) {}
+
+XDPReceiver::~XDPReceiver() {
+    stop();
+}
+
+bool XDPReceiver::start() {
+    if ((config_.frame_size != 2048 && config_.frame_size != 4096) || !is_pow2(config_.frame_count) ||
+        !is_pow2(config_.rx_ring_size)) {
+        std::cerr << "XDPReceiver: frame_size must be 2048/4096, frame_count and rx_ring_size powers of two"
+                  << std::endl;
+        return false;
+    }
+    ifindex_ = if_nametoindex(config_.interface_name.c_str());
+    if (ifindex_ == 0) {
+        perror("if_nametoindex");
+        return false;
+    }
+
+    xsk_fd_ = socket(AF_XDP, SOCK_RAW, 0);
+    if (xsk_fd_ < 0) {
+        perror("socket(AF_XDP)");
+        return false;
+    }
+    if (!setup_umem() || !map_rings() || !bind_socket() || !load_program()) {
+        stop();
+        return false;
+    }
+
+    std::cout << "XDP receiver started on " << config_.interface_name << " queue " << config_.queue_id << " ("
+              << (zero_copy_ ? "zero-copy" : "copy") << ", " << (generic_ ? "generic" : "driver") << " XDP, "
+              << config_.frame_count << " x " << config_.frame_size << "B frames)" << std::endl;
+    return true;
+}
+
+void XDPReceiver::stop() {
+    for (int* fd : {&link_fd_, &prog_fd_, &map_fd_, &xsk_fd_}) { // Link first: detaches the program
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+    for (Ring* ring : {static_cast<Ring*>(&rx_), static_cast<Ring*>(&fill_), &completion_}) {
+        if (ring->map) munmap(ring->map, ring->map_len);
+        ring->map = nullptr;
+    }
+    if (umem_.addr) HugePages::unmap(umem_);
+    umem_ = {};
+    umem_base_ = nullptr;
+    rx_cons_ = rx_cached_prod_ = fill_prod_ = 0;
+}
+
+// Hands the consumed batch back (RX consumer, FILL producer) and picks up
+// whatever the kernel produced since. With need_wakeup, an empty ring means
+// the driver may be waiting for a kick before it uses the new FILL entries.
+ULTRA_HOT bool XDPReceiver::refill() {
+    if (rx_.consumer->load(std::memory_order_relaxed) != rx_cons_) {
+        rx_.consumer->store(rx_cons_, std::memory_order_release);
+        fill_.producer->store(fill_prod_, std::memory_order_release);
+    }
+    rx_cached_prod_ = rx_.producer->load(std::memory_order_acquire);
+    if (rx_cached_prod_ != rx_cons_) return true;
+
+    if (need_wakeup_ &&
+        (std::atomic_ref<uint32_t>(*fill_.flags).load(std::memory_order_relaxed) & XDP_RING_NEED_WAKEUP)) {
+        recvfrom(xsk_fd_, nullptr, 0, MSG_DONTWAIT, nullptr, nullptr);
+        ++wakeups_;
+    }
+    return false;
+}
+
+// Frame memory, pre-faulted: the kernel pins it at registration anyway
+bool XDPReceiver::setup_umem() {
+    HugePageOptions options = config_.memory;
+    options.populate = true;
+    umem_ = HugePages::map(static_cast<size_t>(config_.frame_count) * config_.frame_size, options);
+    if (!umem_.addr) {
+        std::cerr << "XDPReceiver: could not map " << config_.frame_count << " frames" << std::endl;
+        return false;
+    }
+    umem_base_ = static_cast<uint8_t*>(umem_.addr);
+
+    xdp_umem_reg reg{};
+    reg.addr = reinterpret_cast<uint64_t>(umem_.addr);
+    reg.len = static_cast<uint64_t>(config_.frame_count) * config_.frame_size;
+    reg.chunk_size = config_.frame_size;
+    reg.headroom = 0;
+    if (setsockopt(xsk_fd_, SOL_XDP, XDP_UMEM_REG, &reg, sizeof(reg)) < 0) {
+        perror("setsockopt(XDP_UMEM_REG)");
+        return false;
+    }
+    return true;
+}
+
+// FILL holds every frame, so returning chunks can never overflow it
+bool XDPReceiver::map_rings() {
+    const uint32_t fill_size = config_.frame_count;
+    const uint32_t completion_size = 64; // Unused for rx, but bind needs one
+    if (setsockopt(xsk_fd_, SOL_XDP, XDP_UMEM_FILL_RING, &fill_size, sizeof(fill_size)) < 0 ||
+        setsockopt(xsk_fd_, SOL_XDP, XDP_UMEM_COMPLETION_RING, &completion_size, sizeof(completion_size)) < 0 ||
+        setsockopt(xsk_fd_, SOL_XDP, XDP_RX_RING, &config_.rx_ring_size, sizeof(config_.rx_ring_size)) < 0) {
+        perror("setsockopt(XDP ring size)");
+        return false;
+    }
+
+    xdp_mmap_offsets off{};
+    socklen_t len = sizeof(off);
+    if (getsockopt(xsk_fd_, SOL_XDP, XDP_MMAP_OFFSETS, &off, &len) < 0) {
+        perror("getsockopt(XDP_MMAP_OFFSETS)");
+        return false;
+    }
+
+    auto map = [&](Ring& ring, const xdp_ring_offset& o, uint32_t entries, size_t entry_size, off_t pgoff) {
+        ring.map_len = o.desc + entries * entry_size;
+        void* p = mmap(nullptr, ring.map_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, xsk_fd_, pgoff);
+        if (p == MAP_FAILED) {
+            perror("mmap(XDP ring)");
+            ring.map = nullptr;
+            return static_cast<uint8_t*>(nullptr);
+        }
+        auto* base = static_cast<uint8_t*>(p);
+        ring.map = p;
+        ring.producer = reinterpret_cast<std::atomic<uint32_t>*>(base + o.producer);
+        ring.consumer = reinterpret_cast<std::atomic<uint32_t>*>(base + o.consumer);
+        ring.flags = reinterpret_cast<uint32_t*>(base + o.flags);
+        ring.mask = entries - 1;
+        return base + o.desc;
+    };
+
+    auto* rx_descs = map(rx_, off.rx, config_.rx_ring_size, sizeof(xdp_desc), XDP_PGOFF_RX_RING);
+    auto* fill_addrs = map(fill_, off.fr, fill_size, sizeof(uint64_t), XDP_UMEM_PGOFF_FILL_RING);
+    auto* completion = map(completion_, off.cr, completion_size, sizeof(uint64_t), XDP_UMEM_PGOFF_COMPLETION_RING);
+    if (!rx_descs || !fill_addrs || !completion) return false;
+    rx_.descs = reinterpret_cast<xdp_desc*>(rx_descs);
+    fill_.addrs = reinterpret_cast<uint64_t*>(fill_addrs);
+    return true;
+}
+
+bool XDPReceiver::bind_socket() {
+    sockaddr_xdp addr{};
+    addr.sxdp_family = AF_XDP;
+    addr.sxdp_ifindex = ifindex_;
+    addr.sxdp_queue_id = config_.queue_id;
+
+    auto try_bind = [&](uint16_t flags) {
+        addr.sxdp_flags = flags | XDP_USE_NEED_WAKEUP;
+        return bind(xsk_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+    };
+    zero_copy_ = config_.mode != Mode::COPY && !config_.generic_xdp && try_bind(XDP_ZEROCOPY);
+    if (!zero_copy_) {
+        if (config_.mode == Mode::ZERO_COPY) {
+            perror("bind(AF_XDP, XDP_ZEROCOPY)");
+            return false;
+        }
+        if (!try_bind(XDP_COPY)) {
+            perror("bind(AF_XDP)");
+            return false;
+        }
+    }
+    need_wakeup_ = true;
+
+    // Every chunk starts out owned by the kernel
+    for (uint32_t i = 0; i < config_.frame_count; ++i) {
+        fill_.addrs[i] = static_cast<uint64_t>(i) * config_.frame_size;
+    }
+    fill_prod_ = config_.frame_count;
+    fill_.producer->store(fill_prod_, std::memory_order_release);
+    rx_cons_ = rx_cached_prod_ = rx_.consumer->load(std::memory_order_relaxed);
+    return true;
+}
+
+// XDP program, built as raw eBPF:
+//   if frame is IPv4 (no options) / UDP / unfragmented [/ dport in ports]:
+//       return bpf_redirect_map(&xsks, ctx->rx_queue_index, XDP_PASS)
+//   return XDP_PASS
+bool XDPReceiver::load_program() {
+    bpf_attr attr{};
+    attr.map_type = BPF_MAP_TYPE_XSKMAP;
+    attr.key_size = sizeof(uint32_t);
+    attr.value_size = sizeof(uint32_t);
+    attr.max_entries = config_.queue_id + 1;
+    map_fd_ = sys_bpf(BPF_MAP_CREATE, attr);
+    if (map_fd_ < 0) {
+        perror("bpf(BPF_MAP_CREATE, XSKMAP)");
+        return false;
+    }
+
+    std::vector<bpf_insn> prog;
+    std::vector<size_t> to_pass, to_redirect; // Jumps to patch
+    auto jump = [&](std::vector<size_t>& fixups, uint8_t code, uint8_t dst, uint8_t src, int32_t imm) {
+        fixups.push_back(prog.size());
+        prog.push_back(insn(code, dst, src, 0, imm));
+    };
+
+    prog.push_back(insn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_6, BPF_REG_1, 0, 0)); // r6 = ctx
+    prog.push_back(insn(BPF_LDX | BPF_W | BPF_MEM, BPF_REG_2, BPF_REG_6, offsetof(xdp_md, data), 0));
+    prog.push_back(insn(BPF_LDX | BPF_W | BPF_MEM, BPF_REG_3, BPF_REG_6, offsetof(xdp_md, data_end), 0));
+    prog.push_back(insn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_4, BPF_REG_2, 0, 0));
+    prog.push_back(insn(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_4, 0, 0, UDP_HEADERS_END));
+    jump(to_pass, BPF_JMP | BPF_JGT | BPF_X, BPF_REG_4, BPF_REG_3, 0); // Too short
+    // Loads are little-endian reads of network-order bytes
+    prog.push_back(insn(BPF_LDX | BPF_H | BPF_MEM, BPF_REG_5, BPF_REG_2, ETH_TYPE, 0));
+    jump(to_pass, BPF_JMP | BPF_JNE | BPF_K, BPF_REG_5, 0, 0x0008); // ETH_P_IP
+    prog.push_back(insn(BPF_LDX | BPF_B | BPF_MEM, BPF_REG_5, BPF_REG_2, IP_VERSION_IHL, 0));
+    jump(to_pass, BPF_JMP | BPF_JNE | BPF_K, BPF_REG_5, 0, 0x45);
+    prog.push_back(insn(BPF_LDX | BPF_B | BPF_MEM, BPF_REG_5, BPF_REG_2, IP_PROTO, 0));
+    jump(to_pass, BPF_JMP | BPF_JNE | BPF_K, BPF_REG_5, 0, 17); // IPPROTO_UDP
+    prog.push_back(insn(BPF_LDX | BPF_H | BPF_MEM, BPF_REG_5, BPF_REG_2, IP_FLAGS_FRAG, 0));
+    prog.push_back(insn(BPF_ALU64 | BPF_AND | BPF_K, BPF_REG_5, 0, 0, 0xFF3F)); // MF | offset
+    jump(to_pass, BPF_JMP | BPF_JNE | BPF_K, BPF_REG_5, 0, 0);
+    if (!config_.ports.empty()) {
+        prog.push_back(insn(BPF_LDX | BPF_H | BPF_MEM, BPF_REG_5, BPF_REG_2, UDP_DPORT, 0));
+        for (uint16_t port : config_.ports) {
+            jump(to_redirect, BPF_JMP | BPF_JEQ | BPF_K, BPF_REG_5, 0, __builtin_bswap16(port));
+        }
+        jump(to_pass, BPF_JMP | BPF_JA, 0, 0, 0);
+    }
+
+    const size_t redirect_at = prog.size();
+    prog.push_back(insn(BPF_LDX | BPF_W | BPF_MEM, BPF_REG_2, BPF_REG_6, offsetof(xdp_md, rx_queue_index), 0));
+    prog.push_back(insn(BPF_LD | BPF_DW | BPF_IMM, BPF_REG_1, BPF_PSEUDO_MAP_FD, 0, map_fd_));
+    prog.push_back(insn(0, 0, 0, 0, 0)); // Upper half of the 64-bit immediate
+    prog.push_back(insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_3, 0, 0, XDP_PASS)); // If the slot is empty
+    prog.push_back(insn(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_redirect_map));
+    prog.push_back(insn(BPF_JMP | BPF_EXIT, 0, 0, 0, 0));
+    const size_t pass_at = prog.size();
+    prog.push_back(insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, XDP_PASS));
+    prog.push_back(insn(BPF_JMP | BPF_EXIT, 0, 0, 0, 0));
+
+    for (size_t at : to_pass) prog[at].off = static_cast<int16_t>(pass_at - at - 1);
+    for (size_t at : to_redirect) prog[at].off = static_cast<int16_t>(redirect_at - at - 1);
+
+    static const char LICENSE[] = "GPL";
+    char log[4096] = {};
+    attr = {};
+    attr.prog_type = BPF_PROG_TYPE_XDP;
+    attr.insn_cnt = static_cast<uint32_t>(prog.size());
+    attr.insns = reinterpret_cast<uint64_t>(prog.data());
+    attr.license = reinterpret_cast<uint64_t>(LICENSE);
+    attr.log_buf = reinterpret_cast<uint64_t>(log);
+    attr.log_size = sizeof(log);
+    attr.log_level = 1;
+    std::strncpy(attr.prog_name, "ultra_xsk", sizeof(attr.prog_name) - 1);
+    prog_fd_ = sys_bpf(BPF_PROG_LOAD, attr);
+    if (prog_fd_ < 0) {
+        perror("bpf(BPF_PROG_LOAD)");
+        std::cerr << log << std::endl;
+        return false;
+    }
+
+    const uint32_t key = config_.queue_id;
+    const uint32_t value = static_cast<uint32_t>(xsk_fd_);
+    attr = {};
+    attr.map_fd = static_cast<uint32_t>(map_fd_);
+    attr.key = reinterpret_cast<uint64_t>(&key);
+    attr.value = reinterpret_cast<uint64_t>(&value);
+    if (sys_bpf(BPF_MAP_UPDATE_ELEM, attr) < 0) {
+        perror("bpf(BPF_MAP_UPDATE_ELEM)");
+        return false;
+    }
+
+    // Driver hook first (required for zero-copy); generic hook otherwise
+    auto attach = [&](uint32_t flags) {
+        attr = {};
+        attr.link_create.prog_fd = static_cast<uint32_t>(prog_fd_);
+        attr.link_create.target_ifindex = ifindex_;
+        attr.link_create.attach_type = BPF_XDP;
+        attr.link_create.flags = flags;
+        link_fd_ = sys_bpf(BPF_LINK_CREATE, attr);
+        return link_fd_ >= 0;
+    };
+    generic_ = config_.generic_xdp;
+    if (!generic_ && !attach(XDP_FLAGS_DRV_MODE)) {
+        if (zero_copy_) {
+            perror("bpf(BPF_LINK_CREATE, XDP driver mode)");
+            return false;
+        }
+        generic_ = true;
+    }
+    if (generic_ && link_fd_ < 0 && !attach(XDP_FLAGS_SKB_MODE)) {
+        perror("bpf(BPF_LINK_CREATE, XDP)");
+        return false;
+    }
+    return true;
+}
+
+XDPReceiver::Stats XDPReceiver::stats() const {
+    xdp_statistics st{};
+    socklen_t len = sizeof(st);
+    if (xsk_fd_ < 0 || getsockopt(xsk_fd_, SOL_XDP, XDP_STATISTICS, &st, &len) < 0) return {};
+    return {st.rx_dropped, st.rx_ring_full, st.rx_fill_ring_empty_descs, st.rx_invalid_descs};
+}
+
+} // namespace ultra::network
@@ -0,0 +1,89 @@
+#include "ultra/network/multi_channel_receiver.hpp"
+#include "ultra/network/uring_receive.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace ultra::network {
+
+MultiChannelReceiver::MultiChannelReceiver(const Config& config) : config_(config) {
+    channels_.resize(config_.channels.size());
+    for (uint32_t i = 0; i < channels_.size(); ++i) {
+        channels_[i].index = i;
+        channels_[i].max_batches = config_.channels[i].max_batches;
+        order_.push_back(i);
+    }
+
+    // Highest priority first; equal priorities keep config order and
+    // share a tier whose starting channel rotates
+    std::stable_sort(order_.begin(), order_.end(), [&](uint32_t a, uint32_t b) {
+        return config_.channels[a].priority > config_.channels[b].priority;
+    });
+    for (uint32_t i = 0; i < order_.size(); ++i) {
+        if (tiers_.empty() ||
+            config_.channels[order_[tiers_.back().begin]].priority != config_.channels[order_[i]].priority) {
+            tiers_.push_back({i, i, 0});
+        }
+        tiers_.back().end = i + 1;
+    }
+}
+
+MultiChannelReceiver::~MultiChannelReceiver() {
+    stop();
+}
+
+// Receivers are built here so that, with the IO_URING backend, every
+// channel after the first shares the first one's SQ thread: one extra core
+// per venue rather than one per channel
+bool MultiChannelReceiver::start() {
+    int shared_ring_fd = -1;
+    for (Channel& ch : channels_) {
+        const ChannelConfig& cc = config_.channels[ch.index];
+        MulticastReceiver::Config rc = config_.receiver;
+        rc.multicast_group = cc.multicast_group;
+        rc.port = cc.port;
+        rc.non_blocking = true; // A blocking channel would stall all the others
+        rc.uring_attach_fd = shared_ring_fd;
+        ch.receiver = std::make_unique<MulticastReceiver>(rc);
+        if (!ch.receiver->start()) {
+            std::cerr << "MultiChannelReceiver: channel " << cc.name << " (" << cc.multicast_group << ":" << cc.port
+                      << ") failed to start" << std::endl;
+            stop();
+            return false;
+        }
+        const UringReceive* uring = ch.receiver->uring();
+        if (shared_ring_fd < 0 && uring && uring->sqpoll_active()) shared_ring_fd = uring->ring_fd();
+    }
+    std::cout << "Multi-channel receiver started: " << channels_.size() << " channel(s) in " << tiers_.size()
+              << " priority tier(s)" << std::endl;
+    return true;
+}
+
+void MultiChannelReceiver::stop() {
+    for (Channel& ch : channels_) {
+        if (ch.receiver) ch.receiver->stop();
+    }
+}
+
+MultiChannelReceiver::ChannelStats MultiChannelReceiver::stats(size_t channel) const {
+    ChannelStats st = channels_[channel].stats;
+    st.truncated = channels_[channel].receiver ? channels_[channel].receiver->truncated() : 0;
+    return st;
+}
+
+void MultiChannelReceiver::print_stats(std::ostream& os) const {
+    for (size_t i = 0; i < channels_.size(); ++i) {
+        const ChannelStats st = stats(i);
+        const ChannelConfig& cc = config_.channels[i];
+        os << "  " << (cc.name.empty() ? cc.multicast_group : cc.name) << " [prio " << cc.priority << "]: "
+           << st.packets << " pkts, " << st.bytes << " bytes, " << st.empty_polls << "/" << st.polls
+           << " empty polls";
+        if (config_.sequencing != Sequencing::NONE) {
+            os << ", next seq " << st.next_sequence << ", " << st.gaps << " gaps (" << st.missed << " msgs), "
+               << st.duplicates << " dups, " << st.heartbeats << " heartbeats";
+        }
+        if (st.truncated + st.malformed != 0) os << ", " << st.truncated << " truncated, " << st.malformed << " malformed";
+        os << "\n";
+    }
+}
+
+} // namespace ultra::network
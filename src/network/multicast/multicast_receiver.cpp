@@ -1,4 +1,6 @@
 #include "ultra/network/multicast_receiver.hpp"
+#include "ultra/network/uring_receive.hpp"
+#include "ultra/core/time/rdtsc_clock.hpp"
 #include <iostream>
 #include <cstring>
 #include <unistd.h>
@@ -6,9 +8,36 @@
 #include <sys/socket.h>
 #include <arpa/inet.h>
 #include <net/if.h>
+#include <sys/ioctl.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include <linux/sockios.h>
+#include <time.h>
 
 namespace ultra::network {
 
+namespace {
+// Room for one SCM_TIMESTAMPING cmsg (three timespecs)
+constexpr size_t CONTROL_LEN = CMSG_SPACE(sizeof(scm_timestamping));
+
+Timestamp to_ns(const timespec& ts) noexcept {
+    return static_cast<Timestamp>(ts.tv_sec) * 1'000'000'000ULL + static_cast<Timestamp>(ts.tv_nsec);
+}
+
+// Hardware stamp if present (index 2, raw NIC clock), else software (index 0)
+Timestamp rx_timestamp(msghdr& hdr) noexcept {
+    for (cmsghdr* c = CMSG_FIRSTHDR(&hdr); c != nullptr; c = CMSG_NXTHDR(&hdr, c)) {
+        if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_TIMESTAMPING) {
+            scm_timestamping stamps;
+            std::memcpy(&stamps, CMSG_DATA(c), sizeof(stamps));
+            if (stamps.ts[2].tv_sec != 0 || stamps.ts[2].tv_nsec != 0) return to_ns(stamps.ts[2]);
+            return to_ns(stamps.ts[0]);
+        }
+    }
+    return 0;
+}
+} // namespace
+
                    /**
                     * @brief Auto-generated description for MulticastReceiver.
                     * @param config Parameter description.
@@ -20,6 +49,7 @@ MulticastReceiver::MulticastReceiver(const Config& config) : config_(config) {}
                     */
 MulticastReceiver::~MulticastReceiver() {
     stop();
+    if (ring_.addr) HugePages::unmap(ring_);
 }
 
                         /**
@@ -71,6 +101,14 @@ bool MulticastReceiver::start() {
         perror("setsockopt(IP_ADD_MEMBERSHIP)");
         return false;
     }
+#ifdef IP_MULTICAST_ALL
+    // Only this socket's group: otherwise a socket bound to INADDR_ANY also
+    // gets every other group joined on the same port (e.g. sibling channels)
+    int all = 0;
+    if (setsockopt(sock_fd_, IPPROTO_IP, IP_MULTICAST_ALL, &all, sizeof(all)) < 0) {
+        perror("setsockopt(IP_MULTICAST_ALL)");
+    }
+#endif
 
     // 5. Set Non-Blocking if requested
     if (config_.non_blocking) {
@@ -81,6 +119,25 @@ bool MulticastReceiver::start() {
         }
     }
 
+    // 6. Busy polling: recvmmsg spins on the device queue for up to
+    // busy_poll_us before giving up (values above net.core.busy_read need
+    // CAP_NET_ADMIN, so failure is only a warning)
+#ifdef SO_BUSY_POLL
+    if (config_.busy_poll_us > 0 &&
+        setsockopt(sock_fd_, SOL_SOCKET, SO_BUSY_POLL, &config_.busy_poll_us, sizeof(config_.busy_poll_us)) < 0) {
+        perror("setsockopt(SO_BUSY_POLL)");
+    }
+#endif
+
+    // 7. Kernel receive timestamps
+    if (config_.timestamping) enable_timestamping();
+
+    if (config_.backend == Backend::IO_URING && !uring_ && !start_uring()) {
+        std::cerr << "Warning: io_uring receive unavailable, using recvmmsg" << std::endl;
+    }
+    if (!uring_ && !ring_.addr) setup_ring();
+    if (!uring_ && !ring_.addr) return false;
+
     running_ = true;
     std::cout << "UDP Receiver started on " << config_.multicast_group << ":" << config_.port << std::endl;
     return true;
@@ -91,6 +148,7 @@ bool MulticastReceiver::start() {
                          */
 void MulticastReceiver::stop() {
     running_ = false;
+    uring_.reset(); // Before the socket it receives from
     if (sock_fd_ >= 0) {
         close(sock_fd_);
         sock_fd_ = -1;
@@ -118,4 +176,146 @@ ULTRA_HOT int MulticastReceiver::receive(uint8_t* buffer, size_t max_len) {
     return static_cast<int>(n);
 }
 
+// Buffers for batch_size * ring_batches datagrams, faulted in up front, and
+// the recvmmsg headers pointing at them (built once, reused every call)
+void MulticastReceiver::setup_ring() {
+    if (config_.batch_size == 0) config_.batch_size = 1;
+    if (config_.ring_batches == 0) config_.ring_batches = 1;
+    const size_t slots = static_cast<size_t>(config_.batch_size) * config_.ring_batches;
+
+    HugePageOptions options;
+    options.populate = true;
+    ring_ = HugePages::map(slots * config_.buffer_size, options);
+    if (!ring_.addr) {
+        std::cerr << "MulticastReceiver: could not map " << slots << " receive buffers" << std::endl;
+        return;
+    }
+
+    msgs_.assign(slots, mmsghdr{});
+    iovecs_.resize(slots);
+    control_.assign(slots * CONTROL_LEN / sizeof(uint64_t), 0);
+    packets_out_.resize(slots);
+    auto* base = static_cast<uint8_t*>(ring_.addr);
+    for (size_t i = 0; i < slots; ++i) {
+        iovecs_[i].iov_base = base + i * config_.buffer_size;
+        iovecs_[i].iov_len = config_.buffer_size;
+        msgs_[i].msg_hdr.msg_iov = &iovecs_[i];
+        msgs_[i].msg_hdr.msg_iovlen = 1;
+        msgs_[i].msg_hdr.msg_control = reinterpret_cast<uint8_t*>(control_.data()) + i * CONTROL_LEN;
+    }
+}
+
+// Software rx stamps always; NIC stamps only if the driver accepts
+// SIOCSHWTSTAMP (root, capable NIC). The NIC clock is CLOCK_REALTIME only
+// when phc2sys keeps it in step.
+void MulticastReceiver::enable_timestamping() {
+    int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    if (config_.hardware_timestamps && !config_.interface_name.empty()) {
+        hwtstamp_config hw{};
+        hw.tx_type = HWTSTAMP_TX_OFF;
+        hw.rx_filter = HWTSTAMP_FILTER_ALL;
+        ifreq ifr{};
+        std::strncpy(ifr.ifr_name, config_.interface_name.c_str(), IFNAMSIZ - 1);
+        ifr.ifr_data = reinterpret_cast<char*>(&hw);
+        if (ioctl(sock_fd_, SIOCSHWTSTAMP, &ifr) == 0) {
+            flags |= SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+            hw_timestamps_ = true;
+        } else {
+            perror("ioctl(SIOCSHWTSTAMP)");
+            std::cerr << "Warning: no hardware rx timestamps on " << config_.interface_name
+                      << ", using software stamps" << std::endl;
+        }
+    }
+    if (setsockopt(sock_fd_, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) < 0) {
+        perror("setsockopt(SO_TIMESTAMPING)");
+        hw_timestamps_ = false;
+    }
+}
+
+ULTRA_HOT std::span<const MulticastReceiver::Packet> MulticastReceiver::receive_batch() {
+    if (!running_) return {};
+    if (uring_) return receive_batch_uring();
+
+    const size_t first = static_cast<size_t>(ring_batch_) * config_.batch_size;
+    // The kernel shrinks msg_controllen to what it wrote; give it the full space back
+    for (size_t i = first; i < first + config_.batch_size; ++i) msgs_[i].msg_hdr.msg_controllen = CONTROL_LEN;
+    // Non-blocking: whatever is queued now. Blocking: wait for one, then
+    // take whatever else is already queued.
+    const int flags = config_.non_blocking ? MSG_DONTWAIT : MSG_WAITFORONE;
+    const int n = recvmmsg(sock_fd_, &msgs_[first], config_.batch_size, flags, nullptr);
+    if (n <= 0) {
+        if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) perror("recvmmsg");
+        return {};
+    }
+    const Timestamp rx_tsc = RDTSCClock::rdtsc();
+    timespec now;
+    clock_gettime(CLOCK_REALTIME, &now); // Same clock as the kernel stamps
+    const Timestamp user_ts = to_ns(now);
+
+    size_t count = 0;
+    for (int i = 0; i < n; ++i) {
+        mmsghdr& m = msgs_[first + i];
+        if (ULTRA_UNLIKELY(m.msg_hdr.msg_flags & MSG_TRUNC)) {
+            ++truncated_;
+            continue;
+        }
+        packets_out_[first + count++] = {static_cast<const uint8_t*>(iovecs_[first + i].iov_base), m.msg_len,
+                                         rx_tsc, rx_timestamp(m.msg_hdr), user_ts};
+    }
+
+    ring_batch_ = ring_batch_ + 1 == config_.ring_batches ? 0 : ring_batch_ + 1;
+    ++batches_;
+    packets_ += count;
+    return {&packets_out_[first], count};
+}
+
+// The socket stays as set up above; the ring receives from it. Buffers
+// carry the same cmsg space as the recvmmsg path so timestamps still work.
+bool MulticastReceiver::start_uring() {
+    if (config_.batch_size == 0) config_.batch_size = 1;
+    if (config_.ring_batches == 0) config_.ring_batches = 1;
+    UringReceive::Config uring_config;
+    uring_config.buffer_count = config_.uring_buffers;
+    uring_config.payload_size = config_.buffer_size;
+    uring_config.control_len = config_.timestamping ? static_cast<uint32_t>(CONTROL_LEN) : 0;
+    uring_config.batch_size = config_.batch_size;
+    uring_config.ring_batches = config_.ring_batches;
+    uring_config.sqpoll = config_.uring_sqpoll;
+    uring_config.sqpoll_cpu = config_.uring_sqpoll_cpu;
+    uring_config.attach_ring_fd = config_.uring_attach_fd;
+    uring_ = std::make_unique<UringReceive>(uring_config);
+    if (!uring_->start(sock_fd_)) {
+        uring_.reset();
+        return false;
+    }
+    packets_out_.resize(static_cast<size_t>(config_.batch_size) * config_.ring_batches);
+    return true;
+}
+
+ULTRA_HOT std::span<const MulticastReceiver::Packet> MulticastReceiver::receive_batch_uring() {
+    const size_t first = static_cast<size_t>(ring_batch_) * config_.batch_size;
+    size_t count = 0;
+    Timestamp rx_tsc = 0;
+    Timestamp user_ts = 0;
+    const size_t reaped = uring_->reap([&](const UringReceive::Message& m) {
+        if (ULTRA_UNLIKELY(rx_tsc == 0)) {
+            rx_tsc = RDTSCClock::rdtsc();
+            timespec now;
+            clock_gettime(CLOCK_REALTIME, &now);
+            user_ts = to_ns(now);
+        }
+        if (ULTRA_UNLIKELY(m.truncated)) {
+            ++truncated_;
+            return;
+        }
+        packets_out_[first + count++] = {m.payload, m.len, rx_tsc, rx_timestamp(*m.control), user_ts};
+    });
+    if (reaped == 0) return {};
+
+    ring_batch_ = ring_batch_ + 1 == config_.ring_batches ? 0 : ring_batch_ + 1;
+    ++batches_;
+    packets_ += count;
+    return {&packets_out_[first], count};
+}
+
 } // namespace ultra::network
@@ -0,0 +1,95 @@
+#include "ultra/network/multicast_sender.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdio>
+#include <unistd.h>
+
+namespace ultra::network {
+
+MulticastSender::MulticastSender(const Config& config)
+    : config_(config),
+      buffers_(static_cast<size_t>(config.batch_size) * config.buffer_size),
+      iovecs_(config.batch_size),
+      msgs_(config.batch_size) {
+    for (uint32_t i = 0; i < config_.batch_size; ++i) {
+        iovecs_[i].iov_base = buffers_.data() + static_cast<size_t>(i) * config_.buffer_size;
+        msgs_[i].msg_hdr = {};
+        msgs_[i].msg_hdr.msg_iov = &iovecs_[i];
+        msgs_[i].msg_hdr.msg_iovlen = 1;
+        msgs_[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+    }
+}
+
+MulticastSender::~MulticastSender() {
+    stop();
+}
+
+bool MulticastSender::start() {
+    sock_fd_ = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (sock_fd_ < 0) {
+        perror("socket");
+        return false;
+    }
+    if (setsockopt(sock_fd_, SOL_SOCKET, SO_SNDBUF, &config_.send_buffer_size, sizeof(config_.send_buffer_size)) < 0) {
+        perror("setsockopt(SO_SNDBUF)");
+    }
+    if (!config_.interface_ip.empty()) {
+        in_addr iface{};
+        iface.s_addr = inet_addr(config_.interface_ip.c_str());
+        if (setsockopt(sock_fd_, IPPROTO_IP, IP_MULTICAST_IF, &iface, sizeof(iface)) < 0) {
+            perror("setsockopt(IP_MULTICAST_IF)");
+            stop();
+            return false;
+        }
+    }
+    const unsigned char ttl = static_cast<unsigned char>(config_.ttl);
+    const unsigned char loop = config_.loopback ? 1 : 0;
+    if (setsockopt(sock_fd_, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) < 0 ||
+        setsockopt(sock_fd_, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) < 0) {
+        perror("setsockopt(IP_MULTICAST_TTL/LOOP)");
+        stop();
+        return false;
+    }
+    return true;
+}
+
+void MulticastSender::stop() {
+    if (sock_fd_ >= 0) {
+        flush();
+        close(sock_fd_);
+        sock_fd_ = -1;
+    }
+}
+
+int MulticastSender::add_destination(const std::string& group, int port) {
+    sockaddr_in dst{};
+    dst.sin_family = AF_INET;
+    dst.sin_port = htons(static_cast<uint16_t>(port));
+    if (inet_pton(AF_INET, group.c_str(), &dst.sin_addr) != 1) return -1;
+    if (pending_ != 0) flush(); // Queued msg_name pointers go stale if the vector grows
+    destinations_.push_back(dst);
+    return static_cast<int>(destinations_.size() - 1);
+}
+
+bool MulticastSender::flush() {
+    uint32_t sent = 0;
+    bool ok = true;
+    while (sent < pending_) {
+        const int n = sendmmsg(sock_fd_, &msgs_[sent], pending_ - sent, 0);
+        ++stats_.syscalls;
+        if (n < 0) {
+            if (errno == EINTR || errno == ENOBUFS || errno == EAGAIN) continue; // Socket buffer full: retry
+            perror("sendmmsg");
+            stats_.dropped += pending_ - sent;
+            ok = false;
+            break;
+        }
+        for (int i = 0; i < n; ++i) stats_.bytes += msgs_[sent + i].msg_len;
+        stats_.datagrams += static_cast<uint64_t>(n);
+        sent += static_cast<uint32_t>(n);
+    }
+    pending_ = 0;
+    return ok;
+}
+
+} // namespace ultra::network
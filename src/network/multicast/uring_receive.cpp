@@ -0,0 +1,379 @@
+#include "ultra/network/uring_receive.hpp"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+namespace ultra::network {
+
+namespace {
+int io_uring_setup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int io_uring_register(int fd, unsigned opcode, void* arg, unsigned nr_args) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+constexpr uint16_t BUFFER_GROUP = 0;
+constexpr uint64_t SETUP_USER_DATA = 2;
+} // namespace
+
+UringReceive::UringReceive(const Config& config) : config_(config) {}
+
+UringReceive::~UringReceive() {
+    stop();
+}
+
+bool UringReceive::start(int sock_fd) {
+    if (config_.buffer_count == 0 || config_.buffer_count > 32768 ||
+        (config_.buffer_count & (config_.buffer_count - 1)) != 0) {
+        std::cerr << "UringReceive: buffer_count must be a power of two <= 32768" << std::endl;
+        return false;
+    }
+    if (config_.batch_size == 0) config_.batch_size = 1;
+    if (config_.ring_batches == 0) config_.ring_batches = 1;
+    if (static_cast<uint64_t>(config_.batch_size) * config_.ring_batches >= config_.buffer_count) {
+        std::cerr << "UringReceive: buffer_count must exceed batch_size * ring_batches" << std::endl;
+        return false;
+    }
+    sock_fd_ = sock_fd;
+    if (!setup_ring() || !setup_buffers()) {
+        stop();
+        return false;
+    }
+    arm();
+    rearms_ = enters_ = 0;
+    return true;
+}
+
+void UringReceive::stop() {
+    if (ring_fd_ >= 0) {
+        close(ring_fd_); // Cancels the multishot request, unregisters the buffers
+        ring_fd_ = -1;
+    }
+    if (sqes_) munmap(sqes_, sqes_len_);
+    if (ring_map_) munmap(ring_map_, ring_map_len_);
+    if (buf_ring_) munmap(buf_ring_, buf_ring_len_);
+    if (buffer_map_.addr) HugePages::unmap(buffer_map_);
+    sqes_ = nullptr;
+    ring_map_ = nullptr;
+    buf_ring_ = nullptr;
+    buffer_map_ = {};
+    buffers_ = nullptr;
+    armed_ = false;
+    legacy_buffers_ = false;
+    to_provide_.clear();
+}
+
+// The CQ is sized so that every buffer can be completed at once: a full
+// CQ would otherwise stop the multishot request
+bool UringReceive::setup_ring() {
+    // Room for one batch of buffer returns plus the re-arm
+    uint32_t entries = 8;
+    while (entries < config_.batch_size * 2) entries <<= 1;
+    io_uring_params params{};
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = config_.buffer_count * 2;
+    if (config_.sqpoll) {
+        params.flags |= IORING_SETUP_SQPOLL;
+        params.sq_thread_idle = config_.sqpoll_idle_ms;
+        if (config_.sqpoll_cpu >= 0) {
+            params.flags |= IORING_SETUP_SQ_AFF;
+            params.sq_thread_cpu = static_cast<uint32_t>(config_.sqpoll_cpu);
+        }
+        if (config_.attach_ring_fd >= 0) {
+            // Share that ring's SQ thread instead of starting another
+            params.flags |= IORING_SETUP_ATTACH_WQ;
+            params.wq_fd = static_cast<uint32_t>(config_.attach_ring_fd);
+        }
+    }
+    ring_fd_ = io_uring_setup(entries, &params);
+    if (ring_fd_ < 0 && config_.sqpoll) {
+        perror("io_uring_setup(SQPOLL)");
+        std::cerr << "Warning: no SQPOLL, io_uring receive will enter the kernel when idle" << std::endl;
+        params = {};
+        params.flags = IORING_SETUP_CQSIZE;
+        params.cq_entries = config_.buffer_count * 2;
+        ring_fd_ = io_uring_setup(entries, &params);
+    }
+    if (ring_fd_ < 0) {
+        perror("io_uring_setup");
+        return false;
+    }
+    sqpoll_ = (params.flags & IORING_SETUP_SQPOLL) != 0;
+    if (!(params.features & IORING_FEAT_SINGLE_MMAP)) {
+        std::cerr << "UringReceive: kernel lacks IORING_FEAT_SINGLE_MMAP" << std::endl;
+        return false;
+    }
+
+    const size_t sq_len = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    const size_t cq_len = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    ring_map_len_ = sq_len > cq_len ? sq_len : cq_len;
+    void* ring = mmap(nullptr, ring_map_len_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                      IORING_OFF_SQ_RING);
+    if (ring == MAP_FAILED) {
+        perror("mmap(IORING_OFF_SQ_RING)");
+        return false;
+    }
+    ring_map_ = ring;
+    sqes_len_ = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, sqes_len_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                      IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        perror("mmap(IORING_OFF_SQES)");
+        return false;
+    }
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    auto* base = static_cast<uint8_t*>(ring);
+    sq_head_ = reinterpret_cast<std::atomic<uint32_t>*>(base + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<std::atomic<uint32_t>*>(base + params.sq_off.tail);
+    sq_flags_ = reinterpret_cast<std::atomic<uint32_t>*>(base + params.sq_off.flags);
+    sq_array_ = reinterpret_cast<uint32_t*>(base + params.sq_off.array);
+    sq_mask_ = *reinterpret_cast<uint32_t*>(base + params.sq_off.ring_mask);
+    cq_head_ = reinterpret_cast<uint32_t*>(base + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<std::atomic<uint32_t>*>(base + params.cq_off.tail);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+    cq_mask_ = *reinterpret_cast<uint32_t*>(base + params.cq_off.ring_mask);
+    sq_pending_tail_ = sq_tail_->load(std::memory_order_relaxed);
+    return true;
+}
+
+// Buffers pre-faulted (one per in-flight datagram) and all published to
+// the kernel's free-buffer ring
+bool UringReceive::setup_buffers() {
+    buffer_stride_ = static_cast<uint32_t>(sizeof(io_uring_recvmsg_out)) + config_.control_len + config_.payload_size;
+    buffer_stride_ = (buffer_stride_ + 63) & ~63u; // Payloads start on their own cache line
+    HugePageOptions options = config_.memory;
+    options.populate = true;
+    buffer_map_ = HugePages::map(static_cast<size_t>(config_.buffer_count) * buffer_stride_, options);
+    if (!buffer_map_.addr) {
+        std::cerr << "UringReceive: could not map " << config_.buffer_count << " buffers" << std::endl;
+        return false;
+    }
+    buffers_ = static_cast<uint8_t*>(buffer_map_.addr);
+
+    const size_t page = static_cast<size_t>(getpagesize());
+    buf_ring_len_ = (config_.buffer_count * sizeof(io_uring_buf) + page - 1) & ~(page - 1);
+    void* br = mmap(nullptr, buf_ring_len_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (br == MAP_FAILED) {
+        perror("mmap(buffer ring)");
+        return false;
+    }
+    buf_ring_ = static_cast<io_uring_buf_ring*>(br);
+
+    io_uring_buf_reg reg{};
+    reg.ring_addr = reinterpret_cast<uint64_t>(buf_ring_);
+    reg.ring_entries = config_.buffer_count;
+    reg.bgid = BUFFER_GROUP;
+    if (io_uring_register(ring_fd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        perror("io_uring_register(PBUF_RING)");
+        return false;
+    }
+
+    held_.assign(config_.ring_batches, {});
+    for (auto& h : held_) h.reserve(config_.batch_size);
+    batch_ = 0;
+    buf_tail_ = 0;
+    const uint32_t mask = config_.buffer_count - 1;
+    for (uint32_t bid = 0; bid < config_.buffer_count; ++bid) {
+        io_uring_buf& b = buf_ring_->bufs[buf_tail_++ & mask];
+        b.addr = reinterpret_cast<uint64_t>(buffers_ + static_cast<size_t>(bid) * buffer_stride_);
+        b.len = buffer_stride_;
+        b.bid = static_cast<uint16_t>(bid);
+    }
+    std::atomic_ref<uint16_t>(buf_ring_->tail).store(buf_tail_, std::memory_order_release);
+
+    msg_ = {};
+    msg_.msg_namelen = 0;
+    msg_.msg_controllen = config_.control_len;
+
+    if (probe_buffer_ring()) return true;
+
+    // Classic provided buffers: the ring is dropped and every buffer handed
+    // over with one PROVIDE_BUFFERS
+    io_uring_register(ring_fd_, IORING_UNREGISTER_PBUF_RING, &reg, 1);
+    munmap(buf_ring_, buf_ring_len_);
+    buf_ring_ = nullptr;
+    legacy_buffers_ = true;
+    to_provide_.reserve(config_.buffer_count);
+    io_uring_sqe* sqe = next_sqe();
+    sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+    sqe->fd = static_cast<int32_t>(config_.buffer_count);
+    sqe->addr = reinterpret_cast<uint64_t>(buffers_);
+    sqe->len = buffer_stride_;
+    sqe->off = 0; // First buffer id
+    sqe->buf_group = BUFFER_GROUP;
+    int32_t res = 0;
+    if (!submit_and_wait(res) || res < 0) {
+        errno = -res;
+        perror("io_uring PROVIDE_BUFFERS");
+        return false;
+    }
+    std::cerr << "Warning: io_uring buffer ring not usable on this kernel, using PROVIDE_BUFFERS" << std::endl;
+    return true;
+}
+
+// Reads one byte from a pipe through the buffer ring. Some kernels accept
+// the registration but answer every selection with ENOBUFS.
+bool UringReceive::probe_buffer_ring() {
+    int fds[2];
+    if (pipe(fds) < 0) return false;
+    const char byte = 0;
+    bool ok = false;
+    if (write(fds[1], &byte, 1) == 1) {
+        io_uring_sqe* sqe = next_sqe();
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = fds[0];
+        sqe->off = static_cast<uint64_t>(-1);
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = BUFFER_GROUP;
+        int32_t res = 0;
+        ok = submit_and_wait(res) && res == 1;
+    }
+    close(fds[0]);
+    close(fds[1]);
+    if (ok) {
+        // The probe took the buffer at the ring head; put it back at the tail
+        const uint32_t mask = config_.buffer_count - 1;
+        io_uring_buf& b = buf_ring_->bufs[buf_tail_++ & mask];
+        b.addr = reinterpret_cast<uint64_t>(buffers_);
+        b.len = buffer_stride_;
+        b.bid = 0;
+        std::atomic_ref<uint16_t>(buf_ring_->tail).store(buf_tail_, std::memory_order_release);
+    }
+    return ok;
+}
+
+// Next free SQE (zeroed), or nullptr if the SQ thread has not caught up
+io_uring_sqe* UringReceive::next_sqe() {
+    const uint32_t head = sq_head_->load(std::memory_order_acquire);
+    if (sq_pending_tail_ - head > sq_mask_) return nullptr;
+    const uint32_t index = sq_pending_tail_ & sq_mask_;
+    io_uring_sqe* sqe = &sqes_[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sq_array_[index] = index;
+    ++sq_pending_tail_;
+    return sqe;
+}
+
+// Publishes the SQEs taken with next_sqe(). With SQPOLL the SQ thread
+// picks them up (woken if it went idle); otherwise they are submitted here.
+void UringReceive::submit(uint32_t count) {
+    sq_tail_->store(sq_pending_tail_, std::memory_order_release);
+    if (sqpoll_) {
+        if (sq_flags_->load(std::memory_order_acquire) & IORING_SQ_NEED_WAKEUP) {
+            io_uring_enter(ring_fd_, 0, 0, IORING_ENTER_SQ_WAKEUP);
+            ++enters_;
+        }
+    } else {
+        if (io_uring_enter(ring_fd_, count, 0, 0) < 0) perror("io_uring_enter(submit)");
+        ++enters_;
+    }
+}
+
+// Setup only: submits the last next_sqe() and waits for its completion
+bool UringReceive::submit_and_wait(int32_t& res) {
+    sqes_[(sq_pending_tail_ - 1) & sq_mask_].user_data = SETUP_USER_DATA;
+    sq_tail_->store(sq_pending_tail_, std::memory_order_release);
+    const unsigned flags = IORING_ENTER_GETEVENTS | (sqpoll_ ? IORING_ENTER_SQ_WAKEUP : 0);
+    if (io_uring_enter(ring_fd_, 1, 1, flags) < 0) {
+        perror("io_uring_enter(setup)");
+        return false;
+    }
+    const uint32_t head = *cq_head_;
+    if (head == cq_tail_->load(std::memory_order_acquire)) return false;
+    res = cqes_[head & cq_mask_].res;
+    cq_head_store(head + 1);
+    return true;
+}
+
+// Queues the multishot recvmsg (retried on the next reap if the SQ is full)
+void UringReceive::arm() {
+    io_uring_sqe* sqe = next_sqe();
+    if (ULTRA_UNLIKELY(sqe == nullptr)) return;
+    sqe->opcode = IORING_OP_RECVMSG;
+    sqe->fd = sock_fd_;
+    sqe->addr = reinterpret_cast<uint64_t>(&msg_);
+    sqe->len = 0; // Whole provided buffer
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = BUFFER_GROUP;
+    sqe->user_data = RECV_USER_DATA;
+    submit(1);
+    armed_ = true;
+    ++rearms_;
+}
+
+// Nothing completed. Without SQPOLL, completions for our request are
+// task work that only runs when this thread enters the kernel.
+void UringReceive::idle() {
+    if (!sqpoll_) {
+        io_uring_enter(ring_fd_, 0, 0, IORING_ENTER_GETEVENTS);
+        ++enters_;
+    }
+    if (ULTRA_UNLIKELY(!armed_)) arm();
+}
+
+// Returns one batch's buffers: one release store on the buffer ring, or
+// in legacy mode PROVIDE_BUFFERS SQEs, one per run of consecutive ids
+// (see provide_pending(); completions skipped)
+void UringReceive::recycle(uint32_t batch) {
+    auto& held = held_[batch];
+    if (held.empty()) {
+        if (ULTRA_UNLIKELY(!to_provide_.empty())) provide_pending();
+        return;
+    }
+    if (ULTRA_UNLIKELY(legacy_buffers_)) {
+        to_provide_.insert(to_provide_.end(), held.begin(), held.end());
+        held.clear();
+        provide_pending();
+        return;
+    }
+    const uint32_t mask = config_.buffer_count - 1;
+    for (uint16_t bid : held) {
+        io_uring_buf& b = buf_ring_->bufs[buf_tail_++ & mask];
+        b.addr = reinterpret_cast<uint64_t>(buffers_ + static_cast<size_t>(bid) * buffer_stride_);
+        b.len = buffer_stride_;
+        b.bid = bid;
+    }
+    std::atomic_ref<uint16_t>(buf_ring_->tail).store(buf_tail_, std::memory_order_release);
+    held.clear();
+}
+
+// One PROVIDE_BUFFERS per run of consecutive ids (nbufs > 1): buffers come
+// back in the order they were taken, so a batch is usually one or two runs
+void UringReceive::provide_pending() {
+    std::sort(to_provide_.begin(), to_provide_.end(), std::greater<>());
+    uint32_t queued = 0;
+    while (!to_provide_.empty()) {
+        io_uring_sqe* sqe = next_sqe();
+        if (sqe == nullptr) break; // Rest goes with the next batch
+        uint16_t first = to_provide_.back();
+        to_provide_.pop_back();
+        uint32_t run = 1;
+        while (!to_provide_.empty() && to_provide_.back() == first + run) {
+            to_provide_.pop_back();
+            ++run;
+        }
+        sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+        sqe->fd = static_cast<int32_t>(run);
+        sqe->addr = reinterpret_cast<uint64_t>(buffers_ + static_cast<size_t>(first) * buffer_stride_);
+        sqe->len = buffer_stride_;
+        sqe->off = first;
+        sqe->buf_group = BUFFER_GROUP;
+        sqe->flags = IOSQE_CQE_SKIP_SUCCESS;
+        ++queued;
+    }
+    if (queued != 0) submit(queued);
+}
+
+} // namespace ultra::network
@@ -0,0 +1,293 @@
+#include "ultra/network/replay/pcap_reader.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ultra::network {
+
+namespace {
+constexpr uint32_t PCAP_MAGIC_US = 0xA1B2C3D4;
+constexpr uint32_t PCAP_MAGIC_NS = 0xA1B23C4D;
+constexpr size_t PCAP_FILE_HEADER = 24;
+constexpr size_t PCAP_RECORD_HEADER = 16;
+
+constexpr uint32_t PCAPNG_SHB = 0x0A0D0D0A; // Same in both byte orders
+constexpr uint32_t PCAPNG_IDB = 1;
+constexpr uint32_t PCAPNG_OPB = 2;
+constexpr uint32_t PCAPNG_SPB = 3;
+constexpr uint32_t PCAPNG_EPB = 6;
+constexpr uint32_t PCAPNG_BYTE_ORDER_MAGIC = 0x1A2B3C4D;
+constexpr uint16_t PCAPNG_OPT_END = 0;
+constexpr uint16_t PCAPNG_OPT_TSRESOL = 9;
+constexpr uint16_t PCAPNG_OPT_TSOFFSET = 14;
+
+constexpr uint16_t LINKTYPE_ETHERNET = 1;
+constexpr uint16_t LINKTYPE_LINUX_SLL = 113;
+constexpr uint32_t SLL_SKIP = 2; // 16-byte SLL header: protocol at 14, Ethernet has its ethertype at 12
+
+constexpr uint64_t NS_PER_S = 1'000'000'000ull;
+
+uint32_t raw32(const uint8_t* p) noexcept {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+size_t pad4(size_t n) noexcept { return (n + 3) & ~size_t{3}; }
+} // namespace
+
+PcapReader::PcapReader() : PcapReader(Config{}) {}
+
+PcapReader::PcapReader(const Config& config) : config_(config) {}
+
+PcapReader::~PcapReader() {
+    close();
+}
+
+bool PcapReader::open(const std::string& path) {
+    close();
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        perror(("PcapReader: open " + path).c_str());
+        return false;
+    }
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size < 12) {
+        std::cerr << "PcapReader: " << path << " is too short for a capture" << std::endl;
+        ::close(fd);
+        return false;
+    }
+    const int flags = MAP_PRIVATE | (config_.populate ? MAP_POPULATE : 0);
+    void* map = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, flags, fd, 0);
+    ::close(fd); // The mapping keeps the file
+    if (map == MAP_FAILED) {
+        perror("PcapReader: mmap");
+        return false;
+    }
+    madvise(map, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+    base_ = static_cast<const uint8_t*>(map);
+    size_ = static_cast<size_t>(st.st_size);
+
+    const uint32_t magic = raw32(base_);
+    if (magic == PCAP_MAGIC_US || magic == PCAP_MAGIC_NS ||
+        magic == __builtin_bswap32(PCAP_MAGIC_US) || magic == __builtin_bswap32(PCAP_MAGIC_NS)) {
+        if (size_ < PCAP_FILE_HEADER) {
+            std::cerr << "PcapReader: " << path << ": truncated pcap header" << std::endl;
+            close();
+            return false;
+        }
+        format_ = Format::PCAP;
+        swapped_ = magic != PCAP_MAGIC_US && magic != PCAP_MAGIC_NS;
+        const bool nanos = magic == PCAP_MAGIC_NS || magic == __builtin_bswap32(PCAP_MAGIC_NS);
+        // Upper bits of the link type field carry FCS information
+        interfaces_.push_back({static_cast<uint16_t>(load32(base_ + 20) & 0xFFFF), false,
+                               static_cast<uint8_t>(nanos ? 9 : 6), 0});
+        first_record_ = PCAP_FILE_HEADER;
+    } else if (magic == PCAPNG_SHB) {
+        format_ = Format::PCAPNG; // Sections are read as blocks by next()
+        first_record_ = 0;
+    } else {
+        std::cerr << "PcapReader: " << path << " is not a pcap or pcapng capture" << std::endl;
+        close();
+        return false;
+    }
+    pos_ = first_record_;
+    return true;
+}
+
+void PcapReader::close() {
+    if (base_) munmap(const_cast<uint8_t*>(base_), size_);
+    base_ = nullptr;
+    size_ = 0;
+    format_ = Format::NONE;
+    first_record_ = 0;
+    interfaces_.clear();
+    rewind();
+}
+
+void PcapReader::rewind() {
+    pos_ = first_record_;
+    truncated_ = false;
+    last_ts_ = 0;
+    packets_ = skipped_ = not_udp_ = filtered_ = 0;
+    // pcapng interfaces are declared in the stream and re-read from the start
+    if (format_ == Format::PCAPNG) interfaces_.clear();
+}
+
+bool PcapReader::next(Packet& packet) {
+    return format_ == Format::PCAP ? next_pcap(packet) : format_ == Format::PCAPNG && next_pcapng(packet);
+}
+
+bool PcapReader::next_pcap(Packet& packet) {
+    while (pos_ + PCAP_RECORD_HEADER <= size_) {
+        const uint8_t* rec = base_ + pos_;
+        const uint32_t caplen = load32(rec + 8);
+        if (ULTRA_UNLIKELY(caplen > size_ - pos_ - PCAP_RECORD_HEADER)) break;
+        pos_ += PCAP_RECORD_HEADER + caplen;
+        // Seconds and sub-seconds: fold into ticks of the file's resolution
+        const uint64_t ticks_per_s = interfaces_[0].exponent == 9 ? NS_PER_S : 1'000'000ull;
+        const uint64_t ticks = static_cast<uint64_t>(load32(rec)) * ticks_per_s + load32(rec + 4);
+        if (deliver(packet, 0, ticks, rec + PCAP_RECORD_HEADER, caplen, load32(rec + 12))) return true;
+    }
+    if (pos_ != size_) stop("record cut off");
+    return false;
+}
+
+bool PcapReader::next_pcapng(Packet& packet) {
+    while (pos_ + 12 <= size_) {
+        const uint8_t* block = base_ + pos_;
+        const uint32_t type = load32(block);
+        if (type == PCAPNG_SHB) {
+            const uint32_t bom = raw32(block + 8);
+            if (bom != PCAPNG_BYTE_ORDER_MAGIC && bom != __builtin_bswap32(PCAPNG_BYTE_ORDER_MAGIC)) {
+                stop("bad section header byte-order magic");
+                return false;
+            }
+            swapped_ = bom != PCAPNG_BYTE_ORDER_MAGIC;
+            interfaces_.clear(); // Interface ids are per section
+        }
+        const uint32_t total = load32(block + 4);
+        if (ULTRA_UNLIKELY(total < 12 || (total & 3) != 0 || total > size_ - pos_)) {
+            stop(total > size_ - pos_ ? "block cut off" : "bad block length");
+            return false;
+        }
+        pos_ += total;
+        const uint8_t* body = block + 8;
+        const size_t body_len = total - 12;
+
+        switch (type) {
+            case PCAPNG_IDB:
+                if (!add_interface(body, body_len)) return false;
+                break;
+            case PCAPNG_EPB: {
+                if (body_len < 20) break;
+                const uint32_t caplen = load32(body + 12);
+                if (caplen > body_len - 20) break;
+                const uint64_t ticks = (static_cast<uint64_t>(load32(body + 4)) << 32) | load32(body + 8);
+                if (deliver(packet, load32(body), ticks, body + 20, caplen, load32(body + 16))) return true;
+                break;
+            }
+            case PCAPNG_SPB: {
+                if (body_len < 4) break;
+                const uint32_t wire_len = load32(body);
+                const uint32_t caplen = std::min<uint32_t>(wire_len, static_cast<uint32_t>(body_len - 4));
+                if (deliver(packet, 0, UINT64_MAX, body + 4, caplen, wire_len)) return true;
+                break;
+            }
+            case PCAPNG_OPB: {
+                if (body_len < 20) break;
+                const uint32_t caplen = load32(body + 12);
+                if (caplen > body_len - 20) break;
+                const uint64_t ticks = (static_cast<uint64_t>(load32(body + 4)) << 32) | load32(body + 8);
+                if (deliver(packet, load16(body), ticks, body + 20, caplen, load32(body + 16))) return true;
+                break;
+            }
+            default:
+                break; // SHB (handled above), NRB, ISB, DSB, custom...
+        }
+    }
+    if (pos_ != size_) stop("block cut off");
+    return false;
+}
+
+bool PcapReader::add_interface(const uint8_t* body, size_t len) {
+    if (len < 8) {
+        stop("short interface description block");
+        return false;
+    }
+    Interface itf{load16(body), false, 6, 0}; // Default resolution: microseconds
+    // Options: code, length, value padded to 4 bytes
+    for (size_t off = 8; off + 4 <= len;) {
+        const uint16_t code = load16(body + off);
+        const uint16_t opt_len = load16(body + off + 2);
+        const uint8_t* value = body + off + 4;
+        if (code == PCAPNG_OPT_END || off + 4 + opt_len > len) break;
+        if (code == PCAPNG_OPT_TSRESOL && opt_len >= 1) {
+            itf.binary_resolution = (value[0] & 0x80) != 0;
+            itf.exponent = value[0] & 0x7F;
+        } else if (code == PCAPNG_OPT_TSOFFSET && opt_len >= 8) {
+            uint64_t v;
+            std::memcpy(&v, value, sizeof(v));
+            itf.offset_s = static_cast<int64_t>(swapped_ ? __builtin_bswap64(v) : v);
+        }
+        off += 4 + pad4(opt_len);
+    }
+    if ((!itf.binary_resolution && itf.exponent > 18) || (itf.binary_resolution && itf.exponent > 63)) {
+        stop("unsupported timestamp resolution");
+        return false;
+    }
+    interfaces_.push_back(itf);
+    return true;
+}
+
+// ticks == UINT64_MAX: the record has no timestamp (SPB), the previous one is reused
+bool PcapReader::deliver(Packet& packet, uint32_t interface, uint64_t ticks, const uint8_t* data, uint32_t caplen,
+                         uint32_t wire_len) {
+    if (ULTRA_UNLIKELY(interface >= interfaces_.size())) {
+        ++skipped_;
+        return false;
+    }
+    const Interface& itf = interfaces_[interface];
+    uint32_t skip = 0;
+    if (itf.link_type == LINKTYPE_LINUX_SLL) {
+        skip = SLL_SKIP;
+    } else if (ULTRA_UNLIKELY(itf.link_type != LINKTYPE_ETHERNET)) {
+        ++skipped_;
+        return false;
+    }
+    if (ULTRA_UNLIKELY(caplen < skip)) {
+        ++skipped_;
+        return false;
+    }
+    if (ticks != UINT64_MAX) last_ts_ = to_ns(itf, ticks);
+    packet.data = data + skip;
+    packet.caplen = caplen - skip;
+    packet.wire_len = wire_len - std::min(wire_len, skip);
+    packet.timestamp_ns = last_ts_;
+    packet.interface = interface;
+    ++packets_;
+    return true;
+}
+
+Timestamp PcapReader::to_ns(const Interface& itf, uint64_t ticks) noexcept {
+    unsigned __int128 ns;
+    if (itf.binary_resolution) {
+        ns = (static_cast<unsigned __int128>(ticks) * NS_PER_S) >> itf.exponent;
+    } else if (itf.exponent <= 9) {
+        uint64_t scale = 1;
+        for (uint8_t e = itf.exponent; e < 9; ++e) scale *= 10;
+        ns = static_cast<unsigned __int128>(ticks) * scale;
+    } else {
+        uint64_t scale = 1;
+        for (uint8_t e = 9; e < itf.exponent; ++e) scale *= 10;
+        ns = ticks / scale;
+    }
+    return static_cast<Timestamp>(static_cast<int64_t>(ns) + itf.offset_s * static_cast<int64_t>(NS_PER_S));
+}
+
+uint16_t PcapReader::load16(const uint8_t* p) const noexcept {
+    uint16_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return swapped_ ? __builtin_bswap16(v) : v;
+}
+
+uint32_t PcapReader::load32(const uint8_t* p) const noexcept {
+    const uint32_t v = raw32(p);
+    return swapped_ ? __builtin_bswap32(v) : v;
+}
+
+void PcapReader::stop(const char* why) {
+    if (!truncated_) {
+        std::cerr << "PcapReader: " << why << " at offset " << pos_ << " of " << size_
+                  << ", replay ends here" << std::endl;
+    }
+    truncated_ = true;
+    pos_ = size_;
+}
+
+} // namespace ultra::network
@@ -1,6 +1,7 @@
 #include "ultra/risk/pretrade_checker.hpp"
 #include "ultra/execution/gateway_sim.hpp"
 #include "ultra/core/async_logger.hpp"
+#include "ultra/core/memory/scratch_arena.hpp"
 #include <iostream>
 
 namespace ultra::risk {
@@ -19,8 +20,10 @@ PretradeChecker::PretradeChecker(const Config& config) : config_(config) {
                                  * @return bool value.
                                  */
 ULTRA_HOT bool PretradeChecker::check_order(const strategy::StrategyOrder& order) noexcept {
+    ScratchArena::Scope scratch; // Per-order temporaries (trace parameters)
     ULTRA_TRACE("PretradeChecker::check_order", "Safety validation before routing", 
-                "oid=" + std::to_string(order.order_id) + " qty=" + std::to_string(order.quantity));
+                scratch.arena().format("oid=%llu qty=%llu", static_cast<unsigned long long>(order.order_id),
+                                       static_cast<unsigned long long>(order.quantity)));
     
     uint64_t now_ns = RDTSCClock::now();
 
@@ -74,11 +77,20 @@ ULTRA_HOT bool PretradeChecker::check_order(const strategy::StrategyOrder& order
                        * @param report Parameter description.
                        */
 void PretradeChecker::on_execution(const exec::ExecutionReport& report) noexcept {
-    ULTRA_TRACE("PretradeChecker::on_execution", "Position update from fill", "oid=" + std::to_string(report.order_id));
+    ScratchArena::Scope scratch;
+    ULTRA_TRACE("PretradeChecker::on_execution", "Position update from fill",
+                scratch.arena().format("oid=%llu", static_cast<unsigned long long>(report.order_id)));
     // Update position on fills
     if (report.status == OrderStatus::FILLED || report.status == OrderStatus::PARTIAL) {
         // Mock logic
     }
 }
 
+void PretradeChecker::reset() noexcept {
+    current_position_ = 0;
+    total_notional_exposure_ = 0;
+    last_order_hash_ = 0;
+    last_order_time_ns_ = 0;
+}
+
 } // namespace ultra::risk
\ No newline at end of file
@@ -10,8 +10,8 @@ namespace ultra::strategy {
                    * @brief Auto-generated description for RLPolicyStrategy.
                    * @param symbol_id Parameter description.
                    */
-RLPolicyStrategy::RLPolicyStrategy(SymbolId symbol_id)
-    : symbol_id_(symbol_id), order_book_(symbol_id) {
+RLPolicyStrategy::RLPolicyStrategy(SymbolId symbol_id, const HugePageOptions& memory, void* order_storage)
+    : symbol_id_(symbol_id), order_book_(symbol_id, memory, order_storage) {
     std::cout << "RLPolicyStrategy (AI-Integrated) initialized for symbol " << symbol_id_ << std::endl;
 }
 
@@ -64,6 +64,13 @@ bool RLPolicyStrategy::get_order(StrategyOrder& order) {
     return order_queue_.pop(order);
 }
 
+void RLPolicyStrategy::reset() noexcept {
+    order_book_.reset();
+    current_inventory_ = 0;
+    StrategyOrder discarded;
+    while (order_queue_.pop(discarded)) {}
+}
+
                        /**
                         * @brief Auto-generated description for run_inference.
                         */
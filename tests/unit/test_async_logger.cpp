@@ -3,6 +3,8 @@
 #include <fstream>
 #include <chrono>
 #include <thread>
+#include <vector>
+#include <cstdio>
 // #include <json/json.h> // Removed as it's not available
 
 using namespace ultra;
@@ -14,6 +16,7 @@ protected:
         std::remove("/Users/shreejitverma/Documents/GitHub/ultra-hft-project/logs/test_standard.log");
         std::remove("/Users/shreejitverma/Documents/GitHub/ultra-hft-project/logs/test_json.log");
         std::remove("/Users/shreejitverma/Documents/GitHub/ultra-hft-project/logs/test_stress.log");
+        std::remove("/Users/shreejitverma/Documents/GitHub/ultra-hft-project/logs/test_multi_thread.log");
     }
     void TearDown() override {
         AsyncLogger::instance().stop();
@@ -84,3 +87,43 @@ TEST_F(AsyncLoggerTest, StressTest) {
     
     EXPECT_EQ(count, num_msgs);
 }
+
+TEST_F(AsyncLoggerTest, MultiThreadStress) {
+    std::string test_log = "/Users/shreejitverma/Documents/GitHub/ultra-hft-project/logs/test_multi_thread.log";
+    AsyncLogger::instance().start(test_log, false);
+
+    // Two waves of MAX_PRODUCERS threads: the second reuses the rings the
+    // first released on exit
+    const int num_threads = static_cast<int>(AsyncLogger::MAX_PRODUCERS);
+    const int num_msgs = 1000;
+    for (int wave = 0; wave < 2; ++wave) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            const int id = wave * num_threads + t;
+            threads.emplace_back([id] {
+                for (int i = 0; i < num_msgs; ++i) ULTRA_LOG(INFO, "thread %d message %d", id, i);
+            });
+        }
+        for (auto& th : threads) th.join();
+    }
+
+    AsyncLogger::instance().stop();
+
+    // Every line arrives, in order within each thread
+    std::ifstream in(test_log);
+    std::vector<int> next(2 * num_threads, 0);
+    int count = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        auto pos = line.find("thread ");
+        ASSERT_NE(pos, std::string::npos);
+        int id = -1, msg = -1;
+        ASSERT_EQ(std::sscanf(line.c_str() + pos, "thread %d message %d", &id, &msg), 2);
+        ASSERT_GE(id, 0);
+        ASSERT_LT(id, 2 * num_threads);
+        EXPECT_EQ(msg, next[id]++);
+        count++;
+    }
+
+    EXPECT_EQ(count, 2 * num_threads * num_msgs);
+}
@@ -0,0 +1,118 @@
+#include "ultra/core/lockfree/broadcast_ring.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace ultra;
+
+TEST(BroadcastRingTest, EveryConsumerSeesEveryEvent) {
+    BroadcastRing<uint64_t, 16, 4> ring;
+    size_t a = ring.add_consumer();
+    size_t b = ring.add_consumer();
+    ASSERT_NE(a, ring.INVALID_CONSUMER);
+    ASSERT_NE(b, ring.INVALID_CONSUMER);
+
+    for (uint64_t i = 0; i < 10; ++i) ASSERT_TRUE(ring.publish(i));
+    EXPECT_EQ(ring.lag(a), 10u);
+
+    uint64_t v;
+    for (uint64_t i = 0; i < 10; ++i) {
+        ASSERT_TRUE(ring.read(a, v));
+        EXPECT_EQ(v, i);
+    }
+    EXPECT_FALSE(ring.read(a, v));
+    EXPECT_EQ(ring.lag(a), 0u);
+    EXPECT_EQ(ring.lag(b), 10u);
+
+    for (uint64_t i = 0; i < 10; ++i) {
+        const uint64_t* p = ring.peek(b);
+        ASSERT_NE(p, nullptr);
+        EXPECT_EQ(*p, i);
+        ring.advance(b);
+    }
+    EXPECT_EQ(ring.peek(b), nullptr);
+}
+
+TEST(BroadcastRingTest, LateConsumerStartsAtCursor) {
+    BroadcastRing<uint64_t, 16, 4> ring;
+    for (uint64_t i = 0; i < 5; ++i) ASSERT_TRUE(ring.publish(i));
+    size_t c = ring.add_consumer();
+    uint64_t v;
+    EXPECT_FALSE(ring.read(c, v));
+    ring.publish(42);
+    ASSERT_TRUE(ring.read(c, v));
+    EXPECT_EQ(v, 42u);
+}
+
+TEST(BroadcastRingTest, BlocksOnSlowestConsumer) {
+    BroadcastRing<uint64_t, 8, 4> ring;
+    size_t fast = ring.add_consumer();
+    size_t slow = ring.add_consumer();
+
+    uint64_t v;
+    for (uint64_t i = 0; i < 8; ++i) {
+        ASSERT_TRUE(ring.publish(i));
+        ASSERT_TRUE(ring.read(fast, v));
+    }
+    EXPECT_FALSE(ring.publish(8));
+    EXPECT_EQ(ring.lag(slow), 8u);
+
+    ASSERT_TRUE(ring.read(slow, v));
+    EXPECT_TRUE(ring.publish(8));
+
+    // Removing the laggard frees the producer entirely
+    EXPECT_FALSE(ring.publish(9));
+    ring.remove_consumer(slow);
+    EXPECT_TRUE(ring.publish(9));
+}
+
+TEST(BroadcastRingTest, OverwriteCountsOverruns) {
+    BroadcastRing<uint64_t, 8, 4, BroadcastPolicy::OVERWRITE> ring;
+    size_t c = ring.add_consumer();
+
+    for (uint64_t i = 0; i < 20; ++i) ASSERT_TRUE(ring.publish(i));
+
+    // Only the last 8 events are intact
+    uint64_t v;
+    ASSERT_TRUE(ring.read(c, v));
+    EXPECT_EQ(v, 12u);
+    EXPECT_EQ(ring.overruns(c), 12u);
+    for (uint64_t i = 13; i < 20; ++i) {
+        ASSERT_TRUE(ring.read(c, v));
+        EXPECT_EQ(v, i);
+    }
+    EXPECT_FALSE(ring.read(c, v));
+}
+
+TEST(BroadcastRingTest, ConcurrentConsumersInOrder) {
+    using Ring = BroadcastRing<uint64_t, 1024, 4>;
+    auto ring = std::make_unique<Ring>();
+    constexpr uint64_t N = 500000;
+    constexpr int CONSUMERS = 3;
+
+    std::vector<size_t> ids;
+    for (int i = 0; i < CONSUMERS; ++i) ids.push_back(ring->add_consumer());
+
+    std::vector<int> ok(CONSUMERS, 1);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < CONSUMERS; ++i) {
+        threads.emplace_back([&, i] {
+            uint64_t expected = 0, v;
+            while (expected < N) {
+                if (!ring->read(ids[i], v)) { std::this_thread::yield(); continue; }
+                if (v != expected++) ok[i] = 0;
+            }
+        });
+    }
+
+    for (uint64_t i = 0; i < N; ) {
+        if (ring->publish(i)) ++i; else std::this_thread::yield();
+    }
+    for (auto& t : threads) t.join();
+
+    for (int i = 0; i < CONSUMERS; ++i) {
+        EXPECT_TRUE(ok[i]);
+        EXPECT_EQ(ring->lag(ids[i]), 0u);
+    }
+}
@@ -0,0 +1,153 @@
+#include "ultra/core/lockfree/byte_ring.hpp"
+#include "ultra/network/kernel-bypass/dma_ring.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace ultra;
+
+namespace {
+using SmallRing = ByteRing<256>;
+
+std::vector<uint8_t> pattern(size_t len, uint8_t seed) {
+    std::vector<uint8_t> v(len);
+    for (size_t i = 0; i < len; ++i) v[i] = static_cast<uint8_t>(seed + i);
+    return v;
+}
+}
+
+TEST(ByteRingTest, PushPeekRelease) {
+    SmallRing ring;
+    EXPECT_TRUE(ring.empty());
+    EXPECT_TRUE(ring.peek().empty());
+
+    auto a = pattern(5, 1), b = pattern(40, 2);
+    ASSERT_TRUE(ring.push(a.data(), a.size()));
+    ASSERT_TRUE(ring.push(b.data(), b.size()));
+    EXPECT_EQ(ring.used_bytes(), SmallRing::footprint(5) + SmallRing::footprint(40));
+    EXPECT_EQ(SmallRing::footprint(5), 16u);
+    EXPECT_EQ(SmallRing::footprint(40), 48u);
+
+    auto r = ring.peek();
+    ASSERT_EQ(r.size(), 5u);
+    EXPECT_TRUE(std::equal(r.begin(), r.end(), a.begin()));
+    ring.release();
+
+    uint8_t out[64];
+    ASSERT_EQ(ring.pop(out, sizeof(out)), 40u);
+    EXPECT_TRUE(std::equal(out, out + 40, b.begin()));
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.used_bytes(), 0u);
+}
+
+TEST(ByteRingTest, CommitShorterThanReserved) {
+    SmallRing ring;
+    uint8_t* p = ring.try_reserve(100);
+    ASSERT_NE(p, nullptr);
+    std::memcpy(p, "abc", 3);
+    ring.commit(3);
+    EXPECT_EQ(ring.used_bytes(), SmallRing::footprint(3));
+
+    auto r = ring.peek();
+    ASSERT_EQ(r.size(), 3u);
+    EXPECT_EQ(std::memcmp(r.data(), "abc", 3), 0);
+}
+
+TEST(ByteRingTest, RejectsOversizeAndFull) {
+    SmallRing ring;
+    EXPECT_EQ(SmallRing::max_record_size(), 120u);
+    EXPECT_EQ(ring.try_reserve(121), nullptr);
+
+    auto a = pattern(120, 0);
+    ASSERT_TRUE(ring.push(a.data(), a.size())); // 128 bytes
+    ASSERT_TRUE(ring.push(a.data(), a.size())); // 256: full
+    EXPECT_FALSE(ring.push(a.data(), 1));
+    ring.peek();
+    ring.release();
+    EXPECT_TRUE(ring.push(a.data(), 1));
+}
+
+TEST(ByteRingTest, WrapWritesPaddingAndStaysContiguous) {
+    SmallRing ring;
+    auto a = pattern(200, 0);
+    ASSERT_FALSE(ring.push(a.data(), a.size())); // > max_record_size
+
+    // Fill 208 bytes, consume them, so the next write starts 48 bytes from the end
+    auto b = pattern(96, 3);
+    ASSERT_TRUE(ring.push(b.data(), b.size())); // 104
+    ASSERT_TRUE(ring.push(b.data(), b.size())); // 208
+    uint8_t out[128];
+    ASSERT_EQ(ring.pop(out, sizeof(out)), 96u);
+    ASSERT_EQ(ring.pop(out, sizeof(out)), 96u);
+
+    // 64-byte record does not fit in the last 48 bytes: padding + record at 0
+    auto c = pattern(56, 9);
+    ASSERT_TRUE(ring.push(c.data(), c.size()));
+    EXPECT_EQ(ring.used_bytes(), 48u + 64u);
+
+    auto r = ring.peek();
+    ASSERT_EQ(r.size(), 56u);
+    EXPECT_TRUE(std::equal(r.begin(), r.end(), c.begin()));
+    ring.release();
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(ByteRingTest, DMARingBufferPackets) {
+    auto dma = std::make_unique<network::DMARingBuffer>();
+    EXPECT_FALSE(dma->has_data());
+
+    auto pkt = pattern(40, 7);
+    ASSERT_TRUE(dma->write_packet(pkt.data(), pkt.size()));
+
+    uint8_t* slot = dma->reserve();
+    ASSERT_NE(slot, nullptr);
+    std::memcpy(slot, pkt.data(), 20);
+    dma->commit(20);
+
+    size_t len = 0;
+    ASSERT_TRUE(dma->has_data());
+    const uint8_t* p = dma->peek(len);
+    ASSERT_EQ(len, 40u);
+    EXPECT_EQ(std::memcmp(p, pkt.data(), 40), 0);
+    dma->advance();
+
+    p = dma->peek(len);
+    ASSERT_EQ(len, 20u);
+    EXPECT_EQ(std::memcmp(p, pkt.data(), 20), 0);
+    dma->advance();
+    EXPECT_FALSE(dma->has_data());
+    EXPECT_EQ(dma->peek(len), nullptr);
+}
+
+// Variable-length records across threads through many wraps; every record
+// carries its sequence number and a length derived from it
+TEST(ByteRingTest, CrossThreadVariableLength) {
+    auto ring = std::make_unique<ByteRing<4096>>();
+    constexpr uint32_t N = 200000;
+
+    std::thread producer([&] {
+        uint8_t buf[300];
+        for (uint32_t i = 0; i < N; ++i) {
+            const size_t len = 4 + (i * 37) % 290;
+            std::memcpy(buf, &i, 4);
+            for (size_t k = 4; k < len; ++k) buf[k] = static_cast<uint8_t>(i + k);
+            while (!ring->push(buf, len)) std::this_thread::yield();
+        }
+    });
+
+    uint32_t expected = 0, bad = 0;
+    while (expected < N) {
+        auto r = ring->peek();
+        if (r.empty()) { std::this_thread::yield(); continue; }
+        uint32_t seq;
+        std::memcpy(&seq, r.data(), 4);
+        bad += (seq != expected) || (r.size() != 4 + (expected * 37) % 290);
+        for (size_t k = 4; k < r.size(); ++k) bad += (r[k] != static_cast<uint8_t>(expected + k));
+        ring->release();
+        ++expected;
+    }
+    producer.join();
+    EXPECT_EQ(bad, 0u);
+    EXPECT_TRUE(ring->empty());
+}
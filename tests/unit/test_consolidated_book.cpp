@@ -0,0 +1,159 @@
+#include "ultra/market-data/book/consolidated_book.hpp"
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <random>
+
+using namespace ultra;
+using namespace ultra::md;
+using namespace ultra::md::itch;
+
+namespace {
+
+ITCHDecoder::DecodedMessage make_add(OrderId id, Side side, Price price, Quantity qty) {
+    ITCHDecoder::DecodedMessage msg{};
+    msg.valid = true;
+    msg.symbol_id = 1;
+    msg.event_type = MDEventType::ADD_ORDER;
+    msg.order_id = id;
+    msg.side = side;
+    msg.price = price;
+    msg.quantity = qty;
+    return msg;
+}
+
+ITCHDecoder::DecodedMessage make_delete(OrderId id) {
+    ITCHDecoder::DecodedMessage msg{};
+    msg.valid = true;
+    msg.symbol_id = 1;
+    msg.event_type = MDEventType::DELETE_ORDER;
+    msg.order_id = id;
+    return msg;
+}
+
+} // namespace
+
+class ConsolidatedBookTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (auto& b : books_) b = std::make_unique<OrderBookL2>(1);
+        nbbo_ = std::make_unique<ConsolidatedBook>(1);
+        ASSERT_TRUE(nbbo_->add_venue(0, "NASDAQ", books_[0].get()));
+        ASSERT_TRUE(nbbo_->add_venue(1, "NYSE", books_[1].get()));
+        ASSERT_TRUE(nbbo_->add_venue(2, "ARCA", books_[2].get()));
+    }
+
+    void apply(VenueId venue, const ITCHDecoder::DecodedMessage& msg) {
+        books_[venue]->update(msg);
+        nbbo_->on_venue_update(venue);
+    }
+
+    std::unique_ptr<OrderBookL2> books_[3];
+    std::unique_ptr<ConsolidatedBook> nbbo_;
+};
+
+TEST_F(ConsolidatedBookTest, RejectsBadRegistration) {
+    EXPECT_FALSE(nbbo_->add_venue(0, "DUP", books_[1].get()));
+    EXPECT_FALSE(nbbo_->add_venue(ConsolidatedBook::MAX_VENUES, "OOR", books_[1].get()));
+    EXPECT_EQ(nbbo_->venue_count(), 3u);
+    EXPECT_STREQ(nbbo_->venue_name(1), "NYSE");
+}
+
+TEST_F(ConsolidatedBookTest, MergesBestAcrossVenues) {
+    apply(0, make_add(1, Side::BUY, 10000, 100));
+    apply(1, make_add(2, Side::BUY, 10100, 50));
+    apply(2, make_add(3, Side::SELL, 10200, 70));
+    apply(0, make_add(4, Side::SELL, 10300, 30));
+
+    EXPECT_EQ(nbbo_->best_bid().price, 10100);
+    EXPECT_EQ(nbbo_->best_bid().quantity, 50);
+    EXPECT_EQ(nbbo_->best_bid().venue_mask, 1u << 1);
+    EXPECT_EQ(nbbo_->best_ask().price, 10200);
+    EXPECT_EQ(nbbo_->best_venue(Side::SELL), 2);
+    EXPECT_EQ(nbbo_->bid_depth(), 2u);
+    EXPECT_EQ(nbbo_->ask_depth(), 2u);
+}
+
+TEST_F(ConsolidatedBookTest, AttributesSharedPriceLevels) {
+    apply(0, make_add(1, Side::BUY, 10000, 100));
+    apply(1, make_add(2, Side::BUY, 10000, 300));
+    apply(2, make_add(3, Side::BUY, 10000, 300));
+
+    const auto& top = nbbo_->best_bid();
+    EXPECT_EQ(top.quantity, 700);
+    EXPECT_EQ(top.venue_mask, 0b111);
+    EXPECT_EQ(top.venue_qty[0], 100);
+    EXPECT_EQ(top.venue_qty[1], 300);
+    EXPECT_EQ(top.venue_qty[2], 300);
+    // Tie on size goes to the more preferred (lower) venue id
+    EXPECT_EQ(nbbo_->best_venue(Side::BUY), 1);
+
+    apply(1, make_delete(2));
+    EXPECT_EQ(nbbo_->best_bid().quantity, 400);
+    EXPECT_EQ(nbbo_->best_bid().venue_mask, 0b101);
+    EXPECT_EQ(nbbo_->best_venue(Side::BUY), 2);
+
+    apply(0, make_delete(1));
+    apply(2, make_delete(3));
+    EXPECT_EQ(nbbo_->bid_depth(), 0u);
+    EXPECT_EQ(nbbo_->best_bid().price, 0);
+    EXPECT_EQ(nbbo_->best_venue(Side::BUY), ConsolidatedBook::MAX_VENUES);
+}
+
+TEST_F(ConsolidatedBookTest, UntouchedLevelsAreNotRewritten) {
+    for (int i = 0; i < 5; ++i) {
+        apply(0, make_add(100 + i, Side::BUY, 10000 - i * 100, 10));
+    }
+    const uint64_t before = nbbo_->level_updates();
+    apply(1, make_add(200, Side::SELL, 10500, 10));
+    EXPECT_EQ(nbbo_->level_updates() - before, 1u);
+}
+
+// Randomised cross-check: incremental ladder must equal a from-scratch merge
+TEST_F(ConsolidatedBookTest, MatchesFullRebuild) {
+    std::mt19937_64 rng(42);
+    std::vector<std::pair<VenueId, OrderId>> live;
+    OrderId next_id = 1;
+
+    for (int step = 0; step < 20000; ++step) {
+        if (live.empty() || rng() % 3 != 0) {
+            VenueId v = static_cast<VenueId>(rng() % 3);
+            Side side = (rng() & 1) ? Side::BUY : Side::SELL;
+            Price px = (side == Side::BUY ? 9900 : 10100) + (side == Side::BUY ? -1 : 1) *
+                       static_cast<Price>(rng() % 20) * 10;
+            apply(v, make_add(next_id, side, px, 1 + rng() % 500));
+            live.push_back({v, next_id++});
+        } else {
+            size_t k = rng() % live.size();
+            apply(live[k].first, make_delete(live[k].second));
+            live[k] = live.back();
+            live.pop_back();
+        }
+
+        if (step % 997 != 0) continue;
+
+        std::map<Price, Quantity, std::greater<Price>> want_bids;
+        std::map<Price, Quantity> want_asks;
+        for (auto& b : books_) {
+            for (size_t i = 0; i < ConsolidatedBook::DEPTH; ++i) {
+                if (b->bids()[i].price != 0) want_bids[b->bids()[i].price] += b->bids()[i].quantity;
+                if (b->asks()[i].price != INVALID_PRICE) want_asks[b->asks()[i].price] += b->asks()[i].quantity;
+            }
+        }
+
+        ASSERT_EQ(nbbo_->bid_depth(), want_bids.size());
+        size_t i = 0;
+        for (auto& [px, qty] : want_bids) {
+            ASSERT_EQ(nbbo_->bids()[i].price, px);
+            ASSERT_EQ(nbbo_->bids()[i].quantity, qty);
+            ++i;
+        }
+        ASSERT_EQ(nbbo_->ask_depth(), want_asks.size());
+        i = 0;
+        for (auto& [px, qty] : want_asks) {
+            ASSERT_EQ(nbbo_->asks()[i].price, px);
+            ASSERT_EQ(nbbo_->asks()[i].quantity, qty);
+            ++i;
+        }
+    }
+}
@@ -0,0 +1,211 @@
+#include "ultra/network/parsers/ethernet_parser.hpp"
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace ultra;
+using network::EthernetParser;
+using network::FlowTable;
+using Drop = EthernetParser::Drop;
+
+namespace {
+// Ethernet (+ tags) / IPv4 / UDP frame around `payload`
+struct FrameSpec {
+    std::vector<std::pair<uint16_t, uint16_t>> tags; ///< (TPID, VLAN id), outermost first.
+    const char* dst = "239.1.1.1";
+    uint16_t dst_port = 5000;
+    uint8_t protocol = IPPROTO_UDP;
+    uint8_t version_ihl = 0x45;
+    uint16_t flags_offset = 0;
+    size_t payload = 32;
+    int ip_len_delta = 0; ///< Added to the IP total length.
+    int udp_len_delta = 0; ///< Added to the UDP length.
+    size_t padding = 0; ///< Ethernet padding after the datagram.
+};
+
+std::vector<uint8_t> build(const FrameSpec& spec) {
+    std::vector<uint8_t> f(12, 0xAA); // MACs
+    auto put16 = [&](uint16_t v) {
+        f.push_back(static_cast<uint8_t>(v >> 8));
+        f.push_back(static_cast<uint8_t>(v));
+    };
+    for (const auto& [tpid, vid] : spec.tags) {
+        put16(tpid);
+        put16(vid);
+    }
+    put16(ETHERTYPE_IP);
+    const size_t ihl = (spec.version_ihl & 0x0F) * 4u;
+    network::IPv4Header ip{};
+    ip.version_ihl = spec.version_ihl;
+    ip.total_length = htons(static_cast<uint16_t>(ihl + sizeof(network::UDPHeader) + spec.payload + spec.ip_len_delta));
+    ip.flags_offset = htons(spec.flags_offset);
+    ip.ttl = 1;
+    ip.protocol = spec.protocol;
+    ip.src_ip = inet_addr("10.0.0.1");
+    ip.dst_ip = inet_addr(spec.dst);
+    const auto* ip_bytes = reinterpret_cast<const uint8_t*>(&ip);
+    f.insert(f.end(), ip_bytes, ip_bytes + sizeof(ip));
+    f.resize(f.size() + ihl - sizeof(ip), 0); // Options
+    network::UDPHeader udp{};
+    udp.src_port = htons(4000);
+    udp.dst_port = htons(spec.dst_port);
+    udp.length = htons(static_cast<uint16_t>(sizeof(udp) + spec.payload + spec.udp_len_delta));
+    const auto* udp_bytes = reinterpret_cast<const uint8_t*>(&udp);
+    f.insert(f.end(), udp_bytes, udp_bytes + sizeof(udp));
+    for (size_t i = 0; i < spec.payload; ++i) f.push_back(static_cast<uint8_t>(i));
+    f.resize(f.size() + spec.padding, 0);
+    return f;
+}
+
+EthernetParser::ParsedPacket parse(const std::vector<uint8_t>& f) { return EthernetParser::parse(f.data(), f.size(), 7); }
+} // namespace
+
+TEST(EthernetParserTest, PlainUdpFrame) {
+    const auto f = build({});
+    const auto p = parse(f);
+    ASSERT_TRUE(p.valid);
+    EXPECT_EQ(p.drop, Drop::NONE);
+    EXPECT_EQ(p.payload, f.data() + 14 + 20 + 8);
+    EXPECT_EQ(p.payload_len, 32);
+    EXPECT_EQ(p.dst_ip, inet_addr("239.1.1.1"));
+    EXPECT_EQ(ntohs(p.dst_port), 5000);
+    EXPECT_EQ(p.vlan_id, 0);
+    EXPECT_EQ(p.timestamp_ns, 7u);
+}
+
+TEST(EthernetParserTest, VlanAndQinQ) {
+    FrameSpec single;
+    single.tags = {{0x8100, 101}};
+    auto f = build(single);
+    auto p = parse(f);
+    ASSERT_TRUE(p.valid);
+    EXPECT_EQ(p.vlan_id, 101);
+    EXPECT_EQ(p.outer_vlan_id, 0);
+    EXPECT_EQ(p.payload, f.data() + 18 + 20 + 8);
+
+    for (uint16_t outer_tpid : {uint16_t{0x88A8}, uint16_t{0x9100}}) {
+        FrameSpec qinq;
+        qinq.tags = {{outer_tpid, 0x2000 | 7}, {0x8100, 202}}; // PCP bits are not part of the id
+        f = build(qinq);
+        p = parse(f);
+        ASSERT_TRUE(p.valid);
+        EXPECT_EQ(p.outer_vlan_id, 7);
+        EXPECT_EQ(p.vlan_id, 202);
+        EXPECT_EQ(p.payload, f.data() + 22 + 20 + 8);
+    }
+
+    FrameSpec triple;
+    triple.tags = {{0x88A8, 1}, {0x8100, 2}, {0x8100, 3}};
+    EXPECT_EQ(parse(build(triple)).drop, Drop::NOT_IPV4);
+}
+
+TEST(EthernetParserTest, TruncatedAtEveryHeaderIsRejected) {
+    FrameSpec spec;
+    spec.tags = {{0x88A8, 1}, {0x8100, 2}};
+    const auto f = build(spec);
+    for (size_t len = 0; len < f.size(); ++len) {
+        const auto p = EthernetParser::parse(f.data(), len, 0);
+        EXPECT_FALSE(p.valid) << len;
+        EXPECT_EQ(p.drop, Drop::TRUNCATED) << len;
+    }
+    EXPECT_TRUE(EthernetParser::parse(f.data(), f.size(), 0).valid);
+}
+
+TEST(EthernetParserTest, MalformedHeaders) {
+    FrameSpec spec;
+    spec.version_ihl = 0x44; // IHL 16 bytes
+    EXPECT_EQ(parse(build(spec)).drop, Drop::BAD_IP_HEADER);
+    spec.version_ihl = 0x65;
+    EXPECT_EQ(parse(build(spec)).drop, Drop::BAD_IP_HEADER);
+
+    spec = {};
+    spec.protocol = IPPROTO_TCP;
+    EXPECT_EQ(parse(build(spec)).drop, Drop::NOT_UDP);
+
+    spec = {};
+    spec.flags_offset = 0x2000; // MF: first fragment
+    EXPECT_EQ(parse(build(spec)).drop, Drop::FRAGMENT);
+    spec.flags_offset = 0x0010;
+    EXPECT_EQ(parse(build(spec)).drop, Drop::FRAGMENT);
+    spec.flags_offset = 0x4000; // DF alone is fine
+    EXPECT_TRUE(parse(build(spec)).valid);
+
+    spec = {};
+    spec.udp_len_delta = 1; // UDP past the IP datagram
+    EXPECT_EQ(parse(build(spec)).drop, Drop::BAD_UDP_LENGTH);
+    spec.udp_len_delta = -40; // Shorter than its own header
+    EXPECT_EQ(parse(build(spec)).drop, Drop::BAD_UDP_LENGTH);
+
+    spec = {};
+    spec.ip_len_delta = 1; // IP datagram past the frame
+    EXPECT_EQ(parse(build(spec)).drop, Drop::TRUNCATED);
+}
+
+TEST(EthernetParserTest, EthernetPaddingIsNotPayload) {
+    FrameSpec spec;
+    spec.payload = 2;
+    spec.padding = 16; // 60-byte minimum frame
+    const auto p = parse(build(spec));
+    ASSERT_TRUE(p.valid);
+    EXPECT_EQ(p.payload_len, 2);
+}
+
+TEST(EthernetParserTest, FlowTableExactAndAnyPort) {
+    FlowTable flows;
+    EXPECT_EQ(flows.lookup(inet_addr("239.1.1.1"), htons(5000)), FlowTable::NO_CHANNEL);
+    ASSERT_TRUE(flows.add("239.1.1.1", 5000, 3));
+    ASSERT_TRUE(flows.add("239.1.1.2", 0, 4)); // Any port
+    EXPECT_FALSE(flows.add("not-an-ip", 1, 5));
+    for (uint16_t i = 0; i < 40; ++i) flows.add(0xEF020000u + i, 6000, static_cast<uint16_t>(10 + i)); // Grows the table
+
+    EXPECT_EQ(flows.size(), 42u);
+    EXPECT_EQ(flows.lookup(inet_addr("239.1.1.1"), htons(5000)), 3);
+    EXPECT_EQ(flows.lookup(inet_addr("239.1.1.1"), htons(5001)), FlowTable::NO_CHANNEL);
+    EXPECT_EQ(flows.lookup(inet_addr("239.1.1.2"), htons(9)), 4);
+    EXPECT_EQ(flows.lookup(inet_addr("239.2.0.39"), htons(6000)), 49);
+    EXPECT_EQ(flows.lookup(inet_addr("239.2.0.40"), htons(6000)), FlowTable::NO_CHANNEL);
+
+    flows.add("239.1.1.2", 7, 9); // Exact beats any-port
+    EXPECT_EQ(flows.lookup(inet_addr("239.1.1.2"), htons(7)), 9);
+    EXPECT_EQ(flows.lookup(inet_addr("239.1.1.2"), htons(8)), 4);
+
+    flows.add("239.1.1.1", 5000, 8); // Replaces
+    EXPECT_EQ(flows.size(), 43u);
+    EXPECT_EQ(flows.lookup(inet_addr("239.1.1.1"), htons(5000)), 8);
+}
+
+TEST(EthernetParserTest, ParseBurstKeepsMatchedFramesInOrder) {
+    FrameSpec other_port;
+    other_port.dst_port = 5001;
+    FrameSpec tagged;
+    tagged.tags = {{0x8100, 5}};
+    FrameSpec tcp;
+    tcp.protocol = IPPROTO_TCP;
+    const std::vector<std::vector<uint8_t>> frames = {build({}), build(other_port), build(tcp), build(tagged),
+                                                      std::vector<uint8_t>(10, 0), build({})};
+    std::vector<EthernetParser::Frame> burst;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        burst.push_back({frames[i].data(), static_cast<uint32_t>(frames[i].size()), i});
+    }
+
+    FlowTable flows;
+    flows.add("239.1.1.1", 5000, 1);
+    std::vector<EthernetParser::ParsedPacket> out(burst.size());
+    EthernetParser::DropCounters drops{};
+    const size_t kept = EthernetParser::parse_burst(burst.data(), burst.size(), out.data(), &flows, &drops);
+
+    ASSERT_EQ(kept, 3u);
+    EXPECT_EQ(out[0].timestamp_ns, 0u);
+    EXPECT_EQ(out[1].timestamp_ns, 3u);
+    EXPECT_EQ(out[1].vlan_id, 5);
+    EXPECT_EQ(out[2].timestamp_ns, 5u);
+    for (size_t i = 0; i < kept; ++i) EXPECT_EQ(out[i].channel, 1);
+    EXPECT_EQ(drops[static_cast<size_t>(Drop::NONE)], 3u);
+    EXPECT_EQ(drops[static_cast<size_t>(Drop::NO_FLOW)], 1u);
+    EXPECT_EQ(drops[static_cast<size_t>(Drop::NOT_UDP)], 1u);
+    EXPECT_EQ(drops[static_cast<size_t>(Drop::TRUNCATED)], 1u);
+
+    // No table: every valid datagram, channel unset
+    EXPECT_EQ(EthernetParser::parse_burst(burst.data(), burst.size(), out.data()), 4u);
+    EXPECT_EQ(out[1].channel, FlowTable::NO_CHANNEL);
+}
@@ -0,0 +1,70 @@
+#include "ultra/core/memory/hot_arena.hpp"
+#include "ultra/core/lockfree/spsc_queue.hpp"
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace ultra;
+
+namespace {
+HugePageOptions small_pages() {
+    HugePageOptions o;
+    o.page_size = PageSize::SMALL_4K;
+    o.populate = true;
+    return o;
+}
+
+struct Counted {
+    static inline int live = 0;
+    int id;
+    explicit Counted(int i) : id(i) { ++live; }
+    ~Counted() { --live; }
+};
+}
+
+TEST(HotArenaTest, PlacementsAreAlignedAndContiguous) {
+    HotArena arena(64 * 1024, small_pages());
+    EXPECT_EQ(arena.capacity(), 64u * 1024);
+
+    auto* a = static_cast<uint8_t*>(arena.allocate("a", 10));
+    auto* b = static_cast<uint8_t*>(arena.allocate("b", 100, 8)); // Raised to a cache line
+    auto* c = arena.create_page_aligned<std::array<uint64_t, 4>>("c");
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % 64, 0u);
+    EXPECT_EQ(b - a, 64); // 10 bytes round up to one line
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(c) % 4096, 0u);
+    EXPECT_TRUE(arena.contains(a));
+    EXPECT_TRUE(arena.contains(c));
+    EXPECT_FALSE(arena.contains(&arena));
+    EXPECT_EQ(arena.used(), 4096u + 64u);
+
+    using Queue = SPSCQueue<uint64_t, 1024>;
+    auto* q = arena.create<Queue>("queue");
+    ASSERT_TRUE(q->push(7));
+    uint64_t v = 0;
+    ASSERT_TRUE(q->pop(v));
+    EXPECT_EQ(v, 7u);
+
+    std::ostringstream os;
+    arena.print_layout(os);
+    EXPECT_NE(os.str().find("queue"), std::string::npos);
+    EXPECT_NE(os.str().find("4K pages"), std::string::npos);
+}
+
+TEST(HotArenaTest, ThrowsWhenFullAndDestroysObjects) {
+    {
+        HotArena arena(4096, small_pages());
+        auto* x = arena.create<Counted>("x", 1);
+        arena.create<Counted>("y", 2);
+        EXPECT_EQ(x->id, 1);
+        EXPECT_EQ(Counted::live, 2);
+        EXPECT_THROW(arena.allocate("too_big", 8192), std::bad_alloc);
+    }
+    EXPECT_EQ(Counted::live, 0);
+}
+
+TEST(HotArenaTest, FootprintCoversAlignmentSlop) {
+    const size_t need = HotArena::footprint(10) + HotArena::footprint(100) + HotArena::footprint(5000);
+    HotArena arena(need, small_pages());
+    arena.allocate("a", 10);
+    arena.allocate("b", 100);
+    EXPECT_NO_THROW(arena.allocate("c", 5000));
+}
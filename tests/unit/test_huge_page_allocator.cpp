@@ -0,0 +1,100 @@
+#include "ultra/core/memory/huge_page_allocator.hpp"
+#include "ultra/core/memory/object_pool.hpp"
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <vector>
+
+using namespace ultra;
+
+namespace {
+// Pages of [addr, addr+len) currently resident
+size_t resident_pages(void* addr, size_t len) {
+    std::vector<unsigned char> vec((len + 4095) / 4096);
+    if (mincore(addr, len, vec.data()) != 0) return 0;
+    size_t n = 0;
+    for (unsigned char v : vec) n += v & 1;
+    return n;
+}
+}
+
+TEST(HugePageAllocatorTest, MappedLengthRoundsToRequestedPage) {
+    HugePageOptions o;
+    o.page_size = PageSize::SMALL_4K;
+    EXPECT_EQ(HugePages::mapped_length(1, o), 4096u);
+    EXPECT_EQ(HugePages::mapped_length(4097, o), 8192u);
+    o.page_size = PageSize::HUGE_2MB;
+    EXPECT_EQ(HugePages::mapped_length(1, o), 2u << 20);
+    o.page_size = PageSize::HUGE_1GB;
+    EXPECT_EQ(HugePages::mapped_length((1u << 30) + 1, o), 2ull << 30);
+    EXPECT_STREQ(to_string(PageSize::HUGE_1GB), "1GB");
+}
+
+// Whatever the host's hugetlb pool holds, the reported page size must be
+// the one the kernel actually backs the mapping with
+TEST(HugePageAllocatorTest, ReportsObtainedPageSize) {
+    HugePageOptions o;
+    o.page_size = PageSize::HUGE_2MB;
+    o.populate = true;
+    HugePageMapping m = HugePages::map(3 << 20, o);
+    ASSERT_NE(m.addr, nullptr);
+    EXPECT_EQ(m.bytes, 4u << 20);
+    EXPECT_EQ(HugePages::page_size_of(m.addr), m.page_size);
+    HugePages::unmap(m);
+
+    // No fallback: either exactly 1GB pages or nothing
+    o.page_size = PageSize::HUGE_1GB;
+    o.allow_fallback = false;
+    o.populate = false;
+    m = HugePages::map(4096, o);
+    if (m.addr) {
+        EXPECT_EQ(m.page_size, PageSize::HUGE_1GB);
+        HugePages::unmap(m);
+    }
+}
+
+TEST(HugePageAllocatorTest, PopulateFaultsRequestedBytesOnly) {
+    HugePageOptions o;
+    o.page_size = PageSize::SMALL_4K;
+    o.populate = true;
+    HugePageMapping m = HugePages::map(64 * 4096, o);
+    ASSERT_NE(m.addr, nullptr);
+    EXPECT_EQ(resident_pages(m.addr, m.bytes), 64u);
+    HugePages::unmap(m);
+
+    o.populate = false;
+    m = HugePages::map(64 * 4096, o);
+    ASSERT_NE(m.addr, nullptr);
+    EXPECT_EQ(resident_pages(m.addr, m.bytes), 0u);
+    HugePages::unmap(m);
+}
+
+TEST(HugePageAllocatorTest, BindsToCoreNode) {
+    HugePageOptions o;
+    o.page_size = PageSize::SMALL_4K;
+    o.numa_node = HugePages::node_of_cpu(0);
+    o.populate = true;
+    HugePageMapping m = HugePages::map(1 << 20, o);
+    ASSERT_NE(m.addr, nullptr);
+    EXPECT_GE(o.numa_node, 0);
+    // mbind may be filtered in containers; when it works, memory is usable
+    if (m.numa_bound) static_cast<volatile char*>(m.addr)[4096] = 1;
+    HugePages::unmap(m);
+}
+
+TEST(HugePageAllocatorTest, AllocatorAndPoolCarryOptions) {
+    HugePageOptions o;
+    o.page_size = PageSize::SMALL_4K;
+    o.populate = true;
+
+    std::vector<uint64_t, HugePageAllocator<uint64_t>> v{HugePageAllocator<uint64_t>(o)};
+    v.resize(10000, 7);
+    EXPECT_EQ(v.get_allocator().options().page_size, PageSize::SMALL_4K);
+    EXPECT_EQ(v[9999], 7u);
+
+    ObjectPool<uint64_t, 1024> pool({.growable = false, .grow_watermark_pct = 90, .max_chunks = 1, .memory = o});
+    EXPECT_EQ(pool.page_size(), PageSize::SMALL_4K);
+    uint64_t* x = pool.allocate(42u);
+    ASSERT_NE(x, nullptr);
+    EXPECT_EQ(*x, 42u);
+    pool.deallocate(x);
+}
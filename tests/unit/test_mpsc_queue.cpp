@@ -0,0 +1,66 @@
+#include "ultra/core/lockfree/mpsc_queue.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace ultra;
+
+TEST(MPSCQueueTest, FifoUntilFull) {
+    MPSCQueue<uint64_t, 8> q;
+    for (uint64_t i = 0; i < 8; ++i) EXPECT_TRUE(q.push(i));
+    EXPECT_FALSE(q.push(99));
+    EXPECT_EQ(q.size(), 8u);
+
+    uint64_t v;
+    for (uint64_t i = 0; i < 8; ++i) {
+        ASSERT_TRUE(q.pop(v));
+        EXPECT_EQ(v, i);
+    }
+    EXPECT_FALSE(q.pop(v));
+
+    // Slots are reusable on the next lap
+    for (uint64_t i = 0; i < 20; ++i) {
+        ASSERT_TRUE(q.push(i));
+        const uint64_t* p = q.peek();
+        ASSERT_NE(p, nullptr);
+        EXPECT_EQ(*p, i);
+        q.release();
+    }
+    EXPECT_EQ(q.peek(), nullptr);
+}
+
+TEST(MPSCQueueTest, ManyProducersPerProducerOrder) {
+    struct Item { uint32_t producer; uint32_t seq; };
+    using Queue = MPSCQueue<Item, 1024>;
+    auto q = std::make_unique<Queue>();
+    constexpr int PRODUCERS = 4;
+    constexpr uint32_t PER_PRODUCER = 200000;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&, p] {
+            for (uint32_t i = 0; i < PER_PRODUCER; ) {
+                if (q->push({static_cast<uint32_t>(p), i})) ++i;
+                else std::this_thread::yield();
+            }
+        });
+    }
+
+    std::vector<uint32_t> next(PRODUCERS, 0);
+    bool ordered = true;
+    uint64_t total = 0;
+    Item batch[32];
+    while (total < uint64_t(PRODUCERS) * PER_PRODUCER) {
+        size_t n = q->pop_n(batch, 32);
+        if (n == 0) { std::this_thread::yield(); continue; }
+        for (size_t k = 0; k < n; ++k) {
+            ordered &= (batch[k].seq == next[batch[k].producer]++);
+        }
+        total += n;
+    }
+    for (auto& t : producers) t.join();
+
+    EXPECT_TRUE(ordered);
+    for (int p = 0; p < PRODUCERS; ++p) EXPECT_EQ(next[p], PER_PRODUCER);
+}
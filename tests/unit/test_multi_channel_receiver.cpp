@@ -0,0 +1,208 @@
+#include "ultra/network/multi_channel_receiver.hpp"
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace ultra;
+using network::MultiChannelReceiver;
+
+namespace {
+constexpr const char* GROUP = "239.255.42.97";
+constexpr const char* IFACE = "127.0.0.1";
+
+MultiChannelReceiver::Config loopback_config(const std::vector<std::pair<int, int>>& ports_priorities) {
+    MultiChannelReceiver::Config config;
+    config.receiver.interface_ip = IFACE;
+    config.receiver.batch_size = 8;
+    config.receiver.buffer_size = 512;
+    for (const auto& [port, priority] : ports_priorities) {
+        MultiChannelReceiver::ChannelConfig channel;
+        channel.name = "ch" + std::to_string(port);
+        channel.multicast_group = GROUP;
+        channel.port = port;
+        channel.priority = priority;
+        config.channels.push_back(channel);
+    }
+    return config;
+}
+
+void send_datagram(int port, const std::vector<uint8_t>& payload) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    in_addr iface{};
+    iface.s_addr = inet_addr(IFACE);
+    setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &iface, sizeof(iface));
+    sockaddr_in dst{};
+    dst.sin_family = AF_INET;
+    dst.sin_port = htons(static_cast<uint16_t>(port));
+    dst.sin_addr.s_addr = inet_addr(GROUP);
+    sendto(fd, payload.data(), payload.size(), 0, reinterpret_cast<sockaddr*>(&dst), sizeof(dst));
+    close(fd);
+}
+
+// MoldUDP64 packet whose blocks are one byte each: the message's sequence
+// number (low byte), so trimming is visible in the payload
+std::vector<uint8_t> mold_packet(uint64_t seq, uint16_t count, const char* session = "SESSION001") {
+    std::vector<uint8_t> p(sizeof(network::MoldUDP64Header));
+    auto* h = reinterpret_cast<network::MoldUDP64Header*>(p.data());
+    std::memcpy(h->session, session, sizeof(h->session));
+    h->sequence_number = __builtin_bswap64(seq);
+    h->message_count = __builtin_bswap16(count);
+    for (uint16_t i = 0; i < count && count != network::moldudp64::END_OF_SESSION; ++i) {
+        p.push_back(0);
+        p.push_back(1);
+        p.push_back(static_cast<uint8_t>(seq + i));
+    }
+    return p;
+}
+
+struct Delivered {
+    uint32_t channel;
+    uint64_t first_sequence;
+    std::vector<uint8_t> data;
+};
+
+// Polls until `want` packets were delivered or a second passed
+std::vector<Delivered> collect(MultiChannelReceiver& rx, size_t want) {
+    std::vector<Delivered> out;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (out.size() < want && std::chrono::steady_clock::now() < deadline) {
+        rx.poll([&](uint32_t channel, const network::MulticastReceiver::Packet& p, uint64_t seq) {
+            out.push_back({channel, seq, std::vector<uint8_t>(p.data, p.data + p.len)});
+        });
+    }
+    return out;
+}
+
+// Lets loopback datagrams reach the socket queues
+void settle() { std::this_thread::sleep_for(std::chrono::milliseconds(20)); }
+} // namespace
+
+TEST(MultiChannelReceiverTest, MoldSequenceGapsDuplicatesAndOverlap) {
+    auto config = loopback_config({{30111, 0}});
+    config.sequencing = MultiChannelReceiver::Sequencing::MOLDUDP64;
+    MultiChannelReceiver rx(config);
+    ASSERT_TRUE(rx.start());
+
+    send_datagram(30111, mold_packet(1, 2)); // 1, 2
+    send_datagram(30111, mold_packet(3, 1)); // 3
+    send_datagram(30111, mold_packet(3, 1)); // Duplicate
+    send_datagram(30111, mold_packet(6, 1)); // Gap: 4, 5 missed
+    send_datagram(30111, mold_packet(7, 0)); // Heartbeat, in sequence
+    send_datagram(30111, mold_packet(6, 3)); // Overlap: only 7, 8 are new
+    send_datagram(30111, {1, 2, 3}); // Too short
+    settle();
+
+    const auto got = collect(rx, 4);
+    ASSERT_EQ(got.size(), 4u);
+    EXPECT_EQ(got[0].first_sequence, 1u);
+    EXPECT_EQ(got[0].data, (std::vector<uint8_t>{0, 1, 1, 0, 1, 2})); // Header stripped
+    EXPECT_EQ(got[1].first_sequence, 3u);
+    EXPECT_EQ(got[2].first_sequence, 6u);
+    EXPECT_EQ(got[3].first_sequence, 7u);
+    EXPECT_EQ(got[3].data, (std::vector<uint8_t>{0, 1, 7, 0, 1, 8}));
+
+    collect(rx, 1); // Drain the short packet
+    const auto st = rx.stats(0);
+    EXPECT_EQ(st.packets, 4u);
+    EXPECT_EQ(st.gaps, 1u);
+    EXPECT_EQ(st.missed, 2u);
+    EXPECT_EQ(st.duplicates, 1u);
+    EXPECT_EQ(st.heartbeats, 1u);
+    EXPECT_EQ(st.malformed, 1u);
+    EXPECT_EQ(st.next_sequence, 9u);
+
+    // New session: sequence restarts without counting a gap
+    send_datagram(30111, mold_packet(1, 1, "SESSION002"));
+    settle();
+    ASSERT_EQ(collect(rx, 1).size(), 1u);
+    EXPECT_EQ(rx.stats(0).session_changes, 1u);
+    EXPECT_EQ(rx.stats(0).gaps, 1u);
+    EXPECT_EQ(rx.stats(0).next_sequence, 2u);
+}
+
+TEST(MultiChannelReceiverTest, HigherPriorityDrainedFirst) {
+    auto config = loopback_config({{30112, 0}, {30113, 5}});
+    MultiChannelReceiver rx(config);
+    ASSERT_TRUE(rx.start());
+
+    send_datagram(30112, {1});
+    send_datagram(30113, {2});
+    settle();
+    const auto got = collect(rx, 2);
+    ASSERT_EQ(got.size(), 2u);
+    EXPECT_EQ(got[0].channel, 1u); // Priority 5, sent second
+    EXPECT_EQ(got[1].channel, 0u);
+}
+
+TEST(MultiChannelReceiverTest, StrictPriorityDefersLowerTiers) {
+    auto config = loopback_config({{30114, 0}, {30115, 5}});
+    config.strict_priority = true;
+    MultiChannelReceiver rx(config);
+    ASSERT_TRUE(rx.start());
+
+    send_datagram(30114, {1});
+    send_datagram(30115, {2});
+    settle();
+    size_t low = 0, high = 0;
+    auto count = [&](uint32_t channel, const network::MulticastReceiver::Packet&, uint64_t) {
+        (channel == 0 ? low : high)++;
+    };
+    EXPECT_EQ(rx.poll(count), 1u);
+    EXPECT_EQ(high, 1u);
+    EXPECT_EQ(low, 0u);
+    EXPECT_EQ(rx.poll(count), 1u); // High tier quiet now
+    EXPECT_EQ(low, 1u);
+}
+
+TEST(MultiChannelReceiverTest, EqualPrioritiesRotate) {
+    auto config = loopback_config({{30116, 0}, {30117, 0}, {30118, 0}});
+    MultiChannelReceiver rx(config);
+    ASSERT_TRUE(rx.start());
+
+    std::vector<uint32_t> order;
+    auto record = [&](uint32_t channel, const network::MulticastReceiver::Packet&, uint64_t) {
+        order.push_back(channel);
+    };
+    for (int round = 0; round < 2; ++round) {
+        for (int port : {30116, 30117, 30118}) send_datagram(port, {0});
+        settle();
+        EXPECT_EQ(rx.poll(record), 3u);
+    }
+    EXPECT_EQ(order, (std::vector<uint32_t>{0, 1, 2, 1, 2, 0}));
+    EXPECT_EQ(rx.rounds(), 2u);
+    EXPECT_EQ(rx.stats(1).packets, 2u);
+}
+
+TEST(MultiChannelReceiverTest, GroupsSharingAPortStaySeparate) {
+    auto config = loopback_config({{30119, 0}, {30119, 0}});
+    config.channels[1].multicast_group = "239.255.42.96";
+    MultiChannelReceiver rx(config);
+    ASSERT_TRUE(rx.start());
+
+    send_datagram(30119, {7}); // To GROUP only
+    settle();
+    const auto got = collect(rx, 2);
+    ASSERT_EQ(got.size(), 1u);
+    EXPECT_EQ(got[0].channel, 0u);
+    EXPECT_EQ(rx.stats(1).packets, 0u);
+}
+
+TEST(MultiChannelReceiverTest, IoUringChannelsShareOneRingThread) {
+    auto config = loopback_config({{30120, 0}, {30121, 0}});
+    config.receiver.backend = network::MulticastReceiver::Backend::IO_URING;
+    config.receiver.uring_buffers = 32;
+    MultiChannelReceiver rx(config);
+    ASSERT_TRUE(rx.start());
+
+    send_datagram(30120, {1});
+    send_datagram(30121, {2});
+    settle();
+    const auto got = collect(rx, 2);
+    ASSERT_EQ(got.size(), 2u);
+    EXPECT_EQ(rx.stats(0).packets + rx.stats(1).packets, 2u);
+}
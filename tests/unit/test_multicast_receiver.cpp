@@ -0,0 +1,129 @@
+#include "ultra/network/multicast_receiver.hpp"
+#include <arpa/inet.h>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace ultra;
+
+namespace {
+constexpr const char* GROUP = "239.255.42.98";
+constexpr const char* IFACE = "127.0.0.1";
+
+network::MulticastReceiver::Config loopback_config(int port) {
+    network::MulticastReceiver::Config config;
+    config.interface_ip = IFACE;
+    config.multicast_group = GROUP;
+    config.port = port;
+    config.batch_size = 8;
+    config.buffer_size = 256;
+    return config;
+}
+
+// Sends each payload as one datagram to the loopback group
+void send_datagrams(int port, const std::vector<std::vector<uint8_t>>& payloads) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    in_addr iface{};
+    iface.s_addr = inet_addr(IFACE);
+    setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &iface, sizeof(iface));
+    sockaddr_in dst{};
+    dst.sin_family = AF_INET;
+    dst.sin_port = htons(static_cast<uint16_t>(port));
+    dst.sin_addr.s_addr = inet_addr(GROUP);
+    for (const auto& p : payloads) {
+        sendto(fd, p.data(), p.size(), 0, reinterpret_cast<sockaddr*>(&dst), sizeof(dst));
+    }
+    close(fd);
+}
+
+// Polls until `want` packets arrived (copied out) or a second passed
+std::vector<network::MulticastReceiver::Packet> collect(network::MulticastReceiver& rx, size_t want,
+                                                         std::vector<std::vector<uint8_t>>& data) {
+    std::vector<network::MulticastReceiver::Packet> out;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (out.size() < want && std::chrono::steady_clock::now() < deadline) {
+        for (const auto& p : rx.receive_batch()) {
+            out.push_back(p);
+            data.emplace_back(p.data, p.data + p.len);
+        }
+        if (out.size() < want) std::this_thread::yield();
+    }
+    return out;
+}
+
+Timestamp realtime_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<Timestamp>(ts.tv_sec) * 1'000'000'000ULL + static_cast<Timestamp>(ts.tv_nsec);
+}
+} // namespace
+
+TEST(MulticastReceiverTest, BatchReceivesInOrderAndDropsOversized) {
+    network::MulticastReceiver rx(loopback_config(30101));
+    if (!rx.start()) GTEST_SKIP() << "No multicast on loopback";
+
+    std::vector<std::vector<uint8_t>> payloads;
+    for (uint8_t i = 0; i < 5; ++i) payloads.push_back(std::vector<uint8_t>(10 + i, i));
+    payloads.push_back(std::vector<uint8_t>(1000, 0xFF)); // > buffer_size: truncated
+    payloads.push_back(std::vector<uint8_t>(3, 7));
+    send_datagrams(30101, payloads);
+
+    std::vector<std::vector<uint8_t>> got;
+    auto packets = collect(rx, 6, got);
+    if (packets.empty()) GTEST_SKIP() << "Multicast loopback not delivered";
+    ASSERT_EQ(packets.size(), 6u);
+    for (uint8_t i = 0; i < 5; ++i) EXPECT_EQ(got[i], payloads[i]);
+    EXPECT_EQ(got[5], payloads[6]);
+    EXPECT_EQ(rx.truncated(), 1u);
+    EXPECT_EQ(rx.packets(), 6u);
+}
+
+TEST(MulticastReceiverTest, KernelTimestampPrecedesReturn) {
+    network::MulticastReceiver rx(loopback_config(30102));
+    if (!rx.start()) GTEST_SKIP() << "No multicast on loopback";
+
+    const Timestamp before = realtime_ns();
+    send_datagrams(30102, {std::vector<uint8_t>(32, 1), std::vector<uint8_t>(32, 2)});
+    std::vector<std::vector<uint8_t>> got;
+    auto packets = collect(rx, 2, got);
+    if (packets.empty()) GTEST_SKIP() << "Multicast loopback not delivered";
+
+    EXPECT_FALSE(rx.hardware_timestamps_active());
+    for (const auto& p : packets) {
+        ASSERT_NE(p.kernel_ts, 0u); // Software rx stamp from the cmsg
+        EXPECT_GE(p.kernel_ts, before);
+        EXPECT_LE(p.kernel_ts, p.user_ts); // Queued before recvmmsg returned
+    }
+}
+
+TEST(MulticastReceiverTest, IoUringBackendDeliversBatches) {
+    auto config = loopback_config(30103);
+    config.backend = network::MulticastReceiver::Backend::IO_URING;
+    config.uring_buffers = 32; // Fewer than sent: multishot must be re-armed
+    network::MulticastReceiver rx(config);
+    if (!rx.start()) GTEST_SKIP() << "No multicast on loopback";
+    if (rx.backend_active() != network::MulticastReceiver::Backend::IO_URING) GTEST_SKIP() << "No io_uring";
+
+    std::vector<std::vector<uint8_t>> payloads;
+    for (uint8_t i = 0; i < 40; ++i) payloads.push_back(std::vector<uint8_t>(8 + i, i));
+    payloads.push_back(std::vector<uint8_t>(1000, 0xFF)); // > buffer_size: truncated
+    payloads.push_back(std::vector<uint8_t>(5, 0xAA));
+    const Timestamp before = realtime_ns();
+    send_datagrams(30103, payloads);
+
+    std::vector<std::vector<uint8_t>> got;
+    auto packets = collect(rx, 41, got);
+    if (packets.empty()) GTEST_SKIP() << "Multicast loopback not delivered";
+    ASSERT_EQ(packets.size(), 41u);
+    for (size_t i = 0; i < 40; ++i) EXPECT_EQ(got[i], payloads[i]);
+    EXPECT_EQ(got[40], payloads[41]);
+    EXPECT_EQ(rx.truncated(), 1u);
+    for (const auto& p : packets) {
+        EXPECT_GE(p.kernel_ts, before); // cmsg carried in the provided buffer
+        EXPECT_LE(p.kernel_ts, p.user_ts);
+    }
+}
@@ -0,0 +1,120 @@
+#include "ultra/network/multicast_sender.hpp"
+#include "ultra/network/multi_channel_receiver.hpp"
+#include "ultra/network/parsers/moldudp64.hpp"
+#include <chrono>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace ultra;
+using network::MoldUDP64Packer;
+using network::MulticastSender;
+using network::MultiChannelReceiver;
+
+namespace {
+constexpr const char* GROUP = "239.255.42.98";
+constexpr const char* IFACE = "127.0.0.1";
+constexpr const char* SESSION = "TEST000001";
+
+std::vector<uint8_t> message(uint8_t tag, size_t len) { return std::vector<uint8_t>(len, tag); }
+
+struct Delivered {
+    uint32_t channel;
+    uint64_t first_sequence;
+    std::vector<uint8_t> blocks;
+};
+
+std::vector<Delivered> collect(MultiChannelReceiver& rx, size_t want) {
+    std::vector<Delivered> out;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (out.size() < want && std::chrono::steady_clock::now() < deadline) {
+        rx.poll([&](uint32_t channel, const network::MulticastReceiver::Packet& p, uint64_t seq) {
+            out.push_back({channel, seq, std::vector<uint8_t>(p.data, p.data + p.len)});
+        });
+    }
+    return out;
+}
+} // namespace
+
+TEST(MulticastSenderTest, PackerFillsUpToMaxSize) {
+    std::vector<uint8_t> buffer(64, 0);
+    MoldUDP64Packer packer;
+    packer.begin(buffer.data(), 20 + 2 * (2 + 10), SESSION, 41);
+    EXPECT_EQ(packer.size(), sizeof(network::MoldUDP64Header));
+    EXPECT_TRUE(packer.add(message(1, 10).data(), 10));
+    EXPECT_TRUE(packer.add(message(2, 10).data(), 10));
+    EXPECT_FALSE(packer.add(message(3, 1).data(), 1)); // Full
+    ASSERT_EQ(packer.finish(), 44u);
+
+    const auto* h = reinterpret_cast<const network::MoldUDP64Header*>(buffer.data());
+    EXPECT_EQ(std::memcmp(h->session, SESSION, 10), 0);
+    EXPECT_EQ(network::moldudp64::sequence(*h), 41u);
+    EXPECT_EQ(network::moldudp64::count(*h), 2);
+    EXPECT_EQ(network::moldudp64::skip_blocks(buffer.data() + 20, 24, 2), 24u);
+    EXPECT_EQ(buffer[20 + 2 + 10 + 2], 2); // Second block's message
+}
+
+TEST(MulticastSenderTest, BatchedPacketsArriveInSequencePerChannel) {
+    MultiChannelReceiver::Config rx_config;
+    rx_config.receiver.interface_ip = IFACE;
+    rx_config.sequencing = MultiChannelReceiver::Sequencing::MOLDUDP64;
+    for (int port : {30131, 30132}) {
+        MultiChannelReceiver::ChannelConfig channel;
+        channel.multicast_group = GROUP;
+        channel.port = port;
+        rx_config.channels.push_back(channel);
+    }
+    MultiChannelReceiver rx(rx_config);
+    ASSERT_TRUE(rx.start());
+
+    MulticastSender::Config config;
+    config.interface_ip = IFACE;
+    config.batch_size = 8;
+    MulticastSender sender(config);
+    ASSERT_TRUE(sender.start());
+    const int a = sender.add_destination(GROUP, 30131);
+    const int b = sender.add_destination(GROUP, 30132);
+    ASSERT_GE(a, 0);
+    ASSERT_GE(b, 0);
+    EXPECT_EQ(sender.add_destination("not-a-group", 1), -1);
+
+    // Channel a: 3 packets of 2 messages; channel b: 1 packet of 3
+    MoldUDP64Packer packer;
+    uint64_t seq = 1;
+    for (uint8_t p = 0; p < 3; ++p) {
+        packer.begin(sender.buffer(), 1400, SESSION, seq);
+        packer.add(message(p, 5).data(), 5);
+        packer.add(message(p, 7).data(), 7);
+        seq += packer.count();
+        ASSERT_TRUE(sender.commit(a, packer.finish()));
+    }
+    packer.begin(sender.buffer(), 1400, SESSION, 100);
+    for (int i = 0; i < 3; ++i) packer.add(message(9, 3).data(), 3);
+    ASSERT_TRUE(sender.commit(b, packer.finish()));
+    sender.commit(a, network::moldudp64::write_heartbeat(sender.buffer(), SESSION, seq,
+                                                         network::moldudp64::END_OF_SESSION));
+    EXPECT_EQ(sender.pending(), 5u);
+    ASSERT_TRUE(sender.flush());
+    EXPECT_EQ(sender.stats().datagrams, 5u);
+    EXPECT_EQ(sender.stats().syscalls, 1u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const auto got = collect(rx, 4);
+    ASSERT_EQ(got.size(), 4u);
+    std::vector<uint64_t> seqs_a;
+    for (const auto& d : got) {
+        if (d.channel == 0) {
+            seqs_a.push_back(d.first_sequence);
+            EXPECT_EQ(d.blocks.size(), 2u + 5 + 2 + 7); // Header stripped by the receiver
+        } else {
+            EXPECT_EQ(d.first_sequence, 100u);
+            EXPECT_EQ(network::moldudp64::skip_blocks(d.blocks.data(), d.blocks.size(), 3), d.blocks.size());
+        }
+    }
+    EXPECT_EQ(seqs_a, (std::vector<uint64_t>{1, 3, 5}));
+    rx.poll([](uint32_t, const network::MulticastReceiver::Packet&, uint64_t) {}); // End of session
+    EXPECT_EQ(rx.stats(0).gaps, 0u);
+    EXPECT_EQ(rx.stats(0).heartbeats, 1u);
+    EXPECT_EQ(rx.stats(0).next_sequence, 7u);
+}
@@ -0,0 +1,168 @@
+#include "ultra/core/memory/object_pool.hpp"
+#include "ultra/market-data/book/order_book_l2.hpp"
+#include "ultra/strategy/rl-inference/rl_policy.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <set>
+#include <vector>
+
+using namespace ultra;
+
+namespace {
+struct Order {
+    uint64_t id;
+    int64_t price;
+    Order(uint64_t i, int64_t p) : id(i), price(p) {}
+};
+}
+
+TEST(ObjectPoolTest, FixedPoolExhaustsAndRecycles) {
+    ObjectPool<Order, 64> pool;
+    EXPECT_LT(sizeof(pool), 512u); // No inline free-index array
+
+    std::vector<Order*> live;
+    for (uint64_t i = 0; i < 64; ++i) {
+        Order* o = pool.allocate(i, static_cast<int64_t>(i * 10));
+        ASSERT_NE(o, nullptr);
+        EXPECT_EQ(o->id, i);
+        live.push_back(o);
+    }
+    EXPECT_EQ(std::set<Order*>(live.begin(), live.end()).size(), 64u);
+    EXPECT_EQ(pool.in_use(), 64u);
+    EXPECT_EQ(pool.allocate(99u, 0), nullptr);
+    EXPECT_EQ(pool.exhausted(), 1u);
+    EXPECT_FALSE(pool.maintain()); // Not growable
+
+    pool.deallocate(live[10]);
+    Order* again = pool.allocate(7u, 7);
+    EXPECT_EQ(again, live[10]); // LIFO reuse: the hottest slot comes back first
+    EXPECT_EQ(pool.high_watermark(), 64u);
+
+    for (auto* o : live) pool.deallocate(o);
+    EXPECT_EQ(pool.in_use(), 0u);
+    EXPECT_EQ(pool.high_watermark(), 64u);
+}
+
+TEST(ObjectPoolTest, FirstChunkFromCallerStorage) {
+    using Pool = ObjectPool<Order, 8>;
+    static_assert(Pool::chunk_align() <= alignof(uint64_t));
+    std::vector<uint64_t> storage(Pool::chunk_bytes() / sizeof(uint64_t));
+    const auto* begin = reinterpret_cast<const unsigned char*>(storage.data());
+    {
+        Pool pool({.growable = true, .max_chunks = 2, .first_chunk = storage.data()});
+        std::vector<Order*> live;
+        for (uint64_t i = 0; i < 8; ++i) {
+            live.push_back(pool.allocate(i, 0));
+            const auto* p = reinterpret_cast<const unsigned char*>(live.back());
+            EXPECT_TRUE(p >= begin && p < begin + Pool::chunk_bytes());
+        }
+        Order* grown = pool.allocate(8u, 0); // Emergency growth maps chunk 1
+        ASSERT_NE(grown, nullptr);
+        const auto* p = reinterpret_cast<const unsigned char*>(grown);
+        EXPECT_FALSE(p >= begin && p < begin + Pool::chunk_bytes());
+        EXPECT_EQ(pool.chunks(), 2u);
+        pool.deallocate(grown);
+        for (auto* o : live) pool.deallocate(o);
+    } // Must not unmap the caller's chunk
+    EXPECT_EQ(storage.size(), Pool::chunk_bytes() / sizeof(uint64_t));
+}
+
+TEST(ObjectPoolTest, MaintainGrowsAtWatermark) {
+    ObjectPool<Order, 100> pool({.growable = true, .grow_watermark_pct = 80, .max_chunks = 4});
+    std::vector<Order*> live;
+    for (uint64_t i = 0; i < 79; ++i) live.push_back(pool.allocate(i, 0));
+    EXPECT_FALSE(pool.maintain());
+    live.push_back(pool.allocate(79u, 0));
+    EXPECT_TRUE(pool.maintain());
+    EXPECT_EQ(pool.chunks(), 2u);
+    EXPECT_EQ(pool.capacity(), 200u);
+    EXPECT_FALSE(pool.maintain()); // 80/200 is below the new threshold
+
+    // Objects from both chunks are recognised and recycled
+    for (uint64_t i = 80; i < 200; ++i) live.push_back(pool.allocate(i, 0));
+    EXPECT_EQ(pool.emergency_grows(), 0u);
+    for (auto* o : live) {
+        EXPECT_TRUE(pool.owns(o));
+        pool.deallocate(o);
+    }
+    EXPECT_EQ(pool.in_use(), 0u);
+    EXPECT_EQ(pool.high_watermark(), 200u);
+}
+
+TEST(ObjectPoolTest, AllocateGrowsInlineUntilMaxChunks) {
+    ObjectPool<Order, 16> pool({.growable = true, .grow_watermark_pct = 90, .max_chunks = 3});
+    for (uint64_t i = 0; i < 48; ++i) ASSERT_NE(pool.allocate(i, 0), nullptr);
+    EXPECT_EQ(pool.emergency_grows(), 2u);
+    EXPECT_EQ(pool.allocate(48u, 0), nullptr);
+    EXPECT_EQ(pool.exhausted(), 1u);
+
+    pool.clear();
+    EXPECT_EQ(pool.in_use(), 0u);
+    for (uint64_t i = 0; i < 48; ++i) ASSERT_NE(pool.allocate(i, 0), nullptr);
+}
+
+// More resting orders than one pool chunk: the book must keep every one
+TEST(ObjectPoolTest, OrderBookDoesNotDropPastOneChunk) {
+    using namespace ultra::md;
+    auto book = std::make_unique<OrderBookL2>(1);
+
+    itch::ITCHDecoder::DecodedMessage msg{};
+    msg.valid = true;
+    msg.symbol_id = 1;
+    msg.event_type = MDEventType::ADD_ORDER;
+    msg.side = Side::BUY;
+    msg.price = 10000;
+    msg.quantity = 1;
+
+    const uint64_t n = OrderBookL2::MAX_ORDERS + 5000;
+    for (uint64_t i = 1; i <= n; ++i) {
+        msg.order_id = i;
+        book->update(msg);
+        if ((i & 4095) == 0) book->maintain();
+    }
+    EXPECT_EQ(book->best_bid().quantity, static_cast<Quantity>(n));
+    EXPECT_EQ(book->dropped_orders(), 0u);
+    EXPECT_EQ(book->order_pool().in_use(), n);
+    EXPECT_GE(book->order_pool().chunks(), 2u);
+    EXPECT_EQ(book->order_pool().emergency_grows(), 0u);
+
+    msg.event_type = MDEventType::DELETE_ORDER;
+    for (uint64_t i = 1; i <= n; ++i) {
+        msg.order_id = i;
+        book->update(msg);
+    }
+    EXPECT_EQ(book->order_pool().in_use(), 0u);
+    EXPECT_EQ(book->order_pool().high_watermark(), n);
+}
+
+// Engine::strategy_thread_loop: a burst of adds, then an idle pass that
+// calls maintain(). Growth must happen in the idle pass, never in allocate().
+TEST(ObjectPoolTest, StrategyIdlePassGrowsBookPool) {
+    using namespace ultra::md;
+    auto strategy = std::make_unique<strategy::RLPolicyStrategy>(1);
+    const auto& pool = strategy->order_book().order_pool();
+
+    itch::ITCHDecoder::DecodedMessage msg{};
+    msg.valid = true;
+    msg.symbol_id = 1;
+    msg.event_type = MDEventType::ADD_ORDER;
+    msg.side = Side::BUY;
+    msg.price = 10000;
+    msg.quantity = 1;
+
+    constexpr uint64_t BURST = 1024;
+    const uint64_t n = OrderBookL2::MAX_ORDERS + 5000;
+    strategy::StrategyOrder order;
+    for (uint64_t i = 1; i <= n; ++i) {
+        msg.order_id = i;
+        strategy->on_market_data(msg);
+        if (i % BURST == 0) {
+            while (strategy->get_order(order)) {}
+            strategy->maintain(); // Queue empty: the loop's !work_done branch
+        }
+    }
+    EXPECT_EQ(strategy->order_book().dropped_orders(), 0u);
+    EXPECT_EQ(pool.in_use(), n);
+    EXPECT_GE(pool.chunks(), 2u);
+    EXPECT_EQ(pool.emergency_grows(), 0u);
+}
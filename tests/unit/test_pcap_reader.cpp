@@ -0,0 +1,325 @@
+#include "ultra/network/replay/pcap_reader.hpp"
+#include "ultra/network/replay/replay_pacer.hpp"
+#include <arpa/inet.h>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace ultra;
+using network::PcapReader;
+using network::ReplayPacer;
+
+namespace {
+// Ethernet / IPv4 / UDP frame to dst:port with `payload` bytes of `fill`
+std::vector<uint8_t> udp_frame(const char* dst, uint16_t port, size_t payload, uint8_t fill) {
+    std::vector<uint8_t> f(12, 0xAA);
+    f.push_back(0x08);
+    f.push_back(0x00);
+    network::IPv4Header ip{};
+    ip.version_ihl = 0x45;
+    ip.total_length = htons(static_cast<uint16_t>(sizeof(ip) + sizeof(network::UDPHeader) + payload));
+    ip.ttl = 1;
+    ip.protocol = IPPROTO_UDP;
+    ip.dst_ip = inet_addr(dst);
+    const auto* ip_bytes = reinterpret_cast<const uint8_t*>(&ip);
+    f.insert(f.end(), ip_bytes, ip_bytes + sizeof(ip));
+    network::UDPHeader udp{};
+    udp.dst_port = htons(port);
+    udp.length = htons(static_cast<uint16_t>(sizeof(udp) + payload));
+    const auto* udp_bytes = reinterpret_cast<const uint8_t*>(&udp);
+    f.insert(f.end(), udp_bytes, udp_bytes + sizeof(udp));
+    f.resize(f.size() + payload, fill);
+    return f;
+}
+
+std::vector<uint8_t> arp_frame() {
+    std::vector<uint8_t> f(12, 0xFF);
+    f.push_back(0x08);
+    f.push_back(0x06);
+    f.resize(42, 0);
+    return f;
+}
+
+// Little or big-endian field writer
+struct Bytes {
+    std::vector<uint8_t> data;
+    bool big_endian = false;
+
+    void u16(uint16_t v) {
+        for (int i = 0; i < 2; ++i) data.push_back(static_cast<uint8_t>(v >> (big_endian ? 8 * (1 - i) : 8 * i)));
+    }
+    void u32(uint32_t v) {
+        for (int i = 0; i < 4; ++i) data.push_back(static_cast<uint8_t>(v >> (big_endian ? 8 * (3 - i) : 8 * i)));
+    }
+    void u64(uint64_t v) {
+        for (int i = 0; i < 8; ++i) data.push_back(static_cast<uint8_t>(v >> (big_endian ? 8 * (7 - i) : 8 * i)));
+    }
+    void raw(const std::vector<uint8_t>& b) { data.insert(data.end(), b.begin(), b.end()); }
+    void pad() { data.resize((data.size() + 3) & ~size_t{3}, 0); }
+};
+
+struct Record {
+    uint32_t sec;
+    uint32_t frac; ///< us or ns
+    std::vector<uint8_t> frame;
+};
+
+std::vector<uint8_t> pcap_file(const std::vector<Record>& records, bool nanos, bool big_endian,
+                               uint32_t link_type = 1) {
+    Bytes b;
+    b.big_endian = big_endian;
+    b.u32(nanos ? 0xA1B23C4D : 0xA1B2C3D4);
+    b.u16(2);
+    b.u16(4);
+    b.u32(0);
+    b.u32(0);
+    b.u32(65535);
+    b.u32(link_type);
+    for (const Record& r : records) {
+        b.u32(r.sec);
+        b.u32(r.frac);
+        b.u32(static_cast<uint32_t>(r.frame.size()));
+        b.u32(static_cast<uint32_t>(r.frame.size()));
+        b.raw(r.frame);
+    }
+    return b.data;
+}
+
+// pcapng block: type, total length, body (padded), total length
+void ng_block(Bytes& b, uint32_t type, const std::vector<uint8_t>& body) {
+    const uint32_t total = static_cast<uint32_t>(12 + ((body.size() + 3) & ~size_t{3}));
+    b.u32(type);
+    b.u32(total);
+    b.raw(body);
+    b.pad();
+    b.u32(total);
+}
+
+void ng_section(Bytes& b) {
+    Bytes body;
+    body.big_endian = b.big_endian;
+    body.u32(0x1A2B3C4D);
+    body.u16(1);
+    body.u16(0);
+    body.u64(~0ull); // Section length unknown
+    ng_block(b, 0x0A0D0D0A, body.data);
+}
+
+// IDB with optional if_tsresol (tsresol < 0: none) and if_tsoffset
+void ng_interface(Bytes& b, uint16_t link_type, int tsresol, int64_t tsoffset = 0) {
+    Bytes body;
+    body.big_endian = b.big_endian;
+    body.u16(link_type);
+    body.u16(0);
+    body.u32(65535);
+    if (tsresol >= 0) {
+        body.u16(9);
+        body.u16(1);
+        body.data.push_back(static_cast<uint8_t>(tsresol));
+        body.pad();
+    }
+    if (tsoffset != 0) {
+        body.u16(14);
+        body.u16(8);
+        body.u64(static_cast<uint64_t>(tsoffset));
+    }
+    body.u16(0);
+    body.u16(0);
+    ng_block(b, 1, body.data);
+}
+
+void ng_packet(Bytes& b, uint32_t interface, uint64_t ticks, const std::vector<uint8_t>& frame) {
+    Bytes body;
+    body.big_endian = b.big_endian;
+    body.u32(interface);
+    body.u32(static_cast<uint32_t>(ticks >> 32));
+    body.u32(static_cast<uint32_t>(ticks));
+    body.u32(static_cast<uint32_t>(frame.size()));
+    body.u32(static_cast<uint32_t>(frame.size()));
+    body.raw(frame);
+    ng_block(b, 6, body.data);
+}
+
+class TempFile {
+public:
+    explicit TempFile(const std::vector<uint8_t>& bytes)
+        : path_("/tmp/ultra_pcap_test_" + std::to_string(getpid()) + "_" + std::to_string(counter_++)) {
+        FILE* f = std::fopen(path_.c_str(), "wb");
+        std::fwrite(bytes.data(), 1, bytes.size(), f);
+        std::fclose(f);
+    }
+    ~TempFile() { std::remove(path_.c_str()); }
+    const std::string& path() const { return path_; }
+
+private:
+    static inline int counter_ = 0;
+    std::string path_;
+};
+
+constexpr uint64_t SEC = 1'000'000'000ull;
+} // namespace
+
+TEST(PcapReaderTest, ClassicMicrosecondAndNanosecondInBothByteOrders) {
+    const std::vector<Record> records = {{1700000000, 250, udp_frame("239.1.1.1", 5000, 10, 1)},
+                                         {1700000001, 999999, udp_frame("239.1.1.1", 5000, 20, 2)}};
+    for (bool big_endian : {false, true}) {
+        for (bool nanos : {false, true}) {
+            TempFile file(pcap_file(records, nanos, big_endian));
+            PcapReader reader;
+            ASSERT_TRUE(reader.open(file.path()));
+            EXPECT_EQ(reader.format(), PcapReader::Format::PCAP);
+            const uint64_t unit = nanos ? 1 : 1000;
+
+            PcapReader::Packet p{};
+            ASSERT_TRUE(reader.next(p));
+            EXPECT_EQ(p.timestamp_ns, 1700000000 * SEC + 250 * unit);
+            EXPECT_EQ(p.caplen, records[0].frame.size());
+            EXPECT_EQ(p.data[12], 0x08);
+            ASSERT_TRUE(reader.next(p));
+            EXPECT_EQ(p.timestamp_ns, 1700000001 * SEC + 999999 * unit);
+            EXPECT_FALSE(reader.next(p));
+            EXPECT_FALSE(reader.truncated());
+            EXPECT_EQ(reader.packets(), 2u);
+
+            reader.rewind();
+            network::EthernetParser::ParsedPacket udp{};
+            ASSERT_TRUE(reader.next_udp(udp));
+            EXPECT_EQ(udp.payload_len, 10);
+            EXPECT_EQ(udp.payload[0], 1);
+            EXPECT_EQ(udp.timestamp_ns, 1700000000 * SEC + 250 * unit);
+        }
+    }
+}
+
+TEST(PcapReaderTest, NextUdpSkipsOtherTrafficAndFiltersFlows) {
+    TempFile file(pcap_file({{1, 0, arp_frame()},
+                             {2, 0, udp_frame("239.1.1.2", 6000, 8, 9)},
+                             {3, 0, udp_frame("239.1.1.1", 5000, 8, 7)}},
+                            true, false));
+    PcapReader reader;
+    ASSERT_TRUE(reader.open(file.path()));
+    network::FlowTable flows;
+    flows.add("239.1.1.1", 5000, 4);
+
+    network::EthernetParser::ParsedPacket udp{};
+    ASSERT_TRUE(reader.next_udp(udp, &flows));
+    EXPECT_EQ(udp.channel, 4);
+    EXPECT_EQ(udp.timestamp_ns, 3 * SEC);
+    EXPECT_FALSE(reader.next_udp(udp, &flows));
+    EXPECT_EQ(reader.not_udp(), 1u);
+    EXPECT_EQ(reader.filtered(), 1u);
+}
+
+TEST(PcapReaderTest, LinuxCookedAndUnsupportedLinkTypes) {
+    // SLL header: packet type, ARPHRD, address length, 8-byte address, protocol
+    const auto eth = udp_frame("239.1.1.1", 5000, 4, 3);
+    std::vector<uint8_t> sll = {0, 2, 0, 1, 0, 6, 1, 2, 3, 4, 5, 6, 0, 0, 0x08, 0x00};
+    sll.insert(sll.end(), eth.begin() + 14, eth.end());
+
+    TempFile cooked(pcap_file({{1, 0, sll}}, false, false, 113));
+    PcapReader reader;
+    ASSERT_TRUE(reader.open(cooked.path()));
+    network::EthernetParser::ParsedPacket udp{};
+    ASSERT_TRUE(reader.next_udp(udp));
+    EXPECT_EQ(udp.payload_len, 4);
+    EXPECT_EQ(ntohs(udp.dst_port), 5000);
+
+    TempFile raw_ip(pcap_file({{1, 0, eth}}, false, false, 101));
+    ASSERT_TRUE(reader.open(raw_ip.path()));
+    PcapReader::Packet p{};
+    EXPECT_FALSE(reader.next(p));
+    EXPECT_EQ(reader.skipped(), 1u);
+}
+
+TEST(PcapReaderTest, PcapngResolutionsOffsetsAndSections) {
+    for (bool big_endian : {false, true}) {
+        Bytes b;
+        b.big_endian = big_endian;
+        ng_section(b);
+        ng_interface(b, 1, -1); // Default: microseconds
+        ng_interface(b, 1, 9, 100); // Nanoseconds, +100 s
+        ng_interface(b, 1, 0x80 | 10); // 2^-10 s
+        ng_packet(b, 0, 1'000'000, udp_frame("239.1.1.1", 5000, 1, 0));
+        ng_packet(b, 1, 5, udp_frame("239.1.1.1", 5000, 2, 0));
+        ng_packet(b, 2, 1024 + 512, udp_frame("239.1.1.1", 5000, 3, 0));
+        ng_block(b, 0x0BAD, {1, 2, 3, 4}); // Unknown block
+        {
+            // Simple packet block: no timestamp, keeps the previous one
+            Bytes body;
+            body.big_endian = big_endian;
+            const auto frame = udp_frame("239.1.1.1", 5000, 4, 0);
+            body.u32(static_cast<uint32_t>(frame.size()));
+            body.raw(frame);
+            ng_block(b, 3, body.data);
+        }
+        ng_packet(b, 3, 0, udp_frame("239.1.1.1", 5000, 5, 0)); // No such interface
+        ng_section(b); // New section: interface ids start over
+        ng_interface(b, 1, 9);
+        ng_packet(b, 0, 42, udp_frame("239.1.1.1", 5000, 6, 0));
+
+        TempFile file(b.data);
+        PcapReader reader;
+        ASSERT_TRUE(reader.open(file.path()));
+        EXPECT_EQ(reader.format(), PcapReader::Format::PCAPNG);
+        std::vector<std::pair<Timestamp, uint16_t>> got;
+        network::EthernetParser::ParsedPacket udp{};
+        while (reader.next_udp(udp)) got.emplace_back(udp.timestamp_ns, udp.payload_len);
+
+        const std::vector<std::pair<Timestamp, uint16_t>> want = {
+            {SEC, 1}, {100 * SEC + 5, 2}, {SEC + SEC / 2, 3}, {SEC + SEC / 2, 4}, {42, 6}};
+        EXPECT_EQ(got, want) << (big_endian ? "big endian" : "little endian");
+        EXPECT_EQ(reader.skipped(), 1u);
+        EXPECT_FALSE(reader.truncated());
+    }
+}
+
+TEST(PcapReaderTest, CutOffCaptureEndsAtLastWholeRecord) {
+    auto bytes = pcap_file({{1, 0, udp_frame("239.1.1.1", 5000, 8, 0)}, {2, 0, udp_frame("239.1.1.1", 5000, 8, 0)}},
+                           false, false);
+    bytes.resize(bytes.size() - 5);
+    TempFile file(bytes);
+    PcapReader reader;
+    ASSERT_TRUE(reader.open(file.path()));
+    PcapReader::Packet p{};
+    EXPECT_TRUE(reader.next(p));
+    EXPECT_FALSE(reader.next(p));
+    EXPECT_TRUE(reader.truncated());
+
+    TempFile junk(std::vector<uint8_t>(64, 0x42));
+    EXPECT_FALSE(reader.open(junk.path()));
+    EXPECT_FALSE(reader.open("/nonexistent/capture.pcap"));
+}
+
+TEST(ReplayPacerTest, SchedulesOnCaptureTimeScaledBySpeed) {
+    RDTSCClock::calibrate();
+    ReplayPacer paced(1.0);
+    paced.schedule(1000 * SEC); // Anchor: due at once
+    EXPECT_TRUE(paced.due());
+    const Timestamp anchor = paced.due_ns();
+    paced.schedule(1000 * SEC + 3'000'000);
+    EXPECT_EQ(paced.due_ns() - anchor, 3'000'000u);
+    EXPECT_FALSE(paced.due()); // 3 ms ahead
+    paced.schedule(1000 * SEC + 2'000'000); // Backwards: no extra wait
+    EXPECT_EQ(paced.due_ns() - anchor, 3'000'000u);
+
+    ReplayPacer fast(4.0, 10'000'000);
+    fast.schedule(0);
+    const Timestamp fast_anchor = fast.due_ns();
+    fast.schedule(4'000'000);
+    EXPECT_EQ(fast.due_ns() - fast_anchor, 1'000'000u);
+    fast.schedule(3600 * SEC); // An hour of silence, cut to 10 ms
+    EXPECT_EQ(fast.due_ns() - fast_anchor, 1'000'000u + 2'500'000u);
+    EXPECT_EQ(fast.gaps_cut(), 1u);
+    fast.released(fast.due_ns() + 500); // Within LATE_NS
+    EXPECT_EQ(fast.late(), 0u);
+    fast.released(fast.due_ns() + 5000);
+    EXPECT_EQ(fast.late(), 1u);
+    EXPECT_EQ(fast.max_lag_ns(), 5000u);
+
+    ReplayPacer afap(0.0);
+    afap.schedule(0);
+    afap.schedule(3600 * SEC);
+    EXPECT_TRUE(afap.due());
+}
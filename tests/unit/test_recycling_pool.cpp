@@ -0,0 +1,102 @@
+#include "ultra/core/memory/recycling_pool.hpp"
+#include "ultra/core/lockfree/spsc_queue.hpp"
+#include <gtest/gtest.h>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace ultra;
+
+namespace {
+// Stands in for an order/report too large to copy through a queue
+struct BigMessage {
+    uint64_t id;
+    uint64_t checksum;
+    char payload[240];
+    BigMessage(uint64_t i) : id(i), checksum(i * 31 + 7) {}
+};
+}
+
+TEST(RecyclingPoolTest, OwnerOnlyBehavesLikeObjectPool) {
+    RecyclingPool<BigMessage, 32> pool;
+    std::vector<BigMessage*> live;
+    for (uint64_t i = 0; i < 32; ++i) live.push_back(pool.allocate(i));
+    EXPECT_EQ(std::set<BigMessage*>(live.begin(), live.end()).size(), 32u);
+    EXPECT_EQ(pool.allocate(99u), nullptr);
+    EXPECT_EQ(pool.exhausted(), 1u);
+
+    pool.deallocate(live[5]);
+    EXPECT_EQ(pool.allocate(5u), live[5]);
+    for (auto* m : live) pool.deallocate(m);
+    EXPECT_EQ(pool.in_use(), 0u);
+    EXPECT_EQ(pool.high_watermark(), 32u);
+}
+
+TEST(RecyclingPoolTest, RemoteFreesReturnInBatches) {
+    RecyclingPool<BigMessage, 16> pool({.growable = false, .max_chunks = 1, .magazine_size = 4});
+    std::vector<BigMessage*> live;
+    for (uint64_t i = 0; i < 16; ++i) live.push_back(pool.allocate(i));
+
+    {
+        RecyclingPool<BigMessage, 16>::Cache cache(pool);
+        for (int i = 0; i < 3; ++i) cache.release(live[i]);
+        EXPECT_EQ(cache.pending(), 3u);
+        EXPECT_EQ(pool.return_batches(), 0u);
+        EXPECT_EQ(pool.allocate(100u), nullptr); // Still in the magazine
+
+        cache.release(live[3]); // Fills the magazine: one batch
+        EXPECT_EQ(cache.pending(), 0u);
+        EXPECT_EQ(pool.return_batches(), 1u);
+        EXPECT_EQ(pool.returned(), 4u);
+        EXPECT_EQ(pool.in_use(), 12u);
+
+        cache.release(live[4]); // Partial magazine, flushed by ~Cache
+    }
+    EXPECT_EQ(pool.return_batches(), 2u);
+
+    // All five returned slots are reused before the pool reports exhaustion
+    std::set<BigMessage*> reused;
+    for (uint64_t i = 0; i < 5; ++i) {
+        BigMessage* m = pool.allocate(200 + i);
+        ASSERT_NE(m, nullptr);
+        reused.insert(m);
+    }
+    EXPECT_EQ(reused, std::set<BigMessage*>(live.begin(), live.begin() + 5));
+    EXPECT_EQ(pool.reclaims(), 1u); // Whole return stack taken in one exchange
+    EXPECT_EQ(pool.allocate(300u), nullptr);
+}
+
+TEST(RecyclingPoolTest, HandlesCrossThreadsWithoutCopy) {
+    constexpr uint64_t N = 200000;
+    RecyclingPool<BigMessage, 256> pool({.growable = false, .max_chunks = 1, .magazine_size = 16});
+    SPSCQueue<BigMessage*, 1024> handles;
+
+    std::thread retirer([&] {
+        RecyclingPool<BigMessage, 256>::Cache cache(pool);
+        uint64_t expected = 0;
+        while (expected < N) {
+            BigMessage* m;
+            if (!handles.pop(m)) {
+                cache.flush(); // Idle: don't sit on objects the owner needs
+                std::this_thread::yield();
+                continue;
+            }
+            EXPECT_EQ(m->id, expected);
+            EXPECT_EQ(m->checksum, expected * 31 + 7);
+            ++expected;
+            cache.release(m);
+        }
+    });
+
+    for (uint64_t i = 0; i < N; ++i) {
+        BigMessage* m;
+        while ((m = pool.allocate(i)) == nullptr) std::this_thread::yield();
+        while (!handles.push(m)) std::this_thread::yield();
+    }
+    retirer.join();
+
+    EXPECT_EQ(pool.chunks(), 1u);
+    EXPECT_EQ(pool.returned(), N);
+    EXPECT_EQ(pool.in_use(), 0u);
+    EXPECT_LE(pool.high_watermark(), 256u);
+}
@@ -0,0 +1,96 @@
+#include "ultra/core/memory/scratch_arena.hpp"
+#include "ultra/strategy/signal_engine.hpp"
+#include "ultra/strategy/performance_metrics.hpp"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <thread>
+
+using namespace ultra;
+
+TEST(ScratchArenaTest, BumpAllocatesAndScopeRewinds) {
+    ScratchArena arena(4096);
+    void* a;
+    {
+        ScratchArena::Scope scope(arena);
+        a = arena.allocate(100, 8);
+        void* b = arena.allocate(8, 64);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 64, 0u);
+        EXPECT_GT(b, a);
+        {
+            ScratchArena::Scope inner(arena);
+            EXPECT_NE(arena.allocate(1000, 8), nullptr);
+        }
+        // Inner scope released its bytes only
+        void* c = arena.allocate(8, 8);
+        EXPECT_LT(reinterpret_cast<uint8_t*>(c), reinterpret_cast<uint8_t*>(b) + 64);
+    }
+    EXPECT_EQ(arena.allocate(100, 8), a); // Same memory after rewind
+    EXPECT_GE(arena.high_watermark(), 1100u);
+    EXPECT_EQ(arena.upstream_allocations(), 0u);
+}
+
+TEST(ScratchArenaTest, PmrContainersAndFallbackCounter) {
+    ScratchArena arena(1024);
+    {
+        ScratchArena::Scope step(arena);
+        std::pmr::vector<int> v(&arena);
+        for (int i = 0; i < 1000; ++i) v.push_back(i); // Outgrows the first block
+        EXPECT_EQ(v[999], 999);
+    }
+    // Growth during the first step is sizing, not a fallback
+    EXPECT_GT(arena.upstream_allocations(), 0u);
+    EXPECT_EQ(arena.fallbacks(), 0u);
+
+    // Same-size step reuses the retained blocks
+    const uint64_t blocks = arena.upstream_allocations();
+    {
+        ScratchArena::Scope step(arena);
+        std::pmr::vector<int> v(&arena);
+        for (int i = 0; i < 1000; ++i) v.push_back(i);
+    }
+    EXPECT_EQ(arena.upstream_allocations(), blocks);
+    EXPECT_EQ(arena.fallbacks(), 0u);
+
+    // A larger step after a reset has to go to the heap: reported
+    {
+        ScratchArena::Scope step(arena);
+        std::pmr::vector<char> big(arena.bytes_reserved() * 2, 0, &arena);
+    }
+    EXPECT_EQ(arena.fallbacks(), 1u);
+}
+
+TEST(ScratchArenaTest, FormatAndThreadLocal) {
+    ScratchArena::Scope scope;
+    const char* s = scope.arena().format("oid=%llu qty=%u", 123456789012ULL, 100u);
+    EXPECT_STREQ(s, "oid=123456789012 qty=100");
+    const std::string longer(200, 'x');
+    EXPECT_EQ(std::strlen(scope.arena().format("%s", longer.c_str())), 200u);
+
+    ScratchArena* other = nullptr;
+    std::thread t([&] { other = &ScratchArena::local(); });
+    t.join();
+    EXPECT_NE(other, &ScratchArena::local());
+}
+
+TEST(ScratchArenaTest, SignalEnginePmrMatchesVectorApi) {
+    std::vector<double> prices(500);
+    for (size_t i = 0; i < prices.size(); ++i) prices[i] = 100.0 + (i % 17) * 0.5 - (i % 5) * 0.3;
+
+    ScratchArena arena(1 << 16);
+    ScratchArena::Scope step(arena);
+    auto rsi_a = strategy::SignalEngine::rsi(prices, 14);
+    auto rsi_b = strategy::SignalEngine::rsi(prices, 14, &arena);
+    ASSERT_EQ(rsi_a.size(), rsi_b.size());
+    for (size_t i = 0; i < rsi_a.size(); ++i) EXPECT_DOUBLE_EQ(rsi_a[i], rsi_b[i]);
+
+    auto fast = strategy::SignalEngine::sma(prices, 5, &arena);
+    auto slow = strategy::SignalEngine::sma(prices, 20, &arena);
+    auto sig_b = strategy::SignalEngine::ma_crossover_signal(fast, slow, &arena);
+    auto sig_a = strategy::SignalEngine::ma_crossover_signal(strategy::SignalEngine::sma(prices, 5),
+                                                             strategy::SignalEngine::sma(prices, 20));
+    EXPECT_TRUE(std::equal(sig_a.begin(), sig_a.end(), sig_b.begin()));
+
+    auto report = strategy::PerformanceAnalyst::analyze(prices);
+    EXPECT_NE(report.total_return, 0.0);
+}
@@ -0,0 +1,129 @@
+#include "ultra/core/lockfree/shm_spsc_queue.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <sys/wait.h>
+
+using namespace ultra;
+
+namespace {
+std::string test_name(const char* tag) {
+    return std::string("ultra_test_") + tag + "_" + std::to_string(getpid());
+}
+}
+
+TEST(ShmSPSCQueueTest, TwoMappingsShareTheRing) {
+    const std::string name = test_name("map");
+    using Queue = ShmSPSCQueue<uint64_t, 8>;
+    Queue prod, cons;
+    ASSERT_TRUE(prod.create(name));
+    ASSERT_TRUE(cons.attach(name));
+    EXPECT_EQ(prod.role(), Queue::Role::PRODUCER);
+    EXPECT_EQ(cons.role(), Queue::Role::CONSUMER);
+
+    for (uint64_t i = 0; i < 7; ++i) EXPECT_TRUE(prod.push(i));
+    EXPECT_FALSE(prod.push(7));
+    EXPECT_EQ(cons.size(), 7u);
+
+    uint64_t v;
+    for (uint64_t i = 0; i < 7; ++i) {
+        ASSERT_TRUE(cons.pop(v));
+        EXPECT_EQ(v, i);
+    }
+    EXPECT_FALSE(cons.pop(v));
+
+    // Zero-copy path across the wrap
+    for (uint64_t i = 0; i < 20; ++i) {
+        uint64_t* slot = prod.try_reserve();
+        ASSERT_NE(slot, nullptr);
+        *slot = i * 3;
+        prod.commit();
+        const uint64_t* p = cons.peek();
+        ASSERT_NE(p, nullptr);
+        EXPECT_EQ(*p, i * 3);
+        cons.release();
+    }
+}
+
+TEST(ShmSPSCQueueTest, AttachRejectsLayoutMismatch) {
+    const std::string name = test_name("mismatch");
+    ShmSPSCQueue<uint64_t, 8> prod;
+    ASSERT_TRUE(prod.create(name));
+
+    ShmSPSCQueue<uint64_t, 16> wrong_capacity;
+    EXPECT_FALSE(wrong_capacity.attach(name, 0));
+    ShmSPSCQueue<uint32_t, 8> wrong_type;
+    EXPECT_FALSE(wrong_type.attach(name, 0));
+
+    ShmSPSCQueue<uint64_t, 8> missing;
+    EXPECT_FALSE(missing.attach(test_name("nonexistent"), 0));
+}
+
+TEST(ShmSPSCQueueTest, DetectsDeadPeer) {
+    const std::string name = test_name("peer");
+    ShmSPSCQueue<uint64_t, 8> prod;
+    ASSERT_TRUE(prod.create(name));
+    EXPECT_FALSE(prod.peer_alive(1'000'000'000ULL)); // Nobody attached yet
+
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        ShmSPSCQueue<uint64_t, 8> cons;
+        if (!cons.attach(name)) _exit(1);
+        cons.heartbeat();
+        _exit(0); // Dies without close(): pid stays in the control block
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    EXPECT_EQ(prod.peer_pid(), child);
+    EXPECT_FALSE(prod.peer_alive(60'000'000'000ULL)); // Process gone
+}
+
+TEST(ShmSPSCQueueTest, HeartbeatAfterClockReadIsAlive) {
+    using Queue = ShmSPSCQueue<uint64_t, 8>;
+    const uint64_t now = Queue::monotonic_ns();
+    EXPECT_TRUE(Queue::heartbeat_fresh(now + 1'000, now, 0)); // Peer beat after `now` was sampled
+    EXPECT_TRUE(Queue::heartbeat_fresh(now - 500, now, 1'000));
+    EXPECT_FALSE(Queue::heartbeat_fresh(now - 2'000, now, 1'000));
+
+    const std::string name = test_name("fresh");
+    Queue prod, cons;
+    ASSERT_TRUE(prod.create(name));
+    ASSERT_TRUE(cons.attach(name));
+    cons.heartbeat();
+    EXPECT_TRUE(prod.peer_alive(1'000'000'000ULL));
+}
+
+TEST(ShmSPSCQueueTest, CrossProcessInOrder) {
+    const std::string name = test_name("xproc");
+    constexpr uint64_t N = 200000;
+    using Queue = ShmSPSCQueue<uint64_t, 1024>;
+    Queue prod;
+    ASSERT_TRUE(prod.create(name));
+
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        Queue cons;
+        if (!cons.attach(name)) _exit(1);
+        uint64_t expected = 0, v;
+        while (expected < N) {
+            if (!cons.pop(v)) { cons.heartbeat(); sched_yield(); continue; }
+            if (v != expected++) _exit(2);
+        }
+        cons.close();
+        _exit(0);
+    }
+
+    for (uint64_t i = 0; i < N; ) {
+        if (prod.push(i)) ++i; else std::this_thread::yield();
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+    EXPECT_EQ(prod.peer_pid(), 0); // Clean close clears the pid
+}
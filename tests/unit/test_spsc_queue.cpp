@@ -0,0 +1,119 @@
+#include "ultra/core/lockfree/spsc_queue.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace ultra;
+
+TEST(SPSCQueueTest, PushPopUntilFull) {
+    SPSCQueue<uint64_t, 8> q;
+    EXPECT_EQ(q.capacity(), 7u);
+    for (uint64_t i = 0; i < 7; ++i) EXPECT_TRUE(q.push(i));
+    EXPECT_FALSE(q.push(99));
+    EXPECT_EQ(q.size(), 7u);
+
+    uint64_t v;
+    for (uint64_t i = 0; i < 7; ++i) {
+        ASSERT_TRUE(q.pop(v));
+        EXPECT_EQ(v, i);
+    }
+    EXPECT_FALSE(q.pop(v));
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(SPSCQueueTest, BulkOpsWrapAround) {
+    SPSCQueue<uint64_t, 16> q;
+    uint64_t in[16], out[16];
+    uint64_t next_in = 0, next_out = 0;
+
+    // Uneven batch sizes force every wrap offset to be exercised
+    for (int round = 0; round < 200; ++round) {
+        size_t want = 1 + round % 11;
+        for (size_t i = 0; i < want; ++i) in[i] = next_in + i;
+        size_t pushed = q.push_n(in, want);
+        next_in += pushed;
+
+        size_t popped = q.pop_n(out, 1 + round % 7);
+        for (size_t i = 0; i < popped; ++i) ASSERT_EQ(out[i], next_out++);
+    }
+    while (size_t n = q.pop_n(out, 16)) {
+        for (size_t i = 0; i < n; ++i) ASSERT_EQ(out[i], next_out++);
+    }
+    EXPECT_EQ(next_in, next_out);
+}
+
+TEST(SPSCQueueTest, PushNStopsAtCapacity) {
+    SPSCQueue<uint32_t, 8> q;
+    uint32_t in[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    EXPECT_EQ(q.push_n(in, 10), 7u);
+    EXPECT_EQ(q.push_n(in, 1), 0u);
+    uint32_t v;
+    ASSERT_TRUE(q.pop(v));
+    EXPECT_EQ(q.push_n(in, 10), 1u);
+}
+
+TEST(SPSCQueueTest, CrossThreadOrdering) {
+    using Queue = SPSCQueue<uint64_t, 1024>;
+    auto q = std::make_unique<Queue>();
+    constexpr uint64_t N = 2000000;
+
+    std::thread producer([&] {
+        uint64_t batch[32];
+        uint64_t i = 0;
+        while (i < N) {
+            if (i % 3 == 0) {
+                if (q->push(i)) ++i; else std::this_thread::yield();
+                continue;
+            }
+            size_t n = std::min<uint64_t>(32, N - i);
+            for (size_t k = 0; k < n; ++k) batch[k] = i + k;
+            size_t pushed = q->push_n(batch, n);
+            if (pushed == 0) std::this_thread::yield();
+            i += pushed;
+        }
+    });
+
+    uint64_t expected = 0;
+    uint64_t out[32];
+    bool ordered = true;
+    while (expected < N) {
+        size_t n = q->pop_n(out, 32);
+        if (n == 0) std::this_thread::yield();
+        for (size_t k = 0; k < n; ++k) ordered &= (out[k] == expected++);
+    }
+    producer.join();
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(q->empty());
+}
+
+TEST(SPSCQueueTest, ReserveCommitPeekRelease) {
+    struct Big { uint64_t seq; char payload[128]; };
+    SPSCQueue<Big, 4> q;
+
+    // Reserve without commit publishes nothing
+    Big* slot = q.try_reserve();
+    ASSERT_NE(slot, nullptr);
+    EXPECT_EQ(q.peek(), nullptr);
+    EXPECT_EQ(q.try_reserve(), slot);
+
+    for (uint64_t i = 0; i < 3; ++i) {
+        Big* s = q.try_reserve();
+        ASSERT_NE(s, nullptr);
+        s->seq = i;
+        s->payload[0] = static_cast<char>('a' + i);
+        q.commit();
+    }
+    EXPECT_EQ(q.try_reserve(), nullptr);
+
+    for (uint64_t i = 0; i < 3; ++i) {
+        const Big* p = q.peek();
+        ASSERT_NE(p, nullptr);
+        EXPECT_EQ(p->seq, i);
+        EXPECT_EQ(p->payload[0], static_cast<char>('a' + i));
+        EXPECT_EQ(q.peek(), p); // Stable until release
+        q.release();
+    }
+    EXPECT_EQ(q.peek(), nullptr);
+    EXPECT_TRUE(q.empty());
+}
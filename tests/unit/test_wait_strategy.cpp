@@ -0,0 +1,139 @@
+#include "ultra/core/wait_strategy.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace ultra;
+
+namespace {
+class WaitStrategyTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() { RDTSCClock::calibrate(); }
+};
+}
+
+TEST_F(WaitStrategyTest, ParsePolicyNames) {
+    WaitPolicy p = WaitPolicy::BUSY_SPIN;
+    EXPECT_TRUE(parse_wait_policy("spin_futex", p));
+    EXPECT_EQ(p, WaitPolicy::SPIN_FUTEX);
+    EXPECT_TRUE(parse_wait_policy("backoff", p));
+    EXPECT_EQ(p, WaitPolicy::BACKOFF);
+    EXPECT_FALSE(parse_wait_policy("sleepy", p));
+    EXPECT_EQ(p, WaitPolicy::BACKOFF);
+    EXPECT_STREQ(to_string(WaitPolicy::SPIN_YIELD), "spin_yield");
+}
+
+TEST_F(WaitStrategyTest, HistogramPercentiles) {
+    WakeLatencyHistogram h;
+    for (int i = 0; i < 99; ++i) h.record(100); // Bucket [64, 128)
+    h.record(5000);                             // Bucket [4096, 8192)
+    EXPECT_EQ(h.count(), 100u);
+    EXPECT_EQ(h.max_ns(), 5000u);
+    EXPECT_EQ(h.percentile_ns(0.5), 127u);
+    EXPECT_EQ(h.percentile_ns(1.0), 8191u);
+    h.reset();
+    EXPECT_EQ(h.percentile_ns(0.5), 0u);
+}
+
+TEST_F(WaitStrategyTest, OneWakeSamplePerIdleStretch) {
+    WaitStrategy::Config cfg;
+    cfg.policy = WaitPolicy::BACKOFF;
+    cfg.max_backoff_shift = 4;
+    WaitStrategy w(cfg);
+
+    w.on_work(); // Busy from the start: nothing to record
+    EXPECT_EQ(w.idle_gap().count(), 0u);
+    for (int i = 0; i < 50; ++i) w.idle();
+    w.on_work();
+    w.on_work();
+    EXPECT_EQ(w.idle_gap().count(), 1u);
+    EXPECT_EQ(w.wake_latency().count(), 0u); // No notify(): no wake sample
+
+    for (int i = 0; i < 5; ++i) w.idle();
+    w.notify();
+    w.on_work();
+    EXPECT_EQ(w.idle_gap().count(), 2u);
+    EXPECT_EQ(w.wake_latency().count(), 1u);
+}
+
+TEST_F(WaitStrategyTest, BusySpinWakeLatencyStartsAtNotify) {
+    WaitStrategy w; // BUSY_SPIN
+    w.notify(); // Consumed while busy: must not count towards the next stretch
+    w.on_work();
+    for (int i = 0; i < 1000; ++i) w.idle();
+
+    const auto gap_start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - gap_start < std::chrono::milliseconds(2)) w.idle();
+    w.notify();
+    w.on_work();
+
+    ASSERT_EQ(w.wake_latency().count(), 1u);
+    ASSERT_EQ(w.idle_gap().count(), 1u);
+    EXPECT_GE(w.idle_gap().max_ns(), 2'000'000u);
+    EXPECT_LT(w.wake_latency().max_ns(), 1'000'000u); // notify -> poll, not the whole gap
+}
+
+TEST_F(WaitStrategyTest, SpinYieldEscalates) {
+    WaitStrategy::Config cfg;
+    cfg.policy = WaitPolicy::SPIN_YIELD;
+    cfg.spin_iterations = 10;
+    WaitStrategy w(cfg);
+    for (int i = 0; i < 15; ++i) w.idle();
+    EXPECT_EQ(w.yields(), 5u);
+    w.on_work();
+    for (int i = 0; i < 10; ++i) w.idle(); // Back to spinning after work
+    EXPECT_EQ(w.yields(), 5u);
+}
+
+TEST_F(WaitStrategyTest, FutexParkIsBoundedByTimeout) {
+    WaitStrategy::Config cfg;
+    cfg.policy = WaitPolicy::SPIN_FUTEX;
+    cfg.spin_iterations = 0;
+    cfg.park_timeout_ns = 2'000'000; // 2ms
+    WaitStrategy w(cfg);
+
+    auto start = std::chrono::steady_clock::now();
+    w.idle();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(w.parks(), 1u);
+    EXPECT_GE(elapsed, std::chrono::microseconds(1500));
+    EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+
+    // A ready predicate skips the sleep entirely
+    w.idle([] { return true; });
+    EXPECT_EQ(w.parks(), 1u);
+}
+
+TEST_F(WaitStrategyTest, FutexNotifyWakesConsumer) {
+    WaitStrategy::Config cfg;
+    cfg.policy = WaitPolicy::SPIN_FUTEX;
+    cfg.spin_iterations = 0;
+    cfg.park_timeout_ns = 10'000'000'000ULL; // Only notify() can end it in time
+    WaitStrategy w(cfg);
+
+    std::atomic<int> items{0};
+    constexpr int N = 200;
+    std::thread consumer([&] {
+        int seen = 0;
+        while (seen < N) {
+            if (items.load(std::memory_order_acquire) > seen) {
+                ++seen;
+                w.on_work();
+            } else {
+                w.idle([&] { return items.load(std::memory_order_acquire) > seen; });
+            }
+        }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < N; ++i) {
+        items.fetch_add(1, std::memory_order_release);
+        w.notify();
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    consumer.join();
+
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    EXPECT_GT(w.wake_latency().count(), 0u);
+}
@@ -0,0 +1,130 @@
+#include "ultra/core/work_stealing_pool.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace ultra;
+
+TEST(WorkStealingPoolTest, DequeOwnerLifoThiefFifo) {
+    ChaseLevDeque<uint64_t, 8> dq;
+    for (uint64_t i = 1; i <= 8; ++i) ASSERT_TRUE(dq.push(i));
+    EXPECT_FALSE(dq.push(9));
+
+    uint64_t v;
+    ASSERT_TRUE(dq.steal(v));
+    EXPECT_EQ(v, 1u);
+    ASSERT_TRUE(dq.pop(v));
+    EXPECT_EQ(v, 8u);
+    EXPECT_EQ(dq.size(), 6u);
+
+    while (dq.pop(v)) {}
+    EXPECT_TRUE(dq.empty());
+    EXPECT_FALSE(dq.steal(v));
+}
+
+TEST(WorkStealingPoolTest, DequeEachItemTakenOnce) {
+    auto dq = std::make_unique<ChaseLevDeque<uint64_t, 1024>>();
+    constexpr uint64_t N = 200000;
+    std::vector<std::atomic<uint8_t>> seen(N);
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> taken{0};
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t) {
+        thieves.emplace_back([&] {
+            uint64_t v;
+            while (!done.load(std::memory_order_acquire)) {
+                if (dq->steal(v)) {
+                    seen[v].fetch_add(1);
+                    taken.fetch_add(1);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    uint64_t v;
+    for (uint64_t i = 0; i < N; ) {
+        if (dq->push(i)) {
+            ++i;
+        } else if (dq->pop(v)) {
+            seen[v].fetch_add(1);
+            taken.fetch_add(1);
+        }
+        if ((i & 7) == 0 && dq->pop(v)) { // Owner pops interleaved with thieves
+            seen[v].fetch_add(1);
+            taken.fetch_add(1);
+        }
+    }
+    while (dq->pop(v)) {
+        seen[v].fetch_add(1);
+        taken.fetch_add(1);
+    }
+    while (taken.load() < N) std::this_thread::yield();
+    done.store(true, std::memory_order_release);
+    for (auto& t : thieves) t.join();
+
+    size_t bad = 0;
+    for (auto& s : seen) bad += (s.load() != 1);
+    EXPECT_EQ(bad, 0u);
+}
+
+TEST(WorkStealingPoolTest, ParallelForCoversRangeOnce) {
+    WorkStealingPool pool(WorkStealingPool::Config{3, {}});
+    EXPECT_EQ(pool.num_threads(), 3u);
+
+    constexpr size_t N = 100000;
+    std::vector<std::atomic<uint8_t>> hits(N);
+    pool.parallel_for(0, N, 100, [&](size_t lo, size_t hi) {
+        EXPECT_LE(hi - lo, 100u);
+        for (size_t i = lo; i < hi; ++i) hits[i].fetch_add(1, std::memory_order_relaxed);
+    });
+    size_t bad = 0;
+    for (auto& h : hits) bad += (h.load() != 1);
+    EXPECT_EQ(bad, 0u);
+
+    // Empty range is a no-op
+    pool.parallel_for(5, 5, [&](size_t, size_t) { FAIL(); });
+}
+
+TEST(WorkStealingPoolTest, NestedForkJoin) {
+    WorkStealingPool pool(WorkStealingPool::Config{2, {}});
+    std::atomic<uint64_t> sum{0};
+    pool.parallel_for(0, 16, 1, [&](size_t lo, size_t hi) {
+        for (size_t outer = lo; outer < hi; ++outer) {
+            pool.parallel_for(0, 1000, 50, [&](size_t a, size_t b) {
+                uint64_t local = 0;
+                for (size_t i = a; i < b; ++i) local += i;
+                sum.fetch_add(local, std::memory_order_relaxed);
+            });
+        }
+    });
+    EXPECT_EQ(sum.load(), 16u * (999u * 1000u / 2));
+}
+
+TEST(WorkStealingPoolTest, ParallelInvokeAndExceptions) {
+    WorkStealingPool pool(WorkStealingPool::Config{2, {}});
+    int a = 0, b = 0, c = 0;
+    pool.parallel_invoke([&] { a = 1; }, [&] { b = 2; }, [&] { c = 3; });
+    EXPECT_EQ(a + b + c, 6);
+
+    TaskGroup group(pool);
+    std::atomic<int> ran{0};
+    for (int i = 0; i < 10; ++i) {
+        group.run([&, i] {
+            ran.fetch_add(1);
+            if (i == 4) throw std::runtime_error("task failed");
+        });
+    }
+    EXPECT_THROW(group.wait(), std::runtime_error);
+    EXPECT_EQ(ran.load(), 10);
+
+    // Group is reusable after the error was reported
+    group.run([&] { ran.fetch_add(1); });
+    EXPECT_NO_THROW(group.wait());
+    EXPECT_EQ(ran.load(), 11);
+}
@@ -92,7 +92,7 @@ int main(int argc, char** argv) {
         current_mid += current_mid * (mu * dt_event + sigma * dW);
 
         // Step C: Generate ITCH Message
-        AddOrder msg;
+        AddOrder msg{};
         msg.header.type = 'A';
         msg.header.length = __builtin_bswap16(sizeof(AddOrder));
         msg.timestamp = __builtin_bswap64(timestamp_ns);